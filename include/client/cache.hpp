@@ -31,14 +31,24 @@
 #define GKFS_CLIENT_CACHE
 
 #include <client/open_file_map.hpp>
+#include <common/metadata.hpp>
 
+#include <hermes.hpp>
+
+#include <atomic>
+#include <chrono>
 #include <ctime>
 #include <functional>
+#include <list>
+#include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <mutex>
+#include <vector>
 #include <optional>
 #include <cstdint>
+#include <tuple>
 #include <utility>
 
 namespace gkfs::cache {
@@ -186,7 +196,335 @@ public:
     void
     flush_threshold(size_t flush_threshold);
 };
+
+/**
+ * @brief Cache of whole file chunks with adaptive sequential read-ahead.
+ *
+ * Reads that continue where the previous read of the same file ended are
+ * considered sequential. A sequential read that misses the cache fetches the
+ * chunks it covers plus a read-ahead window of whole chunks in a single read.
+ * The window starts at one chunk and doubles with each sequential miss up to
+ * `max_read_ahead` chunks. Non-sequential reads that miss bypass the cache and
+ * reset the window. Cached chunks are evicted in LRU order to stay within
+ * `max_size` bytes.
+ *
+ * The daemons place each chunk at its offset in the buffer but only report the
+ * total size of a read. A fetch that returns fewer bytes than requested is
+ * taken to end at EOF, as it would be for an uncached read of the same range.
+ * Per-file state is only created for reads that may insert chunks and is
+ * dropped with the file's last cached chunk.
+ *
+ * The cache only knows about local modifications. Writes, truncates, and
+ * removals by this client must invalidate the affected file.
+ */
+class ChunkCache {
+public:
+    /**
+     * @brief Reads [offset, offset + count) of a file from the daemons into
+     * buf
+     * @return error code and read size
+     */
+    using fetch_fn = std::function<std::pair<int, long>(char* buf,
+                                                        off64_t offset,
+                                                        size_t count)>;
+
+private:
+    struct chunk_entry {
+        std::string path;
+        uint64_t chunk_id;
+        std::vector<char> data; // shorter than a chunk if it contains EOF
+    };
+    using lru_list = std::list<chunk_entry>;
+
+    struct file_entry {
+        std::unordered_map<uint64_t, lru_list::iterator> chunks;
+        off64_t next_offset{0}; // offset where a sequential read continues
+        uint64_t read_ahead{0}; // current read-ahead window in chunks
+        uint64_t generation{0}; // renewed with every invalidation
+    };
+
+    std::unordered_map<std::string, file_entry> files_;
+    lru_list lru_; // most recently used chunk first
+    std::mutex mtx_;
+
+    size_t chunk_size_;
+    size_t max_size_;
+    uint64_t max_read_ahead_;
+    size_t size_{0}; // cached bytes
+    // source of file generations. Unique across all file entries so that a
+    // fetch in flight is not inserted into a recreated entry of its file.
+    uint64_t generation_{0};
+
+    size_t hits_{0};
+    size_t misses_{0};
+
+    /**
+     * @brief Creates the entry of a file with a new generation. Caller must
+     * hold mtx_
+     */
+    file_entry&
+    add_file(const std::string& path);
+
+    /**
+     * @brief Copies a fully cached range into buf. Caller must hold mtx_
+     * @return read size or -1 if a chunk of the range is not cached
+     */
+    long
+    read_cached(file_entry& file, char* buf, off64_t offset, size_t count);
+
+    /**
+     * @brief Inserts the chunks of a fetched range. Caller must hold mtx_
+     */
+    void
+    insert(const std::string& path, file_entry& file, const char* buf,
+           uint64_t first_chunk, size_t read_size);
+
+    /**
+     * @brief Removes a cached chunk. Caller must hold mtx_
+     */
+    void
+    erase(file_entry& file, uint64_t chunk_id);
+
+public:
+    ChunkCache(size_t chunk_size, size_t max_size, uint64_t max_read_ahead);
+
+    virtual ~ChunkCache() = default;
+
+    /**
+     * @brief Serves a read from the cache, fetching missing chunks and the
+     * read-ahead window for sequential reads
+     * @param path gekkofs path
+     * @param buf
+     * @param offset
+     * @param count
+     * @param fetch function reading from the daemons
+     * @return error code and read size
+     */
+    std::pair<int, long>
+    read(const std::string& path, char* buf, off64_t offset, size_t count,
+         const fetch_fn& fetch);
+
+    /**
+     * @brief Drops the cached chunks of a file that overlap a modified range
+     * @param path
+     * @param offset
+     * @param count
+     */
+    void
+    invalidate(const std::string& path, off64_t offset, size_t count);
+
+    /**
+     * @brief Drops all cached chunks and the read-ahead state of a file
+     * @param path
+     */
+    void
+    invalidate(const std::string& path);
+
+    /**
+     * @brief Clear the entire cache
+     */
+    void
+    clear();
+
+    // GETTER
+    size_t
+    size();
+
+    size_t
+    hits();
+
+    size_t
+    misses();
+};
+
+/**
+ * @brief Cache of file and directory metadata with bounded staleness.
+ *
+ * Entries expire `ttl` after they were fetched, so modifications by other
+ * clients are visible at the latest after `ttl`. Local modifications must
+ * invalidate the affected path. When the cache holds `max_entries` entries,
+ * the oldest entry is evicted.
+ *
+ * A fill passes the epoch taken before its stat request was sent. Fills are
+ * dropped if any path was invalidated in the meantime so that an in-flight
+ * stat cannot restore metadata that a local modification just invalidated.
+ */
+class StatCache {
+private:
+    using clock = std::chrono::steady_clock;
+
+    struct entry {
+        gkfs::metadata::Metadata md;
+        clock::time_point expires;
+        std::list<std::string>::iterator age; // position in insertion order
+    };
+
+    std::unordered_map<std::string, entry> entries_;
+    std::list<std::string> ages_; // oldest entry first
+    std::mutex mtx_;
+
+    std::chrono::milliseconds ttl_;
+    size_t max_entries_;
+    uint64_t epoch_{0}; // increased with every invalidation
+
+    size_t hits_{0};
+    size_t misses_{0};
+
+    /**
+     * @brief Removes an entry. Caller must hold mtx_
+     */
+    void
+    erase(std::unordered_map<std::string, entry>::iterator it);
+
+public:
+    StatCache(std::chrono::milliseconds ttl, size_t max_entries);
+
+    virtual ~StatCache() = default;
+
+    /**
+     * @brief Get the metadata of a path if it is cached and not expired
+     * @param path gekkofs path
+     * @return std::optional<gkfs::metadata::Metadata>
+     */
+    std::optional<gkfs::metadata::Metadata>
+    get(const std::string& path);
+
+    /**
+     * @brief Returns the epoch that must be taken before sending the stat
+     * request of a later insert()
+     * @return epoch
+     */
+    uint64_t
+    epoch();
+
+    /**
+     * @brief Insert the metadata of a path fetched from a daemon. Ignored if
+     * a path was invalidated since epoch was taken
+     * @param path gekkofs path
+     * @param md
+     * @param epoch
+     */
+    void
+    insert(const std::string& path, const gkfs::metadata::Metadata& md,
+           uint64_t epoch);
+
+    /**
+     * @brief Drops the metadata of a path after a local modification
+     * @param path
+     */
+    void
+    invalidate(const std::string& path);
+
+    /**
+     * @brief Clear the entire cache
+     */
+    void
+    clear();
+
+    // GETTER
+    size_t
+    size();
+
+    size_t
+    hits();
+
+    size_t
+    misses();
+};
 } // namespace file
+
+namespace buffer {
+
+/**
+ * @brief Cache of application buffers that are exposed to the network.
+ *
+ * Exposing a buffer registers its memory with the network transport, which
+ * is expensive on RDMA fabrics. Entries are looked up by their exact address
+ * range and access mode and are evicted in least recently used order when the
+ * cache holds `max_entries` entries. Only buffers up to `max_region_size`
+ * bytes are cached, which also bounds the search for overlapping entries.
+ *
+ * When the application returns memory to the kernel, all entries overlapping
+ * the range must be invalidated. Like the stat cache, an insert passes the
+ * epoch taken before the buffer was exposed and is dropped if an invalidation
+ * happened in the meantime.
+ */
+class RegistrationCache {
+private:
+    using key = std::tuple<uintptr_t, size_t, hermes::access_mode>;
+
+    struct entry {
+        std::shared_ptr<hermes::exposed_memory> memory;
+        std::list<key>::iterator age; // position in usage order
+    };
+
+    std::map<key, entry> entries_; // ordered by address for invalidation
+    std::list<key> ages_;          // least recently used entry first
+    std::mutex mtx_;
+
+    size_t max_entries_;
+    size_t max_region_size_;
+    // increased with every invalidation. Together with empty_, it lets
+    // invalidations of an empty cache skip the mutex
+    std::atomic<uint64_t> epoch_{0};
+    std::atomic<bool> empty_{true};
+
+    size_t hits_{0};
+    size_t misses_{0};
+
+    /**
+     * @brief Removes an entry. Caller must hold mtx_
+     * @return the entry's memory, to be released after unlocking mtx_
+     */
+    std::shared_ptr<hermes::exposed_memory>
+    erase(std::map<key, entry>::iterator it);
+
+public:
+    RegistrationCache(size_t max_entries, size_t max_region_size);
+
+    virtual ~RegistrationCache() = default;
+
+    /**
+     * @brief Returns the exposed memory of a buffer, exposing it with
+     * `expose` on a miss. Buffers larger than the maximum region size are
+     * exposed without being cached. The returned memory stays valid as long
+     * as the caller holds it, also if the entry is evicted in the meantime.
+     * @param addr start of the buffer
+     * @param size size of the buffer in bytes
+     * @param mode access mode of the remote side
+     * @param expose function that exposes the buffer, may throw
+     * @return exposed memory
+     */
+    std::shared_ptr<hermes::exposed_memory>
+    get(void* addr, size_t size, hermes::access_mode mode,
+        const std::function<hermes::exposed_memory()>& expose);
+
+    /**
+     * @brief Drops all entries that overlap an address range that is about
+     * to be unmapped or replaced
+     * @param addr start of the range
+     * @param size size of the range in bytes
+     */
+    void
+    invalidate(uintptr_t addr, size_t size);
+
+    /**
+     * @brief Clear the entire cache
+     */
+    void
+    clear();
+
+    // GETTER
+    size_t
+    size();
+
+    size_t
+    hits();
+
+    size_t
+    misses();
+};
+} // namespace buffer
 } // namespace gkfs::cache
 
 #endif // GKFS_CLIENT_CACHE
@@ -59,12 +59,28 @@ static constexpr auto METRICS_IP_PORT = ADD_PREFIX("METRICS_IP_PORT");
 #endif
 
 static constexpr auto NUM_REPL = ADD_PREFIX("NUM_REPL");
+static constexpr auto ASYNC_SIZE_UPDATE = ADD_PREFIX("ASYNC_SIZE_UPDATE");
+static constexpr auto ASYNC_CREATE = ADD_PREFIX("ASYNC_CREATE");
 static constexpr auto PROXY_PID_FILE = ADD_PREFIX("PROXY_PID_FILE");
+static constexpr auto HOST_LOOKUP_CONCURRENCY =
+        ADD_PREFIX("HOST_LOOKUP_CONCURRENCY");
+static constexpr auto LAZY_HOST_LOOKUP = ADD_PREFIX("LAZY_HOST_LOOKUP");
 namespace cache {
 static constexpr auto DENTRY = ADD_PREFIX("DENTRY_CACHE");
 static constexpr auto WRITE_SIZE = ADD_PREFIX("WRITE_SIZE_CACHE");
 static constexpr auto WRITE_SIZE_THRESHOLD =
         ADD_PREFIX("WRITE_SIZE_CACHE_THRESHOLD");
+static constexpr auto WRITE_BACK = ADD_PREFIX("WRITE_BACK_BUFFER");
+static constexpr auto WRITE_BACK_SIZE = ADD_PREFIX("WRITE_BACK_BUFFER_SIZE");
+static constexpr auto CHUNK = ADD_PREFIX("CHUNK_CACHE");
+static constexpr auto CHUNK_SIZE = ADD_PREFIX("CHUNK_CACHE_SIZE");
+static constexpr auto CHUNK_READ_AHEAD = ADD_PREFIX("CHUNK_CACHE_READ_AHEAD");
+static constexpr auto STAT = ADD_PREFIX("STAT_CACHE");
+static constexpr auto STAT_TTL = ADD_PREFIX("STAT_CACHE_TTL");
+static constexpr auto STAT_SIZE = ADD_PREFIX("STAT_CACHE_SIZE");
+static constexpr auto STAT_PREFILL = ADD_PREFIX("STAT_CACHE_PREFILL");
+static constexpr auto REGISTRATION = ADD_PREFIX("REGISTRATION_CACHE");
+static constexpr auto REGISTRATION_SIZE = ADD_PREFIX("REGISTRATION_CACHE_SIZE");
 } // namespace cache
 
 } // namespace gkfs::env
@@ -118,6 +118,14 @@ gkfs_pwrite(int fd, const void* buf, size_t count, off64_t offset);
 ssize_t
 gkfs_write(int fd, const void* buf, size_t count);
 
+ssize_t
+gkfs_do_writev(gkfs::filemap::OpenFile& file, const struct iovec* iov,
+               int iovcnt, off64_t offset, bool update_pos);
+
+ssize_t
+gkfs_writev_ws(gkfs::filemap::OpenFile& file, const struct iovec* iov,
+               int iovcnt, off64_t offset, bool update_pos = false);
+
 ssize_t
 gkfs_pwritev(int fd, const struct iovec* iov, int iovcnt, off_t offset);
 
@@ -138,6 +146,14 @@ gkfs_pread(int fd, void* buf, size_t count, off64_t offset);
 ssize_t
 gkfs_read(int fd, void* buf, size_t count);
 
+ssize_t
+gkfs_do_readv(const gkfs::filemap::OpenFile& file, const struct iovec* iov,
+              int iovcnt, off64_t offset);
+
+ssize_t
+gkfs_readv_ws(const gkfs::filemap::OpenFile& file, const struct iovec* iov,
+              int iovcnt, off64_t offset);
+
 ssize_t
 gkfs_readv(int fd, const struct iovec* iov, int iovcnt);
 
@@ -157,6 +173,27 @@ gkfs_getdents64(unsigned int fd, struct linux_dirent64* dirp,
 int
 gkfs_rmdir(const std::string& path);
 
+// Writes back buffered writes of all open files of path, or of all open files
+// if path is empty
+int
+gkfs_flush_write_back(const std::string& path = "");
+
+// Sends deferred creates of the asynchronous create mode. Returns -1 if the
+// create of path failed, or of any path if path is empty
+int
+gkfs_flush_creates(const std::string& path = "");
+
+// Batched variants that return an error code per path
+std::vector<int>
+gkfs_create_bulk(const std::vector<std::string>& paths, mode_t mode);
+
+std::vector<int>
+gkfs_stat_bulk(const std::vector<std::string>& paths,
+               std::vector<struct stat>& bufs, bool follow_links = true);
+
+std::vector<int>
+gkfs_remove_bulk(const std::vector<std::string>& paths);
+
 int
 gkfs_fsync(unsigned int fd);
 
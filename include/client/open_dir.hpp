@@ -52,10 +52,21 @@ public:
     type();
 };
 
+/**
+ * An open directory. Entries are either added all at once, or, for a paged
+ * directory, page by page from several sources (the daemons) as getdents()
+ * consumes them. A paged directory only holds the entries of the last fetched
+ * pages, so entry positions are counted from the beginning of the directory.
+ */
 class OpenDir : public OpenFile {
 private:
     std::vector<DirEntry> entries;
-
+    // position of the first held entry within the directory
+    size_t offset_{0};
+    // resume key per source. An exhausted source has no resume key
+    std::vector<std::string> cursors_{};
+    std::vector<bool> exhausted_{};
+    bool complete_{true};
 
 public:
     explicit OpenDir(const std::string& path);
@@ -66,8 +77,56 @@ public:
     const DirEntry&
     getdent(unsigned int pos);
 
+    /**
+     * @return position after the last held entry
+     */
     size_t
     size();
+
+    /**
+     * @return position of the first held entry
+     */
+    size_t
+    offset() const;
+
+    /**
+     * Drops all held entries and starts fetching the directory from the
+     * beginning
+     * @param sources number of sources that each provide their own pages
+     */
+    void
+    begin_paging(size_t sources);
+
+    /**
+     * Drops all held entries. The position of following entries continues
+     * after them.
+     */
+    void
+    drop_entries();
+
+    /**
+     * @return true if all sources are exhausted
+     */
+    bool
+    complete() const;
+
+    /**
+     * @param max maximum number of returned sources
+     * @return the first sources that are not exhausted yet
+     */
+    std::vector<size_t>
+    next_sources(size_t max) const;
+
+    const std::string&
+    cursor(size_t source) const;
+
+    /**
+     * Sets the resume key of a source after it returned a page
+     * @param source
+     * @param next_key resume key for the next page, empty if exhausted
+     */
+    void
+    cursor(size_t source, const std::string& next_key);
 };
 
 } // namespace gkfs::filemap
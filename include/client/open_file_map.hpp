@@ -36,6 +36,8 @@
 #include <atomic>
 #include <array>
 #include <string>
+#include <vector>
+#include <cstdint>
 
 namespace gkfs::filemap {
 
@@ -56,6 +58,88 @@ enum class OpenFile_flags {
 
 enum class FileType { regular, directory };
 
+/**
+ * @brief Write-back buffer of an open file that coalesces adjacent small
+ * writes into a single contiguous extent.
+ *
+ * The buffer never spans a chunk boundary so that a flush is served by a single
+ * daemon. It does not talk to the daemons itself. Flushing is done by the
+ * syscall layer, which must hold mutex() while accessing the buffer.
+ */
+class WriteBackBuffer {
+private:
+    std::mutex mutex_;
+    std::vector<char> data_;
+    int64_t offset_{0}; //!< file offset of the first buffered byte
+
+    static std::atomic<size_t> dirty_; //!< number of buffers holding data
+
+public:
+    WriteBackBuffer() = default;
+
+    ~WriteBackBuffer();
+
+    /**
+     * @brief Number of write-back buffers of all open files that hold data.
+     * Readers use it to skip looking for buffers to flush without taking any
+     * lock when nothing is buffered.
+     */
+    static size_t
+    dirty_count();
+
+    std::mutex&
+    mutex();
+
+    bool
+    empty() const;
+
+    const char*
+    data() const;
+
+    size_t
+    size() const;
+
+    int64_t
+    offset() const;
+
+    /**
+     * @brief File offset directly after the last buffered byte
+     */
+    int64_t
+    end() const;
+
+    /**
+     * @brief Adds a write to the buffer if it is adjacent to the buffered
+     * extent, the buffer stays within `capacity` bytes, and the extent does not
+     * cross a chunk boundary. An empty buffer starts a new extent at `offset`.
+     * @param buf
+     * @param count
+     * @param offset
+     * @param capacity maximum number of buffered bytes
+     * @param chunk_size
+     * @return true if the write was buffered
+     */
+    bool
+    append(const char* buf, size_t count, int64_t offset, size_t capacity,
+           size_t chunk_size);
+
+    /**
+     * @brief Checks if the buffer reached its capacity or the end of a chunk
+     * and no further write can be added.
+     * @param capacity
+     * @param chunk_size
+     * @return true if the buffer must be flushed
+     */
+    bool
+    full(size_t capacity, size_t chunk_size) const;
+
+    /**
+     * @brief Drops the buffered data. The allocated memory is kept for reuse.
+     */
+    void
+    clear();
+};
+
 class OpenFile {
 protected:
     FileType type_;
@@ -65,6 +149,8 @@ protected:
     unsigned long pos_;
     std::mutex pos_mutex_;
     std::mutex flag_mutex_;
+    // mutable as reads, which work on const files, flush the buffered data
+    mutable WriteBackBuffer write_back_;
 
 public:
     // multiple threads may want to update the file position if fd has been
@@ -96,44 +182,110 @@ public:
 
     FileType
     type() const;
+
+    WriteBackBuffer&
+    write_back() const;
 };
 
 
+/**
+ * @brief Maps the file descriptors handed out by the client to their open
+ * files.
+ *
+ * File descriptors in [fd_base, fd_base + fd_table_size) are stored in a fixed
+ * slot array indexed by fd - fd_base. Every syscall on a file descriptor asks
+ * the map whether the fd belongs to GekkoFS, so exist() and get() are
+ * wait-free for these fds. Slots are claimed with a compare-and-swap on their
+ * state. get() registers in the slot's reader count while it copies the open
+ * file. add(), remove(), and dup2() only modify the open file of a slot they
+ * have reserved and after the readers of the slot are gone.
+ *
+ * File descriptors outside the slot range, i.e., dup2() targets such as 0, 1,
+ * and 2, and new file descriptors once all slots are taken, are kept in a
+ * mutex-protected map. It is only consulted while it is not empty.
+ */
 class OpenFileMap {
 
 private:
-    std::map<int, std::shared_ptr<OpenFile>> files_;
-    std::recursive_mutex files_mutex_;
+    enum class SlotState : uint8_t { free = 0, reserved, open };
+
+    // one cache line per slot so that get() calls on different fds do not
+    // contend on the reader counters of neighboring slots
+    struct alignas(64) Slot {
+        std::atomic<SlotState> state{SlotState::free};
+        // number of get() calls that may be copying `file`
+        std::atomic<uint32_t> readers{0};
+        // only modified while the slot is reserved and has no readers
+        std::shared_ptr<OpenFile> file;
+    };
+
+    const int fd_base_;
+    const int capacity_;
+    std::unique_ptr<Slot[]> slots_;
+    // one bit per open slot so that get_all() skips empty regions
+    std::unique_ptr<std::atomic<uint64_t>[]> occupied_;
+    // position at which the next search for a free slot starts. New file
+    // descriptors are handed out round-robin to not reuse closed ones
+    // immediately, similar to a monotonic counter
+    std::atomic<unsigned int> next_slot_{0};
+
+    std::map<int, std::shared_ptr<OpenFile>> overflow_;
+    std::mutex overflow_mutex_;
+    std::atomic<size_t> overflow_size_{0};
+    // next file descriptor beyond the slot range given out by the overflow map
+    int overflow_fd_idx_;
+
+    Slot*
+    slot_(int fd);
+
+    int
+    claim_slot_();
 
     int
-    safe_generate_fd_idx_();
-
-    /*
-     * TODO: Setting our file descriptor index to a specific value is dangerous
-     * because we might clash with the kernel. E.g., if we would passthrough and
-     * not intercept and the kernel assigns a file descriptor but we will later
-     * use the same fd value, we will intercept calls that were supposed to be
-     * going to the kernel. This works the other way around too. To mitigate
-     * this issue, we set the initial fd number to a high value. We "hope" that
-     * we do not clash but this is no permanent solution. Note: This solution
-     * will probably work well already for many cases because kernel fd values
-     * are reused, unlike to ours. The only case where we will clash with the
-     * kernel is, if one process has more than 100000 files open at the same
-     * time.
+    add_overflow_(std::shared_ptr<OpenFile> open_file);
+
+    /**
+     * @brief Returns the open file of a slot or nullptr if it is not open.
+     */
+    static std::shared_ptr<OpenFile>
+    load_(Slot& slot);
+
+    /**
+     * @brief Waits until no get() is copying the open file of a reserved slot.
+     */
+    static void
+    wait_for_readers_(Slot& slot);
+
+    /**
+     * @brief Sets the open file of a reserved slot and marks it as open.
      */
-    int fd_idx;
-    std::mutex fd_idx_mutex;
-    std::atomic<bool> fd_validation_needed;
+    void
+    publish_(int idx, std::shared_ptr<OpenFile> open_file);
 
 public:
     OpenFileMap();
 
+    /**
+     * @brief Creates a map with a custom slot range. Used for testing.
+     * @param fd_base first file descriptor held in the slot array
+     * @param capacity number of slots
+     */
+    OpenFileMap(int fd_base, int capacity);
+
     std::shared_ptr<OpenFile>
     get(int fd);
 
     std::shared_ptr<OpenDir>
     get_dir(int dirfd);
 
+    /**
+     * @brief Returns all open files. A file that is referenced by multiple
+     * file descriptors (see dup()) is returned once per descriptor.
+     * @return vector of open files
+     */
+    std::vector<std::shared_ptr<OpenFile>>
+    get_all();
+
     bool
     exist(int fd);
 
@@ -147,12 +299,6 @@ public:
 
     int
     dup2(int oldfd, int newfd);
-
-    int
-    generate_fd_idx();
-
-    int
-    get_fd_idx();
 };
 
 } // namespace gkfs::filemap
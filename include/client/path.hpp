@@ -44,6 +44,20 @@ resolve(const std::string& path, bool resolve_last_link = true);
 std::pair<bool, std::string>
 resolve_new(const std::string& path);
 
+/**
+ * @brief Checks if a path is outside of the mount directory without
+ * canonicalizing it or allocating memory.
+ *
+ * Paths with '.' or '..' components or repeated separators are not checked
+ * since canonicalization may move them into the mount directory. The same
+ * holds for any path if symlinks are followed during path resolution.
+ * @param raw_path absolute path or path relative to the cwd
+ * @return true if the path is external, false if it may be internal and must
+ * be resolved with resolve()
+ */
+bool
+is_certainly_external(const char* raw_path);
+
 [[deprecated(
         "Use GKFS_USE_LEGACY_PATH_RESOLVE to use old implementation")]] bool
 resolve(const std::string& path, std::string& resolved,
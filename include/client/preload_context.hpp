@@ -34,6 +34,8 @@
 #include <map>
 #include <mercury.h>
 #include <memory>
+#include <mutex>
+#include <atomic>
 #include <vector>
 #include <string>
 #include <config.hpp>
@@ -61,6 +63,11 @@ class DentryCache;
 }
 namespace file {
 class WriteSizeCache;
+class ChunkCache;
+class StatCache;
+}
+namespace buffer {
+class RegistrationCache;
 }
 } // namespace cache
 
@@ -80,6 +87,8 @@ struct FsConfig {
     gid_t gid;
 
     std::string rootdir;
+    // data and metadata placement used by the daemons
+    std::string distributor;
 };
 
 enum class RelativizeStatus { internal, external, fd_unknown, fd_not_a_dir };
@@ -103,6 +112,17 @@ private:
     bool use_dentry_cache_{false};
     std::shared_ptr<gkfs::cache::file::WriteSizeCache> write_size_cache_;
     bool use_write_size_cache_{false};
+    bool use_async_size_update_{false};
+    bool use_async_create_{false};
+    bool use_write_back_buffer_{false};
+    std::shared_ptr<gkfs::cache::file::ChunkCache> chunk_cache_;
+    bool use_chunk_cache_{false};
+    std::shared_ptr<gkfs::cache::file::StatCache> stat_cache_;
+    bool use_stat_cache_{false};
+    bool stat_cache_prefill_{false};
+    std::shared_ptr<gkfs::cache::buffer::RegistrationCache> registration_cache_;
+    bool use_registration_cache_{false};
+    size_t write_back_buffer_size_{0};
 
 
     std::string cwd_;
@@ -110,6 +130,12 @@ private:
     std::string mountdir_;
 
     std::vector<hermes::endpoint> hosts_;
+    // daemon addresses that are looked up on first use (see lazy_hosts())
+    bool lazy_hosts_{false};
+    std::vector<std::string> hosts_uris_;
+    std::unique_ptr<std::atomic<bool>[]> hosts_found_;
+    // one per daemon so that a slow lookup only blocks users of that daemon
+    std::unique_ptr<std::mutex[]> hosts_lookup_mutexes_;
     uint64_t local_host_id_;
     uint64_t fwd_host_id_;
     std::string rpc_protocol_;
@@ -168,12 +194,36 @@ public:
     const std::string&
     cwd() const;
 
+    /**
+     * @brief Returns the endpoints of all daemons. With lazy_hosts(), entries
+     * of daemons that were not contacted yet are empty. Use host() to send an
+     * RPC to a daemon.
+     */
     const std::vector<hermes::endpoint>&
     hosts() const;
 
     void
     hosts(const std::vector<hermes::endpoint>& addrs);
 
+    /**
+     * @brief Sets the daemons' addresses without looking them up. Each address
+     * is looked up by the first host() call for its daemon.
+     * @param uris Mercury URIs of the daemons
+     */
+    void
+    lazy_hosts(const std::vector<std::string>& uris);
+
+    /**
+     * @brief Returns the endpoint of a daemon, looking it up if necessary.
+     * @param id daemon id
+     * @return endpoint
+     * @throws std::out_of_range for an unknown id
+     * @throws std::runtime_error if the lookup fails. RPC forwarding
+     * functions call it within their try blocks and report EBUSY.
+     */
+    const hermes::endpoint&
+    host(uint64_t id);
+
     void
     clear_hosts();
 
@@ -268,6 +318,73 @@ public:
     void
     use_write_size_cache(bool use_dentry_cache);
 
+    bool
+    use_async_size_update() const;
+
+    void
+    use_async_size_update(bool use_async_size_update);
+
+    bool
+    use_async_create() const;
+
+    void
+    use_async_create(bool use_async_create);
+
+    bool
+    use_write_back_buffer() const;
+
+    void
+    use_write_back_buffer(bool use_write_back_buffer);
+
+    size_t
+    write_back_buffer_size() const;
+
+    void
+    write_back_buffer_size(size_t write_back_buffer_size);
+
+    std::shared_ptr<gkfs::cache::file::ChunkCache>
+    chunk_cache() const;
+
+    void
+    chunk_cache(std::shared_ptr<gkfs::cache::file::ChunkCache> chunk_cache);
+
+    bool
+    use_chunk_cache() const;
+
+    void
+    use_chunk_cache(bool use_chunk_cache);
+
+    std::shared_ptr<gkfs::cache::file::StatCache>
+    stat_cache() const;
+
+    void
+    stat_cache(std::shared_ptr<gkfs::cache::file::StatCache> stat_cache);
+
+    bool
+    use_stat_cache() const;
+
+    void
+    use_stat_cache(bool use_stat_cache);
+
+    bool
+    stat_cache_prefill() const;
+
+    void
+    stat_cache_prefill(bool stat_cache_prefill);
+
+    std::shared_ptr<gkfs::cache::buffer::RegistrationCache>
+    registration_cache() const;
+
+    void
+    registration_cache(std::shared_ptr<gkfs::cache::buffer::RegistrationCache>
+                               registration_cache);
+
+    bool
+    use_registration_cache() const;
+
+    void
+    use_registration_cache(bool use_registration_cache);
+
     void
     enable_interception();
 
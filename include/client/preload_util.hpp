@@ -34,6 +34,7 @@
 #include <common/metadata.hpp>
 #include <string>
 #include <iostream>
+#include <functional>
 #include <map>
 #include <type_traits>
 #include <optional>
@@ -90,6 +91,19 @@ std::pair<int, off64_t>
 update_file_size(const std::string& path, size_t count, off64_t offset,
                  bool is_append);
 
+/**
+ * @brief Starts updating the write size on the metadata daemon without waiting
+ * for the response. Append writes are not supported as they need the returned
+ * offset before writing.
+ * @param path
+ * @param count
+ * @param offset
+ * @return callable that waits for the update and returns <err,
+ * return_offset>. It must be called exactly once.
+ */
+std::function<std::pair<int, off64_t>()>
+update_file_size_async(const std::string& path, size_t count, off64_t offset);
+
 void
 load_hosts();
 
@@ -99,6 +113,10 @@ load_forwarding_map();
 std::vector<std::pair<std::string, std::string>>
 read_hosts_file();
 
+hermes::endpoint
+lookup_endpoint(const std::string& uri, bool use_proxy = false,
+                std::size_t max_retries = 3);
+
 void
 connect_to_hosts(const std::vector<std::pair<std::string, std::string>>& hosts);
 
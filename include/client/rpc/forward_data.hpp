@@ -35,6 +35,11 @@
 #include <string>
 #include <memory>
 #include <set>
+
+extern "C" {
+#include <sys/uio.h>
+}
+
 namespace gkfs::rpc {
 
 // TODO once we have LEAF, remove all the error code returns and throw them as
@@ -44,11 +49,21 @@ std::pair<int, ssize_t>
 forward_write(const std::string& path, const void* buf, off64_t offset,
               size_t write_size, const int8_t num_copy = 0);
 
+std::pair<int, ssize_t>
+forward_write(const std::string& path, const struct iovec* iov, int iovcnt,
+              off64_t offset, size_t write_size, const int8_t num_copy = 0,
+              bool app_buffer = false);
+
 std::pair<int, ssize_t>
 forward_read(const std::string& path, void* buf, off64_t offset,
              size_t read_size, const int8_t num_copies,
              std::set<int8_t>& failed);
 
+std::pair<int, ssize_t>
+forward_read(const std::string& path, const struct iovec* iov, int iovcnt,
+             off64_t offset, size_t read_size, const int8_t num_copies,
+             std::set<int8_t>& failed, bool app_buffer = false);
+
 int
 forward_truncate(const std::string& path, size_t current_size, size_t new_size,
                  const int8_t num_copies);
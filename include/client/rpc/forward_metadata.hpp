@@ -33,6 +33,7 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <functional>
 /* Forward declaration */
 namespace gkfs {
 namespace filemap {
@@ -55,6 +56,11 @@ forward_create(const std::string& path, mode_t mode, const int copy);
 int
 forward_stat(const std::string& path, std::string& attr, const int copy);
 
+int
+forward_open_metadentry(const std::string& path, mode_t mode, bool create,
+                        bool excl, bool trunc, std::string& attr, bool& created,
+                        int64_t& trunc_size, const int copy);
+
 #ifdef HAS_RENAME
 int
 forward_rename(const std::string& oldpath, const std::string& newpath,
@@ -64,6 +70,18 @@ forward_rename(const std::string& oldpath, const std::string& newpath,
 int
 forward_remove(const std::string& path, bool rm_dir, const int8_t num_copies);
 
+std::vector<int>
+forward_create_batch(const std::vector<std::string>& paths, mode_t mode,
+                     const int copy);
+
+std::vector<int>
+forward_stat_batch(const std::vector<std::string>& paths,
+                   std::vector<std::string>& attrs, const int copy);
+
+std::vector<int>
+forward_remove_batch(const std::vector<std::string>& paths,
+                     const int8_t num_copies, std::vector<std::string>& attrs);
+
 int
 forward_decr_size(const std::string& path, size_t length, const int copy);
 
@@ -78,11 +96,16 @@ forward_update_metadentry_size(const std::string& path, size_t size,
                                off64_t offset, bool append_flag,
                                const int num_copies);
 
+std::function<std::pair<int, off64_t>()>
+forward_update_metadentry_size_async(const std::string& path, size_t size,
+                                     off64_t offset, bool append_flag,
+                                     const int num_copies);
+
 std::pair<int, off64_t>
 forward_get_metadentry_size(const std::string& path, const int copy);
 
-std::pair<int, std::shared_ptr<gkfs::filemap::OpenDir>>
-forward_get_dirents(const std::string& path);
+int
+forward_get_dirents(gkfs::filemap::OpenDir& open_dir);
 
 std::pair<int, std::unique_ptr<std::vector<
                        std::tuple<const std::string, bool, size_t, time_t>>>>
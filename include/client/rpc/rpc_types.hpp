@@ -142,16 +142,17 @@ struct fs_config {
         output()
             : m_mountdir(), m_rootdir(), m_atime_state(), m_mtime_state(),
               m_ctime_state(), m_link_cnt_state(), m_blocks_state(), m_uid(),
-              m_gid() {}
+              m_gid(), m_distributor() {}
 
         output(const std::string& mountdir, const std::string& rootdir,
                bool atime_state, bool mtime_state, bool ctime_state,
                bool link_cnt_state, bool blocks_state, uint32_t uid,
-               uint32_t gid)
+               uint32_t gid, const std::string& distributor)
             : m_mountdir(mountdir), m_rootdir(rootdir),
               m_atime_state(atime_state), m_mtime_state(mtime_state),
               m_ctime_state(ctime_state), m_link_cnt_state(link_cnt_state),
-              m_blocks_state(blocks_state), m_uid(uid), m_gid(gid) {}
+              m_blocks_state(blocks_state), m_uid(uid), m_gid(gid),
+              m_distributor(distributor) {}
 
         output(output&& rhs) = default;
 
@@ -180,6 +181,10 @@ struct fs_config {
             m_blocks_state = out.blocks_state;
             m_uid = out.uid;
             m_gid = out.gid;
+
+            if(out.distributor != nullptr) {
+                m_distributor = out.distributor;
+            }
         }
 
         std::string
@@ -227,6 +232,11 @@ struct fs_config {
             return m_gid;
         }
 
+        std::string
+        distributor() const {
+            return m_distributor;
+        }
+
     private:
         std::string m_mountdir;
         std::string m_rootdir;
@@ -237,6 +247,7 @@ struct fs_config {
         bool m_blocks_state;
         uint32_t m_uid;
         uint32_t m_gid;
+        std::string m_distributor;
     };
 };
 
@@ -1935,8 +1946,8 @@ struct get_dirents {
     using handle_type = hermes::rpc_handle<self_type>;
     using input_type = input;
     using output_type = output;
-    using mercury_input_type = rpc_get_dirents_in_t;
-    using mercury_output_type = rpc_get_dirents_out_t;
+    using mercury_input_type = rpc_get_dirents_paged_in_t;
+    using mercury_output_type = rpc_get_dirents_paged_out_t;
 
     // RPC public identifier
     // (N.B: we reuse the same IDs assigned by Margo so that the daemon
@@ -1954,11 +1965,11 @@ struct get_dirents {
 
     // Mercury callback to serialize input arguments
     constexpr static const auto mercury_in_proc_cb =
-            HG_GEN_PROC_NAME(rpc_get_dirents_in_t);
+            HG_GEN_PROC_NAME(rpc_get_dirents_paged_in_t);
 
     // Mercury callback to serialize output arguments
     constexpr static const auto mercury_out_proc_cb =
-            HG_GEN_PROC_NAME(rpc_get_dirents_out_t);
+            HG_GEN_PROC_NAME(rpc_get_dirents_paged_out_t);
 
     class input {
 
@@ -1967,8 +1978,9 @@ struct get_dirents {
         hermes::detail::post_to_mercury(ExecutionContext*);
 
     public:
-        input(const std::string& path, const hermes::exposed_memory& buffers)
-            : m_path(path), m_buffers(buffers) {}
+        input(const std::string& path, const std::string& start_key,
+              const hermes::exposed_memory& buffers)
+            : m_path(path), m_start_key(start_key), m_buffers(buffers) {}
 
         input(input&& rhs) = default;
 
@@ -1985,20 +1997,27 @@ struct get_dirents {
             return m_path;
         }
 
+        std::string
+        start_key() const {
+            return m_start_key;
+        }
+
         hermes::exposed_memory
         buffers() const {
             return m_buffers;
         }
 
-        explicit input(const rpc_get_dirents_in_t& other)
-            : m_path(other.path), m_buffers(other.bulk_handle) {}
+        explicit input(const rpc_get_dirents_paged_in_t& other)
+            : m_path(other.path), m_start_key(other.start_key),
+              m_buffers(other.bulk_handle) {}
 
-        explicit operator rpc_get_dirents_in_t() {
-            return {m_path.c_str(), hg_bulk_t(m_buffers)};
+        explicit operator rpc_get_dirents_paged_in_t() {
+            return {m_path.c_str(), m_start_key.c_str(), hg_bulk_t(m_buffers)};
         }
 
     private:
         std::string m_path;
+        std::string m_start_key;
         hermes::exposed_memory m_buffers;
     };
 
@@ -2009,10 +2028,10 @@ struct get_dirents {
         hermes::detail::post_to_mercury(ExecutionContext*);
 
     public:
-        output() : m_err(), m_dirents_size() {}
+        output() : m_err(), m_dirents_size(), m_next_key() {}
 
-        output(int32_t err, size_t dirents_size)
-            : m_err(err), m_dirents_size(dirents_size) {}
+        output(int32_t err, size_t dirents_size, const std::string& next_key)
+            : m_err(err), m_dirents_size(dirents_size), m_next_key(next_key) {}
 
         output(output&& rhs) = default;
 
@@ -2024,9 +2043,13 @@ struct get_dirents {
         output&
         operator=(const output& other) = default;
 
-        explicit output(const rpc_get_dirents_out_t& out) {
+        explicit output(const rpc_get_dirents_paged_out_t& out) {
             m_err = out.err;
             m_dirents_size = out.dirents_size;
+
+            if(out.next_key != nullptr) {
+                m_next_key = out.next_key;
+            }
         }
 
         int32_t
@@ -2039,9 +2062,15 @@ struct get_dirents {
             return m_dirents_size;
         }
 
+        std::string
+        next_key() const {
+            return m_next_key;
+        }
+
     private:
         int32_t m_err;
         size_t m_dirents_size;
+        std::string m_next_key;
     };
 };
 
@@ -2304,6 +2333,567 @@ struct chunk_stat {
     };
 };
 
+//==============================================================================
+// definitions for create_batch
+struct create_batch {
+
+    // forward declarations of public input/output types for this RPC
+    class input;
+
+    class output;
+
+    // traits used so that the engine knows what to do with the RPC
+    using self_type = create_batch;
+    using handle_type = hermes::rpc_handle<self_type>;
+    using input_type = input;
+    using output_type = output;
+    using mercury_input_type = rpc_batch_mk_node_in_t;
+    using mercury_output_type = rpc_batch_out_t;
+
+    // RPC public identifier
+    // (N.B: we reuse the same IDs assigned by Margo so that the daemon
+    // understands Hermes RPCs)
+    constexpr static const uint64_t public_id = 17;
+
+    // RPC internal Mercury identifier
+    constexpr static const hg_id_t mercury_id = 0;
+
+    // RPC name
+    constexpr static const auto name = gkfs::rpc::tag::create_batch;
+
+    // requires response?
+    constexpr static const auto requires_response = true;
+
+    // Mercury callback to serialize input arguments
+    constexpr static const auto mercury_in_proc_cb =
+            HG_GEN_PROC_NAME(rpc_batch_mk_node_in_t);
+
+    // Mercury callback to serialize output arguments
+    constexpr static const auto mercury_out_proc_cb =
+            HG_GEN_PROC_NAME(rpc_batch_out_t);
+
+    class input {
+
+        template <typename ExecutionContext>
+        friend hg_return_t
+        hermes::detail::post_to_mercury(ExecutionContext*);
+
+    public:
+        input(const std::string& paths, uint32_t mode)
+            : m_paths(paths), m_mode(mode) {}
+
+        input(input&& rhs) = default;
+
+        input(const input& other) = default;
+
+        input&
+        operator=(input&& rhs) = default;
+
+        input&
+        operator=(const input& other) = default;
+
+        std::string
+        paths() const {
+            return m_paths;
+        }
+
+        uint32_t
+        mode() const {
+            return m_mode;
+        }
+
+        explicit input(const rpc_batch_mk_node_in_t& other)
+            : m_paths(other.paths), m_mode(other.mode) {}
+
+        explicit operator rpc_batch_mk_node_in_t() {
+            return {m_paths.c_str(), m_mode};
+        }
+
+    private:
+        std::string m_paths;
+        uint32_t m_mode;
+    };
+
+    class output {
+
+        template <typename ExecutionContext>
+        friend hg_return_t
+        hermes::detail::post_to_mercury(ExecutionContext*);
+
+    public:
+        output() : m_err(), m_errs(), m_values() {}
+
+        output(int32_t err, const std::string& errs, const std::string& values)
+            : m_err(err), m_errs(errs), m_values(values) {}
+
+        output(output&& rhs) = default;
+
+        output(const output& other) = default;
+
+        output&
+        operator=(output&& rhs) = default;
+
+        output&
+        operator=(const output& other) = default;
+
+        explicit output(const rpc_batch_out_t& out) {
+            m_err = out.err;
+
+            if(out.errs != nullptr) {
+                m_errs = out.errs;
+            }
+
+            if(out.values != nullptr) {
+                m_values = out.values;
+            }
+        }
+
+        int32_t
+        err() const {
+            return m_err;
+        }
+
+        std::string
+        errs() const {
+            return m_errs;
+        }
+
+        std::string
+        values() const {
+            return m_values;
+        }
+
+    private:
+        int32_t m_err;
+        std::string m_errs;
+        std::string m_values;
+    };
+};
+
+//==============================================================================
+// definitions for stat_batch
+struct stat_batch {
+
+    // forward declarations of public input/output types for this RPC
+    class input;
+
+    class output;
+
+    // traits used so that the engine knows what to do with the RPC
+    using self_type = stat_batch;
+    using handle_type = hermes::rpc_handle<self_type>;
+    using input_type = input;
+    using output_type = output;
+    using mercury_input_type = rpc_batch_path_in_t;
+    using mercury_output_type = rpc_batch_out_t;
+
+    // RPC public identifier
+    // (N.B: we reuse the same IDs assigned by Margo so that the daemon
+    // understands Hermes RPCs)
+    constexpr static const uint64_t public_id = 18;
+
+    // RPC internal Mercury identifier
+    constexpr static const hg_id_t mercury_id = 0;
+
+    // RPC name
+    constexpr static const auto name = gkfs::rpc::tag::stat_batch;
+
+    // requires response?
+    constexpr static const auto requires_response = true;
+
+    // Mercury callback to serialize input arguments
+    constexpr static const auto mercury_in_proc_cb =
+            HG_GEN_PROC_NAME(rpc_batch_path_in_t);
+
+    // Mercury callback to serialize output arguments
+    constexpr static const auto mercury_out_proc_cb =
+            HG_GEN_PROC_NAME(rpc_batch_out_t);
+
+    class input {
+
+        template <typename ExecutionContext>
+        friend hg_return_t
+        hermes::detail::post_to_mercury(ExecutionContext*);
+
+    public:
+        input(const std::string& paths) : m_paths(paths) {}
+
+        input(input&& rhs) = default;
+
+        input(const input& other) = default;
+
+        input&
+        operator=(input&& rhs) = default;
+
+        input&
+        operator=(const input& other) = default;
+
+        std::string
+        paths() const {
+            return m_paths;
+        }
+
+        explicit input(const rpc_batch_path_in_t& other)
+            : m_paths(other.paths) {}
+
+        explicit operator rpc_batch_path_in_t() {
+            return {m_paths.c_str()};
+        }
+
+    private:
+        std::string m_paths;
+    };
+
+    class output {
+
+        template <typename ExecutionContext>
+        friend hg_return_t
+        hermes::detail::post_to_mercury(ExecutionContext*);
+
+    public:
+        output() : m_err(), m_errs(), m_values() {}
+
+        output(int32_t err, const std::string& errs, const std::string& values)
+            : m_err(err), m_errs(errs), m_values(values) {}
+
+        output(output&& rhs) = default;
+
+        output(const output& other) = default;
+
+        output&
+        operator=(output&& rhs) = default;
+
+        output&
+        operator=(const output& other) = default;
+
+        explicit output(const rpc_batch_out_t& out) {
+            m_err = out.err;
+
+            if(out.errs != nullptr) {
+                m_errs = out.errs;
+            }
+
+            if(out.values != nullptr) {
+                m_values = out.values;
+            }
+        }
+
+        int32_t
+        err() const {
+            return m_err;
+        }
+
+        std::string
+        errs() const {
+            return m_errs;
+        }
+
+        std::string
+        values() const {
+            return m_values;
+        }
+
+    private:
+        int32_t m_err;
+        std::string m_errs;
+        std::string m_values;
+    };
+};
+
+//==============================================================================
+// definitions for remove_metadata_batch
+struct remove_metadata_batch {
+
+    // forward declarations of public input/output types for this RPC
+    class input;
+
+    class output;
+
+    // traits used so that the engine knows what to do with the RPC
+    using self_type = remove_metadata_batch;
+    using handle_type = hermes::rpc_handle<self_type>;
+    using input_type = input;
+    using output_type = output;
+    using mercury_input_type = rpc_batch_path_in_t;
+    using mercury_output_type = rpc_batch_out_t;
+
+    // RPC public identifier
+    // (N.B: we reuse the same IDs assigned by Margo so that the daemon
+    // understands Hermes RPCs)
+    constexpr static const uint64_t public_id = 19;
+
+    // RPC internal Mercury identifier
+    constexpr static const hg_id_t mercury_id = 0;
+
+    // RPC name
+    constexpr static const auto name = gkfs::rpc::tag::remove_metadata_batch;
+
+    // requires response?
+    constexpr static const auto requires_response = true;
+
+    // Mercury callback to serialize input arguments
+    constexpr static const auto mercury_in_proc_cb =
+            HG_GEN_PROC_NAME(rpc_batch_path_in_t);
+
+    // Mercury callback to serialize output arguments
+    constexpr static const auto mercury_out_proc_cb =
+            HG_GEN_PROC_NAME(rpc_batch_out_t);
+
+    class input {
+
+        template <typename ExecutionContext>
+        friend hg_return_t
+        hermes::detail::post_to_mercury(ExecutionContext*);
+
+    public:
+        input(const std::string& paths) : m_paths(paths) {}
+
+        input(input&& rhs) = default;
+
+        input(const input& other) = default;
+
+        input&
+        operator=(input&& rhs) = default;
+
+        input&
+        operator=(const input& other) = default;
+
+        std::string
+        paths() const {
+            return m_paths;
+        }
+
+        explicit input(const rpc_batch_path_in_t& other)
+            : m_paths(other.paths) {}
+
+        explicit operator rpc_batch_path_in_t() {
+            return {m_paths.c_str()};
+        }
+
+    private:
+        std::string m_paths;
+    };
+
+    class output {
+
+        template <typename ExecutionContext>
+        friend hg_return_t
+        hermes::detail::post_to_mercury(ExecutionContext*);
+
+    public:
+        output() : m_err(), m_errs(), m_values() {}
+
+        output(int32_t err, const std::string& errs, const std::string& values)
+            : m_err(err), m_errs(errs), m_values(values) {}
+
+        output(output&& rhs) = default;
+
+        output(const output& other) = default;
+
+        output&
+        operator=(output&& rhs) = default;
+
+        output&
+        operator=(const output& other) = default;
+
+        explicit output(const rpc_batch_out_t& out) {
+            m_err = out.err;
+
+            if(out.errs != nullptr) {
+                m_errs = out.errs;
+            }
+
+            if(out.values != nullptr) {
+                m_values = out.values;
+            }
+        }
+
+        int32_t
+        err() const {
+            return m_err;
+        }
+
+        std::string
+        errs() const {
+            return m_errs;
+        }
+
+        std::string
+        values() const {
+            return m_values;
+        }
+
+    private:
+        int32_t m_err;
+        std::string m_errs;
+        std::string m_values;
+    };
+};
+
+//==============================================================================
+// definitions for open_metadentry
+struct open_metadentry {
+
+    // forward declarations of public input/output types for this RPC
+    class input;
+
+    class output;
+
+    // traits used so that the engine knows what to do with the RPC
+    using self_type = open_metadentry;
+    using handle_type = hermes::rpc_handle<self_type>;
+    using input_type = input;
+    using output_type = output;
+    using mercury_input_type = rpc_open_in_t;
+    using mercury_output_type = rpc_open_out_t;
+
+    // RPC public identifier
+    // (N.B: we reuse the same IDs assigned by Margo so that the daemon
+    // understands Hermes RPCs)
+    constexpr static const uint64_t public_id = 31;
+
+    // RPC internal Mercury identifier
+    constexpr static const hg_id_t mercury_id = 0;
+
+    // RPC name
+    constexpr static const auto name = gkfs::rpc::tag::open_metadentry;
+
+    // requires response?
+    constexpr static const auto requires_response = true;
+
+    // Mercury callback to serialize input arguments
+    constexpr static const auto mercury_in_proc_cb =
+            HG_GEN_PROC_NAME(rpc_open_in_t);
+
+    // Mercury callback to serialize output arguments
+    constexpr static const auto mercury_out_proc_cb =
+            HG_GEN_PROC_NAME(rpc_open_out_t);
+
+    class input {
+
+        template <typename ExecutionContext>
+        friend hg_return_t
+        hermes::detail::post_to_mercury(ExecutionContext*);
+
+    public:
+        input(const std::string& path, uint32_t mode, bool create, bool excl,
+              bool trunc)
+            : m_path(path), m_mode(mode), m_create(create), m_excl(excl),
+              m_trunc(trunc) {}
+
+        input(input&& rhs) = default;
+
+        input(const input& other) = default;
+
+        input&
+        operator=(input&& rhs) = default;
+
+        input&
+        operator=(const input& other) = default;
+
+        std::string
+        path() const {
+            return m_path;
+        }
+
+        uint32_t
+        mode() const {
+            return m_mode;
+        }
+
+        bool
+        create() const {
+            return m_create;
+        }
+
+        bool
+        excl() const {
+            return m_excl;
+        }
+
+        bool
+        trunc() const {
+            return m_trunc;
+        }
+
+        explicit input(const rpc_open_in_t& other)
+            : m_path(other.path), m_mode(other.mode), m_create(other.create),
+              m_excl(other.excl), m_trunc(other.trunc) {}
+
+        explicit operator rpc_open_in_t() {
+            return {m_path.c_str(), m_mode, m_create, m_excl, m_trunc};
+        }
+
+    private:
+        std::string m_path;
+        uint32_t m_mode;
+        bool m_create;
+        bool m_excl;
+        bool m_trunc;
+    };
+
+    class output {
+
+        template <typename ExecutionContext>
+        friend hg_return_t
+        hermes::detail::post_to_mercury(ExecutionContext*);
+
+    public:
+        output() : m_err(), m_created(), m_trunc_size(), m_db_val() {}
+
+        output(int32_t err, bool created, int64_t trunc_size,
+               const std::string& db_val)
+            : m_err(err), m_created(created), m_trunc_size(trunc_size),
+              m_db_val(db_val) {}
+
+        output(output&& rhs) = default;
+
+        output(const output& other) = default;
+
+        output&
+        operator=(output&& rhs) = default;
+
+        output&
+        operator=(const output& other) = default;
+
+        explicit output(const rpc_open_out_t& out) {
+            m_err = out.err;
+            m_created = out.created;
+            m_trunc_size = out.trunc_size;
+
+            if(out.db_val != nullptr) {
+                m_db_val = out.db_val;
+            }
+        }
+
+        int32_t
+        err() const {
+            return m_err;
+        }
+
+        bool
+        created() const {
+            return m_created;
+        }
+
+        int64_t
+        trunc_size() const {
+            return m_trunc_size;
+        }
+
+        std::string
+        db_val() const {
+            return m_db_val;
+        }
+
+    private:
+        int32_t m_err;
+        bool m_created;
+        int64_t m_trunc_size;
+        std::string m_db_val;
+    };
+};
+
 //==============================================================================
 // definitions for write_data
 struct write_data_proxy {
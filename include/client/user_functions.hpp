@@ -78,6 +78,16 @@ gkfs_remove(const std::string& path);
 
 std::vector<std::string>
 gkfs_get_file_list(const std::string& path);
+
+std::vector<int>
+gkfs_create_bulk(const std::vector<std::string>& paths, mode_t mode);
+
+std::vector<int>
+gkfs_stat_bulk(const std::vector<std::string>& paths,
+               std::vector<struct stat>& bufs, bool follow_links = true);
+
+std::vector<int>
+gkfs_remove_bulk(const std::vector<std::string>& paths);
 } // namespace syscall
 namespace malleable {
 
@@ -29,6 +29,8 @@
 #ifndef GEKKOFS_COMMON_DEFS_HPP
 #define GEKKOFS_COMMON_DEFS_HPP
 
+#include <initializer_list>
+
 namespace gkfs {
 namespace client {
 // This must be equivalent to the line set in the gkfs script
@@ -65,6 +67,10 @@ constexpr auto write = "rpc_srv_write_data";
 constexpr auto read = "rpc_srv_read_data";
 constexpr auto truncate = "rpc_srv_trunc_data";
 constexpr auto get_chunk_stat = "rpc_srv_chunk_stat";
+constexpr auto create_batch = "rpc_srv_mk_node_batch";
+constexpr auto stat_batch = "rpc_srv_stat_batch";
+constexpr auto remove_metadata_batch = "rpc_srv_rm_metadata_batch";
+constexpr auto open_metadentry = "rpc_srv_open_metadentry";
 // IPC communication between client and proxy
 constexpr auto client_proxy_create = "proxy_rpc_srv_create";
 constexpr auto client_proxy_stat = "proxy_rpc_srv_stat";
@@ -35,15 +35,13 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <string>
+#include <string_view>
 #include <cstdint>
 
 namespace gkfs::metadata {
 
 constexpr mode_t LINK_MODE = ((S_IRWXU | S_IRWXG | S_IRWXO) | S_IFLNK);
 
-uint16_t
-gen_unique_id(const std::string& path);
-
 class Metadata {
 private:
     time_t atime_{}; // access time. gets updated on file access unless mounted
@@ -66,6 +64,12 @@ private:
     void
     init_time();
 
+    void
+    parse_binary(std::string_view binary_str);
+
+    void
+    parse_text(std::string_view text_str);
+
 public:
     Metadata() = default;
 
@@ -77,12 +81,20 @@ public:
 
 #endif
 
-    // Construct from a binary representation of the object
-    explicit Metadata(const std::string& binary_str);
+    // Construct from a serialized representation of the object. Accepts the
+    // binary format produced by serialize() and the legacy text format
+    explicit Metadata(std::string_view binary_str);
 
+    // Versioned binary format with a fixed little-endian header, used for
+    // values stored in the metadata backend
     std::string
     serialize() const;
 
+    // Legacy '|'-separated text format for transports that require
+    // NUL-terminated strings, e.g., RPC string fields
+    std::string
+    serialize_text() const;
+
     // currently unused
     void
     update_atime_now();
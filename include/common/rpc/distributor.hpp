@@ -36,12 +36,43 @@
 #include <unordered_map>
 #include <fstream>
 #include <map>
+#include <cstdint>
 
 namespace gkfs::rpc {
 
 using chunkid_t = unsigned int;
 using host_t = unsigned int;
 
+// names of the hash-based distributors that can be selected at daemon startup
+constexpr auto simple_hash_distributor = "simplehash";
+constexpr auto jump_hash_distributor = "jumphash";
+
+/**
+ * @brief Stable 64-bit hash of a path used to place data and metadata.
+ *
+ * Unlike std::hash, the result does not depend on the standard library, the
+ * compiler, or the byte order of the host. Clients, proxies, and daemons built
+ * with different toolchains therefore agree on the placement of a file. The
+ * function follows the wyhash construction: the path is read in 8-byte
+ * little-endian words that are folded with a 64x64->128 bit multiplication.
+ *
+ * Changing this function changes the placement of all files.
+ * @param path
+ * @return hash of path
+ */
+uint64_t
+hash_path(const std::string& path);
+
+/**
+ * @brief Mixes a chunk id into a hash_path() result. This allows hashing a
+ * path once per I/O operation instead of once per chunk.
+ * @param path_hash result of hash_path()
+ * @param chnk_id
+ * @return hash of the chunk
+ */
+uint64_t
+hash_chunk(uint64_t path_hash, chunkid_t chnk_id);
+
 class Distributor {
 public:
     virtual host_t
@@ -63,6 +94,20 @@ public:
     locate_data(const std::string& path, const chunkid_t& chnk_id,
                 unsigned int hosts_size, const int num_copy) = 0;
 
+    /**
+     * @brief Locates a chunk of a path whose hash_path() result was computed
+     * once for all chunks of an operation. Distributors that do not place
+     * chunks by hash ignore path_hash and locate by path.
+     * @param path
+     * @param path_hash result of hash_path(path)
+     * @param chnk_id
+     * @param num_copy
+     * @return host id
+     */
+    virtual host_t
+    locate_data_hashed(const std::string& path, uint64_t path_hash,
+                       const chunkid_t& chnk_id, const int num_copy) const;
+
     virtual host_t
     locate_file_metadata(const std::string& path, const int num_copy) const = 0;
 
@@ -76,7 +121,6 @@ private:
     host_t localhost_;
     unsigned int hosts_size_{0};
     std::vector<host_t> all_hosts_;
-    std::hash<std::string> str_hash;
 
 public:
     SimpleHashDistributor();
@@ -100,6 +144,62 @@ public:
     locate_data(const std::string& path, const chunkid_t& chnk_id,
                 unsigned int host_size, const int num_copy);
 
+    host_t
+    locate_data_hashed(const std::string& path, uint64_t path_hash,
+                       const chunkid_t& chnk_id,
+                       const int num_copy) const override;
+
+    host_t
+    locate_file_metadata(const std::string& path,
+                         const int num_copy) const override;
+
+    std::vector<host_t>
+    locate_directory_metadata() const override;
+};
+
+/**
+ * @brief Places data and metadata with jump consistent hashing (Lamping and
+ * Veach, 2014) of the placement hash.
+ *
+ * Unlike the modulo in SimpleHashDistributor, growing the number of hosts from
+ * N to N + k only moves about k / (N + k) of all chunks and metadata entries,
+ * all of them to the new hosts. This keeps data redistribution on expansion
+ * (see MalleableManager) small. Replicas are placed on the hosts following the
+ * primary host.
+ */
+class JumpHashDistributor : public Distributor {
+private:
+    host_t localhost_;
+    unsigned int hosts_size_{0};
+    std::vector<host_t> all_hosts_;
+
+public:
+    JumpHashDistributor();
+
+    JumpHashDistributor(host_t localhost, unsigned int hosts_size);
+
+    unsigned int
+    hosts_size() const override;
+
+    void
+    hosts_size(unsigned int size) override;
+
+    host_t
+    localhost() const override;
+
+    host_t
+    locate_data(const std::string& path, const chunkid_t& chnk_id,
+                const int num_copy) const override;
+
+    host_t
+    locate_data(const std::string& path, const chunkid_t& chnk_id,
+                unsigned int host_size, const int num_copy) override;
+
+    host_t
+    locate_data_hashed(const std::string& path, uint64_t path_hash,
+                       const chunkid_t& chnk_id,
+                       const int num_copy) const override;
+
     host_t
     locate_file_metadata(const std::string& path,
                          const int num_copy) const override;
@@ -142,7 +242,6 @@ private:
     host_t fwd_host_;
     unsigned int hosts_size_{0};
     std::vector<host_t> all_hosts_;
-    std::hash<std::string> str_hash;
 
 public:
     ForwarderDistributor(host_t fwhost, unsigned int hosts_size);
@@ -191,7 +290,6 @@ private:
     host_t localhost_;
     unsigned int hosts_size_{0};
     std::vector<host_t> all_hosts_;
-    std::hash<std::string> str_hash;
     std::unordered_map<std::string, std::pair<IntervalSet, unsigned int>>
             map_interval;
     std::vector<std::string> prefix_list; // Should not be very long
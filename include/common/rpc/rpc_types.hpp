@@ -79,6 +79,27 @@ MERCURY_GEN_PROC(rpc_update_metadentry_size_out_t,
 MERCURY_GEN_PROC(rpc_get_metadentry_size_out_t,
                  ((hg_int32_t) (err))((hg_int64_t) (ret_size)))
 
+MERCURY_GEN_PROC(rpc_open_in_t,
+                 ((hg_const_string_t) (path))((uint32_t) (mode))(
+                         (hg_bool_t) (create))((hg_bool_t) (excl))(
+                         (hg_bool_t) (trunc)))
+
+MERCURY_GEN_PROC(rpc_open_out_t,
+                 ((hg_int32_t) (err))((hg_bool_t) (created))(
+                         (hg_int64_t) (trunc_size))(
+                         (hg_const_string_t) (db_val)))
+
+// batched metadata requests. Lists of paths, error codes, and values are
+// encoded with gkfs::rpc::encode_string_batch()
+MERCURY_GEN_PROC(rpc_batch_mk_node_in_t,
+                 ((hg_const_string_t) (paths))((uint32_t) (mode)))
+
+MERCURY_GEN_PROC(rpc_batch_path_in_t, ((hg_const_string_t) (paths)))
+
+MERCURY_GEN_PROC(rpc_batch_out_t,
+                 ((hg_int32_t) (err))((hg_const_string_t) (errs))(
+                         (hg_const_string_t) (values)))
+
 #ifdef HAS_SYMLINKS
 MERCURY_GEN_PROC(rpc_mk_symlink_in_t, ((hg_const_string_t) (path))((
                                               hg_const_string_t) (target_path)))
@@ -110,6 +131,14 @@ MERCURY_GEN_PROC(rpc_get_dirents_in_t,
 MERCURY_GEN_PROC(rpc_get_dirents_out_t,
                  ((hg_int32_t) (err))((hg_size_t) (dirents_size)))
 
+MERCURY_GEN_PROC(rpc_get_dirents_paged_in_t,
+                 ((hg_const_string_t) (path))((hg_const_string_t) (start_key))(
+                         (hg_bulk_t) (bulk_handle)))
+
+MERCURY_GEN_PROC(rpc_get_dirents_paged_out_t,
+                 ((hg_int32_t) (err))((hg_size_t) (dirents_size))(
+                         (hg_const_string_t) (next_key)))
+
 
 MERCURY_GEN_PROC(
         rpc_config_out_t,
@@ -117,7 +146,7 @@ MERCURY_GEN_PROC(
                 (hg_bool_t) (atime_state))((hg_bool_t) (mtime_state))(
                 (hg_bool_t) (ctime_state))((hg_bool_t) (link_cnt_state))(
                 (hg_bool_t) (blocks_state))((hg_uint32_t) (uid))(
-                (hg_uint32_t) (gid)))
+                (hg_uint32_t) (gid))((hg_const_string_t) (distributor)))
 
 
 MERCURY_GEN_PROC(rpc_chunk_stat_in_t, ((hg_int32_t) (dummy)))
@@ -34,7 +34,10 @@ extern "C" {
 #include <mercury_proc_string.h>
 }
 
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <sstream>
 #include <vector>
@@ -64,6 +67,26 @@ compress_bitset(const std::vector<uint8_t>& bytes);
 std::vector<uint8_t>
 decompress_bitset(const std::string& compressedString);
 
+std::string
+encode_string_batch(const std::vector<std::string>& strings);
+
+std::vector<std::string>
+decode_string_batch(std::string_view encoded);
+
+/**
+ * @brief Calls `func` for every element of `ids` from up to `concurrency`
+ * threads at the same time, e.g., to look up the addresses of many hosts.
+ * After the first exception no further ids are handed out.
+ * @param ids
+ * @param concurrency maximum number of concurrent calls
+ * @param func
+ * @throws the first exception thrown by `func` once all calls returned
+ */
+void
+for_each_concurrently(const std::vector<uint64_t>& ids,
+                      unsigned int concurrency,
+                      const std::function<void(uint64_t)>& func);
+
 } // namespace gkfs::rpc
 
 #endif // GEKKOFS_COMMON_RPC_UTILS_HPP
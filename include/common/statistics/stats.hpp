@@ -44,13 +44,16 @@
 #include <iomanip>
 #include <fstream>
 #include <atomic>
+#include <functional>
 #include <mutex>
+#include <string>
 #include <config.hpp>
 
 
 // PROMETHEUS includes
 #ifdef GKFS_ENABLE_PROMETHEUS
 #include <prometheus/counter.h>
+#include <prometheus/gauge.h>
 #include <prometheus/summary.h>
 #include <prometheus/exposer.h>
 #include <prometheus/registry.h>
@@ -98,6 +101,25 @@ public:
 
     enum class SizeOp { write_size, read_size }; ///< enum storing Size Stats
 
+    enum class CacheOp {
+        chunk_fd_hit,
+        chunk_fd_miss,
+        bulk_pool_hit,
+        bulk_pool_miss,
+        bulk_pool_fallback,
+        metadata_hit,
+        metadata_miss,
+    }; ///< enum storing cache hit/miss counters
+
+    enum class GaugeOp {
+        bulk_pool_used,
+        bulk_pool_allocated,
+        bulk_pool_capacity,
+    }; ///< enum storing current values, e.g., occupancy
+
+    using external_stats_t = std::vector<
+            std::pair<std::string, unsigned long long>>; ///< name and value
+
 private:
     constexpr static const std::initializer_list<Stats::IopsOp> all_IopsOp = {
             IopsOp::iops_create, IopsOp::iops_write,
@@ -107,11 +129,28 @@ private:
     constexpr static const std::initializer_list<Stats::SizeOp> all_SizeOp = {
             SizeOp::write_size, SizeOp::read_size}; ///< Enum SIZE iterator
 
+    constexpr static const std::initializer_list<Stats::CacheOp> all_CacheOp =
+            {CacheOp::chunk_fd_hit, CacheOp::chunk_fd_miss,
+             CacheOp::bulk_pool_hit, CacheOp::bulk_pool_miss,
+             CacheOp::bulk_pool_fallback, CacheOp::metadata_hit,
+             CacheOp::metadata_miss}; ///< Enum CACHE iterator
+
+    constexpr static const std::initializer_list<Stats::GaugeOp> all_GaugeOp =
+            {GaugeOp::bulk_pool_used, GaugeOp::bulk_pool_allocated,
+             GaugeOp::bulk_pool_capacity}; ///< Enum GAUGE iterator
+
     const std::vector<std::string> IopsOp_s = {
             "IOPS_CREATE", "IOPS_WRITE",   "IOPS_READ",
             "IOPS_STATS",  "IOPS_DIRENTS", "IOPS_REMOVE"}; ///< Stats Labels
     const std::vector<std::string> SizeOp_s = {"WRITE_SIZE",
                                                "READ_SIZE"}; ///< Stats Labels
+    const std::vector<std::string> CacheOp_s = {
+            "CHUNK_FD_CACHE_HIT", "CHUNK_FD_CACHE_MISS", "BULK_POOL_HIT",
+            "BULK_POOL_MISS",     "BULK_POOL_FALLBACK",  "METADATA_CACHE_HIT",
+            "METADATA_CACHE_MISS"}; ///< Stats Labels
+    const std::vector<std::string> GaugeOp_s = {
+            "BULK_POOL_USED_BYTES", "BULK_POOL_ALLOCATED_BYTES",
+            "BULK_POOL_CAPACITY_BYTES"}; ///< Stats Labels
 
     std::chrono::time_point<std::chrono::steady_clock>
             start; ///< When we started the server
@@ -121,6 +160,15 @@ private:
             iops_mean; ///< Stores total value for global mean
     std::map<SizeOp, std::atomic<unsigned long>>
             size_mean; ///< Stores total value for global mean
+    std::map<CacheOp, std::atomic<unsigned long>>
+            cache_count; ///< Stores total number of cache hits/misses
+    std::map<GaugeOp, std::atomic<long long>>
+            gauge_value; ///< Stores the current value of a gauge
+
+    std::mutex external_mutex;
+    std::function<external_stats_t()>
+            external_source; ///< Provides values of other modules, e.g., the
+                             ///< metadata backend
 
     std::mutex time_iops_mutex;
     std::mutex size_iops_mutex;
@@ -191,6 +239,12 @@ private:
                                         ///< Prometheus cpp)
     std::map<IopsOp, Counter*> iops_prometheus; ///< Prometheus IOPS metrics
     std::map<SizeOp, Summary*> size_prometheus; ///< Prometheus SIZE metrics
+    Family<Counter>* family_cache; ///< Prometheus CACHE counter (managed by
+                                   ///< Prometheus cpp)
+    std::map<CacheOp, Counter*> cache_prometheus; ///< Prometheus CACHE metrics
+    Family<Gauge>* family_gauge; ///< Prometheus GAUGE values (managed by
+                                 ///< Prometheus cpp)
+    std::map<GaugeOp, Gauge*> gauge_prometheus; ///< Prometheus GAUGE metrics
 #endif
 
 public:
@@ -260,6 +314,57 @@ public:
     void
     add_value_size(enum SizeOp, unsigned long long value);
 
+    /**
+     * @brief Counts a cache event, e.g., a hit or miss. Cache events are only
+     * accumulated and do not keep a time series.
+     *
+     * @param CacheOp Which cache event to count
+     * @param value number of events to add
+     */
+    void
+    add_value_cache(enum CacheOp, unsigned long long value = 1);
+
+    /**
+     * @brief Get the total number of counted events of a cache operation
+     * @param CacheOp Which cache event to get
+     * @return total count
+     */
+    unsigned long long get_count(enum CacheOp);
+
+    /**
+     * @brief Changes the current value of a gauge, e.g., the occupancy of a
+     * buffer pool. Gauges do not keep a time series.
+     *
+     * @param GaugeOp Which gauge to change
+     * @param delta value to add, may be negative
+     */
+    void
+    add_value_gauge(enum GaugeOp, long long delta);
+
+    /**
+     * @brief Get the current value of a gauge
+     * @param GaugeOp Which gauge to get
+     * @return current value
+     */
+    long long get_gauge(enum GaugeOp);
+
+    /**
+     * @brief Sets a source of values that are maintained by another module,
+     * e.g., the internal statistics of the metadata backend. The source is
+     * called on each output and its values are reported as gauges.
+     *
+     * @param source returns pairs of name and current value
+     */
+    void
+    set_external_source(std::function<external_stats_t()> source);
+
+    /**
+     * @brief Get the current values of the external source
+     * @return pairs of name and value, empty without a source
+     */
+    external_stats_t
+    get_external();
+
     /**
      * @brief Get the total mean value of the asked stat
      * This can be provided inmediately without cost
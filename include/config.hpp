@@ -57,6 +57,45 @@ constexpr bool clear_dentry_cache_on_close = true;
 // file. fsync/close flushes the size to the server immediately.
 constexpr bool use_write_size_cache = false;
 constexpr auto write_size_flush_threshold = 1000;
+// When enabled, adjacent small writes to an open file are coalesced in a
+// per-file client buffer of `write_back_buffer_size` bytes (at most one chunk)
+// and sent to the daemon when the buffer reaches a chunk boundary or on fsync,
+// close, lseek to a different position, or a read of the buffered range.
+// Can be overwritten by LIBGKFS_WRITE_BACK_BUFFER=ON/OFF and
+// LIBGKFS_WRITE_BACK_BUFFER_SIZE.
+constexpr bool use_write_back_buffer = false;
+constexpr auto write_back_buffer_size = 524288; // in bytes
+// When enabled, reads are served from a client cache of whole chunks.
+// Sequential readers fetch up to `chunk_cache_max_read_ahead` chunks ahead.
+// Local writes, truncates, and removals invalidate the affected file.
+// Modifications by other clients are not detected. Can be overwritten by
+// LIBGKFS_CHUNK_CACHE=ON/OFF, LIBGKFS_CHUNK_CACHE_SIZE, and
+// LIBGKFS_CHUNK_CACHE_READ_AHEAD.
+constexpr bool use_chunk_cache = false;
+constexpr auto chunk_cache_size = 256; // in MiB
+constexpr auto chunk_cache_max_read_ahead = 8; // in chunks
+// When enabled, stat requests are served from a client cache of metadata for
+// up to `stat_cache_ttl` milliseconds. Local creates, removals, renames,
+// truncates, and writes invalidate the affected path. Modifications by other
+// clients are visible after the TTL at the latest. With
+// `stat_cache_prefill`, directory listings of ls -l type operations fill the
+// cache with the listed entries' type, size, and ctime. Can be overwritten by
+// LIBGKFS_STAT_CACHE=ON/OFF, LIBGKFS_STAT_CACHE_TTL,
+// LIBGKFS_STAT_CACHE_SIZE, and LIBGKFS_STAT_CACHE_PREFILL=ON/OFF.
+constexpr bool use_stat_cache = false;
+constexpr auto stat_cache_ttl = 1000; // in milliseconds
+constexpr auto stat_cache_size = 65536; // in entries
+constexpr bool stat_cache_prefill = false;
+// When enabled, application buffers of data RPCs stay exposed to the network
+// after an I/O and are reused by later I/O from the same buffer, avoiding a
+// memory registration and deregistration per operation on RDMA transports.
+// Only buffers up to `registration_cache_max_region` are cached. munmap(),
+// mremap(), madvise(), brk(), and mmap(MAP_FIXED) of the application drop
+// overlapping entries. Can be overwritten by
+// LIBGKFS_REGISTRATION_CACHE=ON/OFF and LIBGKFS_REGISTRATION_CACHE_SIZE.
+constexpr bool use_registration_cache = false;
+constexpr auto registration_cache_size = 256; // in entries
+constexpr auto registration_cache_max_region = 64; // in MiB
 } // namespace cache
 
 namespace client_metrics {
@@ -67,6 +106,15 @@ constexpr auto flush_path = "/tmp/gkfs_client_metrics";
 constexpr auto flush_interval = 5; // in seconds
 } // namespace client_metrics
 
+namespace filemap {
+// File descriptors of GekkoFS files start at `fd_base` to stay clear of kernel
+// file descriptors. The first `fd_table_size` of them are held in a fixed slot
+// array which is read without taking a lock. File descriptors beyond it, e.g.,
+// when more files are open at the same time, fall back to a locked map.
+constexpr auto fd_base = 10000;
+constexpr auto fd_table_size = 16384; // in file descriptors
+} // namespace filemap
+
 namespace io {
 /*
  * Zero buffer before read. This is relevant if sparse files are used.
@@ -74,17 +122,11 @@ namespace io {
  */
 constexpr auto zero_buffer_before_read = false;
 /*
- * When the daemon handler serves a read request, it starts tasklets (for each
- * chunk) from the io pool to read all chunks of that read request in parallel.
- * Then another thread is waiting for the first tasklet to finish before
- * initiating the bulk transfer back to the client for this chunk.
- * This will continue in sequence, allowing gaps between bulk transfers while
- * waiting. Although this is CPU efficient, it does not provide the highest I/O.
- * if spin_lock_read is enabled it will try all tasklets if they are finished
- * regardless of their order minimizing the gap between bulk transfers.
- * Due to spinning in a loop this increases CPU utilization
- */
-constexpr auto spin_lock_read = false;
+ * Send the file size update of a non-append write concurrently to the write's
+ * data RPCs instead of before them. The update is still finished before the
+ * write returns. Can be overwritten by LIBGKFS_ASYNC_SIZE_UPDATE=ON/OFF.
+ */
+constexpr auto async_size_update = false;
 } // namespace io
 
 namespace log {
@@ -124,10 +166,63 @@ constexpr auto implicit_data_removal = true;
 // Check for existence of file metadata before create. This done on RocksDB
 // level
 constexpr auto create_exist_check = true;
+/*
+ * Keep decoded metadata of recently used entries in the daemon so that stat
+ * and size requests are served without a metadata backend lookup. The cache is
+ * write-through and sharded by path. Each shard evicts its least recently used
+ * entry when it holds more than metadata_cache_size / metadata_cache_shards
+ * entries. Off by default since the in-memory metadata backend would only be
+ * cached twice.
+ */
+constexpr auto use_metadata_cache = false;
+constexpr auto metadata_cache_size = 262144;
+constexpr auto metadata_cache_shards = 64;
+/*
+ * Defer the create of open(O_CREAT) in the client and send deferred creates in
+ * batches of async_create_batch_size. Pending creates are also sent before the
+ * file is accessed otherwise and before directory listings. A failed deferred
+ * create is reported by the next operation on the file. Can be overwritten by
+ * LIBGKFS_ASYNC_CREATE=ON/OFF.
+ */
+constexpr auto async_create = false;
+constexpr auto async_create_batch_size = 64;
+/*
+ * open() with O_CREAT or O_TRUNC sends a single request to the file's daemon
+ * that creates the file if needed, truncates it, and returns its metadata.
+ * Otherwise, separate create, stat, and size requests are sent. Not used with
+ * the proxy.
+ */
+constexpr auto use_open_rpc = true;
+/*
+ * Remember parent directories that passed the existence check of a create
+ * (GKFS_CREATE_CHECK_PARENTS) for parent_check_cache_ttl seconds. A directory
+ * removed by another client may be accepted as parent during this time. The
+ * cache is cleared when it holds parent_check_cache_size entries. 0 disables
+ * the cache.
+ */
+constexpr auto parent_check_cache_ttl = 1; // in seconds
+constexpr auto parent_check_cache_size = 4096;
 } // namespace metadata
 namespace data {
 // directory name below rootdir where chunks are placed
 constexpr auto chunk_dir = "chunks";
+/*
+ * Keep chunk file descriptors open across I/O requests instead of calling
+ * open()/close() for each chunk access. The cache is sharded by file path and
+ * evicts the least recently used file descriptor per shard. The total number of
+ * cached file descriptors must stay well below the daemon's RLIMIT_NOFILE.
+ */
+constexpr auto use_chunk_fd_cache = true;
+constexpr auto chunk_fd_cache_size = 512;
+constexpr auto chunk_fd_cache_shards = 16;
+/*
+ * Remember chunk directories that are known to exist so that only the first
+ * write to a file creates its chunk directory. The set is cleared per shard
+ * when it exceeds the given number of entries.
+ */
+constexpr auto use_chunk_dir_cache = true;
+constexpr auto chunk_dir_cache_size = 1048576;
+constexpr auto chunk_dir_cache_shards = 16;
 } // namespace data
 
 namespace proxy {
@@ -151,6 +246,29 @@ constexpr auto chunksize = 524288; // in bytes (e.g., 524288 == 512KB)
 // size of preallocated buffer to hold directory entries in rpc call
 constexpr auto dirents_buff_size = (8 * 1024 * 1024);         // 8 mega
 constexpr auto dirents_buff_size_proxy = (128 * 1024 * 1024); // 8 mega
+/*
+ * readdir fetches directory entries in pages. A daemon returns at most
+ * dirents_page_entries entries per page, further limited by the client's page
+ * buffer of dirents_page_size bytes. The client requests pages from up to
+ * dirents_page_window daemons at once.
+ */
+constexpr auto dirents_page_size = (256 * 1024); // in bytes
+constexpr auto dirents_page_entries = 4096;
+constexpr auto dirents_page_window = 8;
+/*
+ * Maximum number of paths sent in one batched create, stat, or remove RPC.
+ * Larger batches are split into several RPCs per daemon.
+ */
+constexpr auto metadata_batch_size = 128;
+/*
+ * Number of daemon addresses that are looked up at the same time when a client,
+ * proxy, or daemon connects to all daemons of the hosts file. With
+ * lazy_host_lookup, a client looks up a daemon's address when it first sends an
+ * RPC to it instead of at startup. Can be overwritten by
+ * LIBGKFS_HOST_LOOKUP_CONCURRENCY and LIBGKFS_LAZY_HOST_LOOKUP=ON/OFF.
+ */
+constexpr auto host_lookup_concurrency = 32;
+constexpr auto lazy_host_lookup = false;
 /*
  * Indicates the number of concurrent progress to drive I/O operations of chunk
  * files to and from local file systems The value is directly mapped to created
@@ -161,13 +279,71 @@ constexpr auto daemon_io_xstreams = 8;
 constexpr auto daemon_handler_xstreams = 4;
 // Number of threads used for RPC handlers at the proxy
 constexpr auto proxy_handler_xstreams = 3;
+/*
+ * Registered bulk buffers used by the daemon's read and write handlers are
+ * pooled and reused across requests. Size class i holds buffers of
+ * (chunksize << i) bytes. Larger requests, or requests that do not fit into
+ * the memory cap, allocate a buffer for the request only. A memory cap of 0
+ * disables pooling.
+ */
+constexpr auto use_bulk_buffer_pool = true;
+constexpr auto bulk_buffer_pool_size_classes = 6; // up to 32 chunks
+constexpr auto bulk_buffer_pool_max_size = (512 * 1024 * 1024); // in bytes
+/*
+ * Number of non-blocking bulk PULL transfers a daemon write handler keeps in
+ * flight. Each chunk is written to disk as soon as its transfer is finished so
+ * that network transfers and disk I/O overlap. 1 pulls one chunk at a time.
+ */
+constexpr auto write_pull_depth = 8;
 } // namespace rpc
 
 namespace rocksdb {
 // Write-ahead logging of rocksdb
 constexpr auto use_write_ahead_log = false;
+/*
+ * Number of entries rewritten per write batch when a metadata database with
+ * path keys is converted to the direct-children key format on startup
+ */
+constexpr auto key_migration_batch_size = 10000;
+/*
+ * Appends reserve their offset on an in-memory file size. Sizes are kept for
+ * up to append_size_cache_size files, sharded by path to reduce lock contention
+ */
+constexpr auto append_size_cache_size = 65536;
+constexpr auto append_size_shards = 16;
+/*
+ * Default tuning profile. Each setting can be overwritten by a profile file
+ * that is passed to the daemon with --dbconfig. The prefix extractor maps a
+ * key to its parent directory so that readdir seeks skip files without
+ * entries of the directory. Settings of 0 keep the RocksDB default.
+ * Statistics cost some CPU time on each operation and are reported in the
+ * daemon stats output.
+ */
+constexpr auto use_prefix_bloom = true;
+constexpr auto bloom_bits_per_key = 10;
+constexpr auto block_cache_size_mb = 128;
+constexpr auto write_buffer_size_mb = 64;
+constexpr auto max_write_buffer_number = 4;
+constexpr auto level0_file_num_compaction_trigger = 0;
+constexpr auto max_background_jobs = 0;
+constexpr auto target_file_size_base_mb = 0;
+constexpr auto use_statistics = false;
 } // namespace rocksdb
 
+namespace inmemory {
+/*
+ * Entries of the in-memory metadata backend are sharded by parent directory,
+ * each shard is protected by its own lock
+ */
+constexpr auto shards = 64;
+/*
+ * Write all metadata to a snapshot file in the metadata directory when the
+ * daemon shuts down and load it when the daemon starts. Without a snapshot,
+ * the file system namespace is lost when the daemon stops.
+ */
+constexpr auto use_snapshot = false;
+} // namespace inmemory
+
 namespace stats {
 constexpr auto max_stats = 1000000; ///< How many stats will be stored
 constexpr auto prometheus_gateway = "127.0.0.1:9091";
@@ -0,0 +1,179 @@
+/*
+  Copyright 2018-2024, Barcelona Supercomputing Center (BSC), Spain
+  Copyright 2015-2024, Johannes Gutenberg Universitaet Mainz, Germany
+
+  This software was partially supported by the
+  EC H2020 funded project NEXTGenIO (Project ID: 671951, www.nextgenio.eu).
+
+  This software was partially supported by the
+  ADA-FS project under the SPPEXA project funded by the DFG.
+
+  This file is part of GekkoFS.
+
+  GekkoFS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GekkoFS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GekkoFS.  If not, see <https://www.gnu.org/licenses/>.
+
+  SPDX-License-Identifier: GPL-3.0-or-later
+*/
+/**
+ * @brief Cache of open chunk file descriptors used by the chunk storage to
+ * avoid an open()/close() pair for every chunk I/O operation.
+ */
+
+#ifndef GEKKOFS_DAEMON_CHUNK_FD_CACHE_HPP
+#define GEKKOFS_DAEMON_CHUNK_FD_CACHE_HPP
+
+#include <common/common_defs.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace gkfs::data {
+
+class FileHandle;
+
+/**
+ * @brief Bounded, sharded LRU cache of open chunk file descriptors keyed by
+ * (file path, chunk id).
+ * @internal
+ * All chunks of a file map to the same shard so that invalidating a file, e.g.,
+ * on remove or truncate, only needs to lock a single shard. Each shard holds an
+ * LRU list and a two-level index (path -> chunk id -> list entry). The shard
+ * lock is only held for index manipulation, never during open(), pread(), or
+ * pwrite().
+ *
+ * File handles are reference counted. An evicted or invalidated file
+ * descriptor is closed only when the last I/O operation using it has finished,
+ * so a tasklet never operates on a closed (or reused) file descriptor.
+ *
+ * Each shard carries an epoch that is incremented on every invalidation. A
+ * file descriptor opened on a cache miss is only inserted if the epoch did not
+ * change in the meantime. Otherwise, a descriptor that was opened concurrently
+ * to a remove operation could outlive the file and serve a later file with the
+ * same name.
+ * @endinternal
+ */
+class ChunkFdCache {
+public:
+    using handle_t = std::shared_ptr<FileHandle>;
+
+private:
+    struct entry {
+        std::string path;
+        gkfs::rpc::chnk_id_t chunk_id;
+        handle_t handle;
+    };
+
+    using lru_list = std::list<entry>;
+
+    struct shard {
+        std::mutex mtx;
+        lru_list lru; //!< most recently used entry at the front
+        std::unordered_map<
+                std::string,
+                std::unordered_map<gkfs::rpc::chnk_id_t, lru_list::iterator>>
+                index;
+        uint64_t epoch{0}; //!< incremented on each invalidation
+    };
+
+    std::unique_ptr<shard[]> shards_;
+    size_t shard_count_;
+    size_t shard_capacity_;
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+
+    shard&
+    shard_for(const std::string& path) const;
+
+    /**
+     * @brief Removes an entry from the index and LRU list. Shard lock must be
+     * held.
+     */
+    static void
+    erase_locked(shard& s, lru_list::iterator it);
+
+public:
+    /**
+     * @brief Creates the cache.
+     * @param capacity Maximum number of open file descriptors in total
+     * @param shard_count Number of independently locked shards
+     */
+    ChunkFdCache(size_t capacity, size_t shard_count);
+
+    ~ChunkFdCache();
+
+    ChunkFdCache(const ChunkFdCache&) = delete;
+
+    ChunkFdCache&
+    operator=(const ChunkFdCache&) = delete;
+
+    /**
+     * @brief Returns an open file handle for the given chunk. On a cache miss
+     * the chunk file is opened with `flags` and inserted into the cache.
+     * @param path GekkoFS file path, e.g., /foo/bar
+     * @param chunk_id Chunk id
+     * @param chunk_path Absolute path of the chunk file on the local FS
+     * @param flags open() flags used on a cache miss
+     * @param hit Set to true if the handle was served from the cache
+     * @return File handle. If open() fails, the handle is invalid and errno is
+     * set accordingly.
+     */
+    handle_t
+    get(const std::string& path, gkfs::rpc::chnk_id_t chunk_id,
+        const std::string& chunk_path, int flags, bool& hit);
+
+    /**
+     * @brief Evicts all cached chunks of a file.
+     * @param path GekkoFS file path, e.g., /foo/bar
+     */
+    void
+    invalidate(const std::string& path);
+
+    /**
+     * @brief Evicts all cached chunks of a file starting with chunk_start.
+     * @param path GekkoFS file path, e.g., /foo/bar
+     * @param chunk_start First chunk id to evict
+     */
+    void
+    invalidate_from(const std::string& path, gkfs::rpc::chnk_id_t chunk_start);
+
+    /**
+     * @brief Evicts a single cached chunk of a file.
+     * @param path GekkoFS file path, e.g., /foo/bar
+     * @param chunk_id Chunk id to evict
+     */
+    void
+    invalidate_chunk(const std::string& path, gkfs::rpc::chnk_id_t chunk_id);
+
+    /**
+     * @brief Evicts all entries.
+     */
+    void
+    clear();
+
+    [[nodiscard]] uint64_t
+    hits() const;
+
+    [[nodiscard]] uint64_t
+    misses() const;
+};
+
+} // namespace gkfs::data
+
+#endif // GEKKOFS_DAEMON_CHUNK_FD_CACHE_HPP
@@ -38,16 +38,25 @@
 #include <limits>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <system_error>
 #include <filesystem>
+#include <unordered_set>
 
 /* Forward declarations */
 namespace spdlog {
 class logger;
 }
 
+namespace gkfs::utils {
+class Stats;
+}
+
 namespace gkfs::data {
 
+class ChunkFdCache;
+class FileHandle;
+
 struct ChunkStat {
     unsigned long chunk_size;
     unsigned long chunk_total;
@@ -73,6 +82,17 @@ private:
 
     std::string root_path_; //!< Path to GekkoFS root directory
     size_t chunksize_; //!< File system chunksize. TODO Why does that exist?
+    std::unique_ptr<ChunkFdCache>
+            fd_cache_; //!< Open chunk files, nullptr if disabled
+    std::shared_ptr<gkfs::utils::Stats>
+            stats_; //!< Stats collection, nullptr if disabled
+
+    struct chunk_dir_shard {
+        std::mutex mtx;
+        std::unordered_set<std::string> dirs;
+    }; //!< Shard of chunk directories that are known to exist
+    std::unique_ptr<chunk_dir_shard[]>
+            known_chunk_dirs_; //!< Known chunk dirs, nullptr if disabled
 
     /**
      * @brief Converts an internal gkfs path under the root dir to the absolute
@@ -104,20 +124,54 @@ private:
 
     /**
      * @brief Initializes the chunk space for a GekkoFS file, creating its
-     * directory on the local file system.
+     * directory on the local file system. Nothing is done if the chunk
+     * directory is already known to exist.
      * @param file_path Chunk file path, e.g., /foo/bar
      */
     void
     init_chunk_space(const std::string& file_path) const;
 
+    /**
+     * @brief Returns the known chunk directory shard for a file path.
+     * @param file_path Chunk file path, e.g., /foo/bar
+     * @return shard reference
+     */
+    chunk_dir_shard&
+    chunk_dir_shard_for(const std::string& file_path) const;
+
+    /**
+     * @brief Removes a file from the set of known chunk directories so that
+     * the next write creates its chunk directory again.
+     * @param file_path Chunk file path, e.g., /foo/bar
+     */
+    void
+    forget_chunk_space(const std::string& file_path) const;
+
+    /**
+     * @brief Returns an open file handle for a chunk file, either from the
+     * chunk file descriptor cache or by opening the file.
+     * @param file_path Chunk file path, e.g., /foo/bar
+     * @param chunk_id Number of chunk id
+     * @param chunk_path Absolute chunk file path on the local FS
+     * @param flags open() flags
+     * @return File handle, invalid on failure with errno set
+     */
+    std::shared_ptr<FileHandle>
+    open_chunk(const std::string& file_path, gkfs::rpc::chnk_id_t chunk_id,
+               const std::string& chunk_path, int flags) const;
+
 public:
     /**
      * @brief Initializes the ChunkStorage object on daemon launch.
      * @param path Root directory where all data is placed on the local FS.
      * @param chunksize Used chunksize in this GekkoFS instance.
+     * @param stats Optional stats collection for cache hit/miss counters
      * @throws ChunkStorageException on launch failure
      */
-    ChunkStorage(std::string& path, size_t chunksize);
+    ChunkStorage(std::string& path, size_t chunksize,
+                 std::shared_ptr<gkfs::utils::Stats> stats = nullptr);
+
+    ~ChunkStorage();
 
     /**
      * @brief Removes chunk directory with all its files which is a recursive
@@ -55,7 +55,8 @@ private:
 public:
     FileHandle() = default;
 
-    explicit FileHandle(int fd, const std::string& path) noexcept : fd_(fd) {}
+    explicit FileHandle(int fd, const std::string& path) noexcept
+        : fd_(fd), path_(path) {}
 
     FileHandle(FileHandle&& rhs) = default;
 
@@ -37,6 +37,7 @@
 #include <daemon/backend/exceptions.hpp>
 #include <tuple>
 #include <daemon/backend/metadata/metadata_backend.hpp>
+#include <daemon/backend/metadata/inmemory_backend.hpp>
 #ifdef GKFS_ENABLE_ROCKSDB
 #include <daemon/backend/metadata/rocksdb_backend.hpp>
 #endif
@@ -49,6 +50,7 @@ namespace gkfs::metadata {
 
 constexpr auto rocksdb_backend = "rocksdb";
 constexpr auto parallax_backend = "parallaxdb";
+constexpr auto inmemory_backend = "inmemory";
 
 class MetadataDB {
 private:
@@ -57,7 +59,13 @@ private:
     std::unique_ptr<AbstractMetadataBackend> backend_;
 
 public:
-    MetadataDB(const std::string& path, const std::string_view database);
+    /**
+     * @param path where KV store data is stored
+     * @param database backend id
+     * @param profile_file RocksDB tuning profile, empty for the default
+     */
+    MetadataDB(const std::string& path, const std::string_view database,
+               const std::string& profile_file = "");
 
     ~MetadataDB();
 
@@ -88,6 +96,23 @@ public:
     void
     put_no_exist(const std::string& key, const std::string& val);
 
+    /**
+     * @brief Gets the KV store values for several keys with a single request.
+     * @param keys KV store keys
+     * @return KV store value per key, std::nullopt if the entry doesn't exist
+     * @throws DBException on failure
+     */
+    [[nodiscard]] std::vector<std::optional<std::string>>
+    get_batch(const std::vector<std::string>& keys) const;
+
+    /**
+     * @brief Puts several entries into the KV store with a single atomic write.
+     * @param kvs pairs of KV store key and value
+     * @throws DBException
+     */
+    void
+    put_batch(const std::vector<std::pair<std::string, std::string>>& kvs);
+
     /**
      * @brief Removes an entry from the KV store.
      * @param key KV store key
@@ -96,6 +121,15 @@ public:
     void
     remove(const std::string& key);
 
+    /**
+     * @brief Removes several entries from the KV store with a single atomic
+     * write. Keys that don't exist are ignored.
+     * @param keys KV store keys
+     * @throws DBException on failure
+     */
+    void
+    remove_batch(const std::vector<std::string>& keys);
+
     /**
      * @brief Checks for existence of an entry.
      * @param key KV store key
@@ -149,6 +183,21 @@ public:
     [[nodiscard]] std::vector<std::pair<std::string, bool>>
     get_dirents(const std::string& dir) const;
 
+    /**
+     * @brief Return one page of file names and modes for the first-level
+     * entries of the given directory. Entries are returned in name order.
+     * @param dir directory prefix string
+     * @param start_key name of the last entry of the previous page, empty for
+     * the first page
+     * @param max_entries maximum number of entries to return
+     * @return vector of pair <std::string name, bool is_dir>,
+     *         where name is the name of the entries and is_dir
+     *         is true in the case the entry is a directory.
+     */
+    [[nodiscard]] std::vector<std::pair<std::string, bool>>
+    get_dirents_page(const std::string& dir, const std::string& start_key,
+                     size_t max_entries) const;
+
     /**
      * @brief Return all file names and modes for the first-level entries of the
      * given directory including their sizes and creation time.
@@ -172,6 +221,13 @@ public:
      */
     uint64_t
     db_size() const;
+
+    /**
+     * @brief Returns internal statistics of the backend, e.g., cache usage
+     * @return pairs of name and value
+     */
+    std::vector<std::pair<std::string, uint64_t>>
+    db_stats() const;
 };
 
 } // namespace gkfs::metadata
@@ -0,0 +1,259 @@
+/*
+  Copyright 2018-2024, Barcelona Supercomputing Center (BSC), Spain
+  Copyright 2015-2024, Johannes Gutenberg Universitaet Mainz, Germany
+
+  This software was partially supported by the
+  EC H2020 funded project NEXTGenIO (Project ID: 671951, www.nextgenio.eu).
+
+  This software was partially supported by the
+  ADA-FS project under the SPPEXA project funded by the DFG.
+
+  This file is part of GekkoFS.
+
+  GekkoFS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GekkoFS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GekkoFS.  If not, see <https://www.gnu.org/licenses/>.
+
+  SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#ifndef GEKKOFS_METADATA_INMEMORYBACKEND_HPP
+#define GEKKOFS_METADATA_INMEMORYBACKEND_HPP
+
+#include <memory>
+#include <map>
+#include <optional>
+#include <shared_mutex>
+#include <config.hpp>
+#include <daemon/backend/exceptions.hpp>
+#include <daemon/backend/metadata/metadata_backend.hpp>
+#include <common/metadata.hpp>
+#include <tuple>
+#include <vector>
+
+namespace gkfs::metadata {
+
+/**
+ * Metadata backend that keeps all entries in DRAM, for file systems that only
+ * live for the duration of a job. Entries are not persisted unless a snapshot
+ * is enabled, in which case they are written to a file at shutdown and loaded
+ * on the next start.
+ *
+ * Entries are sharded by their parent directory. Each shard is an ordered map
+ * with keys in the `<parent>\0<name>` format of the RocksDB backend, so all
+ * direct children of a directory are adjacent in the same shard. Values are
+ * kept decoded and size updates modify them in place under the shard lock.
+ */
+class InMemoryBackend : public MetadataBackend<InMemoryBackend> {
+private:
+    struct shard {
+        mutable std::shared_mutex mtx;
+        std::map<std::string, Metadata> entries;
+    };
+
+    std::unique_ptr<shard[]> shards_;
+    std::string snapshot_path_;
+
+    /**
+     * Returns the shard of a database key's parent directory
+     * @param parent parent directory without a trailing slash
+     * @return shard
+     */
+    shard&
+    shard_for(const std::string& parent) const;
+
+    /**
+     * Translates a path to its database key and returns its shard
+     * @param path absolute path
+     * @return pair of key and shard
+     */
+    std::pair<std::string, shard&>
+    locate(const std::string& path) const;
+
+    /**
+     * Loads the entries of a snapshot file
+     * @throws DBException on failure
+     */
+    void
+    load_snapshot();
+
+    /**
+     * Writes all entries to a new snapshot file, which replaces the previous
+     * snapshot when it is complete
+     * @throws DBException on failure
+     */
+    void
+    write_snapshot() const;
+
+public:
+    /**
+     * @param path directory for the snapshot file
+     * @param use_snapshot write a snapshot at shutdown and load it on start
+     */
+    explicit InMemoryBackend(
+            const std::string& path,
+            bool use_snapshot = gkfs::config::inmemory::use_snapshot);
+
+    virtual ~InMemoryBackend();
+
+    /**
+     * Gets a KV store value for a key
+     * @param key
+     * @return value
+     * @throws NotFoundException if entry doesn't exist
+     */
+    std::string
+    get_impl(const std::string& key) const;
+
+    /**
+     * Puts an entry into the KV store. Like a create merge in RocksDB, an
+     * existing entry is kept
+     * @param key
+     * @param val
+     */
+    void
+    put_impl(const std::string& key, const std::string& val);
+
+    /**
+     * Puts an entry into the KV store if it doesn't exist
+     * @param key
+     * @param val
+     * @throws ExistException if entry already exists
+     */
+    void
+    put_no_exist_impl(const std::string& key, const std::string& val);
+
+    /**
+     * Gets the KV store values for several keys
+     * @param keys
+     * @return value per key, std::nullopt if the entry doesn't exist
+     */
+    std::vector<std::optional<std::string>>
+    get_batch_impl(const std::vector<std::string>& keys) const;
+
+    /**
+     * Puts several entries into the KV store
+     * @param kvs
+     */
+    void
+    put_batch_impl(const std::vector<std::pair<std::string, std::string>>& kvs);
+
+    /**
+     * Removes an entry from the KV store
+     * @param key
+     */
+    void
+    remove_impl(const std::string& key);
+
+    /**
+     * Removes several entries from the KV store
+     * @param keys
+     */
+    void
+    remove_batch_impl(const std::vector<std::string>& keys);
+
+    /**
+     * checks for existence of an entry
+     * @param key
+     * @return true if exists
+     */
+    bool
+    exists_impl(const std::string& key);
+
+    /**
+     * Updates a metadentry atomically and also allows to change keys
+     * @param old_key
+     * @param new_key
+     * @param val
+     */
+    void
+    update_impl(const std::string& old_key, const std::string& new_key,
+                const std::string& val);
+
+    /**
+     * Updates the size on the metadata
+     * Operation. E.g., called before a write() call
+     * @param key
+     * @param io_size
+     * @param offset
+     * @param append
+     * @return offset where the write operation should start. This is only used
+     * when append is set
+     * @throws NotFoundException if entry doesn't exist
+     */
+    off_t
+    increase_size_impl(const std::string& key, size_t io_size, off_t offset,
+                       bool append);
+
+    /**
+     * Decreases the size on the metadata
+     * Operation E.g., called before a truncate() call
+     * @param key
+     * @param size
+     * @throws NotFoundException if entry doesn't exist
+     */
+    void
+    decrease_size_impl(const std::string& key, size_t size);
+
+    /**
+     * Return all the first-level entries of the directory @dir
+     *
+     * @return vector of pair <std::string name, bool is_dir>,
+     *         where name is the name of the entries and is_dir
+     *         is true in the case the entry is a directory.
+     */
+    std::vector<std::pair<std::string, bool>>
+    get_dirents_impl(const std::string& dir) const;
+
+    /**
+     * Return up to @max_entries first-level entries of the directory @dir
+     * whose names sort after @start_key, in name order
+     *
+     * @return vector of pair <std::string name, bool is_dir>,
+     *         where name is the name of the entries and is_dir
+     *         is true in the case the entry is a directory.
+     */
+    std::vector<std::pair<std::string, bool>>
+    get_dirents_page_impl(const std::string& dir, const std::string& start_key,
+                          size_t max_entries) const;
+
+    /**
+     * Return all the first-level entries of the directory @dir
+     *
+     * @return vector of pair <std::string name, bool is_dir - size - ctime>,
+     *         where name is the name of the entries and is_dir
+     *         is true in the case the entry is a directory.
+     */
+    std::vector<std::tuple<std::string, bool, size_t, time_t>>
+    get_dirents_extended_impl(const std::string& dir) const;
+
+    /**
+     * Not supported, there is no iterator object for the sharded maps
+     * @return nullptr
+     */
+    void*
+    iterate_all_impl() const;
+
+    uint64_t
+    db_size_impl() const;
+
+    /**
+     * Returns the number of entries
+     * @return pairs of name and value
+     */
+    std::vector<std::pair<std::string, uint64_t>>
+    db_stats_impl() const;
+};
+
+} // namespace gkfs::metadata
+
+#endif // GEKKOFS_METADATA_INMEMORYBACKEND_HPP
@@ -86,19 +86,16 @@ private:
 
     size_t size_;
     /*
-     * ID of the merge operation that this operand belongs to.
-     * This ID is used only in append operations to communicate the starting
-     * write offset from the asynchronous Merge operation back to the caller in
-     * `increase_size_impl()`.
+     * Append operands were written by earlier versions, which reserved append
+     * offsets inside the merge operator. Their size is added to the file size.
+     * Appends now reserve their offset before merging and write regular
+     * operands.
      */
-    uint16_t merge_id_;
     bool append_;
 
 public:
     IncreaseSizeOperand(size_t size);
 
-    IncreaseSizeOperand(size_t size, uint16_t merge_id, bool append);
-
     explicit IncreaseSizeOperand(const rdb::Slice& serialized_op);
 
     OperandID
@@ -112,11 +109,6 @@ public:
         return size_;
     }
 
-    uint16_t
-    merge_id() const {
-        return merge_id_;
-    }
-
     bool
     append() const {
         return append_;
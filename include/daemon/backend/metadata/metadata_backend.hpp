@@ -30,9 +30,11 @@
 #define GEKKOFS_METADATA_BACKEND_HPP
 
 #include <memory>
+#include <optional>
 #include <spdlog/spdlog.h>
 #include <daemon/backend/exceptions.hpp>
 #include <tuple>
+#include <vector>
 
 namespace gkfs::metadata {
 
@@ -50,9 +52,18 @@ public:
     virtual void
     put_no_exist(const std::string& key, const std::string& val) = 0;
 
+    virtual std::vector<std::optional<std::string>>
+    get_batch(const std::vector<std::string>& keys) const = 0;
+
+    virtual void
+    put_batch(const std::vector<std::pair<std::string, std::string>>& kvs) = 0;
+
     virtual void
     remove(const std::string& key) = 0;
 
+    virtual void
+    remove_batch(const std::vector<std::string>& keys) = 0;
+
     virtual bool
     exists(const std::string& key) = 0;
 
@@ -70,6 +81,10 @@ public:
     virtual std::vector<std::pair<std::string, bool>>
     get_dirents(const std::string& dir) const = 0;
 
+    virtual std::vector<std::pair<std::string, bool>>
+    get_dirents_page(const std::string& dir, const std::string& start_key,
+                     size_t max_entries) const = 0;
+
     virtual std::vector<std::tuple<std::string, bool, size_t, time_t>>
     get_dirents_extended(const std::string& dir) const = 0;
 
@@ -78,6 +93,9 @@ public:
 
     virtual uint64_t
     db_size() const = 0;
+
+    virtual std::vector<std::pair<std::string, uint64_t>>
+    db_stats() const = 0;
 };
 
 template <typename T>
@@ -102,11 +120,26 @@ public:
         static_cast<T&>(*this).put_no_exist_impl(key, val);
     }
 
+    std::vector<std::optional<std::string>>
+    get_batch(const std::vector<std::string>& keys) const {
+        return static_cast<T const&>(*this).get_batch_impl(keys);
+    }
+
+    void
+    put_batch(const std::vector<std::pair<std::string, std::string>>& kvs) {
+        static_cast<T&>(*this).put_batch_impl(kvs);
+    }
+
     void
     remove(const std::string& key) {
         static_cast<T&>(*this).remove_impl(key);
     }
 
+    void
+    remove_batch(const std::vector<std::string>& keys) {
+        static_cast<T&>(*this).remove_batch_impl(keys);
+    }
+
     bool
     exists(const std::string& key) {
         return static_cast<T&>(*this).exists_impl(key);
@@ -135,6 +168,13 @@ public:
         return static_cast<T const&>(*this).get_dirents_impl(dir);
     }
 
+    std::vector<std::pair<std::string, bool>>
+    get_dirents_page(const std::string& dir, const std::string& start_key,
+                     size_t max_entries) const {
+        return static_cast<T const&>(*this).get_dirents_page_impl(
+                dir, start_key, max_entries);
+    }
+
     std::vector<std::tuple<std::string, bool, size_t, time_t>>
     get_dirents_extended(const std::string& dir) const {
         return static_cast<T const&>(*this).get_dirents_extended_impl(dir);
@@ -149,6 +189,11 @@ public:
     db_size() const {
         return static_cast<T const&>(*this).db_size_impl();
     }
+
+    std::vector<std::pair<std::string, uint64_t>>
+    db_stats() const {
+        return static_cast<T const&>(*this).db_stats_impl();
+    }
 };
 
 } // namespace gkfs::metadata
@@ -30,7 +30,6 @@
 #define GEKKOFS_DAEMON_METADATA_LOGGING_HPP
 
 #include <spdlog/spdlog.h>
-#include <map>
 
 namespace gkfs::metadata {
 
@@ -44,10 +43,6 @@ private:
     MetadataModule() = default;
 
     std::shared_ptr<spdlog::logger> log_; ///< Metadata logger
-    ///< Map to remember and assign offsets to write append operations
-    std::map<uint16_t, size_t> append_offset_reserve_{};
-    std::mutex append_offset_reserve_mutex_{}; ///< Mutex to protect
-                                               ///< append_offset_reserve_
 
 public:
     ///< Logger name
@@ -73,26 +68,6 @@ public:
 
     void
     log(const std::shared_ptr<spdlog::logger>& log);
-
-    const std::map<uint16_t, size_t>&
-    append_offset_reserve() const;
-
-    /**
-     * @brief Inserts entry into append_offset_reserve_
-     * @param merge_id Merge ID
-     * @param offset Offset to reserve
-     */
-    void
-    append_offset_reserve_put(uint16_t merge_id, size_t offset);
-
-    /**
-     * @brief Gets and erases entry from append_offset_reserve_
-     * @param merge_id Merge ID
-     * @return Offset reserved for merge_id
-     * @throws std::out_of_range if merge_id is not in append_offset_reserve_
-     */
-    size_t
-    append_offset_reserve_get_and_erase(uint16_t merge_id);
 };
 
 #define GKFS_METADATA_MOD                                                      \
@@ -32,7 +32,9 @@
 #include <memory>
 #include <spdlog/spdlog.h>
 #include <daemon/backend/exceptions.hpp>
+#include <optional>
 #include <tuple>
+#include <vector>
 #include <cstdio>
 extern "C" {
 #include <parallax.h>
@@ -114,6 +116,24 @@ public:
     void
     put_no_exist_impl(const std::string& key, const std::string& val);
 
+    /**
+     * Gets the KV store values for several keys. Parallax has no batched read,
+     * the keys are read one after another.
+     * @param keys
+     * @return value per key, std::nullopt if the entry doesn't exist
+     * @throws DBException on failure
+     */
+    std::vector<std::optional<std::string>>
+    get_batch_impl(const std::vector<std::string>& keys) const;
+
+    /**
+     * Puts several entries into the KV store one after another
+     * @param kvs
+     * @throws DBException on failure
+     */
+    void
+    put_batch_impl(const std::vector<std::pair<std::string, std::string>>& kvs);
+
     /**
      * Removes an entry from the KV store
      * @param key
@@ -122,6 +142,14 @@ public:
     void
     remove_impl(const std::string& key);
 
+    /**
+     * Removes several entries from the KV store one after another
+     * @param keys
+     * @throws DBException on failure
+     */
+    void
+    remove_batch_impl(const std::vector<std::string>& keys);
+
     /**
      * checks for existence of an entry
      * @param key
@@ -176,6 +204,18 @@ public:
     std::vector<std::pair<std::string, bool>>
     get_dirents_impl(const std::string& dir) const;
 
+    /**
+     * Return up to @max_entries first-level entries of the directory @dir
+     * whose names sort after @start_key, in name order
+     *
+     * @return vector of pair <std::string name, bool is_dir>,
+     *         where name is the name of the entries and is_dir
+     *         is true in the case the entry is a directory.
+     */
+    std::vector<std::pair<std::string, bool>>
+    get_dirents_page_impl(const std::string& dir, const std::string& start_key,
+                          size_t max_entries) const;
+
     /**
      * Return all the first-level entries of the directory @dir
      *
@@ -192,6 +232,13 @@ public:
      */
     void*
     iterate_all_impl() const;
+
+    /**
+     * Parallax does not expose internal statistics
+     * @return empty vector
+     */
+    std::vector<std::pair<std::string, uint64_t>>
+    db_stats_impl() const;
 };
 
 } // namespace gkfs::metadata
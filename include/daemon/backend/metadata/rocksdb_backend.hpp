@@ -29,31 +29,152 @@
 #ifndef GEKKOFS_METADATA_ROCKSDBBACKEND_HPP
 #define GEKKOFS_METADATA_ROCKSDBBACKEND_HPP
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <spdlog/spdlog.h>
 #include <rocksdb/db.h>
+#include <config.hpp>
 #include <daemon/backend/exceptions.hpp>
 #include <tuple>
+#include <unordered_map>
+#include <vector>
 
 namespace rdb = rocksdb;
 
 namespace gkfs::metadata {
 
+/**
+ * Tuning profile of the RocksDB backend. The defaults are taken from
+ * gkfs::config::rocksdb. A profile file overwrites them with one
+ * `key = value` pair per line, where the keys are the member names below.
+ * Empty lines and lines starting with '#' are ignored.
+ */
+struct RocksDBProfile {
+    bool prefix_bloom = gkfs::config::rocksdb::use_prefix_bloom;
+    int bloom_bits_per_key = gkfs::config::rocksdb::bloom_bits_per_key;
+    uint64_t block_cache_size_mb = gkfs::config::rocksdb::block_cache_size_mb;
+    uint64_t write_buffer_size_mb =
+            gkfs::config::rocksdb::write_buffer_size_mb;
+    int max_write_buffer_number =
+            gkfs::config::rocksdb::max_write_buffer_number;
+    int level0_file_num_compaction_trigger =
+            gkfs::config::rocksdb::level0_file_num_compaction_trigger;
+    int max_background_jobs = gkfs::config::rocksdb::max_background_jobs;
+    uint64_t target_file_size_base_mb =
+            gkfs::config::rocksdb::target_file_size_base_mb;
+    bool statistics = gkfs::config::rocksdb::use_statistics;
+
+    /**
+     * Reads a profile file
+     * @param file path of the profile file
+     * @return profile
+     * @throws std::runtime_error if the file can't be read or is malformed
+     */
+    static RocksDBProfile
+    load(const std::string& file);
+};
+
 /**
  * Called when the daemon is started: Connects to the KV store
  * @param path where KV store data is stored
+ *
+ * Keys are not stored as plain paths. A path is split at its last '/' and
+ * stored as `<parent>\0<name>`, e.g., `/a/b/c` becomes `/a/b\0c` and `/c`
+ * becomes `/\0c`. The root `/` is stored as is. Because '\0' sorts before
+ * every path character, all direct children of a directory are contiguous,
+ * and readdir reads only these instead of the directory's whole subtree.
  */
 class RocksDBBackend : public MetadataBackend<RocksDBBackend> {
 private:
     std::unique_ptr<rdb::DB> db_;
     rdb::Options options_;
     rdb::WriteOptions write_opts_;
+    RocksDBProfile profile_;
+
+    using append_size_t = std::shared_ptr<std::atomic<size_t>>;
+
+    /**
+     * File sizes of recently appended files. Appends reserve their offset with
+     * a fetch-add on the size, which is then persisted with a merge operand.
+     * Appenders hold a reference to the size while their merge is in flight,
+     * so only sizes without references are dropped when a shard is full.
+     */
+    struct append_shard {
+        std::mutex mtx;
+        std::unordered_map<std::string, append_size_t> sizes;
+    };
+
+    std::unique_ptr<append_shard[]> append_shards_;
+
+    append_shard&
+    append_shard_for(const std::string& key) const;
+
+    /**
+     * Returns the in-memory size of a file, loading it from the database on
+     * first use
+     * @param key
+     * @return size
+     * @throws DBException on failure, NotFoundException if entry doesn't exist
+     */
+    append_size_t
+    append_size(const std::string& key);
+
+    /**
+     * Drops the in-memory size of a file after its metadata was written
+     * directly, e.g., on create, update or remove
+     * @param key
+     */
+    void
+    forget_append_size(const std::string& key);
+
+    /**
+     * Converts a database that still uses plain path keys to the
+     * direct-children key format. Each batch of entries is converted
+     * atomically, so an interrupted conversion is resumed on the next start.
+     */
+    void
+    migrate_key_format();
 
 public:
-    explicit RocksDBBackend(const std::string& path);
+    /// Internal entry holding the key format. Paths never start with '#'
+    static constexpr auto key_format_key = "#key_format";
+    static constexpr auto key_format_version = "2";
+
+    /**
+     * @param path where KV store data is stored
+     * @param profile_file tuning profile, empty for the default profile
+     */
+    explicit RocksDBBackend(const std::string& path,
+                            const std::string& profile_file = "");
 
     virtual ~RocksDBBackend();
 
+    /**
+     * Translates a path to its database key
+     * @param path absolute path
+     * @return key in the direct-children format
+     */
+    static std::string
+    encode_key(const std::string& path);
+
+    /**
+     * Translates a database key back to its path
+     * @param key database key
+     * @return absolute path or an empty string for internal entries
+     */
+    static std::string
+    decode_key(const rdb::Slice& key);
+
+    /**
+     * Returns the common key prefix of all direct children of a directory
+     * @param dir absolute directory path with a trailing slash
+     * @return key prefix
+     */
+    static std::string
+    children_prefix(const std::string& dir);
+
     /**
      * Exception wrapper on Status object. Throws NotFoundException if
      * s.IsNotFound(), general DBException otherwise
@@ -64,7 +185,7 @@ public:
     throw_status_excpt(const rdb::Status& s);
 
     /**
-     * Used for setting KV store settings
+     * Used for setting KV store settings. Applies the tuning profile
      */
     void
     optimize_database_impl();
@@ -97,6 +218,23 @@ public:
     void
     put_no_exist_impl(const std::string& key, const std::string& val);
 
+    /**
+     * Gets the KV store values for several keys with a single MultiGet
+     * @param keys
+     * @return value per key, std::nullopt if the entry doesn't exist
+     * @throws DBException on failure
+     */
+    std::vector<std::optional<std::string>>
+    get_batch_impl(const std::vector<std::string>& keys) const;
+
+    /**
+     * Puts several entries into the KV store with a single WriteBatch
+     * @param kvs
+     * @throws DBException on failure
+     */
+    void
+    put_batch_impl(const std::vector<std::pair<std::string, std::string>>& kvs);
+
     /**
      * Removes an entry from the KV store
      * @param key
@@ -105,6 +243,14 @@ public:
     void
     remove_impl(const std::string& key);
 
+    /**
+     * Removes several entries from the KV store with a single WriteBatch
+     * @param keys
+     * @throws DBException on failure
+     */
+    void
+    remove_batch_impl(const std::vector<std::string>& keys);
+
     /**
      * checks for existence of an entry
      * @param key
@@ -160,6 +306,18 @@ public:
     std::vector<std::pair<std::string, bool>>
     get_dirents_impl(const std::string& dir) const;
 
+    /**
+     * Return up to @max_entries first-level entries of the directory @dir
+     * whose names sort after @start_key, in name order
+     *
+     * @return vector of pair <std::string name, bool is_dir>,
+     *         where name is the name of the entries and is_dir
+     *         is true in the case the entry is a directory.
+     */
+    std::vector<std::pair<std::string, bool>>
+    get_dirents_page_impl(const std::string& dir, const std::string& start_key,
+                          size_t max_entries) const;
+
     /**
      * Return all the first-level entries of the directory @dir
      *
@@ -172,13 +330,21 @@ public:
 
     /**
      * Code example for iterating all entries in KV store. This is for debug
-     * only as it is too expensive
+     * only as it is too expensive. Use decode_key() to get the entries' paths.
      */
     void*
     iterate_all_impl() const;
 
     uint64_t
     db_size_impl() const;
+
+    /**
+     * Returns the sizes of the block cache, memtables, and SST files, and,
+     * if statistics are enabled in the profile, RocksDB's tickers
+     * @return pairs of name and value
+     */
+    std::vector<std::pair<std::string, uint64_t>>
+    db_stats_impl() const;
 };
 
 } // namespace gkfs::metadata
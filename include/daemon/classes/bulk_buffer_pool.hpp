@@ -0,0 +1,203 @@
+/*
+  Copyright 2018-2024, Barcelona Supercomputing Center (BSC), Spain
+  Copyright 2015-2024, Johannes Gutenberg Universitaet Mainz, Germany
+
+  This software was partially supported by the
+  EC H2020 funded project NEXTGenIO (Project ID: 671951, www.nextgenio.eu).
+
+  This software was partially supported by the
+  ADA-FS project under the SPPEXA project funded by the DFG.
+
+  This file is part of GekkoFS.
+
+  GekkoFS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GekkoFS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GekkoFS.  If not, see <https://www.gnu.org/licenses/>.
+
+  SPDX-License-Identifier: GPL-3.0-or-later
+*/
+/**
+ * @brief Pool of pre-registered bulk buffers used by the daemon's data RPC
+ * handlers.
+ */
+
+#ifndef GEKKOFS_DAEMON_BULK_BUFFER_POOL_HPP
+#define GEKKOFS_DAEMON_BULK_BUFFER_POOL_HPP
+
+extern "C" {
+#include <margo.h>
+}
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace gkfs::utils {
+class Stats;
+}
+
+namespace gkfs::daemon {
+
+/**
+ * @brief Daemon-wide pool of registered bulk buffers for a margo instance.
+ * @internal
+ * Buffers are grouped in size classes. Class i holds buffers of
+ * `chunksize << i` bytes so that a request of n chunks is always served by a
+ * buffer of at most twice its size. Buffers are allocated and registered with
+ * margo_bulk_create() on first use and kept on a per-class free list after they
+ * have been returned. The memory of all buffers owned by the pool (free or in
+ * use) never exceeds the given cap. If a class has no free buffer and the cap
+ * is reached, idle buffers of other classes are released to make room. If that is
+ * not enough, or the request exceeds the largest class, a buffer is allocated
+ * for this request only and freed when it is returned (fallback).
+ *
+ * Bulk handles are bound to the margo instance they were created with. Thus,
+ * the daemon's RPC server and proxy server each have their own pool. A pool
+ * must be destroyed before its margo instance is finalized.
+ * @endinternal
+ */
+class BulkBufferPool {
+public:
+    /**
+     * @brief A buffer borrowed from the pool. It is returned to the pool when
+     * it goes out of scope.
+     */
+    class Buffer {
+    private:
+        friend class BulkBufferPool;
+
+        BulkBufferPool* pool_{nullptr};
+        hg_bulk_t handle_{HG_BULK_NULL};
+        void* data_{nullptr};
+        size_t size_class_{0}; //!< size class index, npos for fallback
+
+        Buffer(BulkBufferPool* pool, hg_bulk_t handle, void* data,
+               size_t size_class);
+
+    public:
+        Buffer() = default;
+
+        ~Buffer();
+
+        Buffer(const Buffer&) = delete;
+
+        Buffer&
+        operator=(const Buffer&) = delete;
+
+        Buffer(Buffer&& other) noexcept;
+
+        Buffer&
+        operator=(Buffer&& other) noexcept;
+
+        /**
+         * @brief Bulk handle of the registered buffer
+         */
+        [[nodiscard]] hg_bulk_t
+        handle() const;
+
+        /**
+         * @brief Pointer to the beginning of the registered memory
+         */
+        [[nodiscard]] void*
+        data() const;
+
+        [[nodiscard]] bool
+        valid() const;
+
+        /**
+         * @brief True if the buffer is owned by the pool, false if it was
+         * allocated for this request only.
+         */
+        [[nodiscard]] bool
+        pooled() const;
+    };
+
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+private:
+    struct size_class {
+        size_t size;
+        std::vector<std::pair<hg_bulk_t, void*>> free; //!< idle buffers
+    };
+
+    margo_instance_id mid_;
+    size_t max_size_; //!< memory cap of all pooled buffers in bytes
+    std::shared_ptr<gkfs::utils::Stats> stats_;
+
+    std::mutex mtx_;
+    std::vector<size_class> classes_;
+    size_t allocated_size_{0}; //!< bytes owned by the pool (free + in use)
+    size_t used_size_{0};      //!< bytes currently lent out (pooled only)
+
+    /**
+     * @brief Allocates and registers a new buffer of the given size.
+     * @return {HG_BULK_NULL, nullptr} on failure
+     */
+    std::pair<hg_bulk_t, void*>
+    create(size_t size) const;
+
+    void
+    release(Buffer& buf);
+
+public:
+    /**
+     * @brief Creates an empty pool. Buffers are allocated lazily.
+     * @param mid Margo instance the buffers are registered with
+     * @param chunksize Size of the smallest size class in bytes
+     * @param size_classes Number of size classes
+     * @param max_size Memory cap of all pooled buffers in bytes. 0 disables
+     * pooling and all buffers are allocated per request
+     * @param stats Stats collection, may be nullptr
+     */
+    BulkBufferPool(margo_instance_id mid, size_t chunksize, size_t size_classes,
+                   size_t max_size,
+                   std::shared_ptr<gkfs::utils::Stats> stats = nullptr);
+
+    /**
+     * @brief Frees all idle buffers. All borrowed buffers must have been
+     * returned.
+     */
+    ~BulkBufferPool();
+
+    BulkBufferPool(const BulkBufferPool&) = delete;
+
+    BulkBufferPool&
+    operator=(const BulkBufferPool&) = delete;
+
+    /**
+     * @brief Borrows a registered buffer of at least `size` bytes.
+     * @param size Requested size in bytes
+     * @return Buffer. If allocating a buffer fails, the buffer is invalid.
+     */
+    Buffer
+    acquire(size_t size);
+
+    /**
+     * @brief Bytes of memory currently owned by the pool (free + in use)
+     */
+    size_t
+    allocated_size();
+
+    /**
+     * @brief Bytes of memory currently lent out from the pool
+     */
+    size_t
+    used_size();
+
+    [[nodiscard]] size_t
+    max_size() const;
+};
+
+} // namespace gkfs::daemon
+
+#endif // GEKKOFS_DAEMON_BULK_BUFFER_POOL_HPP
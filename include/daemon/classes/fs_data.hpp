@@ -40,6 +40,7 @@
 namespace gkfs {
 namespace metadata {
 class MetadataDB;
+class MetadataCache;
 }
 
 namespace data {
@@ -81,13 +82,18 @@ private:
                                     // Remains empty if unused
     std::string hosts_file_{};
     bool use_auto_sm_;
+    // placement of data and metadata, e.g., gkfs::rpc::jump_hash_distributor
+    std::string distributor_type_{};
 
     // Database
     std::shared_ptr<gkfs::metadata::MetadataDB> mdb_;
     std::string dbbackend_;
+    // Decoded metadata of hot entries, nullptr if disabled
+    std::shared_ptr<gkfs::metadata::MetadataCache> metadata_cache_;
 
     // Parallax
     unsigned long long parallax_size_md_ = 8589934592ull;
+    std::string rocksdb_profile_{};
 
     // Storage backend
     std::shared_ptr<gkfs::data::ChunkStorage> storage_;
@@ -178,6 +184,13 @@ public:
     void
     close_mdb();
 
+    const std::shared_ptr<gkfs::metadata::MetadataCache>&
+    metadata_cache() const;
+
+    void
+    metadata_cache(
+            const std::shared_ptr<gkfs::metadata::MetadataCache>& metadata_cache);
+
     const std::shared_ptr<gkfs::data::ChunkStorage>&
     storage() const;
 
@@ -219,6 +232,12 @@ public:
     void
     hosts_file(const std::string& lookup_file);
 
+    const std::string&
+    distributor_type() const;
+
+    void
+    distributor_type(const std::string& distributor_type);
+
     bool
     atime_state() const;
 
@@ -255,6 +274,12 @@ public:
     void
     parallax_size_md(unsigned int size_md);
 
+    const std::string&
+    rocksdb_profile() const;
+
+    void
+    rocksdb_profile(const std::string& rocksdb_profile);
+
     const std::shared_ptr<gkfs::utils::Stats>&
     stats() const;
 
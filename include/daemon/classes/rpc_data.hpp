@@ -42,6 +42,8 @@ class Distributor;
 
 namespace daemon {
 
+class BulkBufferPool;
+
 struct margo_client_ids {
     hg_id_t migrate_metadata_id;
     hg_id_t migrate_data_id;
@@ -71,6 +73,9 @@ private:
     std::string self_proxy_addr_str_;
     // Distributor
     std::shared_ptr<gkfs::rpc::Distributor> distributor_;
+    // Registered bulk buffers for data RPC handlers
+    std::shared_ptr<BulkBufferPool> bulk_pool_;
+    std::shared_ptr<BulkBufferPool> proxy_bulk_pool_;
 
 public:
     static RPCData*
@@ -154,6 +159,18 @@ public:
 
     void
     distributor(const std::shared_ptr<gkfs::rpc::Distributor>& distributor);
+
+    const std::shared_ptr<BulkBufferPool>&
+    bulk_pool() const;
+
+    void
+    bulk_pool(const std::shared_ptr<BulkBufferPool>& bulk_pool);
+
+    const std::shared_ptr<BulkBufferPool>&
+    proxy_bulk_pool() const;
+
+    void
+    proxy_bulk_pool(const std::shared_ptr<BulkBufferPool>& proxy_bulk_pool);
 };
 
 } // namespace daemon
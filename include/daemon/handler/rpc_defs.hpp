@@ -48,6 +48,14 @@ DECLARE_MARGO_RPC_HANDLER(rpc_srv_decr_size)
 
 DECLARE_MARGO_RPC_HANDLER(rpc_srv_remove_metadata)
 
+DECLARE_MARGO_RPC_HANDLER(rpc_srv_create_batch)
+
+DECLARE_MARGO_RPC_HANDLER(rpc_srv_stat_batch)
+
+DECLARE_MARGO_RPC_HANDLER(rpc_srv_remove_metadata_batch)
+
+DECLARE_MARGO_RPC_HANDLER(rpc_srv_open_metadentry)
+
 DECLARE_MARGO_RPC_HANDLER(rpc_srv_update_metadentry)
 
 DECLARE_MARGO_RPC_HANDLER(rpc_srv_get_metadentry_size)
@@ -44,6 +44,7 @@
 #include <daemon/daemon.hpp>
 #include <common/common_defs.hpp>
 
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -146,10 +147,12 @@ public:
         task_eventuals_.resize(n);
     };
     /**
-     * Destructor calls cancel_all_tasks to clean up all used resources.
+     * Destructor calls cancel_all_tasks to clean up all used resources unless
+     * the derived class already did so in its own destructor.
      */
     ~ChunkOperation() {
-        cancel_all_tasks();
+        if(!abt_tasks_.empty())
+            cancel_all_tasks();
     }
 
     /**
@@ -290,10 +293,29 @@ public:
  * @brief Chunk operation class for read operations with one object per read
  * RPC request. May involve multiple I/O task depending on the number of chunks
  * involved.
+ * @internal
+ * Reads are completion-driven: Each tasklet posts the non-blocking PUSH bulk
+ * transfer of its chunk as soon as it has read the chunk. The RPC handler only
+ * waits on a single eventual that is set when the last tasklet has finished
+ * and then waits for the already in-flight transfers. Hence, transfers are
+ * started in the order the chunks are read without the handler spinning over
+ * all tasklets.
+ * @endinternal
  */
 class ChunkReadOperation : public ChunkOperation<ChunkReadOperation> {
     friend class ChunkOperation<ChunkReadOperation>;
 
+public:
+    struct bulk_args {
+        margo_instance_id mid;               //!< Margo instance ID of server
+        hg_addr_t origin_addr;               //!< abstract address of client
+        hg_bulk_t origin_bulk_handle;        //!< bulk handle from client
+        std::vector<size_t>* origin_offsets; //!< offsets in origin buffer
+        hg_bulk_t local_bulk_handle;         //!< local bulk handle for PUSH
+        std::vector<size_t>* local_offsets;  //!< offsets in local buffer
+        std::vector<uint64_t>* chunk_ids;    //!< all chunk ids in this read
+    }; //!< Struct to push read data to the client
+
 private:
     struct chunk_read_args {
         const std::string* path;      //!< Path to affected chunk directory
@@ -301,38 +323,53 @@ private:
         gkfs::rpc::chnk_id_t chnk_id; //!< chunk id that is affected
         size_t size;                  //!< size to read from chunk
         off64_t off;                  //!< offset for individual chunk
-        ABT_eventual eventual;        //!< Attached eventual
-        bool bulk_transfer_done = false;
+        size_t idx;                   //!< index of this chunk in bulk_args
+        ChunkReadOperation* op;       //!< operation this chunk belongs to
+        ssize_t read;                 //!< read size or negative error code
+        margo_request push_req;       //!< posted PUSH transfer or null
     }; //!< Struct for an chunk read operation
 
     std::vector<struct chunk_read_args> task_args_; //!< tasklet input structs
+    bulk_args bulk_args_;                           //!< PUSH transfer info
+    std::atomic<int> io_err_{0}; //!< first error, stops further transfers
+    std::atomic<size_t> pending_{1}; //!< unfinished tasklets + 1 for launcher
+    ABT_eventual done_eventual_{ABT_EVENTUAL_NULL}; //!< set when pending_ == 0
+
     /**
-     * @brief Exclusively used by the Argobots tasklet.
-     * @param _arg Pointer to input struct of type <chunk_read_args>. Error
-     * code<int> is placed into eventual to signal its failure or success.
+     * @brief Exclusively used by the Argobots tasklet. Reads the chunk and
+     * posts its PUSH bulk transfer.
+     * @param _arg Pointer to input struct of type <chunk_read_args>. The read
+     * size is placed into the struct. The last finishing tasklet sets the
+     * operation's eventual.
      */
     static void
     read_file_abt(void* _arg);
     /**
-     * @brief Resets the task_arg_ struct.
+     * @brief Drops a reference of pending_ and sets the eventual when the last
+     * reference is gone.
+     */
+    void
+    finish_one();
+    /**
+     * @brief Waits for all posted PUSH transfers and resets the task_arg_
+     * struct.
      */
     void
     clear_task_args();
 
 public:
-    struct bulk_args {
-        margo_instance_id mid;               //!< Margo instance ID of server
-        hg_addr_t origin_addr;               //!< abstract address of client
-        hg_bulk_t origin_bulk_handle;        //!< bulk handle from client
-        std::vector<size_t>* origin_offsets; //!< offsets in origin buffer
-        hg_bulk_t local_bulk_handle;         //!< local bulk handle for PUSH
-        std::vector<size_t>* local_offsets;  //!< offsets in local buffer
-        std::vector<uint64_t>* chunk_ids;    //!< all chunk ids in this read
-    }; //!< Struct to push read data to the client
-
-    ChunkReadOperation(const std::string& path, size_t n);
+    /**
+     * @brief Constructor.
+     * @param path Path to chunk directory
+     * @param n Number of chunks read by this RPC request
+     * @param args Bulk_args for push transfers. The referenced offset and
+     * chunk id vectors must be filled for a chunk before read_nonblock() is
+     * called for it and outlive this object.
+     */
+    ChunkReadOperation(const std::string& path, size_t n,
+                       const bulk_args& args);
 
-    ~ChunkReadOperation() = default;
+    ~ChunkReadOperation();
 
     /**
      * @brief Read request called by RPC handler function and launches a
@@ -349,13 +386,13 @@ public:
                   size_t size, off64_t offset);
 
     /**
-     * @brief Waits for all local I/O operations to finish and push buffers back
-     * to the daemon.
-     * @param args Bulk_args for push transfer
+     * @brief Waits for all local I/O operations to finish and for their
+     * buffers being pushed back to the client. Must be called once after all
+     * read_nonblock() calls.
      * @return Pair for error code for success (0) or failure and read size
      */
     std::pair<int, size_t>
-    wait_for_tasks_and_push_back(const bulk_args& args);
+    wait_for_tasks_and_push_back();
 };
 
 } // namespace gkfs::data
@@ -0,0 +1,221 @@
+/*
+  Copyright 2018-2024, Barcelona Supercomputing Center (BSC), Spain
+  Copyright 2015-2024, Johannes Gutenberg Universitaet Mainz, Germany
+
+  This software was partially supported by the
+  EC H2020 funded project NEXTGenIO (Project ID: 671951, www.nextgenio.eu).
+
+  This software was partially supported by the
+  ADA-FS project under the SPPEXA project funded by the DFG.
+
+  This file is part of GekkoFS.
+
+  GekkoFS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GekkoFS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GekkoFS.  If not, see <https://www.gnu.org/licenses/>.
+
+  SPDX-License-Identifier: GPL-3.0-or-later
+*/
+/**
+ * @brief Cache of decoded metadata used by the metadata operations to serve
+ * stat and size requests without reaching the metadata backend.
+ */
+
+#ifndef GEKKOFS_DAEMON_METADATA_CACHE_HPP
+#define GEKKOFS_DAEMON_METADATA_CACHE_HPP
+
+#include <common/metadata.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace gkfs::utils {
+class Stats;
+} // namespace gkfs::utils
+
+namespace gkfs::metadata {
+
+/**
+ * @brief Bounded, sharded LRU cache of Metadata objects keyed by path.
+ * @internal
+ * The cache is write-through: every metadata operation that modifies an entry
+ * updates or evicts the cached object after the backend operation succeeded.
+ * Each shard holds an LRU list and an index into it. The shard lock is never
+ * held during a backend operation.
+ *
+ * Each shard carries an epoch that is incremented by every modification. The
+ * caller takes the epoch before the backend operation and passes it to the
+ * cache afterwards. If the epoch changed in the meantime, another modification
+ * of the shard finished concurrently and its order with respect to the
+ * caller's backend operation is unknown. The cache then evicts the entry
+ * instead of caching a possibly outdated object.
+ * @endinternal
+ */
+class MetadataCache {
+private:
+    using lru_list = std::list<std::pair<std::string, Metadata>>;
+
+    struct shard {
+        std::mutex mtx;
+        lru_list lru; //!< most recently used entry at the front
+        //! keys point to the path stored in the LRU list entry
+        std::unordered_map<std::string_view, lru_list::iterator> index;
+        uint64_t epoch{0}; //!< incremented on each modification
+    };
+
+    std::unique_ptr<shard[]> shards_;
+    size_t shard_count_;
+    size_t shard_capacity_;
+    std::shared_ptr<gkfs::utils::Stats> stats_;
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+
+    shard&
+    shard_for(const std::string& path) const;
+
+    /**
+     * @brief Inserts or replaces an entry and evicts the least recently used
+     * entry if the shard is full. Shard lock must be held.
+     */
+    void
+    insert_locked(shard& s, const std::string& path, const Metadata& md);
+
+    /**
+     * @brief Removes an entry if it exists. Shard lock must be held.
+     */
+    static void
+    erase_locked(shard& s, const std::string& path);
+
+public:
+    /**
+     * @brief Creates the cache.
+     * @param capacity Maximum number of cached entries in total
+     * @param shard_count Number of independently locked shards
+     * @param stats Optional stats collection for cache hit/miss counters
+     */
+    MetadataCache(size_t capacity, size_t shard_count,
+                  std::shared_ptr<gkfs::utils::Stats> stats = nullptr);
+
+    MetadataCache(const MetadataCache&) = delete;
+
+    MetadataCache&
+    operator=(const MetadataCache&) = delete;
+
+    /**
+     * @brief Looks up the metadata of a path.
+     * @param path
+     * @param md Set to the cached metadata on a hit
+     * @param epoch Set to the shard's epoch on a miss, to be passed to fill()
+     * @return true on a cache hit
+     */
+    bool
+    get(const std::string& path, Metadata& md, uint64_t& epoch);
+
+    /**
+     * @brief Returns the current epoch of the path's shard. Must be called
+     * before the backend operation of a modification.
+     * @param path
+     * @return epoch
+     */
+    uint64_t
+    epoch(const std::string& path);
+
+    /**
+     * @brief Caches metadata read from the backend after a miss. Nothing is
+     * cached if the shard was modified since `epoch` was taken.
+     * @param path
+     * @param md
+     * @param epoch Epoch returned by get()
+     */
+    void
+    fill(const std::string& path, const Metadata& md, uint64_t epoch);
+
+    /**
+     * @brief Caches metadata written to the backend, e.g., on create or
+     * update. The entry is evicted instead if the shard was modified since
+     * `epoch` was taken.
+     * @param path
+     * @param md
+     * @param epoch Epoch returned by epoch() before the backend operation
+     */
+    void
+    put(const std::string& path, const Metadata& md, uint64_t epoch);
+
+    /**
+     * @brief Applies a modification that was written to the backend, e.g., a
+     * size update, to a cached entry. Uncached entries are not loaded. The
+     * entry is evicted instead if the shard was modified since `epoch` was
+     * taken.
+     * @param path
+     * @param epoch Epoch returned by epoch() before the backend operation
+     * @param modify Modification to apply to the cached entry
+     */
+    void
+    update(const std::string& path, uint64_t epoch,
+           const std::function<void(Metadata&)>& modify);
+
+    /**
+     * @brief Mirrors a size increase that the backend merged into an entry,
+     * see MetadataDB::increase_size(). If the backend lost the offset reserved
+     * for an append, the resulting size is unknown and the entry is evicted.
+     * @param path
+     * @param epoch Epoch returned by epoch() before the backend operation
+     * @param io_size
+     * @param offset
+     * @param append
+     * @param start Starting offset returned by the backend for an append
+     */
+    void
+    increase_size(const std::string& path, uint64_t epoch, size_t io_size,
+                  off_t offset, bool append, off_t start);
+
+    /**
+     * @brief Mirrors a size decrease that the backend merged into an entry,
+     * see MetadataDB::decrease_size().
+     * @param path
+     * @param epoch Epoch returned by epoch() before the backend operation
+     * @param size
+     */
+    void
+    decrease_size(const std::string& path, uint64_t epoch, size_t size);
+
+    /**
+     * @brief Evicts an entry, e.g., on remove.
+     * @param path
+     */
+    void
+    erase(const std::string& path);
+
+    /**
+     * @brief Evicts all entries.
+     */
+    void
+    clear();
+
+    [[nodiscard]] uint64_t
+    hits() const;
+
+    [[nodiscard]] uint64_t
+    misses() const;
+};
+
+} // namespace gkfs::metadata
+
+#endif // GEKKOFS_DAEMON_METADATA_CACHE_HPP
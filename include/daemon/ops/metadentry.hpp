@@ -32,11 +32,15 @@
 #include <daemon/daemon.hpp>
 #include <common/metadata.hpp>
 
+#include <optional>
+#include <utility>
+#include <vector>
+
 namespace gkfs::metadata {
 
 /**
  * @brief Returns the metadata of an object at a specific path. The metadata can
- * be of dummy values if configured
+ * be of dummy values if configured. Served from the metadata cache if enabled
  * @param path
  * @param attr
  * @return
@@ -44,6 +48,16 @@ namespace gkfs::metadata {
 Metadata
 get(const std::string& path);
 
+/**
+ * @brief Returns the metadata of several objects. Entries that are not in the
+ * metadata cache are read from the backend with a single request
+ * @param paths
+ * @return metadata per path, std::nullopt if the object does not exist
+ * @throws DBException
+ */
+std::vector<std::optional<Metadata>>
+get_batch(const std::vector<std::string>& paths);
+
 /**
  * @brief Get metadentry string only for path
  * @param path
@@ -69,6 +83,19 @@ get_size(const std::string& path);
 std::vector<std::pair<std::string, bool>>
 get_dirents(const std::string& dir);
 
+/**
+ * @brief Returns one page of directory entries for given directory in name
+ * order
+ * @param dir
+ * @param start_key name of the last entry of the previous page, empty for the
+ * first page
+ * @param max_entries
+ * @return
+ */
+std::vector<std::pair<std::string, bool>>
+get_dirents_page(const std::string& dir, const std::string& start_key,
+                 size_t max_entries);
+
 /**
  * @brief Returns a vector of directory entries for given directory (extended
  * version)
@@ -87,6 +114,36 @@ get_dirents_extended(const std::string& dir);
 void
 create(const std::string& path, Metadata& md);
 
+/**
+ * @brief Creates metadata of several objects with the same mode with a single
+ * backend write
+ * @param paths
+ * @param mode
+ * @return error code per path, EEXIST if the object already exists
+ * @throws DBException
+ */
+std::vector<int>
+create_batch(const std::vector<std::string>& paths, mode_t mode);
+
+/**
+ * @brief Opens a metadentry with open() semantics. The entry is created if it
+ * doesn't exist and create is set. An existing regular file is truncated to
+ * size 0 if trunc is set. Links and renamed files are not truncated.
+ * @param path
+ * @param md metadata for a new entry, set to the metadata of the opened entry
+ * @param create
+ * @param excl fail if the entry exists
+ * @param trunc
+ * @return whether the entry was created and the file size before a
+ * truncation, 0 if the file was not truncated
+ * @throws NotFoundException if the entry doesn't exist and create is not set
+ * @throws ExistsException if the entry exists and excl is set
+ * @throws DBException
+ */
+std::pair<bool, size_t>
+open_or_create(const std::string& path, Metadata& md, bool create, bool excl,
+               bool trunc);
+
 /**
  * @brief Update metadentry by given Metadata object and path
  * @param path
@@ -107,6 +164,15 @@ update(const std::string& path, Metadata& md);
 off_t
 update_size(const std::string& path, size_t io_size, off_t offset, bool append);
 
+/**
+ * @brief Decreases a metadentry's size, e.g., before a truncate
+ * @param path
+ * @param size new size
+ * @throws gkfs::metadata::DBException
+ */
+void
+decrease_size(const std::string& path, size_t size);
+
 /**
  * @brief Remove metadentry if exists
  * @param path
@@ -116,6 +182,15 @@ update_size(const std::string& path, size_t io_size, off_t offset, bool append);
 void
 remove(const std::string& path);
 
+/**
+ * @brief Remove several metadentries with a single backend write. Paths that
+ * don't exist are ignored
+ * @param paths
+ * @throws gkfs::metadata::DBException
+ */
+void
+remove_batch(const std::vector<std::string>& paths);
+
 } // namespace gkfs::metadata
 
 #endif // GEKKOFS_METADENTRY_HPP
@@ -31,8 +31,12 @@
 #include <client/preload.hpp>
 #include <client/preload_util.hpp>
 #include <client/logging.hpp>
+#include <common/arithmetic/arithmetic.hpp>
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -180,6 +184,460 @@ WriteSizeCache::flush_threshold(size_t flush_threshold) {
     flush_threshold_ = flush_threshold;
 }
 
+ChunkCache::ChunkCache(size_t chunk_size, size_t max_size,
+                       uint64_t max_read_ahead)
+    : chunk_size_(chunk_size), max_size_(max_size),
+      max_read_ahead_(max_read_ahead) {}
+
+ChunkCache::file_entry&
+ChunkCache::add_file(const std::string& path) {
+    auto& file = files_[path];
+    file.generation = ++generation_;
+    return file;
+}
+
+long
+ChunkCache::read_cached(file_entry& file, char* buf, off64_t offset,
+                        size_t count) {
+    using gkfs::utils::arithmetic::block_index;
+    auto first_chunk = block_index(offset, chunk_size_);
+    auto last_chunk = block_index(offset + count - 1, chunk_size_);
+    // check first, so that a partial hit does not touch the LRU order
+    for(auto chunk_id = first_chunk; chunk_id <= last_chunk; chunk_id++) {
+        auto it = file.chunks.find(chunk_id);
+        if(it == file.chunks.end()) {
+            return -1;
+        }
+        if(it->second->data.size() < chunk_size_) {
+            // EOF is within this chunk. Later chunks are empty.
+            break;
+        }
+    }
+    size_t read = 0;
+    for(auto chunk_id = first_chunk; chunk_id <= last_chunk; chunk_id++) {
+        auto entry = file.chunks.at(chunk_id);
+        lru_.splice(lru_.begin(), lru_, entry);
+        auto& data = entry->data;
+        auto chunk_offset = chunk_id * chunk_size_;
+        auto start = std::max<uint64_t>(offset, chunk_offset) - chunk_offset;
+        if(start < data.size()) {
+            auto n = std::min(data.size() - start, count - read);
+            memcpy(buf + read, data.data() + start, n);
+            read += n;
+        }
+        if(data.size() < chunk_size_) {
+            break;
+        }
+    }
+    return static_cast<long>(read);
+}
+
+void
+ChunkCache::insert(const std::string& path, file_entry& file, const char* buf,
+                   uint64_t first_chunk, size_t read_size) {
+    for(size_t pos = 0; pos < read_size; pos += chunk_size_) {
+        auto chunk_id = first_chunk + pos / chunk_size_;
+        erase(file, chunk_id);
+        auto n = std::min(chunk_size_, read_size - pos);
+        lru_.push_front({path, chunk_id, std::vector<char>(buf + pos,
+                                                           buf + pos + n)});
+        file.chunks.emplace(chunk_id, lru_.begin());
+        size_ += n;
+    }
+    // evict least recently used chunks of any file
+    while(size_ > max_size_ && !lru_.empty()) {
+        auto victim_file = files_.find(lru_.back().path);
+        erase(victim_file->second, lru_.back().chunk_id);
+        if(victim_file->second.chunks.empty()) {
+            files_.erase(victim_file);
+        }
+    }
+}
+
+void
+ChunkCache::erase(file_entry& file, uint64_t chunk_id) {
+    auto it = file.chunks.find(chunk_id);
+    if(it == file.chunks.end()) {
+        return;
+    }
+    size_ -= it->second->data.size();
+    lru_.erase(it->second);
+    file.chunks.erase(it);
+}
+
+std::pair<int, long>
+ChunkCache::read(const std::string& path, char* buf, off64_t offset,
+                 size_t count, const fetch_fn& fetch) {
+    using gkfs::utils::arithmetic::block_index;
+    if(count == 0) {
+        return fetch(buf, offset, count);
+    }
+    auto first_chunk = block_index(offset, chunk_size_);
+    auto chunk_n = block_index(offset + count - 1, chunk_size_) -
+                   first_chunk + 1;
+    // the fetched chunks must fit into the cache
+    auto max_chunks = max_size_ / chunk_size_;
+    bool cacheable = chunk_n <= max_chunks;
+    uint64_t window = 0;
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> const lock(mtx_);
+        auto it = files_.find(path);
+        bool sequential;
+        if(it == files_.end()) {
+            // the first read of a file is sequential if it starts at 0
+            sequential = offset == 0;
+        } else {
+            auto& file = it->second;
+            sequential = offset == file.next_offset;
+            file.next_offset = offset + count;
+            auto read = read_cached(file, buf, offset, count);
+            if(read >= 0) {
+                hits_++;
+                return {0, read};
+            }
+            if(!sequential) {
+                file.read_ahead = 0;
+            }
+        }
+        misses_++;
+        if(!sequential || !cacheable) {
+            return fetch(buf, offset, count);
+        }
+        auto& file = it == files_.end() ? add_file(path) : it->second;
+        file.next_offset = offset + count;
+        file.read_ahead = file.read_ahead == 0
+                                  ? 1
+                                  : std::min(file.read_ahead * 2,
+                                             max_read_ahead_);
+        window = std::min(file.read_ahead, max_read_ahead_);
+        generation = file.generation;
+    }
+    chunk_n = std::min(chunk_n + window, max_chunks);
+
+    auto fetch_offset = first_chunk * chunk_size_;
+    auto fetch_size = chunk_n * chunk_size_;
+    LOG(DEBUG,
+        "ChunkCache::{}() path '{}' fetching '{}' chunks from chunk '{}' (read-ahead '{}')",
+        __func__, path, chunk_n, first_chunk, window);
+    // sparse chunks leave gaps in the buffer that must read as zeros
+    auto fetch_buf = std::unique_ptr<char[]>(new char[fetch_size]());
+    auto ret = fetch(fetch_buf.get(), fetch_offset, fetch_size);
+    // bytes beyond read_size are past EOF
+    size_t read_size = ret.first ? 0 : static_cast<size_t>(ret.second);
+    auto skip = offset - fetch_offset;
+    size_t read = 0;
+    if(read_size > skip) {
+        read = std::min(count, read_size - skip);
+        memcpy(buf, fetch_buf.get() + skip, read);
+    }
+
+    std::lock_guard<std::mutex> const lock(mtx_);
+    auto it = files_.find(path);
+    // do not cache data that a local modification made stale in the meantime
+    if(it == files_.end() || it->second.generation != generation) {
+        return {ret.first, static_cast<long>(read)};
+    }
+    if(read_size > 0) {
+        insert(path, it->second, fetch_buf.get(), first_chunk, read_size);
+        // eviction may have dropped the entry
+        it = files_.find(path);
+    }
+    if(it != files_.end() && it->second.chunks.empty()) {
+        files_.erase(it);
+    }
+    return {ret.first, static_cast<long>(read)};
+}
+
+void
+ChunkCache::invalidate(const std::string& path, off64_t offset, size_t count) {
+    using gkfs::utils::arithmetic::block_index;
+    std::lock_guard<std::mutex> const lock(mtx_);
+    auto it = files_.find(path);
+    if(it == files_.end()) {
+        return;
+    }
+    auto& file = it->second;
+    file.generation = ++generation_;
+    if(count == 0) {
+        return;
+    }
+    auto first_chunk = block_index(offset, chunk_size_);
+    auto last_chunk = block_index(offset + count - 1, chunk_size_);
+    if(last_chunk - first_chunk >= file.chunks.size()) {
+        // fewer cached chunks than chunks in the range
+        for(auto chunk = file.chunks.begin(); chunk != file.chunks.end();) {
+            auto chunk_id = (chunk++)->first;
+            if(chunk_id >= first_chunk && chunk_id <= last_chunk) {
+                erase(file, chunk_id);
+            }
+        }
+    } else {
+        for(auto chunk_id = first_chunk; chunk_id <= last_chunk; chunk_id++) {
+            erase(file, chunk_id);
+        }
+    }
+    // a write that extends the file changes a previously short EOF chunk
+    for(auto chunk = file.chunks.begin(); chunk != file.chunks.end();) {
+        auto chunk_id = chunk->first;
+        auto is_short = chunk->second->data.size() < chunk_size_;
+        chunk++;
+        if(chunk_id < first_chunk && is_short) {
+            erase(file, chunk_id);
+        }
+    }
+    if(file.chunks.empty()) {
+        files_.erase(it);
+    }
+}
+
+void
+ChunkCache::invalidate(const std::string& path) {
+    std::lock_guard<std::mutex> const lock(mtx_);
+    auto it = files_.find(path);
+    if(it == files_.end()) {
+        return;
+    }
+    for(auto chunk = it->second.chunks.begin();
+        chunk != it->second.chunks.end();) {
+        auto chunk_id = (chunk++)->first;
+        erase(it->second, chunk_id);
+    }
+    // fetches still in flight find a new generation if the entry is recreated
+    files_.erase(it);
+}
+
+void
+ChunkCache::clear() {
+    std::lock_guard<std::mutex> const lock(mtx_);
+    files_.clear();
+    lru_.clear();
+    size_ = 0;
+}
+
+size_t
+ChunkCache::size() {
+    std::lock_guard<std::mutex> const lock(mtx_);
+    return size_;
+}
+
+size_t
+ChunkCache::hits() {
+    std::lock_guard<std::mutex> const lock(mtx_);
+    return hits_;
+}
+
+size_t
+ChunkCache::misses() {
+    std::lock_guard<std::mutex> const lock(mtx_);
+    return misses_;
+}
+
+StatCache::StatCache(std::chrono::milliseconds ttl, size_t max_entries)
+    : ttl_(ttl), max_entries_(max_entries) {}
+
+void
+StatCache::erase(std::unordered_map<std::string, entry>::iterator it) {
+    ages_.erase(it->second.age);
+    entries_.erase(it);
+}
+
+std::optional<gkfs::metadata::Metadata>
+StatCache::get(const std::string& path) {
+    std::lock_guard<std::mutex> const lock(mtx_);
+    auto it = entries_.find(path);
+    if(it == entries_.end()) {
+        misses_++;
+        return {};
+    }
+    if(clock::now() >= it->second.expires) {
+        erase(it);
+        misses_++;
+        return {};
+    }
+    hits_++;
+    return it->second.md;
+}
+
+uint64_t
+StatCache::epoch() {
+    std::lock_guard<std::mutex> const lock(mtx_);
+    return epoch_;
+}
+
+void
+StatCache::insert(const std::string& path, const gkfs::metadata::Metadata& md,
+                  uint64_t epoch) {
+    std::lock_guard<std::mutex> const lock(mtx_);
+    if(epoch != epoch_ || max_entries_ == 0) {
+        return;
+    }
+    auto expires = clock::now() + ttl_;
+    auto it = entries_.find(path);
+    if(it != entries_.end()) {
+        it->second.md = md;
+        it->second.expires = expires;
+        return;
+    }
+    if(entries_.size() >= max_entries_) {
+        erase(entries_.find(ages_.front()));
+    }
+    ages_.push_back(path);
+    entries_.emplace(path, entry{md, expires, std::prev(ages_.end())});
+}
+
+void
+StatCache::invalidate(const std::string& path) {
+    std::lock_guard<std::mutex> const lock(mtx_);
+    epoch_++;
+    auto it = entries_.find(path);
+    if(it != entries_.end()) {
+        erase(it);
+    }
+}
+
+void
+StatCache::clear() {
+    std::lock_guard<std::mutex> const lock(mtx_);
+    epoch_++;
+    entries_.clear();
+    ages_.clear();
+}
+
+size_t
+StatCache::size() {
+    std::lock_guard<std::mutex> const lock(mtx_);
+    return entries_.size();
+}
+
+size_t
+StatCache::hits() {
+    std::lock_guard<std::mutex> const lock(mtx_);
+    return hits_;
+}
+
+size_t
+StatCache::misses() {
+    std::lock_guard<std::mutex> const lock(mtx_);
+    return misses_;
+}
+
 } // namespace file
 
+namespace buffer {
+
+RegistrationCache::RegistrationCache(size_t max_entries, size_t max_region_size)
+    : max_entries_(max_entries), max_region_size_(max_region_size) {}
+
+std::shared_ptr<hermes::exposed_memory>
+RegistrationCache::erase(std::map<key, entry>::iterator it) {
+    auto memory = std::move(it->second.memory);
+    ages_.erase(it->second.age);
+    entries_.erase(it);
+    if(entries_.empty()) {
+        empty_ = true;
+    }
+    return memory;
+}
+
+std::shared_ptr<hermes::exposed_memory>
+RegistrationCache::get(void* addr, size_t size, hermes::access_mode mode,
+                       const std::function<hermes::exposed_memory()>& expose) {
+    if(size > max_region_size_ || max_entries_ == 0) {
+        return std::make_shared<hermes::exposed_memory>(expose());
+    }
+    auto k = std::make_tuple(reinterpret_cast<uintptr_t>(addr), size, mode);
+    uint64_t epoch;
+    {
+        std::lock_guard<std::mutex> const lock(mtx_);
+        auto it = entries_.find(k);
+        if(it != entries_.end()) {
+            ages_.splice(ages_.end(), ages_, it->second.age);
+            hits_++;
+            return it->second.memory;
+        }
+        misses_++;
+        epoch = epoch_;
+    }
+    // exposing is expensive and must not block other lookups
+    auto memory = std::make_shared<hermes::exposed_memory>(expose());
+
+    // unexposing as well, so it happens after unlocking
+    std::shared_ptr<hermes::exposed_memory> evicted;
+    std::lock_guard<std::mutex> const lock(mtx_);
+    if(entries_.count(k) != 0) {
+        // inserted by another thread in the meantime
+        return memory;
+    }
+    // Mark the cache as non-empty before checking the epoch. An invalidation
+    // that increases the epoch after the check sees the new entry.
+    empty_ = false;
+    if(epoch != epoch_) {
+        // the buffer may have been unmapped while it was exposed
+        empty_ = entries_.empty();
+        return memory;
+    }
+    if(entries_.size() >= max_entries_) {
+        evicted = erase(entries_.find(ages_.front()));
+        empty_ = false;
+    }
+    ages_.push_back(k);
+    entries_.emplace(k, entry{memory, std::prev(ages_.end())});
+    return memory;
+}
+
+void
+RegistrationCache::invalidate(uintptr_t addr, size_t size) {
+    // called for every munmap() of the application
+    epoch_++;
+    if(empty_ || size == 0) {
+        return;
+    }
+    std::vector<std::shared_ptr<hermes::exposed_memory>> invalidated;
+    std::lock_guard<std::mutex> const lock(mtx_);
+    auto end = addr + std::min(size, UINTPTR_MAX - addr);
+    // cached buffers are at most max_region_size_ bytes long, so no entry
+    // that starts further below can reach into the range
+    auto first = addr - std::min(addr, max_region_size_);
+    auto it = entries_.lower_bound(
+            std::make_tuple(first, size_t{0}, hermes::access_mode{}));
+    while(it != entries_.end() && std::get<0>(it->first) < end) {
+        auto start = std::get<0>(it->first);
+        if(start + std::get<1>(it->first) > addr) {
+            invalidated.push_back(erase(it++));
+        } else {
+            ++it;
+        }
+    }
+}
+
+void
+RegistrationCache::clear() {
+    std::lock_guard<std::mutex> const lock(mtx_);
+    epoch_++;
+    entries_.clear();
+    ages_.clear();
+    empty_ = true;
+}
+
+size_t
+RegistrationCache::size() {
+    std::lock_guard<std::mutex> const lock(mtx_);
+    return entries_.size();
+}
+
+size_t
+RegistrationCache::hits() {
+    std::lock_guard<std::mutex> const lock(mtx_);
+    return hits_;
+}
+
+size_t
+RegistrationCache::misses() {
+    std::lock_guard<std::mutex> const lock(mtx_);
+    return misses_;
+}
+
+} // namespace buffer
+
 } // namespace gkfs::cache
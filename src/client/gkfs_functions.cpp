@@ -40,13 +40,22 @@
 #include <client/cache.hpp>
 
 #include <common/path_util.hpp>
+#include <common/rpc/distributor.hpp>
 #ifdef GKFS_ENABLE_CLIENT_METRICS
 #include <common/msgpack_util.hpp>
 #endif
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 extern "C" {
 #include <dirent.h> // used for file types in the getdents{,64}() functions
+#include <limits.h>
 #include <linux/kernel.h> // used for definition of alignment macros
 #include <sys/statfs.h>
 #include <sys/statvfs.h>
@@ -96,32 +105,762 @@ struct dirent_extended {
 
 namespace {
 
+/*
+ * Parent directories that recently passed the existence check of a create,
+ * mapped to the time their entry expires. Entries are dropped when this client
+ * removes the directory.
+ */
+std::mutex parent_check_mutex;
+std::unordered_map<std::string, std::chrono::steady_clock::time_point>
+        parent_check_cache;
+
+/**
+ * Checks if metadata for parent directory exists (can be disabled with
+ * GKFS_CREATE_CHECK_PARENTS). Successful checks are cached for
+ * parent_check_cache_ttl seconds. errno may be set
+ * @param path
+ * @return 0 on success, -1 on failure
+ */
+int
+check_parent_dir(const std::string& path) {
+#if GKFS_CREATE_CHECK_PARENTS
+    constexpr auto ttl = std::chrono::seconds(
+            gkfs::config::metadata::parent_check_cache_ttl);
+    auto p_comp = gkfs::path::dirname(path);
+    if(ttl.count() > 0) {
+        lock_guard<mutex> lock(parent_check_mutex);
+        auto it = parent_check_cache.find(p_comp);
+        if(it != parent_check_cache.end()) {
+            if(std::chrono::steady_clock::now() < it->second) {
+                return 0;
+            }
+            parent_check_cache.erase(it);
+        }
+    }
+    auto md = gkfs::utils::get_metadata(p_comp);
+    if(!md) {
+        if(errno == ENOENT) {
+            LOG(DEBUG, "Parent component does not exist: '{}'", p_comp);
+        } else {
+            LOG(ERROR, "Failed to get metadata for parent component '{}': {}",
+                path, strerror(errno));
+        }
+        return -1;
+    }
+    if(!S_ISDIR(md->mode())) {
+        LOG(DEBUG, "Parent component is not a directory: '{}'", p_comp);
+        errno = ENOTDIR;
+        return -1;
+    }
+    if(ttl.count() > 0) {
+        lock_guard<mutex> lock(parent_check_mutex);
+        if(parent_check_cache.size() >=
+           gkfs::config::metadata::parent_check_cache_size) {
+            parent_check_cache.clear();
+        }
+        parent_check_cache[p_comp] = std::chrono::steady_clock::now() + ttl;
+    }
+#endif // GKFS_CREATE_CHECK_PARENTS
+    return 0;
+}
+
+/**
+ * Drops a removed directory from the parent check cache
+ * @param path
+ */
+void
+forget_parent_dir(const std::string& path) {
+    lock_guard<mutex> lock(parent_check_mutex);
+    parent_check_cache.erase(path);
+}
+
+/**
+ * Drops a path from the stat cache after it was modified by this client
+ * @param path
+ */
+void
+invalidate_stat(const std::string& path) {
+    if(CTX->use_stat_cache()) {
+        CTX->stat_cache()->invalidate(path);
+    }
+}
+
+/**
+ * Fills the stat cache with the entries of a directory listing. Only the file
+ * type, size, and ctime of an entry are known.
+ * @param dir
+ * @param entries
+ * @param epoch stat cache epoch taken before the listing was requested
+ */
+void
+prefill_stat_cache(
+        const std::string& dir,
+        const std::vector<std::tuple<const std::string, bool, size_t, time_t>>&
+                entries,
+        uint64_t epoch) {
+    for(const auto& [name, is_dir, size, ctime] : entries) {
+        gkfs::metadata::Metadata md{};
+        md.mode(is_dir ? gkfs::config::syscall::stat::dir_mode_default
+                       : gkfs::config::syscall::stat::file_mode_default);
+        md.size(size);
+        md.ctime(ctime);
+        auto path = dir == "/" ? dir + name
+                               : gkfs::path::prepend_path(dir, name.c_str());
+        CTX->stat_cache()->insert(path, md, epoch);
+    }
+}
+
+/**
+ * Checks the file type of a mode for a create request. Regular files are
+ * assumed if no file type is given.
+ * @param mode
+ * @return 0 on success, errno otherwise
+ */
+int
+check_create_mode(mode_t& mode) {
+    switch(mode & S_IFMT) {
+        case 0:
+            mode |= S_IFREG;
+            return 0;
+        case S_IFREG: // intentionally fall-through
+        case S_IFDIR:
+            return 0;
+        case S_IFCHR: // intentionally fall-through
+        case S_IFBLK:
+        case S_IFIFO:
+        case S_IFSOCK:
+            LOG(WARNING, "Unsupported node type");
+            return ENOTSUP;
+        default:
+            LOG(WARNING, "Unrecognized node type");
+            return EINVAL;
+    }
+}
+
+/**
+ * Creates the metadata of several paths on all replicas with batched RPCs
+ * @param paths
+ * @param mode
+ * @return error code per path. A path is created if at least one replica
+ * succeeds
+ */
+std::vector<int>
+create_batch(const std::vector<std::string>& paths, mode_t mode) {
+    std::vector<int> errs(paths.size(), 0);
+    std::vector<bool> success(paths.size(), false);
+    for(auto copy = 0; copy < CTX->get_replicas() + 1; copy++) {
+        auto copy_errs = gkfs::rpc::forward_create_batch(paths, mode, copy);
+        for(size_t i = 0; i < paths.size(); i++) {
+            if(copy_errs[i]) {
+                errs[i] = copy_errs[i];
+            } else {
+                success[i] = true;
+            }
+        }
+    }
+    for(size_t i = 0; i < paths.size(); i++) {
+        if(success[i])
+            errs[i] = 0;
+        invalidate_stat(paths[i]);
+    }
+    return errs;
+}
+
+/*
+ * Creates of open(O_CREAT) calls deferred in asynchronous create mode. They are
+ * sent with batched create RPCs when async_create_batch_size creates are
+ * queued, before another operation accesses a queued path, or on exit.
+ */
+struct deferred_create {
+    std::string path;
+    mode_t mode;
+    int flags;
+};
+
+std::mutex deferred_creates_mutex;
+std::condition_variable deferred_creates_sent;
+std::vector<deferred_create> deferred_creates; // queued, not sent yet
+// paths of queued creates mapped to whether they are being sent
+std::unordered_map<std::string, bool> deferred_create_paths;
+size_t deferred_creates_sending = 0;
+// queued creates and creates being sent, read without the mutex by I/O paths
+std::atomic<size_t> deferred_create_n{0};
+
+/**
+ * Finishes a deferred create whose file already existed. open() would have
+ * opened the existing file, so only O_EXCL and O_TRUNC need to be applied.
+ * errno may be set
+ * @param create
+ * @return 0 on success, -1 on failure
+ */
+int
+finish_existing_create(const deferred_create& create) {
+    if(create.flags & O_EXCL) {
+        errno = EEXIST;
+        return -1;
+    }
+    auto md = gkfs::utils::get_metadata(create.path);
+    if(!md) {
+        return -1;
+    }
+    if(!S_ISREG(md->mode())) {
+        errno = EISDIR;
+        return -1;
+    }
+#ifdef HAS_SYMLINKS
+    // the existing file can't be followed after its fd was handed out
+    if(md->is_link() || md->blocks() == -1) {
+        errno = ENOTSUP;
+        return -1;
+    }
+#endif // HAS_SYMLINKS
+    if((create.flags & O_TRUNC) &&
+       ((create.flags & O_RDWR) || (create.flags & O_WRONLY))) {
+        return gkfs::syscall::gkfs_truncate(create.path, md->size(), 0);
+    }
+    return 0;
+}
+
+/**
+ * Sends a batch of deferred creates. Creates that fail are logged.
+ * @param creates
+ * @param path path whose create result is returned, empty for all paths
+ * @return 0 on success, errno of the failed create of path (or any create)
+ */
+int
+send_deferred_creates(const std::vector<deferred_create>& creates,
+                      const std::string& path) {
+    std::map<mode_t, std::vector<size_t>> by_mode;
+    for(size_t i = 0; i < creates.size(); i++) {
+        by_mode[creates[i].mode].push_back(i);
+    }
+    std::vector<int> errs(creates.size(), 0);
+    for(const auto& [mode, idxs] : by_mode) {
+        std::vector<std::string> paths;
+        paths.reserve(idxs.size());
+        for(auto i : idxs) {
+            paths.push_back(creates[i].path);
+        }
+        auto mode_errs = create_batch(paths, mode);
+        for(size_t j = 0; j < idxs.size(); j++) {
+            errs[idxs[j]] = mode_errs[j];
+        }
+    }
+
+    auto err = 0;
+    for(size_t i = 0; i < creates.size(); i++) {
+        if(errs[i] == EEXIST) {
+            errs[i] = finish_existing_create(creates[i]) ? errno : 0;
+        }
+        if(errs[i] == 0) {
+            continue;
+        }
+        LOG(ERROR, "{}() Deferred create of '{}' failed: '{}'", __func__,
+            creates[i].path, strerror(errs[i]));
+        if(path.empty() || creates[i].path == path) {
+            err = errs[i];
+        }
+    }
+    return err;
+}
+
+/**
+ * Sends the queued deferred creates without holding deferred_creates_mutex
+ * during the RPCs. A create of path that another thread is sending is waited
+ * for. errno may be set
+ * @param path path whose create result is returned, empty for all paths. If
+ * empty, creates sent by other threads are waited for as well.
+ * @return 0 on success, -1 if the create of path (or any create) failed
+ */
+int
+flush_deferred_creates(const std::string& path) {
+    std::vector<deferred_create> creates;
+    {
+        unique_lock<mutex> lock(deferred_creates_mutex);
+        if(!path.empty()) {
+            deferred_creates_sent.wait(lock, [&path] {
+                auto it = deferred_create_paths.find(path);
+                return it == deferred_create_paths.end() || !it->second;
+            });
+            if(deferred_create_paths.count(path) == 0) {
+                return 0;
+            }
+        }
+        creates.swap(deferred_creates);
+        for(const auto& create : creates) {
+            deferred_create_paths[create.path] = true;
+        }
+        deferred_creates_sending += creates.size();
+    }
+    auto err = creates.empty() ? 0 : send_deferred_creates(creates, path);
+    {
+        unique_lock<mutex> lock(deferred_creates_mutex);
+        for(const auto& create : creates) {
+            auto it = deferred_create_paths.find(create.path);
+            if(it != deferred_create_paths.end() && it->second) {
+                deferred_create_paths.erase(it);
+            }
+        }
+        deferred_creates_sending -= creates.size();
+        deferred_create_n -= creates.size();
+        deferred_creates_sent.notify_all();
+        if(path.empty()) {
+            deferred_creates_sent.wait(
+                    lock, [] { return deferred_creates_sending == 0; });
+        }
+    }
+    if(err) {
+        errno = err;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Defers the create of an open(O_CREAT) call in asynchronous create mode and
+ * opens the file. errno may be set
+ * @param path
+ * @param mode
+ * @param flags
+ * @return fd on success, -1 on failure
+ */
+int
+defer_create(const std::string& path, mode_t mode, int flags) {
+    if(check_parent_dir(path)) {
+        return -1;
+    }
+    bool batch_full;
+    {
+        lock_guard<mutex> lock(deferred_creates_mutex);
+        deferred_creates.push_back({path, mode, flags});
+        deferred_create_paths[path] = false;
+        deferred_create_n++;
+        invalidate_stat(path);
+        const auto batch_size = static_cast<size_t>(
+                gkfs::config::metadata::async_create_batch_size);
+        batch_full = deferred_creates.size() >= batch_size;
+    }
+    if(batch_full) {
+        // failed creates of the batch are logged
+        flush_deferred_creates(path);
+    }
+    return CTX->file_map()->add(
+            std::make_shared<gkfs::filemap::OpenFile>(path, flags));
+}
+
+/**
+ * Creates, stats, and truncates the metadata of an open() call with a single
+ * RPC to the file's daemon. The parent directory is checked before a create.
+ * A created file is also created on the other metadata replicas and the data
+ * chunks of a truncated file are removed. errno may be set
+ * @param path
+ * @param mode
+ * @param flags
+ * @param md set to the metadata of the opened file
+ * @param created set if the file was created
+ * @return 0 on success, -1 on failure
+ */
+int
+open_metadentry(const std::string& path, mode_t mode, int flags,
+                gkfs::metadata::Metadata& md, bool& created) {
+    const bool create = flags & O_CREAT;
+    const bool trunc =
+            (flags & O_TRUNC) && ((flags & O_RDWR) || (flags & O_WRONLY));
+    if(create && check_parent_dir(path)) {
+        return -1;
+    }
+    std::string attr;
+    int64_t trunc_size = 0;
+    auto err = gkfs::rpc::forward_open_metadentry(
+            path, mode, create, flags & O_EXCL, trunc, attr, created,
+            trunc_size, 0);
+    if(err) {
+        LOG(DEBUG, "Failed to open metadata of '{}': '{}'", path,
+            strerror(err));
+        errno = err;
+        return -1;
+    }
+    md = gkfs::metadata::Metadata(attr);
+    if(created || trunc_size > 0) {
+        invalidate_stat(path);
+    }
+    for(auto copy = 1; copy < CTX->get_replicas() + 1; copy++) {
+        if(created) {
+            err = gkfs::rpc::forward_create(path, mode, copy);
+        } else if(trunc_size > 0) {
+            err = gkfs::rpc::forward_decr_size(path, 0, copy);
+        }
+        if(err) {
+            LOG(WARNING, "Failed to update metadata replica {} of '{}': '{}'",
+                copy, path, strerror(err));
+        }
+    }
+    if(trunc_size > 0) {
+        if(CTX->use_chunk_cache()) {
+            CTX->chunk_cache()->invalidate(path);
+        }
+        err = gkfs::rpc::forward_truncate(path, trunc_size, 0,
+                                          CTX->get_replicas());
+        if(err) {
+            LOG(DEBUG, "Failed to truncate data");
+            errno = err;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Sums up the lengths of a scatter/gather list. errno may be set
+ * @param iov
+ * @param iovcnt
+ * @return total size or -1 if the list is invalid
+ */
+ssize_t
+iov_size(const struct iovec* iov, int iovcnt) {
+    if(iovcnt < 0 || iovcnt > IOV_MAX) {
+        errno = EINVAL;
+        return -1;
+    }
+    size_t count = 0;
+    for(int i = 0; i < iovcnt; i++) {
+        if(iov[i].iov_len > static_cast<size_t>(SSIZE_MAX) - count) {
+            errno = EINVAL;
+            return -1;
+        }
+        count += iov[i].iov_len;
+    }
+    return static_cast<ssize_t>(count);
+}
+
+/**
+ * Copies a scatter/gather list into one contiguous buffer
+ * @param iov
+ * @param iovcnt
+ * @param count sum of all iov_len
+ * @return contiguous buffer of `count` bytes
+ */
+unique_ptr<char[]>
+gather_iov(const struct iovec* iov, int iovcnt, size_t count) {
+    auto buf = make_unique<char[]>(count);
+    size_t pos = 0;
+    for(int i = 0; i < iovcnt; i++) {
+        memcpy(buf.get() + pos, iov[i].iov_base, iov[i].iov_len);
+        pos += iov[i].iov_len;
+    }
+    return buf;
+}
+
+/**
+ * Copies the first `count` bytes of a contiguous buffer into a scatter/gather
+ * list
+ * @param buf
+ * @param count
+ * @param iov
+ * @param iovcnt
+ */
+void
+scatter_iov(const char* buf, size_t count, const struct iovec* iov,
+            int iovcnt) {
+    for(int i = 0; i < iovcnt && count > 0; i++) {
+        auto len = std::min(count, iov[i].iov_len);
+        memcpy(iov[i].iov_base, buf, len);
+        buf += len;
+        count -= len;
+    }
+}
+
+/**
+ * Writes data from a scatter/gather list to the daemons as a single write and
+ * updates the file size once. errno may be set
+ * @param path
+ * @param iov
+ * @param iovcnt
+ * @param count sum of all iov_len
+ * @param offset is set to the write's actual offset for appends
+ * @param is_append
+ * @param app_buffer true if the application owns the buffers
+ * @return written size or -1 on error
+ */
+ssize_t
+write_to_daemons(const std::string& path, const struct iovec* iov, int iovcnt,
+                 size_t count, off64_t& offset, bool is_append,
+                 bool app_buffer) {
+    if(CTX->use_async_create() &&
+       gkfs::syscall::gkfs_flush_creates(path) == -1) {
+        return -1;
+    }
+    int err;
+    auto write_size = 0;
+    auto num_replicas = CTX->get_replicas();
+    // pending size update that is joined after the data was written
+    std::function<pair<int, off64_t>()> size_update{};
+    if(CTX->use_write_size_cache() && !is_append) {
+        auto [size_update_cnt, cached_size] =
+                CTX->write_size_cache()->record(path, offset + count);
+        if(size_update_cnt > CTX->write_size_cache()->flush_threshold()) {
+            err = CTX->write_size_cache()->flush(path, false).first;
+            if(err) {
+                LOG(ERROR,
+                    "update_metadentry_size() during cache flush failed with err '{}'",
+                    err);
+                errno = err;
+                return -1;
+            }
+        }
+    } else if(CTX->use_async_size_update() && !is_append) {
+        // The size update does not influence the data RPCs for non-append
+        // writes. Thus, it is sent concurrently and joined before returning.
+        size_update = gkfs::utils::update_file_size_async(path, count, offset);
+    } else {
+        auto ret_offset =
+                gkfs::utils::update_file_size(path, count, offset, is_append);
+        err = ret_offset.first;
+        if(err) {
+            LOG(ERROR, "update_metadentry_size() failed with err '{}'", err);
+            errno = err;
+            return -1;
+        }
+        if(is_append) {
+            // When append is set the EOF is set to the offset
+            // forward_update_metadentry_size returns. This is because it is an
+            // atomic operation on the server and reserves the space for this
+            // append
+            if(ret_offset.second == -1) {
+                LOG(ERROR,
+                    "update_metadentry_size() received -1 as starting offset. "
+                    "This occurs when the daemon lost the offset it reserved "
+                    "for the append or could not load the file size.");
+                errno = EIO;
+                return -1;
+            }
+            offset = ret_offset.second;
+        }
+    }
+
+    pair<int, long> ret_write;
+    if(gkfs::config::proxy::fwd_io && CTX->use_proxy() &&
+       count > gkfs::config::proxy::fwd_io_count_threshold) {
+        if(iovcnt == 1) {
+            ret_write = gkfs::rpc::forward_write_proxy(path, iov[0].iov_base,
+                                                       offset, count);
+        } else {
+            // the proxy protocol only carries a single buffer
+            auto buf = gather_iov(iov, iovcnt, count);
+            ret_write = gkfs::rpc::forward_write_proxy(path, buf.get(), offset,
+                                                       count);
+        }
+    } else {
+        ret_write = gkfs::rpc::forward_write(path, iov, iovcnt, offset, count,
+                                             0, app_buffer);
+    }
+    err = ret_write.first;
+    write_size = ret_write.second;
+
+    if(num_replicas > 0) {
+        auto ret_write_repl = gkfs::rpc::forward_write(
+                path, iov, iovcnt, offset, count, num_replicas, app_buffer);
+
+        if(err and ret_write_repl.first == 0) {
+            // We succesfully write the data to some replica
+            err = ret_write_repl.first;
+            // Write size will be wrong
+            write_size = ret_write_repl.second;
+        }
+    }
+
+    // always join a pending size update, also if the data path failed
+    auto size_err = size_update ? size_update().first : 0;
+    if(CTX->use_chunk_cache()) {
+        CTX->chunk_cache()->invalidate(path, offset, count);
+    }
+    invalidate_stat(path);
+
+    if(err) {
+        LOG(WARNING, "gkfs::rpc::forward_write() failed with err '{}'", err);
+        errno = err;
+        return -1;
+    }
+    if(size_err) {
+        LOG(ERROR, "update_metadentry_size() failed with err '{}'", size_err);
+        errno = size_err;
+        return -1;
+    }
+    if(static_cast<size_t>(write_size) != count) {
+        LOG(WARNING,
+            "gkfs::rpc::forward_write() wrote '{}' bytes instead of '{}'",
+            write_size, count);
+    }
+    return write_size; // return written size
+}
+
+/**
+ * Writes data to the daemons and updates the file size. errno may be set
+ * @param path
+ * @param buf
+ * @param count
+ * @param offset is set to the write's actual offset for appends
+ * @param is_append
+ * @param app_buffer true if the application owns the buffer
+ * @return written size or -1 on error
+ */
+ssize_t
+write_to_daemons(const std::string& path, const char* buf, size_t count,
+                 off64_t& offset, bool is_append, bool app_buffer) {
+    struct iovec iov = {const_cast<char*>(buf), count};
+    return write_to_daemons(path, &iov, 1, count, offset, is_append,
+                            app_buffer);
+}
+
 /**
- * Checks if metadata for parent directory exists (can be disabled with
- * GKFS_CREATE_CHECK_PARENTS). errno may be set
+ * Reads data from the daemons into a scatter/gather list as a single read
  * @param path
- * @return 0 on success, -1 on failure
+ * @param iov
+ * @param iovcnt
+ * @param offset
+ * @param count sum of all iov_len
+ * @param app_buffer true if the application owns the buffers
+ * @return error code and read size
  */
-int
-check_parent_dir(const std::string& path) {
-#if GKFS_CREATE_CHECK_PARENTS
-    auto p_comp = gkfs::path::dirname(path);
-    auto md = gkfs::utils::get_metadata(p_comp);
-    if(!md) {
-        if(errno == ENOENT) {
-            LOG(DEBUG, "Parent component does not exist: '{}'", p_comp);
+pair<int, long>
+read_from_daemons(const std::string& path, const struct iovec* iov, int iovcnt,
+                  off64_t offset, size_t count, bool app_buffer) {
+    if(CTX->use_async_create() &&
+       gkfs::syscall::gkfs_flush_creates(path) == -1) {
+        return make_pair(errno, 0);
+    }
+    // Zeroing buffer before read is only relevant for sparse files. Otherwise
+    // sparse regions contain invalid data.
+    if constexpr(gkfs::config::io::zero_buffer_before_read) {
+        for(int i = 0; i < iovcnt; i++) {
+            memset(iov[i].iov_base, 0, sizeof(char) * iov[i].iov_len);
+        }
+    }
+
+    pair<int, long> ret;
+    if(gkfs::config::proxy::fwd_io && CTX->use_proxy() &&
+       count > gkfs::config::proxy::fwd_io_count_threshold) {
+        if(iovcnt == 1) {
+            ret = gkfs::rpc::forward_read_proxy(path, iov[0].iov_base, offset,
+                                                count);
         } else {
-            LOG(ERROR, "Failed to get metadata for parent component '{}': {}",
-                path, strerror(errno));
+            // the proxy protocol only carries a single buffer
+            auto buf = make_unique<char[]>(count);
+            ret = gkfs::rpc::forward_read_proxy(path, buf.get(), offset, count);
+            if(ret.second > 0) {
+                scatter_iov(buf.get(), ret.second, iov, iovcnt);
+            }
+        }
+    } else {
+        std::set<int8_t> failed; // set with failed targets.
+        if(CTX->get_replicas() != 0) {
+
+            ret = gkfs::rpc::forward_read(path, iov, iovcnt, offset, count,
+                                          CTX->get_replicas(), failed,
+                                          app_buffer);
+            while(ret.first == EIO) {
+                ret = gkfs::rpc::forward_read(path, iov, iovcnt, offset, count,
+                                              CTX->get_replicas(), failed,
+                                              app_buffer);
+                LOG(WARNING, "gkfs::rpc::forward_read() failed with ret '{}'",
+                    ret.first);
+            }
+
+        } else {
+            ret = gkfs::rpc::forward_read(path, iov, iovcnt, offset, count, 0,
+                                          failed, app_buffer);
         }
+    }
+    return ret;
+}
+
+/**
+ * Reads data from the daemons
+ * @param path
+ * @param buf
+ * @param offset
+ * @param count
+ * @param app_buffer true if the application owns the buffer
+ * @return error code and read size
+ */
+pair<int, long>
+read_from_daemons(const std::string& path, char* buf, off64_t offset,
+                  size_t count, bool app_buffer) {
+    struct iovec iov = {buf, count};
+    return read_from_daemons(path, &iov, 1, offset, count, app_buffer);
+}
+
+/**
+ * Writes the content of a file's write-back buffer to the daemons. The caller
+ * must hold the buffer's mutex. The buffer is empty afterwards, also on error.
+ * errno may be set
+ * @param file
+ * @return 0 on success, -1 on failure
+ */
+int
+flush_write_back_locked(const gkfs::filemap::OpenFile& file) {
+    auto& write_back = file.write_back();
+    if(write_back.empty()) {
+        return 0;
+    }
+    off64_t offset = write_back.offset();
+    auto count = write_back.size();
+    LOG(DEBUG, "{}() path: '{}', count: '{}', offset: '{}'", __func__,
+        file.path(), count, offset);
+    auto written = write_to_daemons(file.path(), write_back.data(), count,
+                                    offset, false, false);
+    write_back.clear();
+    if(written < 0) {
         return -1;
     }
-    if(!S_ISDIR(md->mode())) {
-        LOG(DEBUG, "Parent component is not a directory: '{}'", p_comp);
-        errno = ENOTDIR;
+    if(static_cast<size_t>(written) != count) {
+        LOG(ERROR, "{}() wrote '{}' bytes instead of '{}'", __func__, written,
+            count);
+        errno = EIO;
         return -1;
     }
-#endif // GKFS_CREATE_CHECK_PARENTS
+    return 0;
+}
+
+/**
+ * Writes the content of a file's write-back buffer to the daemons.
+ * errno may be set
+ * @param file
+ * @return 0 on success, -1 on failure
+ */
+int
+flush_write_back(const gkfs::filemap::OpenFile& file) {
+    if(!CTX->use_write_back_buffer() ||
+       file.type() != gkfs::filemap::FileType::regular) {
+        return 0;
+    }
+    lock_guard<mutex> lock(file.write_back().mutex());
+    return flush_write_back_locked(file);
+}
+
+/**
+ * Makes sure that the entry at `pos` of a paged directory is loaded, fetching
+ * further pages from the daemons once the loaded entries are consumed. Only
+ * the last fetched pages are held in memory.
+ * @param open_dir
+ * @param pos position of the next entry to read
+ * @return error code. If the directory has no entry at `pos`, it is complete
+ * and `pos >= open_dir.size()`
+ */
+int
+load_dirents(gkfs::filemap::OpenDir& open_dir, unsigned long pos) {
+    if(pos < open_dir.offset()) {
+        // the position was moved back, e.g., by rewinddir(). Start over.
+        open_dir.begin_paging(
+                CTX->distributor()->locate_directory_metadata().size());
+    }
+    while(pos >= open_dir.size() && !open_dir.complete()) {
+        open_dir.drop_entries();
+        auto err = gkfs::rpc::forward_get_dirents(open_dir);
+        if(err != 0) {
+            return err;
+        }
+    }
     return 0;
 }
 
@@ -145,6 +884,9 @@ gkfs_open(const std::string& path, mode_t mode, int flags) {
         errno = ENOTSUP;
         return -1;
     }
+    if(CTX->use_async_create() && gkfs_flush_creates(path) == -1) {
+        return -1;
+    }
 
     // metadata object filled during create or stat
     gkfs::metadata::Metadata md{};
@@ -154,6 +896,23 @@ gkfs_open(const std::string& path, mode_t mode, int flags) {
             errno = ENOTSUP;
             return -1;
         }
+        if(CTX->use_async_create() &&
+           !(gkfs::config::proxy::fwd_create && CTX->use_proxy())) {
+            return defer_create(path, mode | S_IFREG, flags);
+        }
+    }
+    if(gkfs::config::metadata::use_open_rpc && !CTX->use_proxy() &&
+       (flags & (O_CREAT | O_TRUNC))) {
+        // create, stat, and truncate with one RPC
+        bool created = false;
+        if(open_metadentry(path, mode | S_IFREG, flags, md, created)) {
+            return -1;
+        }
+        if(created) {
+            return CTX->file_map()->add(
+                    std::make_shared<gkfs::filemap::OpenFile>(path, flags));
+        }
+    } else if(flags & O_CREAT) {
         // no access check required here. If one is using our FS they have the
         // permissions.
         auto err = gkfs_create(path, mode | S_IFREG);
@@ -283,30 +1042,15 @@ int
 gkfs_create(const std::string& path, mode_t mode) {
 
     // file type must be set
-    switch(mode & S_IFMT) {
-        case 0:
-            mode |= S_IFREG;
-            break;
-        case S_IFREG: // intentionally fall-through
-        case S_IFDIR:
-            break;
-        case S_IFCHR: // intentionally fall-through
-        case S_IFBLK:
-        case S_IFIFO:
-        case S_IFSOCK:
-            LOG(WARNING, "Unsupported node type");
-            errno = ENOTSUP;
-            return -1;
-        default:
-            LOG(WARNING, "Unrecognized node type");
-            errno = EINVAL;
-            return -1;
+    int err = check_create_mode(mode);
+    if(err) {
+        errno = err;
+        return -1;
     }
 
     if(check_parent_dir(path)) {
         return -1;
     }
-    int err = 0;
     if(gkfs::config::proxy::fwd_create && CTX->use_proxy()) {
         // no replication support for proxy
         err = gkfs::rpc::forward_create_proxy(path, mode);
@@ -330,6 +1074,7 @@ gkfs_create(const std::string& path, mode_t mode) {
             return -1;
         }
     }
+    invalidate_stat(path);
     return 0;
 }
 
@@ -341,6 +1086,15 @@ gkfs_create(const std::string& path, mode_t mode) {
  */
 int
 gkfs_remove(const std::string& path) {
+    if(CTX->use_async_create() && gkfs_flush_creates(path) == -1) {
+        return -1;
+    }
+    if(CTX->use_write_back_buffer() && gkfs_flush_write_back(path) == -1) {
+        return -1;
+    }
+    if(CTX->use_chunk_cache()) {
+        CTX->chunk_cache()->invalidate(path);
+    }
 #ifdef HAS_SYMLINKS
 #ifdef HAS_RENAME
     auto md = gkfs::utils::get_metadata(path);
@@ -369,6 +1123,7 @@ gkfs_remove(const std::string& path) {
             }
             auto err = gkfs::rpc::forward_remove(new_path, false,
                                                  CTX->get_replicas());
+            invalidate_stat(new_path);
             if(err) {
                 errno = err;
                 return -1;
@@ -383,6 +1138,7 @@ gkfs_remove(const std::string& path) {
     } else {
         err = gkfs::rpc::forward_remove(path, false, CTX->get_replicas());
     }
+    invalidate_stat(path);
     if(err) {
         errno = err;
         return -1;
@@ -400,6 +1156,9 @@ gkfs_remove(const std::string& path) {
  */
 int
 gkfs_access(const std::string& path, const int mask, bool follow_links) {
+    if(CTX->use_async_create() && gkfs_flush_creates(path) == -1) {
+        return -1;
+    }
     auto md = gkfs::utils::get_metadata(path, follow_links);
     if(!md) {
         LOG(DEBUG, "File does not exist '{}'", path);
@@ -445,6 +1204,17 @@ gkfs_access(const std::string& path, const int mask, bool follow_links) {
  */
 int
 gkfs_rename(const string& old_path, const string& new_path) {
+    if(CTX->use_async_create() && (gkfs_flush_creates(old_path) == -1 ||
+                                   gkfs_flush_creates(new_path) == -1)) {
+        return -1;
+    }
+    if(CTX->use_write_back_buffer() && gkfs_flush_write_back(old_path) == -1) {
+        return -1;
+    }
+    if(CTX->use_chunk_cache()) {
+        CTX->chunk_cache()->invalidate(old_path);
+        CTX->chunk_cache()->invalidate(new_path);
+    }
     auto md_old = gkfs::utils::get_metadata(old_path, false);
 
     // if the file is not found, or it is a renamed one cancel.
@@ -475,6 +1245,7 @@ gkfs_rename(const string& old_path, const string& new_path) {
 
             auto err = gkfs::rpc::forward_update_metadentry(
                     new_path, md_old.value(), flags, 0);
+            invalidate_stat(new_path);
 
             if(err) {
                 errno = err;
@@ -486,6 +1257,7 @@ gkfs_rename(const string& old_path, const string& new_path) {
                 is_dir = true;
             err = gkfs::rpc::forward_remove(old_path, is_dir,
                                             CTX->get_replicas());
+            invalidate_stat(old_path);
             if(err) {
                 errno = err;
                 return -1;
@@ -496,6 +1268,8 @@ gkfs_rename(const string& old_path, const string& new_path) {
     }
 
     auto err = gkfs::rpc::forward_rename(old_path, new_path, md_old.value());
+    invalidate_stat(old_path);
+    invalidate_stat(new_path);
     if(err) {
         errno = err;
         return -1;
@@ -516,6 +1290,12 @@ gkfs_rename(const string& old_path, const string& new_path) {
  */
 int
 gkfs_stat(const string& path, struct stat* buf, bool follow_links) {
+    if(CTX->use_async_create() && gkfs_flush_creates(path) == -1) {
+        return -1;
+    }
+    if(CTX->use_write_back_buffer() && gkfs_flush_write_back(path) == -1) {
+        return -1;
+    }
     auto md = gkfs::utils::get_metadata(path, follow_links);
     if(!md) {
         return -1;
@@ -555,6 +1335,12 @@ gkfs_stat(const string& path, struct stat* buf, bool follow_links) {
 int
 gkfs_statx(int dirfs, const std::string& path, int flags, unsigned int mask,
            struct statx* buf, bool follow_links) {
+    if(CTX->use_async_create() && gkfs_flush_creates(path) == -1) {
+        return -1;
+    }
+    if(CTX->use_write_back_buffer() && gkfs_flush_write_back(path) == -1) {
+        return -1;
+    }
     auto md = gkfs::utils::get_metadata(path, follow_links);
 
     if(!md) {
@@ -715,8 +1501,21 @@ gkfs_lseek(shared_ptr<gkfs::filemap::OpenFile> gkfs_fd, off_t offset,
             gkfs_fd->pos(gkfs_fd->pos() + offset);
             break;
         case SEEK_END: {
+            if(CTX->use_async_create() &&
+               gkfs_flush_creates(gkfs_fd->path()) == -1) {
+                return -1;
+            }
+            // the file size must include buffered writes
+            if(flush_write_back(*gkfs_fd) == -1) {
+                return -1;
+            }
             std::pair<int, off64_t> ret{};
-            if(gkfs::config::proxy::fwd_get_size && CTX->use_proxy()) {
+            auto cached_md = CTX->use_stat_cache()
+                                     ? CTX->stat_cache()->get(gkfs_fd->path())
+                                     : std::nullopt;
+            if(cached_md) {
+                ret = {0, static_cast<off64_t>(cached_md->size())};
+            } else if(gkfs::config::proxy::fwd_get_size && CTX->use_proxy()) {
                 ret = gkfs::rpc::forward_get_metadentry_size_proxy(
                         gkfs_fd->path());
             } else {
@@ -754,6 +1553,17 @@ gkfs_lseek(shared_ptr<gkfs::filemap::OpenFile> gkfs_fd, off_t offset,
             errno = EINVAL;
             return -1;
     }
+    if(CTX->use_write_back_buffer() &&
+       gkfs_fd->type() == gkfs::filemap::FileType::regular) {
+        // buffered writes are not continued at a different position
+        auto& write_back = gkfs_fd->write_back();
+        lock_guard<mutex> lock(write_back.mutex());
+        if(!write_back.empty() &&
+           write_back.end() != static_cast<int64_t>(gkfs_fd->pos()) &&
+           flush_write_back_locked(*gkfs_fd) == -1) {
+            return -1;
+        }
+    }
     return gkfs_fd->pos();
 }
 
@@ -773,6 +1583,9 @@ gkfs_truncate(const std::string& path, off_t old_size, off_t new_size) {
     if(new_size == old_size) {
         return 0;
     }
+    if(CTX->use_chunk_cache()) {
+        CTX->chunk_cache()->invalidate(path);
+    }
     int err = 0;
     // decrease size on metadata server first
     if(gkfs::config::proxy::fwd_truncate && CTX->use_proxy()) {
@@ -785,6 +1598,7 @@ gkfs_truncate(const std::string& path, off_t old_size, off_t new_size) {
             }
         }
     }
+    invalidate_stat(path);
     if(err) {
         LOG(DEBUG, "Failed to decrease size");
         errno = err;
@@ -814,6 +1628,13 @@ gkfs_truncate(const std::string& path, off_t old_size, off_t new_size) {
  */
 int
 gkfs_truncate(const std::string& path, off_t length) {
+    if(CTX->use_async_create() && gkfs_flush_creates(path) == -1) {
+        return -1;
+    }
+    // buffered writes must not be written back after the truncation
+    if(CTX->use_write_back_buffer() && gkfs_flush_write_back(path) == -1) {
+        return -1;
+    }
     /* TODO CONCURRENCY:
      * At the moment we first ask the length to the metadata-server in order to
      * know which data-server have data to be deleted.
@@ -879,8 +1700,8 @@ gkfs_truncate(const std::string& path, off_t length) {
             errno = EINVAL;
             return -1;
         }
-        CTX->file_map()->remove(output_fd);
-        return 0;
+        // closing writes back the zeroes if they were buffered
+        return gkfs_close(output_fd);
     }
     return gkfs_truncate(path, size, length);
 }
@@ -929,89 +1750,50 @@ gkfs_do_write(gkfs::filemap::OpenFile& file, const char* buf, size_t count,
         errno = EISDIR;
         return -1;
     }
-    int err;
-    auto path = make_unique<string>(file.path());
     auto is_append = file.get_flag(gkfs::filemap::OpenFile_flags::append);
-    auto write_size = 0;
-    auto num_replicas = CTX->get_replicas();
     LOG(DEBUG, "{}() path: '{}', count: '{}', offset: '{}', is_append: '{}'",
-        __func__, *path, count, offset, is_append);
-    if(CTX->use_write_size_cache() && !is_append) {
-        auto [size_update_cnt, cached_size] =
-                CTX->write_size_cache()->record(*path, offset + count);
-        if(size_update_cnt > CTX->write_size_cache()->flush_threshold()) {
-            err = CTX->write_size_cache()->flush(*path, false).first;
-            if(err) {
-                LOG(ERROR,
-                    "update_metadentry_size() during cache flush failed with err '{}'",
-                    err);
-                errno = err;
+        __func__, file.path(), count, offset, is_append);
+    if(CTX->use_write_back_buffer() && !is_append) {
+        auto& write_back = file.write_back();
+        lock_guard<mutex> lock(write_back.mutex());
+        auto capacity = CTX->write_back_buffer_size();
+        auto chunksize = gkfs::config::rpc::chunksize;
+        if(!write_back.append(buf, count, offset, capacity, chunksize)) {
+            // the write does not continue the buffered extent
+            if(flush_write_back_locked(file) == -1) {
                 return -1;
             }
+            if(!write_back.append(buf, count, offset, capacity, chunksize)) {
+                // too large for the buffer or spans a chunk boundary
+                auto written = write_to_daemons(file.path(), buf, count,
+                                                offset, false, true);
+                if(written >= 0 && update_pos) {
+                    file.pos(offset + written);
+                }
+                return written;
+            }
         }
-    } else {
-        auto ret_offset =
-                gkfs::utils::update_file_size(*path, count, offset, is_append);
-        err = ret_offset.first;
-        if(err) {
-            LOG(ERROR, "update_metadentry_size() failed with err '{}'", err);
-            errno = err;
+        if(write_back.full(capacity, chunksize) &&
+           flush_write_back_locked(file) == -1) {
             return -1;
         }
-        if(is_append) {
-            // When append is set the EOF is set to the offset
-            // forward_update_metadentry_size returns. This is because it is an
-            // atomic operation on the server and reserves the space for this
-            // append
-            if(ret_offset.second == -1) {
-                LOG(ERROR,
-                    "update_metadentry_size() received -1 as starting offset. "
-                    "This occurs when the staring offset could not be extracted "
-                    "from RocksDB's merge operations. Inform GekkoFS devs.");
-                errno = EIO;
-                return -1;
-            }
-            offset = ret_offset.second;
-        }
-    }
-
-    pair<int, long> ret_write;
-    if(gkfs::config::proxy::fwd_io && CTX->use_proxy() &&
-       count > gkfs::config::proxy::fwd_io_count_threshold) {
-        ret_write = gkfs::rpc::forward_write_proxy(*path, buf, offset, count);
-    } else {
-        ret_write = gkfs::rpc::forward_write(*path, buf, offset, count, 0);
-    }
-    err = ret_write.first;
-    write_size = ret_write.second;
-
-    if(num_replicas > 0) {
-        auto ret_write_repl = gkfs::rpc::forward_write(*path, buf, offset,
-                                                       count, num_replicas);
-
-        if(err and ret_write_repl.first == 0) {
-            // We succesfully write the data to some replica
-            err = ret_write_repl.first;
-            // Write size will be wrong
-            write_size = ret_write_repl.second;
+        if(update_pos) {
+            file.pos(offset + count);
         }
+        return count;
     }
-
-    if(err) {
-        LOG(WARNING, "gkfs::rpc::forward_write() failed with err '{}'", err);
-        errno = err;
+    // e.g., O_APPEND was set with fcntl() after buffered writes
+    if(flush_write_back(file) == -1) {
         return -1;
     }
-    if(update_pos) {
+
+    auto written =
+            write_to_daemons(file.path(), buf, count, offset, is_append, true);
+    if(written >= 0 && update_pos) {
         // Update offset in file descriptor in the file map
-        file.pos(offset + write_size);
-    }
-    if(static_cast<size_t>(write_size) != count) {
-        LOG(WARNING,
-            "gkfs::rpc::forward_write() wrote '{}' bytes instead of '{}'",
-            write_size, count);
+        file.pos(offset + written);
     }
-    return write_size; // return written size
+    return written;
 }
 
 /**
@@ -1057,22 +1839,116 @@ gkfs_pwrite(int fd, const void* buf, size_t count, off64_t offset) {
 }
 
 /**
- * gkfs wrapper for write() system calls
+ * gkfs wrapper for write() system calls
+ * errno may be set
+ * @param fd
+ * @param buf
+ * @param count
+ * @return written size or -1 on error
+ */
+ssize_t
+gkfs_write(int fd, const void* buf, size_t count) {
+    auto gkfs_fd = CTX->file_map()->get(fd);
+    if(!gkfs_fd)
+        return 0;
+    // call pwrite and update pos
+    auto ret = gkfs_write_ws(*gkfs_fd, reinterpret_cast<const char*>(buf),
+                             count, gkfs_fd->pos(), true);
+    return ret;
+}
+
+/**
+ * Actual vectored write function for all gkfs write operations. All segments
+ * are written as one write with a single file size update, unless the
+ * write-back buffer is used, which coalesces the segments itself.
+ * errno may be set
+ * @param file
+ * @param iov
+ * @param iovcnt
+ * @param offset
+ * @param update_pos pos should only be updated for some write operations (see
+ * man 2 pwritev)
+ * @return written size or -1 on error
+ */
+ssize_t
+gkfs_do_writev(gkfs::filemap::OpenFile& file, const struct iovec* iov,
+               int iovcnt, off64_t offset, bool update_pos) {
+
+    if(file.type() != gkfs::filemap::FileType::regular) {
+        assert(file.type() == gkfs::filemap::FileType::directory);
+        LOG(WARNING, "Cannot write to directory");
+        errno = EISDIR;
+        return -1;
+    }
+    auto count = iov_size(iov, iovcnt);
+    if(count <= 0) {
+        return count;
+    }
+    auto is_append = file.get_flag(gkfs::filemap::OpenFile_flags::append);
+    LOG(DEBUG,
+        "{}() path: '{}', iovcnt: '{}', count: '{}', offset: '{}', is_append: '{}'",
+        __func__, file.path(), iovcnt, count, offset, is_append);
+    if(CTX->use_write_back_buffer() && !is_append) {
+        ssize_t written = 0;
+        for(int i = 0; i < iovcnt; ++i) {
+            auto len = iov[i].iov_len;
+            if(len == 0) {
+                continue;
+            }
+            auto ret = gkfs_do_write(
+                    file, reinterpret_cast<const char*>(iov[i].iov_base), len,
+                    offset + written, false);
+            if(ret == -1) {
+                if(written == 0) {
+                    return -1;
+                }
+                break;
+            }
+            written += ret;
+            if(static_cast<size_t>(ret) < len) {
+                break;
+            }
+        }
+        if(update_pos) {
+            file.pos(offset + written);
+        }
+        return written;
+    }
+    // e.g., O_APPEND was set with fcntl() after buffered writes
+    if(flush_write_back(file) == -1) {
+        return -1;
+    }
+
+    auto written = write_to_daemons(file.path(), iov, iovcnt, count, offset,
+                                    is_append, true);
+    if(written >= 0 && update_pos) {
+        file.pos(offset + written);
+    }
+    return written;
+}
+
+/**
+ * Wrapper function for all gkfs vectored write operations
  * errno may be set
- * @param fd
- * @param buf
- * @param count
+ * @param file
+ * @param iov
+ * @param iovcnt
+ * @param offset
+ * @param update_pos pos should only be updated for some write operations (see
+ * man 2 pwritev)
  * @return written size or -1 on error
  */
 ssize_t
-gkfs_write(int fd, const void* buf, size_t count) {
-    auto gkfs_fd = CTX->file_map()->get(fd);
-    if(!gkfs_fd)
-        return 0;
-    // call pwrite and update pos
-    auto ret = gkfs_write_ws(*gkfs_fd, reinterpret_cast<const char*>(buf),
-                             count, gkfs_fd->pos(), true);
-    return ret;
+gkfs_writev_ws(gkfs::filemap::OpenFile& file, const struct iovec* iov,
+               int iovcnt, off64_t offset, bool update_pos) {
+#ifdef GKFS_ENABLE_CLIENT_METRICS
+    auto start_t = std::chrono::high_resolution_clock::now();
+    auto written = gkfs_do_writev(file, iov, iovcnt, offset, update_pos);
+    CTX->write_metrics()->add_event(written, start_t);
+    return written;
+#else
+    return gkfs_do_writev(file, iov, iovcnt, offset, update_pos);
+#endif
 }
 
 /**
@@ -1090,31 +1966,7 @@ gkfs_pwritev(int fd, const struct iovec* iov, int iovcnt, off_t offset) {
     auto file = CTX->file_map()->get(fd);
     if(!file)
         return 0;
-    auto pos = offset; // keep track of current position
-    ssize_t written = 0;
-    ssize_t ret;
-    for(int i = 0; i < iovcnt; ++i) {
-        auto count = (iov + i)->iov_len;
-        if(count == 0) {
-            continue;
-        }
-        auto buf = (iov + i)->iov_base;
-        ret = gkfs_write_ws(*file, reinterpret_cast<char*>(buf), count, pos);
-        if(ret == -1) {
-            break;
-        }
-        written += ret;
-        pos += ret;
-
-        if(static_cast<size_t>(ret) < count) {
-            break;
-        }
-    }
-
-    if(written == 0) {
-        return -1;
-    }
-    return written;
+    return gkfs_writev_ws(*file, iov, iovcnt, offset);
 }
 
 /**
@@ -1131,14 +1983,8 @@ gkfs_writev(int fd, const struct iovec* iov, int iovcnt) {
     auto gkfs_fd = CTX->file_map()->get(fd);
     if(!gkfs_fd)
         return 0;
-    auto pos = gkfs_fd->pos(); // retrieve the current offset
-    auto ret = gkfs_pwritev(fd, iov, iovcnt, pos);
-    assert(ret != 0);
-    if(ret < 0) {
-        return -1;
-    }
-    gkfs_fd->pos(pos + ret);
-    return ret;
+    // call pwritev and update pos
+    return gkfs_writev_ws(*gkfs_fd, iov, iovcnt, gkfs_fd->pos(), true);
 }
 
 /**
@@ -1158,34 +2004,25 @@ gkfs_do_read(const gkfs::filemap::OpenFile& file, char* buf, size_t count,
         errno = EISDIR;
         return -1;
     }
-
-    // Zeroing buffer before read is only relevant for sparse files. Otherwise
-    // sparse regions contain invalid data.
-    if constexpr(gkfs::config::io::zero_buffer_before_read) {
-        memset(buf, 0, sizeof(char) * count);
+    // buffered writes of all open files of the path must reach the daemons
+    // before they can be read
+    if(CTX->use_write_back_buffer() &&
+       gkfs_flush_write_back(file.path()) == -1) {
+        return -1;
     }
 
     pair<int, long> ret;
-    if(gkfs::config::proxy::fwd_io && CTX->use_proxy() &&
-       count > gkfs::config::proxy::fwd_io_count_threshold) {
-        ret = gkfs::rpc::forward_read_proxy(file.path(), buf, offset, count);
+    if(CTX->use_chunk_cache()) {
+        auto path = file.path();
+        ret = CTX->chunk_cache()->read(
+                path, buf, offset, count,
+                [&path](char* fetch_buf, off64_t fetch_offset,
+                        size_t fetch_count) {
+                    return read_from_daemons(path, fetch_buf, fetch_offset,
+                                             fetch_count, false);
+                });
     } else {
-        std::set<int8_t> failed; // set with failed targets.
-        if(CTX->get_replicas() != 0) {
-
-            ret = gkfs::rpc::forward_read(file.path(), buf, offset, count,
-                                          CTX->get_replicas(), failed);
-            while(ret.first == EIO) {
-                ret = gkfs::rpc::forward_read(file.path(), buf, offset, count,
-                                              CTX->get_replicas(), failed);
-                LOG(WARNING, "gkfs::rpc::forward_read() failed with ret '{}'",
-                    ret.first);
-            }
-
-        } else {
-            ret = gkfs::rpc::forward_read(file.path(), buf, offset, count, 0,
-                                          failed);
-        }
+        ret = read_from_daemons(file.path(), buf, offset, count, true);
     }
     auto err = ret.first;
     if(err) {
@@ -1257,6 +2094,93 @@ gkfs_read(int fd, void* buf, size_t count) {
     return ret;
 }
 
+/**
+ * Actual vectored read function for all gkfs read operations. All segments are
+ * read as one read, unless the chunk cache is used, which serves contiguous
+ * reads only.
+ * errno may be set
+ * @param file
+ * @param iov
+ * @param iovcnt
+ * @param offset
+ * @return read size or -1 on error
+ */
+ssize_t
+gkfs_do_readv(const gkfs::filemap::OpenFile& file, const struct iovec* iov,
+              int iovcnt, off64_t offset) {
+    if(file.type() != gkfs::filemap::FileType::regular) {
+        assert(file.type() == gkfs::filemap::FileType::directory);
+        LOG(WARNING, "Cannot read from directory");
+        errno = EISDIR;
+        return -1;
+    }
+    auto count = iov_size(iov, iovcnt);
+    if(count <= 0) {
+        return count;
+    }
+    if(CTX->use_chunk_cache()) {
+        ssize_t read = 0;
+        for(int i = 0; i < iovcnt; ++i) {
+            auto len = iov[i].iov_len;
+            if(len == 0) {
+                continue;
+            }
+            auto ret = gkfs_do_read(
+                    file, reinterpret_cast<char*>(iov[i].iov_base), len,
+                    offset + read);
+            if(ret == -1) {
+                if(read == 0) {
+                    return -1;
+                }
+                break;
+            }
+            read += ret;
+            if(static_cast<size_t>(ret) < len) {
+                break;
+            }
+        }
+        return read;
+    }
+    // buffered writes of all open files of the path must reach the daemons
+    // before they can be read
+    if(CTX->use_write_back_buffer() &&
+       gkfs_flush_write_back(file.path()) == -1) {
+        return -1;
+    }
+
+    auto ret =
+            read_from_daemons(file.path(), iov, iovcnt, offset, count, true);
+    auto err = ret.first;
+    if(err) {
+        LOG(WARNING, "gkfs::rpc::forward_read() failed with ret '{}'", err);
+        errno = err;
+        return -1;
+    }
+    return ret.second; // return read size
+}
+
+/**
+ * Wrapper function for all gkfs vectored read operations
+ * errno may be set
+ * @param file
+ * @param iov
+ * @param iovcnt
+ * @param offset
+ * @return read size or -1 on error
+ */
+ssize_t
+gkfs_readv_ws(const gkfs::filemap::OpenFile& file, const struct iovec* iov,
+              int iovcnt, off64_t offset) {
+#ifdef GKFS_ENABLE_CLIENT_METRICS
+    auto start_t = std::chrono::high_resolution_clock::now();
+    auto read = gkfs_do_readv(file, iov, iovcnt, offset);
+    CTX->read_metrics()->add_event(read, start_t);
+    return read;
+#else
+    return gkfs_do_readv(file, iov, iovcnt, offset);
+#endif
+}
+
 /**
  * gkfs wrapper for preadv() system calls
  * errno may be set
@@ -1272,31 +2196,7 @@ gkfs_preadv(int fd, const struct iovec* iov, int iovcnt, off_t offset) {
     auto file = CTX->file_map()->get(fd);
     if(!file)
         return 0;
-    auto pos = offset; // keep track of current position
-    ssize_t read = 0;
-    ssize_t ret;
-    for(int i = 0; i < iovcnt; ++i) {
-        auto count = (iov + i)->iov_len;
-        if(count == 0) {
-            continue;
-        }
-        auto buf = (iov + i)->iov_base;
-        ret = gkfs_read_ws(*file, reinterpret_cast<char*>(buf), count, pos);
-        if(ret == -1) {
-            break;
-        }
-        read += ret;
-        pos += ret;
-
-        if(static_cast<size_t>(ret) < count) {
-            break;
-        }
-    }
-
-    if(read == 0) {
-        return -1;
-    }
-    return read;
+    return gkfs_readv_ws(*file, iov, iovcnt, offset);
 }
 
 /**
@@ -1314,12 +2214,11 @@ gkfs_readv(int fd, const struct iovec* iov, int iovcnt) {
     if(!gkfs_fd)
         return 0;
     auto pos = gkfs_fd->pos(); // retrieve the current offset
-    auto ret = gkfs_preadv(fd, iov, iovcnt, pos);
-    assert(ret != 0);
-    if(ret < 0) {
-        return -1;
+    auto ret = gkfs_readv_ws(*gkfs_fd, iov, iovcnt, pos);
+    // Update offset in file descriptor in the file map
+    if(ret > 0) {
+        gkfs_fd->pos(pos + ret);
     }
-    gkfs_fd->pos(pos + ret);
     return ret;
 }
 
@@ -1331,6 +2230,10 @@ gkfs_readv(int fd, const struct iovec* iov, int iovcnt) {
  */
 int
 gkfs_opendir(const std::string& path) {
+    // pending creates must be visible, their failures are logged
+    if(CTX->use_async_create()) {
+        gkfs_flush_creates();
+    }
     auto md = gkfs::utils::get_metadata(path);
     if(!md) {
         return -1;
@@ -1346,6 +2249,8 @@ gkfs_opendir(const std::string& path) {
     // this is used in get_metadata() later to avoid stat RPCs
     if(CTX->use_dentry_cache()) {
         ret.second = make_shared<gkfs::filemap::OpenDir>(path);
+        const bool prefill = CTX->use_stat_cache() && CTX->stat_cache_prefill();
+        const auto epoch = prefill ? CTX->stat_cache()->epoch() : 0;
         std::vector<std::future<
                 pair<int, unique_ptr<vector<tuple<const basic_string<char>,
                                                   bool, size_t, time_t>>>>>>
@@ -1384,12 +2289,19 @@ gkfs_opendir(const std::string& path) {
                                                       get<3>(dentry)});
                 cnt++;
             }
+            if(prefill) {
+                prefill_stat_cache(path, open_dir, epoch);
+            }
             ret.first = res.first;
         }
         LOG(DEBUG, "{}() Unpacked dirents for path '{}' counted '{}' entries",
             __func__, path, cnt);
     } else {
-        ret = gkfs::rpc::forward_get_dirents(path);
+        // entries are fetched page by page while getdents() consumes them
+        ret.second = make_shared<gkfs::filemap::OpenDir>(path);
+        ret.second->begin_paging(
+                CTX->distributor()->locate_directory_metadata().size());
+        ret.first = load_dirents(*ret.second, 0);
     }
     auto err = ret.first;
     if(err) {
@@ -1408,6 +2320,10 @@ gkfs_opendir(const std::string& path) {
  */
 int
 gkfs_rmdir(const std::string& path) {
+    // pending creates must be visible, their failures are logged
+    if(CTX->use_async_create()) {
+        gkfs_flush_creates();
+    }
     int err;
     // check that directory is empty if a strict dir hierarchy is enforced
     // TODO rename #define
@@ -1417,15 +2333,16 @@ gkfs_rmdir(const std::string& path) {
         LOG(DEBUG, "Error: Path '{}' err code '{}' ", path, strerror(errno));
         return -1;
     }
-    auto ret = gkfs::rpc::forward_get_dirents(path);
-    err = ret.first;
+    // the first page with entries suffices
+    gkfs::filemap::OpenDir open_dir(path);
+    open_dir.begin_paging(
+            CTX->distributor()->locate_directory_metadata().size());
+    err = load_dirents(open_dir, 0);
     if(err) {
         errno = err;
         return -1;
     }
-    assert(ret.second);
-    auto open_dir = ret.second;
-    if(open_dir->size() != 0) {
+    if(open_dir.size() != 0) {
         errno = ENOTEMPTY;
         return -1;
     }
@@ -1435,10 +2352,12 @@ gkfs_rmdir(const std::string& path) {
     } else {
         err = gkfs::rpc::forward_remove(path, true, CTX->get_replicas());
     }
+    invalidate_stat(path);
     if(err) {
         errno = err;
         return -1;
     }
+    forget_parent_dir(path);
     return 0;
 }
 
@@ -1452,7 +2371,7 @@ gkfs_rmdir(const std::string& path) {
  */
 int
 gkfs_getdents(unsigned int fd, struct linux_dirent* dirp, unsigned int count) {
-    // Get opendir object (content was downloaded with opendir() call)
+    // Get opendir object (the first page was fetched with opendir() call)
     auto open_dir = CTX->file_map()->get_dir(fd);
     if(open_dir == nullptr) {
         // Cast did not succeeded: open_file is a regular file
@@ -1462,13 +2381,24 @@ gkfs_getdents(unsigned int fd, struct linux_dirent* dirp, unsigned int count) {
 
     // get directory position of which entries to return
     auto pos = open_dir->pos();
+    auto err = load_dirents(*open_dir, pos);
+    if(err) {
+        errno = err;
+        return -1;
+    }
     if(pos >= open_dir->size()) {
         return 0;
     }
 
     unsigned int written = 0;
     struct linux_dirent* current_dirp = nullptr;
-    while(pos < open_dir->size()) {
+    while(true) {
+        if(pos >= open_dir->size()) {
+            // loaded entries are consumed, fetch the next page. An error is
+            // reported by the next call
+            if(load_dirents(*open_dir, pos) != 0 || pos >= open_dir->size())
+                break;
+        }
         // get dentry fir current position
         auto de = open_dir->getdent(pos);
         /*
@@ -1533,12 +2463,23 @@ gkfs_getdents64(unsigned int fd, struct linux_dirent64* dirp,
         return -1;
     }
     auto pos = open_dir->pos();
+    auto err = load_dirents(*open_dir, pos);
+    if(err) {
+        errno = err;
+        return -1;
+    }
     if(pos >= open_dir->size()) {
         return 0;
     }
     unsigned int written = 0;
     struct linux_dirent64* current_dirp = nullptr;
-    while(pos < open_dir->size()) {
+    while(true) {
+        if(pos >= open_dir->size()) {
+            // loaded entries are consumed, fetch the next page. An error is
+            // reported by the next call
+            if(load_dirents(*open_dir, pos) != 0 || pos >= open_dir->size())
+                break;
+        }
         auto de = open_dir->getdent(pos);
         /*
          * Calculate the total dentry size within the kernel struct
@@ -1585,6 +2526,227 @@ gkfs_getdents64(unsigned int fd, struct linux_dirent64* dirp,
     return written;
 }
 
+/**
+ * Writes back the buffered writes of all open files of a path
+ * errno may be set
+ * @param path empty for all open files
+ * @return 0 on success, -1 on failure
+ */
+int
+gkfs_flush_write_back(const std::string& path) {
+    // reads call this on every I/O, avoid scanning the open files for nothing
+    if(gkfs::filemap::WriteBackBuffer::dirty_count() == 0) {
+        return 0;
+    }
+    auto err = 0;
+    for(const auto& file : CTX->file_map()->get_all()) {
+        if(!path.empty() && file->path() != path) {
+            continue;
+        }
+        if(flush_write_back(*file) == -1) {
+            err = errno;
+        }
+    }
+    if(err) {
+        errno = err;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * Sends the deferred creates of asynchronous create mode
+ * errno may be set
+ * @param path path that is about to be accessed, empty for all paths
+ * @return 0 on success, -1 if the create of path (or any create) failed
+ */
+int
+gkfs_flush_creates(const std::string& path) {
+    // reads and writes call this on every I/O, skip the mutex if possible
+    if(deferred_create_n.load() == 0) {
+        return 0;
+    }
+    return flush_deferred_creates(path);
+}
+
+/**
+ * Creates several files or directories of the same mode with batched RPCs.
+ * Paths that share a daemon are created with a single RPC.
+ * @param paths
+ * @param mode
+ * @return error code per path, 0 on success
+ */
+std::vector<int>
+gkfs_create_bulk(const std::vector<std::string>& paths, mode_t mode) {
+    std::vector<int> errs(paths.size(), 0);
+    auto err = check_create_mode(mode);
+    if(err) {
+        std::fill(errs.begin(), errs.end(), err);
+        return errs;
+    }
+    // failures of other deferred creates are logged and reported on access
+    if(CTX->use_async_create()) {
+        gkfs_flush_creates();
+    }
+    if(gkfs::config::proxy::fwd_create && CTX->use_proxy()) {
+        for(size_t i = 0; i < paths.size(); i++) {
+            errs[i] = gkfs_create(paths[i], mode) ? errno : 0;
+        }
+        return errs;
+    }
+    // check each parent directory only once
+    std::map<std::string, int> parent_errs;
+    std::vector<std::string> batch_paths;
+    std::vector<size_t> batch_idxs;
+    for(size_t i = 0; i < paths.size(); i++) {
+        auto parent = gkfs::path::dirname(paths[i]);
+        auto it = parent_errs.find(parent);
+        if(it == parent_errs.end()) {
+            it = parent_errs
+                         .emplace(parent,
+                                  check_parent_dir(paths[i]) ? errno : 0)
+                         .first;
+        }
+        if(it->second) {
+            errs[i] = it->second;
+            continue;
+        }
+        batch_paths.push_back(paths[i]);
+        batch_idxs.push_back(i);
+    }
+    auto batch_errs = create_batch(batch_paths, mode);
+    for(size_t j = 0; j < batch_idxs.size(); j++) {
+        errs[batch_idxs[j]] = batch_errs[j];
+    }
+    return errs;
+}
+
+/**
+ * Retrieves the stat information of several paths with batched RPCs. Paths
+ * that need to be resolved, e.g., links, fall back to gkfs_stat().
+ * @param paths
+ * @param bufs is resized to hold one stat struct per path
+ * @param follow_links
+ * @return error code per path, 0 on success
+ */
+std::vector<int>
+gkfs_stat_bulk(const std::vector<std::string>& paths,
+               std::vector<struct stat>& bufs, bool follow_links) {
+    std::vector<int> errs(paths.size(), 0);
+    bufs.resize(paths.size());
+    // flush errors are reported by the close() or fsync() of the files
+    if(CTX->use_async_create()) {
+        gkfs_flush_creates();
+    }
+    if(CTX->use_write_back_buffer()) {
+        gkfs_flush_write_back();
+    }
+    auto stat_single = [&](size_t i) {
+        errs[i] = gkfs_stat(paths[i], &bufs[i], follow_links) ? errno : 0;
+    };
+    if((gkfs::config::proxy::fwd_stat && CTX->use_proxy()) ||
+       CTX->use_dentry_cache()) {
+        for(size_t i = 0; i < paths.size(); i++) {
+            stat_single(i);
+        }
+        return errs;
+    }
+    std::vector<std::string> attrs;
+    auto batch_errs = gkfs::rpc::forward_stat_batch(paths, attrs, 0);
+    for(size_t i = 0; i < paths.size(); i++) {
+        if(batch_errs[i]) {
+            if(batch_errs[i] != ENOENT && CTX->get_replicas() > 0) {
+                // gkfs_stat() retries on the other replicas
+                stat_single(i);
+            } else {
+                errs[i] = batch_errs[i];
+            }
+            continue;
+        }
+        gkfs::metadata::Metadata md{attrs[i]};
+#ifdef HAS_SYMLINKS
+        if(follow_links && md.is_link()) {
+            stat_single(i);
+            continue;
+        }
+#ifdef HAS_RENAME
+        if(md.blocks() == -1 || !md.target_path().empty()) {
+            stat_single(i);
+            continue;
+        }
+#endif // HAS_RENAME
+#endif // HAS_SYMLINKS
+        gkfs::utils::metadata_to_stat(paths[i], md, bufs[i]);
+    }
+    return errs;
+}
+
+/**
+ * Removes several files with batched RPCs. Paths that share a daemon are
+ * removed with a single RPC. A renamed file is removed at its new path as well.
+ * @param paths
+ * @return error code per path, 0 on success
+ */
+std::vector<int>
+gkfs_remove_bulk(const std::vector<std::string>& paths) {
+    std::vector<int> errs(paths.size(), 0);
+    // flush errors are reported by the close() or fsync() of the files
+    if(CTX->use_async_create()) {
+        gkfs_flush_creates();
+    }
+    if(CTX->use_write_back_buffer()) {
+        gkfs_flush_write_back();
+    }
+    if(gkfs::config::proxy::fwd_remove && CTX->use_proxy()) {
+        for(size_t i = 0; i < paths.size(); i++) {
+            errs[i] = gkfs_remove(paths[i]) ? errno : 0;
+        }
+        return errs;
+    }
+    for(const auto& path : paths) {
+        if(CTX->use_chunk_cache()) {
+            CTX->chunk_cache()->invalidate(path);
+        }
+    }
+    std::vector<std::string> attrs;
+    errs = gkfs::rpc::forward_remove_batch(paths, CTX->get_replicas(), attrs);
+    for(const auto& path : paths) {
+        invalidate_stat(path);
+    }
+#if defined(HAS_SYMLINKS) && defined(HAS_RENAME)
+    // the removed metadata tells which files were renamed, see gkfs_remove()
+    for(size_t i = 0; i < paths.size(); i++) {
+        if(errs[i]) {
+            continue;
+        }
+        gkfs::metadata::Metadata md{attrs[i]};
+        if(md.target_path().empty()) {
+            continue;
+        }
+        std::string new_path;
+        while(!md.target_path().empty()) {
+            new_path = md.target_path();
+            auto target_md = gkfs::utils::get_metadata(new_path, false);
+            if(!target_md) {
+                errs[i] = errno;
+                break;
+            }
+            md = *target_md;
+        }
+        if(errs[i]) {
+            continue;
+        }
+        if(CTX->use_chunk_cache()) {
+            CTX->chunk_cache()->invalidate(new_path);
+        }
+        errs[i] = gkfs::rpc::forward_remove(new_path, false,
+                                            CTX->get_replicas());
+        invalidate_stat(new_path);
+    }
+#endif // HAS_SYMLINKS && HAS_RENAME
+    return errs;
+}
+
 int
 gkfs_fsync(unsigned int fd) {
     auto file = CTX->file_map()->get(fd);
@@ -1592,9 +2754,19 @@ gkfs_fsync(unsigned int fd) {
         errno = 0;
         return 0;
     }
+    // send a deferred create even if nothing was written
+    if(CTX->use_async_create() && gkfs_flush_creates(file->path()) == -1) {
+        return -1;
+    }
+    // write back buffered data to be server consistent
+    if(flush_write_back(*file) == -1) {
+        LOG(ERROR, "{}() write-back failed with err '{}'", __func__, errno);
+        return -1;
+    }
     // flush write size cache to be server consistent
     if(CTX->use_write_size_cache()) {
         auto err = CTX->write_size_cache()->flush(file->path(), true).first;
+        invalidate_stat(file->path());
         if(err) {
             LOG(ERROR, "{}() write_size_cache() failed with err '{}'", __func__,
                 err);
@@ -1616,9 +2788,15 @@ int
 gkfs_close(unsigned int fd) {
     auto file = CTX->file_map()->get(fd);
     if(file) {
+        // write back buffered data to be server consistent
+        if(flush_write_back(*file) == -1) {
+            LOG(ERROR, "{}() write-back failed with err '{}'", __func__, errno);
+            return -1;
+        }
         // flush write size cache to be server consistent
         if(CTX->use_write_size_cache()) {
             auto err = CTX->write_size_cache()->flush(file->path(), true).first;
+            invalidate_stat(file->path());
             if(err) {
                 LOG(ERROR, "{}() write_size_cache() failed with err '{}'",
                     __func__, err);
@@ -1663,6 +2841,10 @@ gkfs_close(unsigned int fd) {
  */
 int
 gkfs_mk_symlink(const std::string& path, const std::string& target_path) {
+    if(CTX->use_async_create() && (gkfs_flush_creates(path) == -1 ||
+                                   gkfs_flush_creates(target_path) == -1)) {
+        return -1;
+    }
     /* The following check is not POSIX compliant.
      * In POSIX the target is not checked at all.
      *  Here if the target is a directory we raise a NOTSUP error.
@@ -1691,6 +2873,7 @@ gkfs_mk_symlink(const std::string& path, const std::string& target_path) {
     }
 
     auto err = gkfs::rpc::forward_mk_symlink(path, target_path);
+    invalidate_stat(path);
     if(err) {
         errno = err;
         return -1;
@@ -1711,6 +2894,9 @@ gkfs_mk_symlink(const std::string& path, const std::string& target_path) {
  */
 int
 gkfs_readlink(const std::string& path, char* buf, int bufsize) {
+    if(CTX->use_async_create() && gkfs_flush_creates(path) == -1) {
+        return -1;
+    }
     auto md = gkfs::utils::get_metadata(path, false);
     if(!md) {
         LOG(DEBUG, "Named link doesn't exist");
@@ -1739,20 +2925,27 @@ gkfs_readlink(const std::string& path, char* buf, int bufsize) {
 
 std::vector<std::string>
 gkfs_get_file_list(const std::string& path) {
-    auto ret = gkfs::rpc::forward_get_dirents(path);
-    auto err = ret.first;
-    if(err) {
-        errno = err;
-        return {};
+    // pending creates must be visible, their failures are logged
+    if(CTX->use_async_create()) {
+        gkfs_flush_creates();
     }
-
-    auto open_dir = ret.second;
+    gkfs::filemap::OpenDir open_dir(path);
+    open_dir.begin_paging(
+            CTX->distributor()->locate_directory_metadata().size());
 
     std::vector<std::string> file_list;
     unsigned int pos = 0;
 
-    while(pos < open_dir->size()) {
-        auto de = open_dir->getdent(pos++);
+    while(true) {
+        auto err = load_dirents(open_dir, pos);
+        if(err) {
+            errno = err;
+            return {};
+        }
+        if(pos >= open_dir.size()) {
+            break;
+        }
+        auto de = open_dir.getdent(pos++);
         file_list.push_back(de.name());
     }
     return file_list;
@@ -1771,6 +2964,12 @@ gkfs_getsingleserverdir(const char* path, struct dirent_extended* dirp,
     pair<int, unique_ptr<vector<
                       tuple<const basic_string<char>, bool, size_t, time_t>>>>
             ret{};
+    // pending creates must be visible, their failures are logged
+    if(CTX->use_async_create()) {
+        gkfs::syscall::gkfs_flush_creates();
+    }
+    const bool prefill = CTX->use_stat_cache() && CTX->stat_cache_prefill();
+    const auto epoch = prefill ? CTX->stat_cache()->epoch() : 0;
     if(gkfs::config::proxy::fwd_get_dirents_single && CTX->use_proxy()) {
         ret = gkfs::rpc::forward_get_dirents_single_proxy(path, server);
     } else {
@@ -1782,6 +2981,9 @@ gkfs_getsingleserverdir(const char* path, struct dirent_extended* dirp,
         errno = err;
         return -1;
     }
+    if(prefill) {
+        prefill_stat_cache(path, *ret.second, epoch);
+    }
 
     auto& open_dir = *ret.second;
     unsigned int pos = 0;
@@ -31,6 +31,10 @@
 #include <client/preload.hpp>
 #include <client/hooks.hpp>
 #include <client/logging.hpp>
+#include <client/open_file_map.hpp>
+#include <client/cache.hpp>
+#include <client/path.hpp>
+#include <common/path_util.hpp>
 
 #include <optional>
 #include <fmt/format.h>
@@ -41,6 +45,7 @@ extern "C" {
 #include <syscall.h>
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/mman.h>
 #include <printf.h>
 }
 
@@ -427,6 +432,194 @@ hook_internal(long syscall_number, long arg0, long arg1, long arg2, long arg3,
     return gkfs::syscall::hooked;
 }
 
+/*
+ * is_external_path -- checks cheaply if a path argument relative to `dirfd`
+ * is certainly outside of GekkoFS
+ */
+inline bool
+is_external_path(int dirfd, const char* path) {
+    if(path != nullptr && path[0] != gkfs::path::separator &&
+       dirfd != AT_FDCWD) {
+        // relative to a directory that is not opened in GekkoFS
+        return !CTX->file_map()->exist(dirfd);
+    }
+    return gkfs::path::is_certainly_external(path);
+}
+
+/*
+ * is_external_syscall -- fast path for application syscalls that do not
+ * concern GekkoFS
+ *
+ * Before dispatching a syscall to its hook, check its fd or raw path
+ * argument without resolving the path or allocating memory. Only syscalls
+ * are listed whose hooks pass external calls to the kernel unmodified. A
+ * return value of false means that the hook has to decide.
+ */
+inline bool
+is_external_syscall(long syscall_number, long arg0, long arg1) {
+
+    switch(syscall_number) {
+
+        case SYS_read:
+        case SYS_pread64:
+        case SYS_readv:
+        case SYS_preadv:
+        case SYS_write:
+        case SYS_pwrite64:
+        case SYS_writev:
+        case SYS_pwritev:
+        case SYS_fstat:
+        case SYS_lseek:
+        case SYS_ftruncate:
+        case SYS_fsync:
+        case SYS_fdatasync:
+        case SYS_fchmod:
+        case SYS_fcntl:
+#ifdef SYS_getdents
+        case SYS_getdents:
+#endif
+        case SYS_getdents64:
+        case SYS_fstatfs:
+#ifdef SYS_flistxattr
+        case SYS_flistxattr:
+#endif
+        case SYS_fallocate:
+        case SYS_fadvise64:
+            return !CTX->file_map()->exist(static_cast<int>(arg0));
+
+#ifdef SYS_open
+        case SYS_open:
+#endif
+#ifdef SYS_creat
+        case SYS_creat:
+#endif
+#ifdef SYS_stat
+        case SYS_stat:
+#endif
+#ifdef SYS_lstat
+        case SYS_lstat:
+#endif
+#ifdef SYS_access
+        case SYS_access:
+#endif
+#ifdef SYS_unlink
+        case SYS_unlink:
+#endif
+#ifdef SYS_rmdir
+        case SYS_rmdir:
+#endif
+#ifdef SYS_mkdir
+        case SYS_mkdir:
+#endif
+#ifdef SYS_chmod
+        case SYS_chmod:
+#endif
+#ifdef SYS_readlink
+        case SYS_readlink:
+#endif
+#ifdef SYS_listxattr
+        case SYS_listxattr:
+#endif
+#ifdef SYS_llistxattr
+        case SYS_llistxattr:
+#endif
+        case SYS_truncate:
+        case SYS_statfs:
+        case SYS_getxattr:
+        case SYS_lgetxattr:
+            return is_external_path(AT_FDCWD,
+                                    reinterpret_cast<const char*>(arg0));
+
+        case SYS_openat:
+#ifdef STATX_TYPE
+        case SYS_statx:
+#endif
+        case SYS_newfstatat:
+        case SYS_faccessat:
+#ifdef SYS_faccessat2
+        case SYS_faccessat2:
+#endif
+        case SYS_unlinkat:
+        case SYS_mkdirat:
+        case SYS_fchmodat:
+        case SYS_readlinkat:
+            return is_external_path(static_cast<int>(arg0),
+                                    reinterpret_cast<const char*>(arg1));
+
+        default:
+            return false;
+    }
+}
+
+/*
+ * invalidate_registrations -- drop cached exposed buffers before the
+ * application returns their memory to the kernel
+ *
+ * Registered memory that is unmapped or replaced must not be used for
+ * further RDMA transfers. Heap memory that is reused by malloc() keeps its
+ * mapping and needs no invalidation.
+ */
+inline void
+invalidate_registrations(long syscall_number, long arg0, long arg1, long arg2,
+                         long arg3) {
+
+    if(!CTX->use_registration_cache()) {
+        return;
+    }
+    auto addr = static_cast<uintptr_t>(arg0);
+    auto size = static_cast<size_t>(arg1);
+    switch(syscall_number) {
+
+        case SYS_munmap:
+        case SYS_mremap:
+            break;
+
+        case SYS_madvise:
+            if(arg2 != MADV_DONTNEED &&
+#ifdef MADV_FREE
+               arg2 != MADV_FREE &&
+#endif
+               arg2 != MADV_REMOVE) {
+                return;
+            }
+            break;
+
+        case SYS_mmap:
+            if(!(arg3 & MAP_FIXED)) {
+                return;
+            }
+            break;
+
+        case SYS_brk: {
+            if(addr == 0) {
+                return;
+            }
+            // only a shrinking heap unmaps memory, i.e., [new, old break). The
+            // old break is read from the kernel as breaks that the client set
+            // itself or that failed would make a tracked value stale
+            auto old_brk = static_cast<uintptr_t>(
+                    syscall_no_intercept_wrapper(SYS_brk, 0));
+            if(addr >= old_brk) {
+                return;
+            }
+            size = old_brk - addr;
+            break;
+        }
+
+#ifdef SYS_shmdt
+        case SYS_shmdt:
+            // the size of the detached segment is not passed. Drop everything
+            // from its start as detaching shared memory is rare
+            size = UINTPTR_MAX - addr;
+            break;
+#endif
+
+        default:
+            return;
+    }
+    CTX->registration_cache()->invalidate(addr, size);
+}
+
 /*
  * hook -- interception hook for application syscalls
  *
@@ -446,6 +639,13 @@ hook(long syscall_number, long arg0, long arg1, long arg2, long arg3, long arg4,
                 gkfs::syscall::not_executed,
         syscall_number, args);
 
+    if(is_external_syscall(syscall_number, arg0, arg1)) {
+        ::save_current_syscall_info(gkfs::syscall::from_external_code |
+                                    gkfs::syscall::to_kernel |
+                                    gkfs::syscall::not_executed);
+        return gkfs::syscall::forward_to_kernel;
+    }
+
     switch(syscall_number) {
 
         case SYS_execve:
@@ -825,6 +1025,20 @@ hook(long syscall_number, long arg0, long arg1, long arg2, long arg3, long arg4,
                     static_cast<off_t>(arg2), static_cast<int>(arg4));
             break;
 
+        case SYS_munmap:
+        case SYS_mremap:
+        case SYS_madvise:
+        case SYS_mmap:
+        case SYS_brk:
+#ifdef SYS_shmdt
+        case SYS_shmdt:
+#endif
+            invalidate_registrations(syscall_number, arg0, arg1, arg2, arg3);
+            ::save_current_syscall_info(gkfs::syscall::from_external_code |
+                                        gkfs::syscall::to_kernel |
+                                        gkfs::syscall::not_executed);
+            return gkfs::syscall::forward_to_kernel;
+
         default:
             // ignore any other syscalls, i.e.: pass them on to the kernel
             // (syscalls forwarded to the kernel that return are logged in
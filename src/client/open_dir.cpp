@@ -28,6 +28,7 @@
 */
 
 #include <client/open_dir.hpp>
+#include <algorithm>
 #include <stdexcept>
 #include <cstring>
 
@@ -58,12 +59,66 @@ OpenDir::add(const std::string& name, const FileType& type) {
 
 const DirEntry&
 OpenDir::getdent(unsigned int pos) {
-    return entries.at(pos);
+    if(pos < offset_) {
+        throw std::out_of_range("Directory entry was already dropped");
+    }
+    return entries.at(pos - offset_);
 }
 
 size_t
 OpenDir::size() {
-    return entries.size();
+    return offset_ + entries.size();
+}
+
+size_t
+OpenDir::offset() const {
+    return offset_;
+}
+
+void
+OpenDir::begin_paging(size_t sources) {
+    entries.clear();
+    offset_ = 0;
+    cursors_.assign(sources, "");
+    exhausted_.assign(sources, false);
+    complete_ = sources == 0;
+}
+
+void
+OpenDir::drop_entries() {
+    offset_ += entries.size();
+    entries.clear();
+}
+
+bool
+OpenDir::complete() const {
+    return complete_;
+}
+
+std::vector<size_t>
+OpenDir::next_sources(size_t max) const {
+    std::vector<size_t> sources;
+    for(size_t i = 0; i < exhausted_.size() && sources.size() < max; i++) {
+        if(!exhausted_[i]) {
+            sources.push_back(i);
+        }
+    }
+    return sources;
+}
+
+const std::string&
+OpenDir::cursor(size_t source) const {
+    return cursors_.at(source);
+}
+
+void
+OpenDir::cursor(size_t source, const std::string& next_key) {
+    cursors_.at(source) = next_key;
+    if(next_key.empty()) {
+        exhausted_.at(source) = true;
+        complete_ = std::all_of(exhausted_.begin(), exhausted_.end(),
+                                [](bool exhausted) { return exhausted; });
+    }
 }
 
 } // namespace gkfs::filemap
\ No newline at end of file
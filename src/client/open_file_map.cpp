@@ -32,6 +32,11 @@
 #include <client/preload.hpp>
 #include <client/preload_util.hpp>
 #include <client/logging.hpp>
+#include <common/arithmetic/arithmetic.hpp>
+#include <config.hpp>
+
+#include <limits>
+#include <thread>
 
 extern "C" {
 #include <fcntl.h>
@@ -60,8 +65,6 @@ OpenFile::OpenFile(const string& path, const int flags, FileType type)
     pos_ = 0; // If O_APPEND flag is used, it will be used before each write.
 }
 
-OpenFileMap::OpenFileMap() : fd_idx(10000), fd_validation_needed(false) {}
-
 string
 OpenFile::path() const {
     return path_;
@@ -101,13 +104,202 @@ OpenFile::type() const {
     return type_;
 }
 
+WriteBackBuffer&
+OpenFile::write_back() const {
+    return write_back_;
+}
+
+// WriteBackBuffer starts here
+
+std::atomic<size_t> WriteBackBuffer::dirty_{0};
+
+WriteBackBuffer::~WriteBackBuffer() {
+    if(!data_.empty()) {
+        dirty_--;
+    }
+}
+
+size_t
+WriteBackBuffer::dirty_count() {
+    return dirty_.load();
+}
+
+std::mutex&
+WriteBackBuffer::mutex() {
+    return mutex_;
+}
+
+bool
+WriteBackBuffer::empty() const {
+    return data_.empty();
+}
+
+const char*
+WriteBackBuffer::data() const {
+    return data_.data();
+}
+
+size_t
+WriteBackBuffer::size() const {
+    return data_.size();
+}
+
+int64_t
+WriteBackBuffer::offset() const {
+    return offset_;
+}
+
+int64_t
+WriteBackBuffer::end() const {
+    return offset_ + static_cast<int64_t>(data_.size());
+}
+
+bool
+WriteBackBuffer::append(const char* buf, size_t count, int64_t offset,
+                        size_t capacity, size_t chunk_size) {
+    if(count == 0 || offset < 0) {
+        return false;
+    }
+    auto start = data_.empty() ? offset : offset_;
+    if(!data_.empty() && offset != end()) {
+        return false;
+    }
+    if(data_.size() + count > capacity) {
+        return false;
+    }
+    // the buffered extent must be served by a single chunk
+    if(gkfs::utils::arithmetic::block_index(start, chunk_size) !=
+       gkfs::utils::arithmetic::block_index(offset + count - 1, chunk_size)) {
+        return false;
+    }
+    if(data_.empty()) {
+        offset_ = offset;
+        data_.reserve(capacity);
+        dirty_++;
+    }
+    data_.insert(data_.end(), buf, buf + count);
+    return true;
+}
+
+bool
+WriteBackBuffer::full(size_t capacity, size_t chunk_size) const {
+    if(data_.empty()) {
+        return false;
+    }
+    return data_.size() >= capacity ||
+           gkfs::utils::arithmetic::block_overrun(end(), chunk_size) == 0;
+}
+
+void
+WriteBackBuffer::clear() {
+    if(!data_.empty()) {
+        data_.clear();
+        dirty_--;
+    }
+}
+
 // OpenFileMap starts here
 
+OpenFileMap::OpenFileMap()
+    : OpenFileMap(gkfs::config::filemap::fd_base,
+                  gkfs::config::filemap::fd_table_size) {}
+
+OpenFileMap::OpenFileMap(int fd_base, int capacity)
+    : fd_base_(fd_base), capacity_(capacity),
+      slots_(make_unique<Slot[]>(capacity)),
+      occupied_(make_unique<atomic<uint64_t>[]>((capacity + 63) / 64)),
+      overflow_fd_idx_(fd_base + capacity) {}
+
+OpenFileMap::Slot*
+OpenFileMap::slot_(const int fd) {
+    if(fd < fd_base_ || fd - fd_base_ >= capacity_) {
+        return nullptr;
+    }
+    return &slots_[fd - fd_base_];
+}
+
+int
+OpenFileMap::claim_slot_() {
+    auto capacity = static_cast<unsigned int>(capacity_);
+    for(unsigned int i = 0; i < capacity; i++) {
+        auto idx = next_slot_.fetch_add(1, memory_order_relaxed) % capacity;
+        auto expected = SlotState::free;
+        if(slots_[idx].state.compare_exchange_strong(
+                   expected, SlotState::reserved, memory_order_acquire)) {
+            return static_cast<int>(idx);
+        }
+    }
+    return -1;
+}
+
+shared_ptr<OpenFile>
+OpenFileMap::load_(Slot& slot) {
+    if(slot.state.load(memory_order_acquire) != SlotState::open) {
+        return nullptr;
+    }
+    shared_ptr<OpenFile> file;
+    // the reader count and the state are sequentially consistent so that
+    // either this reader sees the slot as reserved or the writer sees the
+    // reader and waits for it
+    slot.readers.fetch_add(1);
+    if(slot.state.load() == SlotState::open) {
+        file = slot.file;
+    }
+    slot.readers.fetch_sub(1, memory_order_release);
+    return file;
+}
+
+void
+OpenFileMap::wait_for_readers_(Slot& slot) {
+    while(slot.readers.load() != 0) {
+        this_thread::yield();
+    }
+}
+
+void
+OpenFileMap::publish_(int idx, shared_ptr<OpenFile> open_file) {
+    auto& slot = slots_[idx];
+    wait_for_readers_(slot);
+    slot.file = std::move(open_file);
+    slot.state.store(SlotState::open, memory_order_release);
+    occupied_[idx / 64].fetch_or(uint64_t{1} << (idx % 64),
+                                 memory_order_release);
+}
+
+int
+OpenFileMap::add_overflow_(shared_ptr<OpenFile> open_file) {
+    lock_guard<mutex> lock(overflow_mutex_);
+    int fd;
+    // skip file descriptors that are still in use after a wrap around or dup2()
+    do {
+        fd = overflow_fd_idx_;
+        if(overflow_fd_idx_ == numeric_limits<int>::max()) {
+            LOG(WARNING,
+                "File descriptor index exceeded ints max value. Setting it back to {}",
+                fd_base_ + capacity_);
+            overflow_fd_idx_ = fd_base_ + capacity_;
+        } else {
+            overflow_fd_idx_++;
+        }
+    } while(overflow_.count(fd) != 0);
+    overflow_.emplace(fd, std::move(open_file));
+    overflow_size_.store(overflow_.size(), memory_order_release);
+    return fd;
+}
+
 shared_ptr<OpenFile>
 OpenFileMap::get(int fd) {
-    lock_guard<recursive_mutex> lock(files_mutex_);
-    auto f = files_.find(fd);
-    if(f == files_.end()) {
+    auto slot = slot_(fd);
+    if(slot != nullptr) {
+        return load_(*slot);
+    }
+    // kernel file descriptors end up here. Do not lock unless dup2() was used
+    if(overflow_size_.load(memory_order_acquire) == 0) {
+        return nullptr;
+    }
+    lock_guard<mutex> lock(overflow_mutex_);
+    auto f = overflow_.find(fd);
+    if(f == overflow_.end()) {
         return nullptr;
     } else {
         return f->second;
@@ -123,74 +315,93 @@ OpenFileMap::get_dir(int dirfd) {
     return static_pointer_cast<OpenDir>(f);
 }
 
-bool
-OpenFileMap::exist(const int fd) {
-    lock_guard<recursive_mutex> lock(files_mutex_);
-    auto f = files_.find(fd);
-    return !(f == files_.end());
+vector<shared_ptr<OpenFile>>
+OpenFileMap::get_all() {
+    vector<shared_ptr<OpenFile>> files;
+    for(int word = 0; word < (capacity_ + 63) / 64; word++) {
+        auto bits = occupied_[word].load(memory_order_acquire);
+        while(bits != 0) {
+            auto bit = __builtin_ctzll(bits);
+            bits &= bits - 1;
+            auto file = load_(slots_[word * 64 + bit]);
+            if(file != nullptr) {
+                files.emplace_back(std::move(file));
+            }
+        }
+    }
+    if(overflow_size_.load(memory_order_acquire) != 0) {
+        lock_guard<mutex> lock(overflow_mutex_);
+        for(const auto& [fd, file] : overflow_) {
+            files.emplace_back(file);
+        }
+    }
+    return files;
 }
 
-int
-OpenFileMap::safe_generate_fd_idx_() {
-    auto fd = generate_fd_idx();
-    /*
-     * Check if fd is still in use and generate another if yes
-     * Note that this can only happen once the all fd indices within the int has
-     * been used to the int::max Once this limit is exceeded, we set fd_idx back
-     * to 3 and begin anew. Only then, if a file was open for a long time will
-     * we have to generate another index.
-     *
-     * This situation can only occur when all fd indices have been given away
-     * once and we start again, in which case the fd_validation_needed flag is
-     * set. fd_validation is set to false, if
-     */
-    if(fd_validation_needed) {
-        while(exist(fd)) {
-            fd = generate_fd_idx();
-        }
+bool
+OpenFileMap::exist(const int fd) {
+    auto slot = slot_(fd);
+    if(slot != nullptr) {
+        return slot->state.load(memory_order_acquire) == SlotState::open;
     }
-    return fd;
+    if(overflow_size_.load(memory_order_acquire) == 0) {
+        return false;
+    }
+    lock_guard<mutex> lock(overflow_mutex_);
+    return overflow_.count(fd) != 0;
 }
 
 int
 OpenFileMap::add(std::shared_ptr<OpenFile> open_file) {
-    auto fd = safe_generate_fd_idx_();
-    lock_guard<recursive_mutex> lock(files_mutex_);
-    files_.insert(make_pair(fd, open_file));
-    return fd;
+    auto idx = claim_slot_();
+    if(idx == -1) {
+        // all slots are taken
+        return add_overflow_(std::move(open_file));
+    }
+    publish_(idx, std::move(open_file));
+    return fd_base_ + idx;
 }
 
 bool
 OpenFileMap::remove(const int fd) {
-    lock_guard<recursive_mutex> lock(files_mutex_);
-    auto f = files_.find(fd);
-    if(f == files_.end()) {
-        return false;
+    auto slot = slot_(fd);
+    if(slot != nullptr) {
+        // only one of concurrent removes of the same fd succeeds
+        auto expected = SlotState::open;
+        if(!slot->state.compare_exchange_strong(expected, SlotState::reserved)) {
+            return false;
+        }
+        wait_for_readers_(*slot);
+        // cleared while the slot is reserved so that a new open file of the
+        // slot cannot lose its bit
+        auto idx = fd - fd_base_;
+        occupied_[idx / 64].fetch_and(~(uint64_t{1} << (idx % 64)),
+                                      memory_order_release);
+        // the open file is released after the slot is available again
+        auto file = std::move(slot->file);
+        slot->state.store(SlotState::free, memory_order_release);
+        return true;
     }
-    files_.erase(fd);
-    if(fd_validation_needed && files_.empty()) {
-        fd_validation_needed = false;
-        LOG(DEBUG, "fd_validation flag reset");
+    lock_guard<mutex> lock(overflow_mutex_);
+    if(overflow_.erase(fd) == 0) {
+        return false;
     }
+    overflow_size_.store(overflow_.size(), memory_order_release);
     return true;
 }
 
 int
 OpenFileMap::dup(const int oldfd) {
-    lock_guard<recursive_mutex> lock(files_mutex_);
     auto open_file = get(oldfd);
     if(open_file == nullptr) {
         errno = EBADF;
         return -1;
     }
-    auto newfd = safe_generate_fd_idx_();
-    files_.insert(make_pair(newfd, open_file));
-    return newfd;
+    return add(std::move(open_file));
 }
 
 int
 OpenFileMap::dup2(const int oldfd, const int newfd) {
-    lock_guard<recursive_mutex> lock(files_mutex_);
     auto open_file = get(oldfd);
     if(open_file == nullptr) {
         errno = EBADF;
@@ -198,45 +409,23 @@ OpenFileMap::dup2(const int oldfd, const int newfd) {
     }
     if(oldfd == newfd)
         return newfd;
-    // remove newfd if exists in filemap silently
-    if(exist(newfd)) {
-        remove(newfd);
-    }
-    // to prevent duplicate fd idx in the future. First three fd are reservered
-    // by os streams that we do not overwrite
-    if(get_fd_idx() < newfd && newfd != 0 && newfd != 1 && newfd != 2)
-        fd_validation_needed = true;
-    files_.insert(make_pair(newfd, open_file));
+    // replace the open file of newfd silently if it exists
+    auto slot = slot_(newfd);
+    if(slot != nullptr) {
+        auto expected = SlotState::free;
+        while(!slot->state.compare_exchange_weak(expected,
+                                                 SlotState::reserved)) {
+            // a concurrent add() or remove() is about to finish with the slot
+            if(expected == SlotState::reserved)
+                expected = SlotState::free;
+        }
+        publish_(newfd - fd_base_, std::move(open_file));
+        return newfd;
+    }
+    lock_guard<mutex> lock(overflow_mutex_);
+    overflow_[newfd] = std::move(open_file);
+    overflow_size_.store(overflow_.size(), memory_order_release);
     return newfd;
 }
 
-/**
- * Generate new file descriptor index to be used as an fd within one process
- * @return fd_idx
- */
-int
-OpenFileMap::generate_fd_idx() {
-    // We need a mutex here for thread safety
-    std::lock_guard<std::mutex> inode_lock(fd_idx_mutex);
-    if(fd_idx == std::numeric_limits<int>::max()) {
-        LOG(WARNING,
-            "File descriptor index exceeded ints max value. Setting it back to 100000");
-        /*
-         * Setting fd_idx back to 3 could have the effect that fd are given
-         * twice for different path. This must not happen. Instead a flag is set
-         * which tells can tell the OpenFileMap that it should check if this fd
-         * is really safe to use.
-         */
-        fd_idx = 100000;
-        fd_validation_needed = true;
-    }
-    return fd_idx++;
-}
-
-int
-OpenFileMap::get_fd_idx() {
-    std::lock_guard<std::mutex> inode_lock(fd_idx_mutex);
-    return fd_idx;
-}
-
-} // namespace gkfs::filemap
\ No newline at end of file
+} // namespace gkfs::filemap
@@ -35,10 +35,12 @@
 #include <common/path_util.hpp>
 
 #include <stack>
+#include <string_view>
 #include <utility>
 #include <vector>
 #include <string>
 #include <cassert>
+#include <cstring>
 
 #ifndef BYPASS_SYSCALL
 #include <libsyscall_intercept_hook_point.h>
@@ -200,6 +202,52 @@ resolve_new(const string& path) {
     return make_pair(false, resolved);
 }
 
+bool
+is_certainly_external(const char* raw_path) {
+#if defined(GKFS_USE_LEGACY_PATH_RESOLVE) ||                                   \
+        defined(GKFS_FOLLOW_EXTERNAL_SYMLINKS)
+    // an external symlink may point into the mount directory
+    return false;
+#else
+    if(raw_path == nullptr || raw_path[0] == '\0' || raw_path[0] == '.') {
+        return false;
+    }
+    for(auto c = raw_path; *c != '\0'; c++) {
+        if(c[0] == path::separator &&
+           (c[1] == path::separator || c[1] == '.')) {
+            return false;
+        }
+    }
+    // Without these components, the resolved path is the raw path (relative to
+    // the cwd) without a trailing separator. As resolve_new(), only compare
+    // the mount directory with its beginning.
+    const string_view mountdir(CTX->mountdir());
+    if(raw_path[0] == path::separator) {
+        return strncmp(raw_path, mountdir.data(), mountdir.size()) != 0;
+    }
+    const string_view cwd(CTX->cwd());
+    if(cwd.empty()) {
+        return false;
+    }
+    auto cwd_head = cwd.substr(0, mountdir.size());
+    if(mountdir.compare(0, cwd_head.size(), cwd_head) != 0) {
+        return true;
+    }
+    if(cwd.size() >= mountdir.size()) {
+        // the cwd is inside the mount directory
+        return false;
+    }
+    auto mountdir_tail = mountdir.substr(cwd.size());
+    if(cwd.back() != path::separator) {
+        if(mountdir_tail.front() != path::separator) {
+            return true;
+        }
+        mountdir_tail.remove_prefix(1);
+    }
+    return strncmp(raw_path, mountdir_tail.data(), mountdir_tail.size()) != 0;
+#endif
+}
+
 /** Resolve path to its canonical representation
  *
  * Populate `resolved` with the canonical representation of `path`.
@@ -34,6 +34,7 @@
 #include <client/preload_util.hpp>
 #include <client/intercept.hpp>
 #include <client/cache.hpp>
+#include <client/gkfs_functions.hpp>
 
 #include <common/rpc/distributor.hpp>
 #include <common/common_defs.hpp>
@@ -41,6 +42,8 @@
 #include <common/msgpack_util.hpp>
 #endif
 
+#include <algorithm>
+#include <chrono>
 #include <ctime>
 #include <cstdlib>
 #include <fstream>
@@ -229,36 +232,6 @@ init_environment() {
                        "Failed to connect to hosts: "s + e.what());
     }
 
-    /* Setup distributor */
-    auto forwarding_map_file = gkfs::env::get_var(
-            gkfs::env::FORWARDING_MAP_FILE, gkfs::config::forwarding_file_path);
-
-    if(!forwarding_map_file.empty()) {
-        try {
-            gkfs::utils::load_forwarding_map();
-
-            LOG(INFO, "{}() Forward to {}", __func__, CTX->fwd_host_id());
-        } catch(std::exception& e) {
-            exit_error_msg(EXIT_FAILURE,
-                           fmt::format("Unable set the forwarding host '{}'",
-                                       e.what()));
-        }
-
-        auto forwarder_dist = std::make_shared<gkfs::rpc::ForwarderDistributor>(
-                CTX->fwd_host_id(), CTX->hosts().size());
-        CTX->distributor(forwarder_dist);
-    } else {
-
-#ifdef GKFS_USE_GUIDED_DISTRIBUTION
-        auto distributor = std::make_shared<gkfs::rpc::GuidedDistributor>(
-                CTX->local_host_id(), CTX->hosts().size());
-#else
-        auto distributor = std::make_shared<gkfs::rpc::SimpleHashDistributor>(
-                CTX->local_host_id(), CTX->hosts().size());
-#endif
-        CTX->distributor(distributor);
-    }
-
     auto use_dcache = gkfs::env::get_var(gkfs::env::cache::DENTRY,
                                          gkfs::config::cache::use_dentry_cache
                                                  ? "ON"
@@ -319,6 +292,149 @@ init_environment() {
         }
     }
 
+    auto use_async_size_update =
+            gkfs::env::get_var(gkfs::env::ASYNC_SIZE_UPDATE,
+                               gkfs::config::io::async_size_update ? "ON"
+                                                                   : "OFF") ==
+            "ON";
+    CTX->use_async_size_update(use_async_size_update);
+    LOG(INFO, "Asynchronous file size updates on write are {}.",
+        use_async_size_update ? "enabled" : "disabled");
+
+    auto use_async_create =
+            gkfs::env::get_var(gkfs::env::ASYNC_CREATE,
+                               gkfs::config::metadata::async_create ? "ON"
+                                                                    : "OFF") ==
+            "ON";
+    CTX->use_async_create(use_async_create);
+    LOG(INFO, "Asynchronous file creates are {}.",
+        use_async_create ? "enabled" : "disabled");
+
+    auto use_write_back_buffer =
+            gkfs::env::get_var(gkfs::env::cache::WRITE_BACK,
+                               gkfs::config::cache::use_write_back_buffer
+                                       ? "ON"
+                                       : "OFF") == "ON";
+    if(use_write_back_buffer) {
+        auto env_size =
+                gkfs::env::get_var(gkfs::env::cache::WRITE_BACK_SIZE,
+                                   gkfs::config::cache::write_back_buffer_size);
+        // a buffered extent never spans more than one chunk
+        auto write_back_buffer_size = static_cast<size_t>(
+                std::clamp(env_size, 0, gkfs::config::rpc::chunksize));
+        if(write_back_buffer_size == 0) {
+            LOG(WARNING,
+                "Write-back buffer is enabled but its size is set to 0. Buffer is disabled as a result.");
+            use_write_back_buffer = false;
+        } else {
+            CTX->write_back_buffer_size(write_back_buffer_size);
+            LOG(INFO, "Write-back buffer enabled with '{}' bytes per file",
+                write_back_buffer_size);
+        }
+    } else {
+        LOG(INFO, "Write-back buffer is disabled.");
+    }
+    CTX->use_write_back_buffer(use_write_back_buffer);
+
+    auto use_chunk_cache =
+            gkfs::env::get_var(gkfs::env::cache::CHUNK,
+                               gkfs::config::cache::use_chunk_cache ? "ON"
+                                                                    : "OFF") ==
+            "ON";
+    if(use_chunk_cache) {
+        auto cache_size = static_cast<size_t>(std::max(
+                gkfs::env::get_var(gkfs::env::cache::CHUNK_SIZE,
+                                   gkfs::config::cache::chunk_cache_size),
+                0));
+        auto read_ahead = static_cast<uint64_t>(std::max(
+                gkfs::env::get_var(
+                        gkfs::env::cache::CHUNK_READ_AHEAD,
+                        gkfs::config::cache::chunk_cache_max_read_ahead),
+                0));
+        if(cache_size * 1024 * 1024 < gkfs::config::rpc::chunksize) {
+            LOG(WARNING,
+                "Chunk cache is enabled but its size is smaller than a chunk. Cache is disabled as a result.");
+            use_chunk_cache = false;
+        } else {
+            CTX->chunk_cache(std::make_shared<gkfs::cache::file::ChunkCache>(
+                    gkfs::config::rpc::chunksize, cache_size * 1024 * 1024,
+                    read_ahead));
+            LOG(INFO,
+                "Chunk cache enabled with '{}' MiB and up to '{}' read-ahead chunks",
+                cache_size, read_ahead);
+        }
+    } else {
+        LOG(INFO, "Chunk cache is disabled.");
+    }
+    CTX->use_chunk_cache(use_chunk_cache);
+
+    auto use_stat_cache =
+            gkfs::env::get_var(gkfs::env::cache::STAT,
+                               gkfs::config::cache::use_stat_cache ? "ON"
+                                                                   : "OFF") ==
+            "ON";
+    if(use_stat_cache) {
+        auto ttl = std::max(
+                gkfs::env::get_var(gkfs::env::cache::STAT_TTL,
+                                   gkfs::config::cache::stat_cache_ttl),
+                0);
+        auto max_entries = static_cast<size_t>(std::max(
+                gkfs::env::get_var(gkfs::env::cache::STAT_SIZE,
+                                   gkfs::config::cache::stat_cache_size),
+                0));
+        if(ttl == 0 || max_entries == 0) {
+            LOG(WARNING,
+                "Stat cache is enabled but its TTL or size is set to 0. Cache is disabled as a result.");
+            use_stat_cache = false;
+        } else {
+            CTX->stat_cache(std::make_shared<gkfs::cache::file::StatCache>(
+                    std::chrono::milliseconds(ttl), max_entries));
+            CTX->stat_cache_prefill(
+                    gkfs::env::get_var(
+                            gkfs::env::cache::STAT_PREFILL,
+                            gkfs::config::cache::stat_cache_prefill ? "ON"
+                                                                    : "OFF") ==
+                    "ON");
+            LOG(INFO,
+                "Stat cache enabled with a TTL of '{}' ms and up to '{}' entries",
+                ttl, max_entries);
+        }
+    } else {
+        LOG(INFO, "Stat cache is disabled.");
+    }
+    CTX->use_stat_cache(use_stat_cache);
+
+    auto use_registration_cache =
+            gkfs::env::get_var(gkfs::env::cache::REGISTRATION,
+                               gkfs::config::cache::use_registration_cache
+                                       ? "ON"
+                                       : "OFF") == "ON";
+    if(use_registration_cache) {
+        auto max_entries = static_cast<size_t>(std::max(
+                gkfs::env::get_var(gkfs::env::cache::REGISTRATION_SIZE,
+                                   gkfs::config::cache::registration_cache_size),
+                0));
+        if(max_entries == 0) {
+            LOG(WARNING,
+                "Registration cache is enabled but its size is set to 0. Cache is disabled as a result.");
+            use_registration_cache = false;
+        } else {
+            size_t max_region =
+                    static_cast<size_t>(
+                            gkfs::config::cache::registration_cache_max_region)
+                    << 20;
+            CTX->registration_cache(
+                    std::make_shared<gkfs::cache::buffer::RegistrationCache>(
+                            max_entries, max_region));
+            LOG(INFO,
+                "Registration cache enabled with up to '{}' buffers of at most '{}' bytes",
+                max_entries, max_region);
+        }
+    } else {
+        LOG(INFO, "Registration cache is disabled.");
+    }
+    CTX->use_registration_cache(use_registration_cache);
+
     LOG(INFO, "Retrieving file system configuration...");
 
     if(!gkfs::rpc::forward_get_fs_config()) {
@@ -326,6 +442,44 @@ init_environment() {
                 EXIT_FAILURE,
                 "Unable to fetch file system configurations from daemon process through RPC.");
     }
+
+    /* Setup distributor */
+    auto forwarding_map_file = gkfs::env::get_var(
+            gkfs::env::FORWARDING_MAP_FILE, gkfs::config::forwarding_file_path);
+
+    if(!forwarding_map_file.empty()) {
+        try {
+            gkfs::utils::load_forwarding_map();
+
+            LOG(INFO, "{}() Forward to {}", __func__, CTX->fwd_host_id());
+        } catch(std::exception& e) {
+            exit_error_msg(EXIT_FAILURE,
+                           fmt::format("Unable set the forwarding host '{}'",
+                                       e.what()));
+        }
+
+        auto forwarder_dist = std::make_shared<gkfs::rpc::ForwarderDistributor>(
+                CTX->fwd_host_id(), CTX->hosts().size());
+        CTX->distributor(forwarder_dist);
+    } else {
+
+#ifdef GKFS_USE_GUIDED_DISTRIBUTION
+        auto distributor = std::make_shared<gkfs::rpc::GuidedDistributor>(
+                CTX->local_host_id(), CTX->hosts().size());
+#else
+        std::shared_ptr<gkfs::rpc::Distributor> distributor;
+        if(CTX->fs_conf()->distributor == gkfs::rpc::jump_hash_distributor) {
+            distributor = std::make_shared<gkfs::rpc::JumpHashDistributor>(
+                    CTX->local_host_id(), CTX->hosts().size());
+        } else {
+            distributor = std::make_shared<gkfs::rpc::SimpleHashDistributor>(
+                    CTX->local_host_id(), CTX->hosts().size());
+        }
+        LOG(INFO, "Data distribution: '{}'", CTX->fs_conf()->distributor);
+#endif
+        CTX->distributor(distributor);
+    }
+
     // Initialize random number generator and seed for replica selection
     // in case of failure, a new replica will be selected
     if(CTX->get_replicas() > 0) {
@@ -396,6 +550,27 @@ init_preload() {
  */
 void
 destroy_preload() {
+    // send creates of files that were never accessed
+    if(CTX->use_async_create()) {
+        gkfs::syscall::gkfs_flush_creates();
+    }
+    // write back data of files that the application did not close
+    if(CTX->use_write_back_buffer()) {
+        gkfs::syscall::gkfs_flush_write_back();
+    }
+    if(CTX->use_chunk_cache()) {
+        LOG(INFO, "Chunk cache hits: '{}', misses: '{}'",
+            CTX->chunk_cache()->hits(), CTX->chunk_cache()->misses());
+    }
+    if(CTX->use_stat_cache()) {
+        LOG(INFO, "Stat cache hits: '{}', misses: '{}'",
+            CTX->stat_cache()->hits(), CTX->stat_cache()->misses());
+    }
+    if(CTX->use_registration_cache()) {
+        LOG(INFO, "Registration cache hits: '{}', misses: '{}'",
+            CTX->registration_cache()->hits(),
+            CTX->registration_cache()->misses());
+    }
     auto forwarding_map_file = gkfs::env::get_var(
             gkfs::env::FORWARDING_MAP_FILE, gkfs::config::forwarding_file_path);
     if(!forwarding_map_file.empty()) {
@@ -416,6 +591,10 @@ destroy_preload() {
         LOG(DEBUG, "Shutting down IPC subsystem");
         ld_proxy_service.reset();
     }
+    // cached buffers must be unexposed before the engine is shut down
+    if(CTX->use_registration_cache()) {
+        CTX->registration_cache()->clear();
+    }
     LOG(DEBUG, "Shutting down RPC subsystem");
     ld_network_service.reset();
     LOG(DEBUG, "RPC subsystem shut down");
@@ -449,6 +628,9 @@ gkfs_init() {
 
 extern "C" int
 gkfs_end() {
+    if(CTX->use_async_create()) {
+        gkfs::syscall::gkfs_flush_creates();
+    }
     CTX->clear_hosts();
     LOG(DEBUG, "Peer information deleted");
 
@@ -33,6 +33,7 @@
 #include <client/open_file_map.hpp>
 #include <client/open_dir.hpp>
 #include <client/path.hpp>
+#include <client/preload_util.hpp>
 
 #include <common/env_util.hpp>
 #include <common/path_util.hpp>
@@ -225,11 +226,44 @@ PreloadContext::hosts() const {
 void
 PreloadContext::hosts(const std::vector<hermes::endpoint>& endpoints) {
     hosts_ = endpoints;
+    lazy_hosts_ = false;
+    hosts_uris_.clear();
+    hosts_found_.reset();
+    hosts_lookup_mutexes_.reset();
+}
+
+void
+PreloadContext::lazy_hosts(const std::vector<std::string>& uris) {
+    hosts_.assign(uris.size(), hermes::endpoint{});
+    hosts_uris_ = uris;
+    hosts_found_ = std::make_unique<std::atomic<bool>[]>(uris.size());
+    hosts_lookup_mutexes_ = std::make_unique<std::mutex[]>(uris.size());
+    lazy_hosts_ = true;
+}
+
+const hermes::endpoint&
+PreloadContext::host(uint64_t id) {
+    auto& endp = hosts_.at(id);
+    if(!lazy_hosts_ || hosts_found_[id].load(std::memory_order_acquire)) {
+        return endp;
+    }
+    // concurrent callers for the same daemon wait for a single lookup
+    std::lock_guard<std::mutex> lock(hosts_lookup_mutexes_[id]);
+    if(!hosts_found_[id].load(std::memory_order_relaxed)) {
+        endp = gkfs::utils::lookup_endpoint(hosts_uris_[id]);
+        LOG(DEBUG, "Found peer: {}", endp.to_string());
+        hosts_found_[id].store(true, std::memory_order_release);
+    }
+    return endp;
 }
 
 void
 PreloadContext::clear_hosts() {
     hosts_.clear();
+    lazy_hosts_ = false;
+    hosts_uris_.clear();
+    hosts_found_.reset();
+    hosts_lookup_mutexes_.reset();
 }
 
 uint64_t
@@ -454,6 +488,120 @@ PreloadContext::use_write_size_cache(bool use_write_size_cache) {
     use_write_size_cache_ = use_write_size_cache;
 }
 
+bool
+PreloadContext::use_async_size_update() const {
+    return use_async_size_update_;
+}
+
+void
+PreloadContext::use_async_size_update(bool use_async_size_update) {
+    use_async_size_update_ = use_async_size_update;
+}
+
+bool
+PreloadContext::use_async_create() const {
+    return use_async_create_;
+}
+
+void
+PreloadContext::use_async_create(bool use_async_create) {
+    use_async_create_ = use_async_create;
+}
+
+bool
+PreloadContext::use_write_back_buffer() const {
+    return use_write_back_buffer_;
+}
+
+void
+PreloadContext::use_write_back_buffer(bool use_write_back_buffer) {
+    use_write_back_buffer_ = use_write_back_buffer;
+}
+
+size_t
+PreloadContext::write_back_buffer_size() const {
+    return write_back_buffer_size_;
+}
+
+void
+PreloadContext::write_back_buffer_size(size_t write_back_buffer_size) {
+    write_back_buffer_size_ = write_back_buffer_size;
+}
+
+std::shared_ptr<gkfs::cache::file::ChunkCache>
+PreloadContext::chunk_cache() const {
+    return chunk_cache_;
+}
+
+void
+PreloadContext::chunk_cache(
+        std::shared_ptr<gkfs::cache::file::ChunkCache> chunk_cache) {
+    chunk_cache_ = chunk_cache;
+}
+
+bool
+PreloadContext::use_chunk_cache() const {
+    return use_chunk_cache_;
+}
+
+void
+PreloadContext::use_chunk_cache(bool use_chunk_cache) {
+    use_chunk_cache_ = use_chunk_cache;
+}
+
+std::shared_ptr<gkfs::cache::file::StatCache>
+PreloadContext::stat_cache() const {
+    return stat_cache_;
+}
+
+void
+PreloadContext::stat_cache(
+        std::shared_ptr<gkfs::cache::file::StatCache> stat_cache) {
+    stat_cache_ = stat_cache;
+}
+
+bool
+PreloadContext::use_stat_cache() const {
+    return use_stat_cache_;
+}
+
+void
+PreloadContext::use_stat_cache(bool use_stat_cache) {
+    use_stat_cache_ = use_stat_cache;
+}
+
+bool
+PreloadContext::stat_cache_prefill() const {
+    return stat_cache_prefill_;
+}
+
+void
+PreloadContext::stat_cache_prefill(bool stat_cache_prefill) {
+    stat_cache_prefill_ = stat_cache_prefill;
+}
+
+std::shared_ptr<gkfs::cache::buffer::RegistrationCache>
+PreloadContext::registration_cache() const {
+    return registration_cache_;
+}
+
+void
+PreloadContext::registration_cache(
+        std::shared_ptr<gkfs::cache::buffer::RegistrationCache>
+                registration_cache) {
+    registration_cache_ = registration_cache;
+}
+
+bool
+PreloadContext::use_registration_cache() const {
+    return use_registration_cache_;
+}
+
+void
+PreloadContext::use_registration_cache(bool use_registration_cache) {
+    use_registration_cache_ = use_registration_cache;
+}
+
 void
 PreloadContext::enable_interception() {
     interception_enabled_ = true;
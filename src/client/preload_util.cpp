@@ -56,49 +56,6 @@ using namespace std;
 
 namespace {
 
-/**
- * Looks up a host endpoint via Hermes
- * @param uri
- * @param max_retries
- * @return hermes endpoint, if successful
- * @throws std::runtime_error
- */
-hermes::endpoint
-lookup_endpoint(const std::string& uri, bool use_proxy = false,
-                std::size_t max_retries = 3) {
-
-    LOG(DEBUG, "Looking up address \"{}\"", uri);
-
-    std::random_device rd; // obtain a random number from hardware
-    std::size_t attempts = 0;
-    std::string error_msg;
-
-    do {
-        try {
-            if(use_proxy)
-                return ld_proxy_service->lookup(uri);
-            else
-                return ld_network_service->lookup(uri);
-        } catch(const exception& ex) {
-            error_msg = ex.what();
-
-            LOG(WARNING, "Failed to lookup address '{}'. Attempts [{}/{}]", uri,
-                attempts + 1, max_retries);
-
-            // Wait a random amount of time and try again
-            std::mt19937 g(rd()); // seed the random generator
-            std::uniform_int_distribution<> distr(
-                    50, 50 * (attempts + 2)); // define the range
-            std::this_thread::sleep_for(std::chrono::milliseconds(distr(g)));
-            continue;
-        }
-    } while(++attempts < max_retries);
-
-    throw std::runtime_error(
-            fmt::format("Endpoint for address '{}' could not be found ({})",
-                        uri, error_msg));
-}
-
 /**
  * extracts protocol from a given URI generated by the RPC server of the daemon
  * @param uri
@@ -195,10 +152,99 @@ load_hostfile(const std::string& path) {
     return hosts;
 }
 
+/**
+ * Sends a stat request for a path or serves it from the stat cache if enabled
+ * @param path
+ * @param md set to the path's metadata
+ * @param try_replicas retry on the other metadata replicas on failure
+ * @return error code
+ */
+int
+stat_path(const std::string& path, gkfs::metadata::Metadata& md,
+          bool try_replicas) {
+    uint64_t epoch = 0;
+    if(CTX->use_stat_cache()) {
+        auto cached = CTX->stat_cache()->get(path);
+        if(cached) {
+            LOG(DEBUG, "{}(): Stat cache hit for file '{}'", __func__, path);
+            md = *cached;
+            return 0;
+        }
+        epoch = CTX->stat_cache()->epoch();
+    }
+    std::string attr;
+    int err{};
+    if(gkfs::config::proxy::fwd_stat && CTX->use_proxy()) {
+        err = gkfs::rpc::forward_stat_proxy(path, attr);
+    } else {
+        err = gkfs::rpc::forward_stat(path, attr, 0);
+        // TODO: retry on failure
+        if(err && try_replicas) {
+            auto copy = 1;
+            while(copy < CTX->get_replicas() + 1 && err) {
+                LOG(ERROR, "Retrying Stat on replica {}", copy);
+                err = gkfs::rpc::forward_stat(path, attr, copy);
+                copy++;
+            }
+        }
+    }
+    if(err) {
+        return err;
+    }
+    md = gkfs::metadata::Metadata{attr};
+    if(CTX->use_stat_cache()) {
+        CTX->stat_cache()->insert(path, md, epoch);
+    }
+    return 0;
+}
+
 } // namespace
 
 namespace gkfs::utils {
 
+/**
+ * Looks up a host endpoint via Hermes
+ * @param uri
+ * @param use_proxy look up the address with the proxy's Hermes instance
+ * @param max_retries
+ * @return hermes endpoint, if successful
+ * @throws std::runtime_error
+ */
+hermes::endpoint
+lookup_endpoint(const std::string& uri, bool use_proxy,
+                std::size_t max_retries) {
+
+    LOG(DEBUG, "Looking up address \"{}\"", uri);
+
+    std::random_device rd; // obtain a random number from hardware
+    std::size_t attempts = 0;
+    std::string error_msg;
+
+    do {
+        try {
+            if(use_proxy)
+                return ld_proxy_service->lookup(uri);
+            else
+                return ld_network_service->lookup(uri);
+        } catch(const exception& ex) {
+            error_msg = ex.what();
+
+            LOG(WARNING, "Failed to lookup address '{}'. Attempts [{}/{}]", uri,
+                attempts + 1, max_retries);
+
+            // Wait a random amount of time and try again
+            std::mt19937 g(rd()); // seed the random generator
+            std::uniform_int_distribution<> distr(
+                    50, 50 * (attempts + 2)); // define the range
+            std::this_thread::sleep_for(std::chrono::milliseconds(distr(g)));
+            continue;
+        }
+    } while(++attempts < max_retries);
+
+    throw std::runtime_error(
+            fmt::format("Endpoint for address '{}' could not be found ({})",
+                        uri, error_msg));
+}
 
 /**
  * Retrieve metadata from daemon and return Metadata object
@@ -209,8 +255,6 @@ namespace gkfs::utils {
  */
 optional<gkfs::metadata::Metadata>
 get_metadata(const string& path, bool follow_links) {
-    std::string attr;
-    int err{};
     // Use file metadata from dentry cache if available
     if(CTX->use_dentry_cache()) {
         // get parent and filename path to retrieve the cache entry
@@ -232,43 +276,25 @@ get_metadata(const string& path, bool follow_links) {
             return md;
         }
     }
-    if(gkfs::config::proxy::fwd_stat && CTX->use_proxy()) {
-        err = gkfs::rpc::forward_stat_proxy(path, attr);
-    } else {
-        err = gkfs::rpc::forward_stat(path, attr, 0);
-        // TODO: retry on failure
-        if(err) {
-            auto copy = 1;
-            while(copy < CTX->get_replicas() + 1 && err) {
-                LOG(ERROR, "Retrying Stat on replica {} {}", copy,
-                    follow_links);
-                err = gkfs::rpc::forward_stat(path, attr, copy);
-                copy++;
-            }
-        }
-    }
+    gkfs::metadata::Metadata md{};
+    auto err = stat_path(path, md, true);
     if(err) {
         errno = err;
         return {};
     }
 #ifdef HAS_SYMLINKS
     if(follow_links) {
-        gkfs::metadata::Metadata md{attr};
         while(md.is_link()) {
-            if(gkfs::config::proxy::fwd_stat && CTX->use_proxy()) {
-                err = gkfs::rpc::forward_stat_proxy(md.target_path(), attr);
-            } else {
-                err = gkfs::rpc::forward_stat(md.target_path(), attr, 0);
-            }
+            auto target = md.target_path();
+            err = stat_path(target, md, false);
             if(err) {
                 errno = err;
                 return {};
             }
-            md = gkfs::metadata::Metadata{attr};
         }
     }
 #endif
-    return gkfs::metadata::Metadata{attr};
+    return md;
 }
 
 
@@ -343,6 +369,19 @@ update_file_size(const std::string& path, size_t count, off64_t offset,
     return ret_offset;
 }
 
+std::function<pair<int, off64_t>()>
+update_file_size_async(const std::string& path, size_t count, off64_t offset) {
+    LOG(DEBUG, "{}() path: '{}', count: '{}', offset: '{}'", __func__, path,
+        count, offset);
+    if(gkfs::config::proxy::fwd_update_size && CTX->use_proxy()) {
+        // the proxy does not provide a non-blocking update
+        auto ret_offset = update_file_size(path, count, offset, false);
+        return [ret_offset] { return ret_offset; };
+    }
+    return gkfs::rpc::forward_update_metadentry_size_async(
+            path, count, offset, false, CTX->get_replicas());
+}
+
 map<string, uint64_t>
 load_forwarding_map_file(const std::string& lfpath) {
 
@@ -438,14 +477,46 @@ read_hosts_file() {
 }
 
 /**
- * Connects to daemons and lookup Mercury URI addresses via Hermes
+ * Connects to daemons and lookup Mercury URI addresses via Hermes. Addresses
+ * are looked up concurrently or, in lazy mode, on first use except for the
+ * local daemon.
  * @param hosts vector<pair<hostname, Mercury URI address>>
  * @throws std::runtime_error through lookup_endpoint()
  */
 void
 connect_to_hosts(const vector<pair<string, string>>& hosts) {
     auto local_hostname = gkfs::rpc::get_my_hostname(true);
+    uint64_t local_host_id = 0;
     bool local_host_found = false;
+    for(uint64_t id = 0; id < hosts.size(); id++) {
+        if(hosts[id].first == local_hostname) {
+            LOG(DEBUG, "Found local host: {}", local_hostname);
+            local_host_id = id;
+            local_host_found = true;
+            break;
+        }
+    }
+    if(!local_host_found) {
+        LOG(WARNING, "Failed to find local host. Using host '0' as local host");
+    }
+    CTX->local_host_id(local_host_id);
+
+    auto lazy = gkfs::env::get_var(gkfs::env::LAZY_HOST_LOOKUP,
+                                   gkfs::config::rpc::lazy_host_lookup
+                                           ? "ON"
+                                           : "OFF") == "ON";
+    if(lazy) {
+        vector<string> uris;
+        uris.reserve(hosts.size());
+        for(const auto& host : hosts) {
+            uris.emplace_back(host.second);
+        }
+        CTX->lazy_hosts(uris);
+        // the local daemon is contacted right away for the fs configuration
+        CTX->host(local_host_id);
+        LOG(INFO, "Daemon addresses are looked up on first use");
+        return;
+    }
 
     std::vector<hermes::endpoint> addrs;
     addrs.resize(hosts.size());
@@ -463,26 +534,15 @@ connect_to_hosts(const vector<pair<string, string>>& hosts) {
     ::mt19937 g(rd());  // seed the random generator
     ::shuffle(host_ids.begin(), host_ids.end(), g); // Shuffle hosts vector
     // lookup addresses and put abstract server addresses into rpc_addresses
-
-    for(const auto& id : host_ids) {
-        const auto& hostname = hosts.at(id).first;
-        const auto& uri = hosts.at(id).second;
-
-        addrs[id] = lookup_endpoint(uri);
-
-        if(!local_host_found && hostname == local_hostname) {
-            LOG(DEBUG, "Found local host: {}", hostname);
-            CTX->local_host_id(id);
-            local_host_found = true;
-        }
-
-        LOG(DEBUG, "Found peer: {}", addrs[id].to_string());
-    }
-
-    if(!local_host_found) {
-        LOG(WARNING, "Failed to find local host. Using host '0' as local host");
-        CTX->local_host_id(0);
-    }
+    auto concurrency = gkfs::env::get_var(
+            gkfs::env::HOST_LOOKUP_CONCURRENCY,
+            gkfs::config::rpc::host_lookup_concurrency);
+    gkfs::rpc::for_each_concurrently(
+            host_ids, static_cast<unsigned int>(std::max(concurrency, 1)),
+            [&](uint64_t id) {
+                addrs[id] = lookup_endpoint(hosts.at(id).second);
+                LOG(DEBUG, "Found peer: {}", addrs[id].to_string());
+            });
 
     CTX->hosts(addrs);
 }
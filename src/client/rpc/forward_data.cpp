@@ -31,6 +31,7 @@
 #include <client/rpc/forward_data.hpp>
 #include <client/rpc/rpc_types.hpp>
 #include <client/logging.hpp>
+#include <client/cache.hpp>
 
 #include <common/rpc/distributor.hpp>
 #include <common/arithmetic/arithmetic.hpp>
@@ -47,15 +48,59 @@ namespace gkfs::rpc {
  * NOTE: No errno is defined here!
  */
 
+namespace {
+
+/**
+ * Turns a scatter/gather list into the buffer sequence of one exposed memory
+ * region. Empty segments are skipped.
+ * @param iov
+ * @param iovcnt
+ * @return buffer sequence
+ */
+std::vector<hermes::mutable_buffer>
+make_bufseq(const struct iovec* iov, int iovcnt) {
+    std::vector<hermes::mutable_buffer> bufseq;
+    bufseq.reserve(iovcnt);
+    for(int i = 0; i < iovcnt; i++) {
+        if(iov[i].iov_len == 0) {
+            continue;
+        }
+        bufseq.emplace_back(iov[i].iov_base, iov[i].iov_len);
+    }
+    return bufseq;
+}
+
+/**
+ * Exposes buffers so that they can serve as RDMA data sources or targets. A
+ * single application buffer is taken from the registration cache if it is
+ * enabled. Otherwise, the buffers are "unexposed" when the last reference is
+ * dropped.
+ * @param bufseq
+ * @param mode
+ * @param app_buffer true if the application owns the buffers. Only their
+ * unmapping is seen by the syscall hook that invalidates the cache.
+ * @return exposed memory, throws on failure
+ */
+std::shared_ptr<hermes::exposed_memory>
+expose_buffers(const std::vector<hermes::mutable_buffer>& bufseq,
+               hermes::access_mode mode, bool app_buffer) {
+    auto expose = [&bufseq, mode]() {
+        return ld_network_service->expose(bufseq, mode);
+    };
+    if(app_buffer && CTX->use_registration_cache() && bufseq.size() == 1) {
+        return CTX->registration_cache()->get(
+                bufseq[0].data(), bufseq[0].size(), mode, expose);
+    }
+    return std::make_shared<hermes::exposed_memory>(expose());
+}
+
+} // namespace
+
 /**
  * Send an RPC request to write from a buffer.
- * There is a bitset of 1024 chunks to tell the server
- * which chunks to process. Exceeding this value will work without
- * replication. Another way is to leverage mercury segments.
- * TODO: Decide how to manage a write to a replica that doesn't exist
  * @param path
  * @param buf
- * @param append_flag
+ * @param offset
  * @param write_size
  * @param num_copies number of replicas
  * @return pair<error code, written size>
@@ -63,6 +108,31 @@ namespace gkfs::rpc {
 pair<int, ssize_t>
 forward_write(const string& path, const void* buf, const off64_t offset,
               const size_t write_size, const int8_t num_copies) {
+    struct iovec iov = {const_cast<void*>(buf), write_size};
+    return forward_write(path, &iov, 1, offset, write_size, num_copies);
+}
+
+/**
+ * Send an RPC request to write from a scatter/gather list. The list is exposed
+ * as one multi-segment bulk handle so that the daemons see a single contiguous
+ * buffer of `write_size` bytes.
+ * There is a bitset of 1024 chunks to tell the server
+ * which chunks to process. Exceeding this value will work without
+ * replication. Another way is to leverage mercury segments.
+ * TODO: Decide how to manage a write to a replica that doesn't exist
+ * @param path
+ * @param iov
+ * @param iovcnt
+ * @param offset
+ * @param write_size sum of all iov_len
+ * @param num_copies number of replicas
+ * @param app_buffer true if the application owns the buffers
+ * @return pair<error code, written size>
+ */
+pair<int, ssize_t>
+forward_write(const string& path, const struct iovec* iov, const int iovcnt,
+              const off64_t offset, const size_t write_size,
+              const int8_t num_copies, bool app_buffer) {
 
     if(gkfs::config::proxy::fwd_io && CTX->use_proxy()) {
         LOG(WARNING,
@@ -98,11 +168,14 @@ forward_write(const string& path, const void* buf, const off64_t offset,
 
     std::unordered_map<uint64_t, std::vector<uint8_t>> write_ops_vect;
 
+    // the path is hashed once for all chunks
+    auto path_hash = gkfs::rpc::hash_path(path);
     // If num_copies is 0, we do the normal write operation. Otherwise
     // we process all the replicas.
     for(uint64_t chnk_id = chnk_start; chnk_id <= chnk_end; chnk_id++) {
         for(auto copy = num_copies ? 1 : 0; copy < num_copies + 1; copy++) {
-            auto target = CTX->distributor()->locate_data(path, chnk_id, copy);
+            auto target = CTX->distributor()->locate_data_hashed(
+                    path, path_hash, chnk_id, copy);
 
             if(write_ops_vect.find(target) == write_ops_vect.end())
                 write_ops_vect[target] =
@@ -129,17 +202,15 @@ forward_write(const string& path, const void* buf, const off64_t offset,
     }
 
     // some helper variables for async RPC
-    std::vector<hermes::mutable_buffer> bufseq{
-            hermes::mutable_buffer{const_cast<void*>(buf), write_size},
-    };
+    auto bufseq = make_bufseq(iov, iovcnt);
 
     // expose user buffers so that they can serve as RDMA data sources
-    // (these are automatically "unexposed" when the destructor is called)
-    hermes::exposed_memory local_buffers;
+    // (held until all RPCs of this operation have completed)
+    std::shared_ptr<hermes::exposed_memory> local_buffers;
 
     try {
-        local_buffers = ld_network_service->expose(
-                bufseq, hermes::access_mode::read_only);
+        local_buffers = expose_buffers(bufseq, hermes::access_mode::read_only,
+                                       app_buffer);
 
     } catch(const std::exception& ex) {
         LOG(ERROR, "Failed to expose buffers for RMA");
@@ -172,9 +243,8 @@ forward_write(const string& path, const void* buf, const off64_t offset,
                                                gkfs::config::rpc::chunksize);
         }
 
-        auto endp = CTX->hosts().at(target);
-
         try {
+            auto endp = CTX->host(target);
             LOG(DEBUG, "Sending RPC ...");
 
             gkfs::rpc::write_data::input in(
@@ -191,7 +261,7 @@ forward_write(const string& path, const void* buf, const off64_t offset,
                     // chunk end id of this write
                     chnk_end,
                     // total size to write
-                    total_chunk_size, local_buffers);
+                    total_chunk_size, *local_buffers);
 
             // TODO(amiranda): add a post() with RPC_TIMEOUT to hermes so that
             // we can retry for RPC_TRIES (see old commits with margo)
@@ -302,6 +372,29 @@ pair<int, ssize_t>
 forward_read(const string& path, void* buf, const off64_t offset,
              const size_t read_size, const int8_t num_copies,
              std::set<int8_t>& failed) {
+    struct iovec iov = {buf, read_size};
+    return forward_read(path, &iov, 1, offset, read_size, num_copies, failed);
+}
+
+/**
+ * Send an RPC request to read to a scatter/gather list. The list is exposed as
+ * one multi-segment bulk handle so that the daemons see a single contiguous
+ * buffer of `read_size` bytes.
+ * @param path
+ * @param iov
+ * @param iovcnt
+ * @param offset
+ * @param read_size sum of all iov_len
+ * @param num_copies number of copies available (0 is no replication)
+ * @param failed nodes failed that should not be used
+ * @param app_buffer true if the application owns the buffers
+ * @return pair<error code, read size>
+ */
+pair<int, ssize_t>
+forward_read(const string& path, const struct iovec* iov, const int iovcnt,
+             const off64_t offset, const size_t read_size,
+             const int8_t num_copies, std::set<int8_t>& failed,
+             bool app_buffer) {
 
     if(gkfs::config::proxy::fwd_io && CTX->use_proxy()) {
         LOG(WARNING,
@@ -330,14 +423,17 @@ forward_read(const string& path, void* buf, const off64_t offset,
     uint64_t chnk_end_target = 0;
     std::unordered_map<uint64_t, std::vector<uint8_t>> read_bitset_vect;
 
+    // the path is hashed once for all chunks
+    auto path_hash = gkfs::rpc::hash_path(path);
     for(uint64_t chnk_id = chnk_start; chnk_id <= chnk_end; chnk_id++) {
-        auto target = CTX->distributor()->locate_data(path, chnk_id, 0);
+        auto target = CTX->distributor()->locate_data_hashed(path, path_hash,
+                                                             chnk_id, 0);
         if(num_copies > 0) {
             // If we have some failures we select another copy (randomly).
             while(failed.find(target) != failed.end()) {
                 LOG(DEBUG, "Selecting another node, target: {} down", target);
-                target = CTX->distributor()->locate_data(path, chnk_id,
-                                                         rand() % num_copies);
+                target = CTX->distributor()->locate_data_hashed(
+                        path, path_hash, chnk_id, rand() % num_copies);
             }
         }
 
@@ -366,17 +462,15 @@ forward_read(const string& path, void* buf, const off64_t offset,
     }
 
     // some helper variables for async RPCs
-    std::vector<hermes::mutable_buffer> bufseq{
-            hermes::mutable_buffer{buf, read_size},
-    };
+    auto bufseq = make_bufseq(iov, iovcnt);
 
     // expose user buffers so that they can serve as RDMA data targets
-    // (these are automatically "unexposed" when the destructor is called)
-    hermes::exposed_memory local_buffers;
+    // (held until all RPCs of this operation have completed)
+    std::shared_ptr<hermes::exposed_memory> local_buffers;
 
     try {
-        local_buffers = ld_network_service->expose(
-                bufseq, hermes::access_mode::write_only);
+        local_buffers = expose_buffers(bufseq, hermes::access_mode::write_only,
+                                       app_buffer);
 
     } catch(const std::exception& ex) {
         LOG(ERROR, "Failed to expose buffers for RMA");
@@ -410,10 +504,8 @@ forward_read(const string& path, void* buf, const off64_t offset,
                                                gkfs::config::rpc::chunksize);
         }
 
-        auto endp = CTX->hosts().at(target);
-
         try {
-
+            auto endp = CTX->host(target);
             LOG(DEBUG, "Sending RPC ...");
 
             gkfs::rpc::read_data::input in(
@@ -430,7 +522,7 @@ forward_read(const string& path, void* buf, const off64_t offset,
                     // chunk end id of this write
                     chnk_end,
                     // total size to write
-                    total_chunk_size, local_buffers);
+                    total_chunk_size, *local_buffers);
 
             // TODO(amiranda): add a post() with RPC_TIMEOUT to hermes so
             // that we can retry for RPC_TRIES (see old commits with margo)
@@ -534,10 +626,12 @@ forward_truncate(const std::string& path, size_t current_size, size_t new_size,
                                                gkfs::config::rpc::chunksize);
 
     std::unordered_set<unsigned int> hosts;
+    auto path_hash = gkfs::rpc::hash_path(path);
     for(unsigned int chunk_id = chunk_start; chunk_id <= chunk_end;
         ++chunk_id) {
         for(auto copy = 0; copy < (num_copies + 1); ++copy) {
-            hosts.insert(CTX->distributor()->locate_data(path, chunk_id, copy));
+            hosts.insert(CTX->distributor()->locate_data_hashed(
+                    path, path_hash, chunk_id, copy));
         }
     }
 
@@ -547,9 +641,8 @@ forward_truncate(const std::string& path, size_t current_size, size_t new_size,
 
     for(const auto& host : hosts) {
 
-        auto endp = CTX->hosts().at(host);
-
         try {
+            auto endp = CTX->host(host);
             LOG(DEBUG, "Sending RPC ...");
 
             gkfs::rpc::trunc_data::input in(path, new_size);
@@ -609,8 +702,9 @@ forward_get_chunk_stat() {
 
     auto err = 0;
 
-    for(const auto& endp : CTX->hosts()) {
+    for(uint64_t id = 0; id < CTX->hosts().size(); id++) {
         try {
+            const auto& endp = CTX->host(id);
             LOG(DEBUG, "Sending RPC to host: {}", endp.to_string());
 
             gkfs::rpc::chunk_stat::input in(0);
@@ -628,7 +722,7 @@ forward_get_chunk_stat() {
             // TODO(amiranda): we should cancel all previously posted
             // requests here, unfortunately, Hermes does not support it yet
             // :/
-            LOG(ERROR, "Failed to send request to host: {}", endp.to_string());
+            LOG(ERROR, "Failed to send request to host: {}", id);
             err = EBUSY;
             break; // We need to gather all responses so we can't return
                    // here
@@ -653,7 +747,7 @@ forward_get_chunk_stat() {
                 err = out.err();
                 LOG(ERROR,
                     "Host '{}' reported err code '{}' during stat chunk.",
-                    CTX->hosts().at(i).to_string(), err);
+                    CTX->host(i).to_string(), err);
                 // we don't break here to ensure all responses are processed
                 continue;
             }
@@ -47,12 +47,11 @@ forward_expand_start(int old_server_conf, int new_server_conf) {
     for(std::size_t i = 0; i < targets.size(); ++i) {
 
         // Setup rpc input parameters for each host
-        auto endp = CTX->hosts().at(targets[i]);
-
         gkfs::malleable::rpc::expand_start::input in(old_server_conf,
                                                      new_server_conf);
 
         try {
+            auto endp = CTX->host(targets[i]);
             LOG(DEBUG, "{}() Sending RPC to host: '{}'", __func__, targets[i]);
             handles.emplace_back(
                     ld_network_service
@@ -110,10 +109,8 @@ forward_expand_status() {
 
     for(std::size_t i = 0; i < targets.size(); ++i) {
 
-        // Setup rpc input parameters for each host
-        auto endp = CTX->hosts().at(targets[i]);
-
         try {
+            auto endp = CTX->host(targets[i]);
             LOG(DEBUG, "{}() Sending RPC to host: '{}'", __func__, targets[i]);
             handles.emplace_back(
                     ld_network_service
@@ -171,10 +168,8 @@ forward_expand_finalize() {
 
     for(std::size_t i = 0; i < targets.size(); ++i) {
 
-        // Setup rpc input parameters for each host
-        auto endp = CTX->hosts().at(targets[i]);
-
         try {
+            auto endp = CTX->host(targets[i]);
             LOG(DEBUG, "{}() Sending RPC to host: '{}'", __func__, targets[i]);
             handles.emplace_back(
                     ld_network_service
@@ -42,13 +42,16 @@ namespace gkfs::rpc {
 bool
 forward_get_fs_config() {
 
-    auto endp = CTX->hosts().at(CTX->local_host_id());
     gkfs::rpc::fs_config::output out;
 
     bool found = false;
     size_t idx = 0;
+    // ask the local daemon first and the others in turn if it fails
+    uint64_t host_id = CTX->local_host_id();
     while(!found && idx < CTX->hosts().size()) {
         try {
+            // looking up the address may fail as well and is retried
+            auto endp = CTX->host(host_id);
             LOG(DEBUG, "Retrieving file system configurations from daemon");
             // TODO(amiranda): add a post() with RPC_TIMEOUT to hermes so that
             // we can retry for RPC_TRIES (see old commits with margo)
@@ -62,7 +65,7 @@ forward_get_fs_config() {
             LOG(ERROR,
                 "Retrieving fs configurations from daemon, possible reattempt at peer: {}",
                 idx);
-            endp = CTX->hosts().at(idx++);
+            host_id = idx++;
         }
     }
 
@@ -80,6 +83,7 @@ forward_get_fs_config() {
     CTX->fs_conf()->blocks_state = out.blocks_state();
     CTX->fs_conf()->uid = out.uid();
     CTX->fs_conf()->gid = out.gid();
+    CTX->fs_conf()->distributor = out.distributor();
 
     LOG(DEBUG, "Got response with mountdir {}", out.mountdir());
 
@@ -37,6 +37,9 @@
 #include <common/rpc/rpc_util.hpp>
 #include <common/rpc/distributor.hpp>
 #include <common/rpc/rpc_types.hpp>
+#include <common/metadata.hpp>
+
+#include <map>
 
 using namespace std;
 
@@ -60,10 +63,9 @@ forward_create(const std::string& path, const mode_t mode, const int copy) {
         LOG(WARNING, "{} was called even though proxy should be used!",
             __func__);
     }
-    auto endp = CTX->hosts().at(
-            CTX->distributor()->locate_file_metadata(path, copy));
-
     try {
+        auto endp = CTX->host(
+                CTX->distributor()->locate_file_metadata(path, copy));
         LOG(DEBUG, "Sending RPC ...");
         // TODO(amiranda): add a post() with RPC_TIMEOUT to hermes so that we
         // can retry for RPC_TRIES (see old commits with margo)
@@ -95,10 +97,9 @@ forward_stat(const std::string& path, string& attr, const int copy) {
         LOG(WARNING, "{} was called even though proxy should be used!",
             __func__);
     }
-    auto endp = CTX->hosts().at(
-            CTX->distributor()->locate_file_metadata(path, copy));
-
     try {
+        auto endp = CTX->host(
+                CTX->distributor()->locate_file_metadata(path, copy));
         LOG(DEBUG, "Sending RPC ...");
         // TODO(amiranda): add a post() with RPC_TIMEOUT to hermes so that we
         // can retry for RPC_TRIES (see old commits with margo)
@@ -122,76 +123,78 @@ forward_stat(const std::string& path, string& attr, const int copy) {
 }
 
 /**
- * Send an RPC for a remove request. This removes metadata and all data chunks
- * possible distributed across many daemons. Optimizations are in place for
- * small files (file_size / chunk_size) < number_of_daemons where no broadcast
- * to all daemons is used to remove all chunks. Otherwise, a broadcast to all
- * daemons is used.
- *
- * This function only attempts data removal if data exists (determined when
- * metadata is removed)
+ * Send an RPC that opens a file's metadata with open() semantics and returns
+ * it. Replaces a create, a stat, and a size decrease request
  * @param path
- * @param num_copies Replication scenarios with many replicas
+ * @param mode mode of a created file
+ * @param create create the file if it doesn't exist
+ * @param excl fail with EEXIST if the file exists
+ * @param trunc set the size of an existing regular file to 0
+ * @param attr metadata value string of the opened file
+ * @param created set if the file was created
+ * @param trunc_size size of the file before truncation, 0 if not truncated
+ * @param copy metadata replica to open
  * @return error code
  */
 int
-forward_remove(const std::string& path, bool rm_dir, const int8_t num_copies) {
-    if(gkfs::config::proxy::fwd_remove && CTX->use_proxy()) {
-        LOG(WARNING, "{} was called even though proxy should be used!",
-            __func__);
-    }
-    int64_t size = 0;
-    uint32_t mode = 0;
-
-    for(auto copy = 0; copy < (num_copies + 1); copy++) {
-        auto endp = CTX->hosts().at(
+forward_open_metadentry(const std::string& path, const mode_t mode,
+                        bool create, bool excl, bool trunc, string& attr,
+                        bool& created, int64_t& trunc_size, const int copy) {
+    try {
+        auto endp = CTX->host(
                 CTX->distributor()->locate_file_metadata(path, copy));
+        LOG(DEBUG, "Sending RPC ...");
+        // TODO(amiranda): add a post() with RPC_TIMEOUT to hermes so that we
+        // can retry for RPC_TRIES (see old commits with margo)
+        // TODO(amiranda): hermes will eventually provide a post(endpoint)
+        // returning one result and a broadcast(endpoint_set) returning a
+        // result_set. When that happens we can remove the .at(0) :/
+        auto out = ld_network_service
+                           ->post<gkfs::rpc::open_metadentry>(
+                                   endp, path, mode, create, excl, trunc)
+                           .get()
+                           .at(0);
+        LOG(DEBUG, "Got response success: {}", out.err());
 
-        /*
-         * Send one RPC to metadata destination and remove metadata while
-         * retrieving size and mode to determine if data needs to removed too
-         */
-        try {
-            LOG(DEBUG, "Sending RPC ...");
-            // TODO(amiranda): add a post() with RPC_TIMEOUT to hermes so that
-            // we can retry for RPC_TRIES (see old commits with margo)
-            // TODO(amiranda): hermes will eventually provide a post(endpoint)
-            // returning one result and a broadcast(endpoint_set) returning a
-            // result_set. When that happens we can remove the .at(0) :/
-            auto out = ld_network_service
-                               ->post<gkfs::rpc::remove_metadata>(endp, path,
-                                                                  rm_dir)
-                               .get()
-                               .at(0);
-
-            LOG(DEBUG, "Got response success: {}", out.err());
+        if(out.err())
+            return out.err();
 
-            if(out.err())
-                return out.err();
-            size = out.size();
-            mode = out.mode();
-        } catch(const std::exception& ex) {
-            LOG(ERROR, "while getting rpc output");
-            return EBUSY;
-        }
+        attr = out.db_val();
+        created = out.created();
+        trunc_size = out.trunc_size();
+    } catch(const std::exception& ex) {
+        LOG(ERROR, "while getting rpc output");
+        return EBUSY;
     }
-    // if file is not a regular file or it's size is 0, data does not need to
-    // be removed, thus, we exit
-    if(!S_ISREG(mode) || size == 0)
-        return 0;
-
+    return 0;
+}
 
-    std::vector<hermes::rpc_handle<gkfs::rpc::remove_data>> handles;
+namespace {
 
+/**
+ * Sends the non-blocking RPCs that remove all data chunks of a file whose
+ * metadata was removed. Small files (file_size / chunk_size) <
+ * number_of_daemons only contact the daemons that hold their chunks. Otherwise,
+ * a broadcast to all daemons is used.
+ * @param path
+ * @param size file size returned by the metadata removal
+ * @param num_copies Replication scenarios with many replicas
+ * @param handles posted RPCs are appended here
+ * @return error code
+ */
+int
+post_remove_data(const std::string& path, const int64_t size,
+                 const int8_t num_copies,
+                 std::vector<hermes::rpc_handle<gkfs::rpc::remove_data>>&
+                         handles) {
     // Small files
     if(static_cast<std::size_t>(size / gkfs::config::rpc::chunksize) <
        CTX->hosts().size()) {
         for(auto copymd = 0; copymd < (num_copies + 1); copymd++) {
             const auto metadata_host_id =
                     CTX->distributor()->locate_file_metadata(path, copymd);
-            const auto endp_metadata = CTX->hosts().at(metadata_host_id);
-
             try {
+                const auto endp_metadata = CTX->host(metadata_host_id);
                 LOG(DEBUG, "Sending RPC to host: {}",
                     endp_metadata.to_string());
                 gkfs::rpc::remove_data::input in(path);
@@ -218,7 +221,7 @@ forward_remove(const std::string& path, bool rm_dir, const int8_t num_copies) {
                             if(chnk_host_id == metadata_host_id)
                                 continue;
                         }
-                        const auto endp_chnk = CTX->hosts().at(chnk_host_id);
+                        const auto endp_chnk = CTX->host(chnk_host_id);
 
                         LOG(DEBUG, "Sending RPC to host: {}",
                             endp_chnk.to_string());
@@ -236,8 +239,9 @@ forward_remove(const std::string& path, bool rm_dir, const int8_t num_copies) {
             }
         }
     } else { // "Big" files
-        for(const auto& endp : CTX->hosts()) {
+        for(uint64_t id = 0; id < CTX->hosts().size(); id++) {
             try {
+                const auto& endp = CTX->host(id);
                 LOG(DEBUG, "Sending RPC to host: {}", endp.to_string());
 
                 gkfs::rpc::remove_data::input in(path);
@@ -259,12 +263,23 @@ forward_remove(const std::string& path, bool rm_dir, const int8_t num_copies) {
                 // :/
                 LOG(ERROR,
                     "Failed to forward non-blocking rpc request to host: {}",
-                    endp.to_string());
+                    id);
                 return EBUSY;
             }
         }
     }
-    // wait for RPC responses
+    return 0;
+}
+
+/**
+ * Waits for the data removal RPCs posted by post_remove_data()
+ * @param handles
+ * @return error code
+ */
+int
+wait_remove_data(
+        const std::vector<hermes::rpc_handle<gkfs::rpc::remove_data>>&
+                handles) {
     auto err = 0;
     for(const auto& h : handles) {
         try {
@@ -284,6 +299,235 @@ forward_remove(const std::string& path, bool rm_dir, const int8_t num_copies) {
     return err;
 }
 
+/**
+ * Sends a batched metadata request for the given replica of each path. Paths
+ * are grouped by their metadata daemon and split into RPCs of at most
+ * metadata_batch_size paths. All RPCs are posted before the first response is
+ * awaited.
+ * @tparam RPC create_batch, stat_batch, or remove_metadata_batch
+ * @param paths
+ * @param copy metadata replica to contact
+ * @param values filled with the value the daemon returned per path, if given
+ * @param args additional RPC input arguments
+ * @return error code per path
+ */
+template <typename RPC, typename... Args>
+std::vector<int>
+forward_batch(const std::vector<std::string>& paths, const int copy,
+              std::vector<std::string>* values, const Args&... args) {
+    std::vector<int> errs(paths.size(), 0);
+    if(values)
+        values->assign(paths.size(), {});
+    std::map<uint64_t, std::vector<size_t>> host_paths;
+    for(size_t i = 0; i < paths.size(); i++) {
+        host_paths[CTX->distributor()->locate_file_metadata(paths[i], copy)]
+                .push_back(i);
+    }
+
+    const size_t batch_size = gkfs::config::rpc::metadata_batch_size;
+    std::vector<std::pair<std::vector<size_t>, hermes::rpc_handle<RPC>>>
+            handles;
+    for(const auto& [host, idxs] : host_paths) {
+        for(size_t start = 0; start < idxs.size(); start += batch_size) {
+            std::vector<size_t> batch(
+                    idxs.begin() + start,
+                    idxs.begin() + std::min(start + batch_size, idxs.size()));
+            std::vector<std::string> batch_paths;
+            batch_paths.reserve(batch.size());
+            for(auto i : batch)
+                batch_paths.push_back(paths[i]);
+            try {
+                LOG(DEBUG, "Sending RPC with {} paths to host: {}",
+                    batch.size(), host);
+                auto handle = ld_network_service->post<RPC>(
+                        CTX->host(host),
+                        gkfs::rpc::encode_string_batch(batch_paths), args...);
+                handles.emplace_back(std::move(batch), std::move(handle));
+            } catch(const std::exception& ex) {
+                LOG(ERROR,
+                    "Failed to forward non-blocking rpc request to host: {}",
+                    host);
+                for(auto i : batch)
+                    errs[i] = EBUSY;
+            }
+        }
+    }
+
+    for(auto& [batch, handle] : handles) {
+        try {
+            auto out = handle.get().at(0);
+            LOG(DEBUG, "Got response success: {}", out.err());
+            if(out.err()) {
+                for(auto i : batch)
+                    errs[i] = out.err();
+                continue;
+            }
+            auto batch_errs = gkfs::rpc::decode_string_batch(out.errs());
+            std::vector<std::string> batch_vals;
+            if(values)
+                batch_vals = gkfs::rpc::decode_string_batch(out.values());
+            if(batch_errs.size() != batch.size() ||
+               (values && batch_vals.size() != batch.size())) {
+                throw std::runtime_error("Malformed batch response");
+            }
+            for(size_t j = 0; j < batch.size(); j++) {
+                errs[batch[j]] = std::stoi(batch_errs[j]);
+                if(values)
+                    (*values)[batch[j]] = std::move(batch_vals[j]);
+            }
+        } catch(const std::exception& ex) {
+            LOG(ERROR, "while getting rpc output");
+            for(auto i : batch)
+                errs[i] = EBUSY;
+        }
+    }
+    return errs;
+}
+
+} // namespace
+
+/**
+ * Send an RPC for a remove request. This removes metadata and all data chunks
+ * possible distributed across many daemons. Optimizations are in place for
+ * small files (file_size / chunk_size) < number_of_daemons where no broadcast
+ * to all daemons is used to remove all chunks. Otherwise, a broadcast to all
+ * daemons is used.
+ *
+ * This function only attempts data removal if data exists (determined when
+ * metadata is removed)
+ * @param path
+ * @param num_copies Replication scenarios with many replicas
+ * @return error code
+ */
+int
+forward_remove(const std::string& path, bool rm_dir, const int8_t num_copies) {
+    if(gkfs::config::proxy::fwd_remove && CTX->use_proxy()) {
+        LOG(WARNING, "{} was called even though proxy should be used!",
+            __func__);
+    }
+    int64_t size = 0;
+    uint32_t mode = 0;
+
+    for(auto copy = 0; copy < (num_copies + 1); copy++) {
+        /*
+         * Send one RPC to metadata destination and remove metadata while
+         * retrieving size and mode to determine if data needs to removed too
+         */
+        try {
+            auto endp = CTX->host(
+                    CTX->distributor()->locate_file_metadata(path, copy));
+            LOG(DEBUG, "Sending RPC ...");
+            // TODO(amiranda): add a post() with RPC_TIMEOUT to hermes so that
+            // we can retry for RPC_TRIES (see old commits with margo)
+            // TODO(amiranda): hermes will eventually provide a post(endpoint)
+            // returning one result and a broadcast(endpoint_set) returning a
+            // result_set. When that happens we can remove the .at(0) :/
+            auto out = ld_network_service
+                               ->post<gkfs::rpc::remove_metadata>(endp, path,
+                                                                  rm_dir)
+                               .get()
+                               .at(0);
+
+            LOG(DEBUG, "Got response success: {}", out.err());
+
+            if(out.err())
+                return out.err();
+            size = out.size();
+            mode = out.mode();
+        } catch(const std::exception& ex) {
+            LOG(ERROR, "while getting rpc output");
+            return EBUSY;
+        }
+    }
+    // if file is not a regular file or it's size is 0, data does not need to
+    // be removed, thus, we exit
+    if(!S_ISREG(mode) || size == 0)
+        return 0;
+
+    std::vector<hermes::rpc_handle<gkfs::rpc::remove_data>> handles;
+    auto err = post_remove_data(path, size, num_copies, handles);
+    if(err)
+        return err;
+    return wait_remove_data(handles);
+}
+
+/**
+ * Send batched RPCs for create requests of several files with the same mode
+ * @param paths
+ * @param mode
+ * @param copy Number of replica to create
+ * @return error code per path
+ */
+std::vector<int>
+forward_create_batch(const std::vector<std::string>& paths, const mode_t mode,
+                     const int copy) {
+    return forward_batch<gkfs::rpc::create_batch>(
+            paths, copy, nullptr, static_cast<uint32_t>(mode));
+}
+
+/**
+ * Send batched RPCs for stat requests of several paths
+ * @param paths
+ * @param attrs metadata value string per path
+ * @param copy metadata replica to read from
+ * @return error code per path
+ */
+std::vector<int>
+forward_stat_batch(const std::vector<std::string>& paths,
+                   std::vector<std::string>& attrs, const int copy) {
+    return forward_batch<gkfs::rpc::stat_batch>(paths, copy, &attrs);
+}
+
+/**
+ * Send batched RPCs for remove requests of several files. Works like
+ * forward_remove() for each path but removes the metadata of all paths of a
+ * daemon with one RPC. Data chunks of all removed files are then removed
+ * concurrently.
+ * @param paths
+ * @param num_copies Replication scenarios with many replicas
+ * @param attrs set to the removed metadata value string per path
+ * @return error code per path
+ */
+std::vector<int>
+forward_remove_batch(const std::vector<std::string>& paths,
+                     const int8_t num_copies, std::vector<std::string>& attrs) {
+    std::vector<int> errs(paths.size(), 0);
+    attrs.assign(paths.size(), {});
+    for(auto copy = 0; copy < (num_copies + 1); copy++) {
+        std::vector<std::string> copy_attrs;
+        auto copy_errs = forward_batch<gkfs::rpc::remove_metadata_batch>(
+                paths, copy, &copy_attrs);
+        for(size_t i = 0; i < paths.size(); i++) {
+            if(errs[i])
+                continue;
+            errs[i] = copy_errs[i];
+            if(copy == 0)
+                attrs[i] = std::move(copy_attrs[i]);
+        }
+    }
+
+    std::vector<std::vector<hermes::rpc_handle<gkfs::rpc::remove_data>>>
+            handles(paths.size());
+    for(size_t i = 0; i < paths.size(); i++) {
+        if(errs[i])
+            continue;
+        gkfs::metadata::Metadata md(attrs[i]);
+        // if file is not a regular file or it's size is 0, data does not need
+        // to be removed
+        if(!S_ISREG(md.mode()) || md.size() == 0)
+            continue;
+        errs[i] = post_remove_data(paths[i], md.size(), num_copies, handles[i]);
+    }
+    for(size_t i = 0; i < paths.size(); i++) {
+        if(!handles[i].empty()) {
+            auto err = wait_remove_data(handles[i]);
+            if(!errs[i])
+                errs[i] = err;
+        }
+    }
+    return errs;
+}
+
 /**
  * Send an RPC for a decrement file size request. This is for example used
  * during a truncate() call.
@@ -298,10 +542,9 @@ forward_decr_size(const std::string& path, size_t length, const int copy) {
         LOG(WARNING, "{} was called even though proxy should be used!",
             __func__, gkfs::config::proxy::fwd_truncate);
     }
-    auto endp = CTX->hosts().at(
-            CTX->distributor()->locate_file_metadata(path, copy));
-
     try {
+        auto endp = CTX->host(
+                CTX->distributor()->locate_file_metadata(path, copy));
         LOG(DEBUG, "Sending RPC ...");
         // TODO(amiranda): add a post() with RPC_TIMEOUT to hermes so that we
         // can retry for RPC_TRIES (see old commits with margo)
@@ -338,10 +581,9 @@ forward_update_metadentry(const string& path,
                           const gkfs::metadata::MetadentryUpdateFlags& md_flags,
                           const int copy) {
 
-    auto endp = CTX->hosts().at(
-            CTX->distributor()->locate_file_metadata(path, copy));
-
     try {
+        auto endp = CTX->host(
+                CTX->distributor()->locate_file_metadata(path, copy));
         LOG(DEBUG, "Sending RPC ...");
         // TODO(amiranda): add a post() with RPC_TIMEOUT to hermes so that we
         // can retry for RPC_TRIES (see old commits with margo)
@@ -396,8 +638,16 @@ int
 forward_rename(const string& oldpath, const string& newpath,
                const gkfs::metadata::Metadata& md) {
 
-    auto endp = CTX->hosts().at(
-            CTX->distributor()->locate_file_metadata(oldpath, 0));
+    hermes::endpoint endp;
+    hermes::endpoint endp2;
+    try {
+        endp = CTX->host(CTX->distributor()->locate_file_metadata(oldpath, 0));
+        endp2 = CTX->host(
+                CTX->distributor()->locate_file_metadata(newpath, 0));
+    } catch(const std::exception& ex) {
+        LOG(ERROR, "{}() Failed to look up daemon: {}", __func__, ex.what());
+        return EBUSY;
+    }
 
     try {
         LOG(DEBUG, "Sending RPC ...");
@@ -443,9 +693,6 @@ forward_rename(const string& oldpath, const string& newpath,
     // TODO(amiranda): hermes will eventually provide a post(endpoint)
     // returning one result and a broadcast(endpoint_set) returning a
     // result_set. When that happens we can remove the .at(0) :/
-    auto endp2 = CTX->hosts().at(
-            CTX->distributor()->locate_file_metadata(newpath, 0));
-
     try {
         LOG(DEBUG, "Sending RPC ...");
         // TODO(amiranda): add a post() with RPC_TIMEOUT to hermes so that we
@@ -533,57 +780,81 @@ forward_update_metadentry_size(const string& path, const size_t size,
         LOG(WARNING, "{} was called even though proxy should be used!",
             __func__);
     }
-    std::vector<hermes::rpc_handle<gkfs::rpc::update_metadentry_size>> handles;
+    return forward_update_metadentry_size_async(path, size, offset,
+                                                append_flag, num_copies)();
+}
+
+/**
+ * Send an RPC request for an update to the file size without waiting for the
+ * response. This allows to overlap the update with, e.g., the data RPCs of a
+ * write() call.
+ * @param path
+ * @param size
+ * @param offset
+ * @param append_flag
+ * @param num_copies number of replicas
+ * @return callable that waits for all responses and returns pair<error code,
+ * size after update>. It must be called exactly once.
+ */
+std::function<pair<int, off64_t>()>
+forward_update_metadentry_size_async(const string& path, const size_t size,
+                                     const off64_t offset,
+                                     const bool append_flag,
+                                     const int num_copies) {
+    using handle_t = hermes::rpc_handle<gkfs::rpc::update_metadentry_size>;
+    auto handles = make_shared<std::vector<handle_t>>();
 
     for(auto copy = 0; copy < num_copies + 1; copy++) {
-        auto endp = CTX->hosts().at(
-                CTX->distributor()->locate_file_metadata(path, copy));
         try {
+            auto endp = CTX->host(
+                    CTX->distributor()->locate_file_metadata(path, copy));
             LOG(DEBUG, "Sending RPC ...");
             // TODO(amiranda): add a post() with RPC_TIMEOUT to hermes so that
             // we can retry for RPC_TRIES (see old commits with margo)
             // TODO(amiranda): hermes will eventually provide a post(endpoint)
             // returning one result and a broadcast(endpoint_set) returning a
             // result_set. When that happens we can remove the .at(0) :/
-            handles.emplace_back(
+            handles->emplace_back(
                     ld_network_service->post<gkfs::rpc::update_metadentry_size>(
                             endp, path, size, offset,
                             bool_to_merc_bool(append_flag)));
         } catch(const std::exception& ex) {
             LOG(ERROR, "while getting rpc output");
-            return make_pair(EBUSY, 0);
+            return [] { return make_pair(EBUSY, static_cast<off64_t>(0)); };
         }
     }
-    auto err = 0;
-    ssize_t out_size = 0;
-    auto idx = 0;
-    bool valid = false;
-    for(const auto& h : handles) {
-        try {
-            // XXX We might need a timeout here to not wait forever for an
-            // output that never comes?
-            auto out = h.get().at(0);
-
-            if(out.err() != 0) {
-                LOG(ERROR, "Daemon {} reported error: {}", idx, out.err());
-            } else {
-                valid = true;
-                out_size = out.ret_size();
-            }
+    return [handles]() -> pair<int, off64_t> {
+        auto err = 0;
+        ssize_t out_size = 0;
+        auto idx = 0;
+        bool valid = false;
+        for(const auto& h : *handles) {
+            try {
+                // XXX We might need a timeout here to not wait forever for an
+                // output that never comes?
+                auto out = h.get().at(0);
+
+                if(out.err() != 0) {
+                    LOG(ERROR, "Daemon {} reported error: {}", idx, out.err());
+                } else {
+                    valid = true;
+                    out_size = out.ret_size();
+                }
 
-        } catch(const std::exception& ex) {
-            LOG(ERROR, "Failed to get rpc output");
-            if(!valid) {
-                err = EIO;
+            } catch(const std::exception& ex) {
+                LOG(ERROR, "Failed to get rpc output");
+                if(!valid) {
+                    err = EIO;
+                }
             }
+            idx++;
         }
-        idx++;
-    }
 
-    if(!valid)
-        return make_pair(err, 0);
-    else
-        return make_pair(0, out_size);
+        if(!valid)
+            return make_pair(err, 0);
+        else
+            return make_pair(0, out_size);
+    };
 }
 
 
@@ -600,10 +871,9 @@ forward_get_metadentry_size(const std::string& path, const int copy) {
         LOG(WARNING, "{} is run due to missing proxy implementation!",
             __func__);
     }
-    auto endp = CTX->hosts().at(
-            CTX->distributor()->locate_file_metadata(path, copy));
-
     try {
+        auto endp = CTX->host(
+                CTX->distributor()->locate_file_metadata(path, copy));
         LOG(DEBUG, "Sending RPC ...");
         // TODO(amiranda): add a post() with RPC_TIMEOUT to hermes so that we
         // can retry for RPC_TRIES (see old commits with margo)
@@ -628,40 +898,46 @@ forward_get_metadentry_size(const std::string& path, const int copy) {
 }
 
 /**
- * Send an RPC request to receive all entries of a directory.
+ * Send RPC requests to receive the next pages of entries of a paged directory.
+ * Pages are requested from up to `dirents_page_window` daemons at once, each
+ * resuming after the last entry of its previous page. The received entries are
+ * appended to the open directory.
  * @param open_dir
  * @return error code
  */
-pair<int, shared_ptr<gkfs::filemap::OpenDir>>
-forward_get_dirents(const string& path) {
+int
+forward_get_dirents(gkfs::filemap::OpenDir& open_dir) {
 
     if(CTX->use_proxy()) {
         LOG(WARNING, "{} is run due to missing proxy implementation!",
             __func__);
     }
 
+    const auto& path = open_dir.path();
     LOG(DEBUG, "{}() enter for path '{}'", __func__, path)
 
     auto const targets = CTX->distributor()->locate_directory_metadata();
+    auto const sources =
+            open_dir.next_sources(gkfs::config::rpc::dirents_page_window);
+    if(sources.empty()) {
+        return 0;
+    }
 
-    /* preallocate receiving buffer. The actual size is not known yet.
+    /* preallocate receiving buffer for one page per daemon.
      *
      * On C++14 make_unique function also zeroes the newly allocated buffer.
      * It turns out that this operation is increadibly slow for such a big
      * buffer. Moreover we don't need a zeroed buffer here.
      */
+    const std::size_t per_host_buff_size = gkfs::config::rpc::dirents_page_size;
     auto large_buffer = std::unique_ptr<char[]>(
-            new char[gkfs::config::rpc::dirents_buff_size]);
-
-    // XXX there is a rounding error here depending on the number of targets...
-    const std::size_t per_host_buff_size =
-            gkfs::config::rpc::dirents_buff_size / targets.size();
+            new char[per_host_buff_size * sources.size()]);
 
     // expose local buffers for RMA from servers
     std::vector<hermes::exposed_memory> exposed_buffers;
-    exposed_buffers.reserve(targets.size());
+    exposed_buffers.reserve(sources.size());
 
-    for(std::size_t i = 0; i < targets.size(); ++i) {
+    for(std::size_t i = 0; i < sources.size(); ++i) {
         try {
             exposed_buffers.emplace_back(ld_network_service->expose(
                     std::vector<hermes::mutable_buffer>{hermes::mutable_buffer{
@@ -671,7 +947,7 @@ forward_get_dirents(const string& path) {
         } catch(const std::exception& ex) {
             LOG(ERROR, "{}() Failed to expose buffers for RMA. err '{}'",
                 __func__, ex.what());
-            return make_pair(EBUSY, nullptr);
+            return EBUSY;
         }
     }
 
@@ -679,21 +955,23 @@ forward_get_dirents(const string& path) {
     // send RPCs
     std::vector<hermes::rpc_handle<gkfs::rpc::get_dirents>> handles;
 
-    for(std::size_t i = 0; i < targets.size(); ++i) {
+    for(std::size_t i = 0; i < sources.size(); ++i) {
 
         // Setup rpc input parameters for each host
-        auto endp = CTX->hosts().at(targets[i]);
+        auto target = targets[sources[i]];
 
-        gkfs::rpc::get_dirents::input in(path, exposed_buffers[i]);
+        gkfs::rpc::get_dirents::input in(path, open_dir.cursor(sources[i]),
+                                         exposed_buffers[i]);
 
         try {
-            LOG(DEBUG, "{}() Sending RPC to host: '{}'", __func__, targets[i]);
+            auto endp = CTX->host(target);
+            LOG(DEBUG, "{}() Sending RPC to host: '{}'", __func__, target);
             handles.emplace_back(
                     ld_network_service->post<gkfs::rpc::get_dirents>(endp, in));
         } catch(const std::exception& ex) {
             LOG(ERROR,
                 "{}() Unable to send non-blocking get_dirents() on {} [peer: {}] err '{}'",
-                __func__, path, targets[i], ex.what());
+                __func__, path, target, ex.what());
             err = EBUSY;
             break; // we need to gather responses from already sent RPCS
         }
@@ -701,10 +979,9 @@ forward_get_dirents(const string& path) {
 
     LOG(DEBUG,
         "{}() path '{}' send rpc_srv_get_dirents() rpc to '{}' targets. per_host_buff_size '{}' Waiting on reply next and deserialize",
-        __func__, path, targets.size(), per_host_buff_size);
+        __func__, path, handles.size(), per_host_buff_size);
 
     auto send_error = err != 0;
-    auto open_dir = make_shared<gkfs::filemap::OpenDir>(path);
     // wait for RPC responses
     for(std::size_t i = 0; i < handles.size(); ++i) {
 
@@ -723,7 +1000,7 @@ forward_get_dirents(const string& path) {
             if(out.err() != 0) {
                 LOG(ERROR,
                     "{}() Failed to retrieve dir entries from host '{}'. Error '{}', path '{}'",
-                    __func__, targets[i], strerror(out.err()), path);
+                    __func__, targets[sources[i]], strerror(out.err()), path);
                 err = out.err();
                 // We need to gather all responses before exiting
                 continue;
@@ -731,11 +1008,14 @@ forward_get_dirents(const string& path) {
         } catch(const std::exception& ex) {
             LOG(ERROR,
                 "{}() Failed to get rpc output.. [path: {}, target host: {}] err '{}'",
-                __func__, path, targets[i], ex.what());
+                __func__, path, targets[sources[i]], ex.what());
             err = EBUSY;
             // We need to gather all responses before exiting
             continue;
         }
+        // a failed page is not added so that the directory stays consistent
+        if(err != 0)
+            continue;
 
         // each server wrote information to its pre-defined region in
         // large_buffer, recover it by computing the base_address for each
@@ -765,10 +1045,11 @@ forward_get_dirents(const string& path) {
             // number of characters in entry + \0 terminator
             names_ptr += name.size() + 1;
 
-            open_dir->add(name, ftype);
+            open_dir.add(name, ftype);
         }
+        open_dir.cursor(sources[i], out.next_key());
     }
-    return make_pair(err, open_dir);
+    return err;
 }
 
 /**
@@ -828,11 +1109,10 @@ forward_get_dirents_single(const string& path, int server) {
     // send RPCs
     std::vector<hermes::rpc_handle<gkfs::rpc::get_dirents_extended>> handles;
 
-    auto endp = CTX->hosts().at(targets[i]);
-
     gkfs::rpc::get_dirents_extended::input in(path, exposed_buffers[0]);
 
     try {
+        auto endp = CTX->host(targets[i]);
         LOG(DEBUG, "{}() Sending RPC to host: '{}'", __func__, targets[i]);
         handles.emplace_back(
                 ld_network_service->post<gkfs::rpc::get_dirents_extended>(endp,
@@ -841,7 +1121,8 @@ forward_get_dirents_single(const string& path, int server) {
         LOG(ERROR,
             "{}() Unable to send non-blocking get_dirents() on {} [peer: {}] err '{}'",
             __func__, path, targets[i], ex.what());
-        err = EBUSY;
+        // there is no response to wait for
+        return make_pair(EBUSY, std::move(output_ptr));
     }
 
     LOG(DEBUG,
@@ -919,10 +1200,9 @@ forward_get_dirents_single(const string& path, int server) {
 int
 forward_mk_symlink(const std::string& path, const std::string& target_path) {
 
-    auto endp =
-            CTX->hosts().at(CTX->distributor()->locate_file_metadata(path, 0));
-
     try {
+        auto endp = CTX->host(
+                CTX->distributor()->locate_file_metadata(path, 0));
         LOG(DEBUG, "Sending RPC ...");
         // TODO(amiranda): add a post() with RPC_TIMEOUT to hermes so that we
         // can retry for RPC_TRIES (see old commits with margo)
@@ -60,6 +60,12 @@ hermes::detail::register_user_request_types(uint32_t provider_id) {
         (void) registered_requests().add<gkfs::rpc::chunk_stat>(provider_id);
         (void) registered_requests().add<gkfs::rpc::get_dirents_extended>(
                 provider_id);
+        (void) registered_requests().add<gkfs::rpc::create_batch>(provider_id);
+        (void) registered_requests().add<gkfs::rpc::stat_batch>(provider_id);
+        (void) registered_requests().add<gkfs::rpc::remove_metadata_batch>(
+                provider_id);
+        (void) registered_requests().add<gkfs::rpc::open_metadentry>(
+                provider_id);
         (void) registered_requests().add<gkfs::malleable::rpc::expand_start>(
                 provider_id);
         (void) registered_requests().add<gkfs::malleable::rpc::expand_status>(
@@ -36,39 +36,78 @@ extern "C" {
 #include <unistd.h>
 }
 
+#include <charconv>
+#include <cstring>
 #include <ctime>
 #include <cassert>
-#include <random>
+#include <stdexcept>
 
 namespace gkfs::metadata {
 
 static const char MSP = '|'; // metadata separator
 
-/**
- * Generate a unique ID for a given path
- * @param path
- * @return unique ID
+namespace {
+
+/*
+ * Binary format, all integers little-endian:
+ * version(u8) mode(u32) size(u64) atime(i64) mtime(i64) ctime(i64)
+ * link_count(u64) blocks(i64) target_len(u32) rename_len(u32) target rename
  */
-uint16_t
-gen_unique_id(const std::string& path) {
-    // Generate a random salt value using a pseudo-random number generator
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0,
-                                        std::numeric_limits<uint16_t>::max());
-    auto salt = static_cast<uint16_t>(dis(gen));
+constexpr uint8_t binary_format_version = 1; // never an ASCII digit
+constexpr size_t binary_header_size =
+        sizeof(uint8_t) + sizeof(uint32_t) + 6 * sizeof(uint64_t) +
+        2 * sizeof(uint32_t);
+
+template <typename T>
+inline T
+to_little_endian(T value) {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    if constexpr(sizeof(T) == sizeof(uint64_t)) {
+        return static_cast<T>(__builtin_bswap64(value));
+    } else {
+        return static_cast<T>(__builtin_bswap32(value));
+    }
+#else
+    return value;
+#endif
+}
 
-    // Concatenate the identifier and salt values into a single string
-    auto input_str = fmt::format("{}{}", path, salt);
+template <typename T>
+inline char*
+store_le(char* dst, T value) {
+    value = to_little_endian(value);
+    std::memcpy(dst, &value, sizeof(T));
+    return dst + sizeof(T);
+}
+
+template <typename T>
+inline T
+load_le(const char* src) {
+    T value;
+    std::memcpy(&value, src, sizeof(T));
+    return to_little_endian(value);
+}
 
-    // Use std::hash function to generate a hash value from the input string
-    std::hash<std::string> const hasher;
-    auto hash_value = hasher(input_str);
+template <typename T>
+inline const char*
+parse_number(const char* first, const char* last, T& value) {
+    auto [ptr, ec] = std::from_chars(first, last, value);
+    if(ec != std::errc() || ptr == first) {
+        throw std::invalid_argument("Malformed metadata field");
+    }
+    return ptr;
+}
 
-    // Use the lower 16 bits of the hash value as the unique ID
-    return static_cast<uint16_t>(hash_value & 0xFFFF);
+inline const char*
+expect_separator(const char* ptr, const char* last) {
+    if(ptr == last || *ptr != MSP) {
+        throw std::invalid_argument("Missing metadata separator");
+    }
+    return ptr + 1;
 }
 
+} // namespace
+
 inline void
 Metadata::init_time() {
     if constexpr(gkfs::config::metadata::use_ctime) {
@@ -103,83 +142,160 @@ Metadata::Metadata(const mode_t mode, const std::string& target_path)
 
 #endif
 
-Metadata::Metadata(const std::string& binary_str) {
-    size_t read = 0;
+Metadata::Metadata(std::string_view binary_str) {
+    if(!binary_str.empty() &&
+       static_cast<uint8_t>(binary_str[0]) == binary_format_version) {
+        parse_binary(binary_str);
+    } else {
+        parse_text(binary_str);
+    }
+}
 
-    auto ptr = binary_str.data();
-    mode_ = static_cast<unsigned int>(std::stoul(ptr, &read));
-    // we read something
-    assert(read > 0);
-    ptr += read;
+/**
+ * Parses the binary format. Header fields are decoded in place, only
+ * non-empty symlink or rename paths may allocate.
+ * @param binary_str
+ * @throws std::invalid_argument if the value is truncated
+ */
+void
+Metadata::parse_binary(std::string_view binary_str) {
+    if(binary_str.size() < binary_header_size) {
+        throw std::invalid_argument("Truncated metadata header");
+    }
+    auto ptr = binary_str.data() + 1;
+    // The order is important. don't change.
+    mode_ = static_cast<mode_t>(load_le<uint32_t>(ptr));
+    ptr += sizeof(uint32_t);
+    size_ = static_cast<size_t>(load_le<uint64_t>(ptr));
+    ptr += sizeof(uint64_t);
+    atime_ = static_cast<time_t>(load_le<int64_t>(ptr));
+    ptr += sizeof(int64_t);
+    mtime_ = static_cast<time_t>(load_le<int64_t>(ptr));
+    ptr += sizeof(int64_t);
+    ctime_ = static_cast<time_t>(load_le<int64_t>(ptr));
+    ptr += sizeof(int64_t);
+    link_count_ = static_cast<nlink_t>(load_le<uint64_t>(ptr));
+    ptr += sizeof(uint64_t);
+    blocks_ = static_cast<blkcnt_t>(load_le<int64_t>(ptr));
+    ptr += sizeof(int64_t);
+    auto target_len = load_le<uint32_t>(ptr);
+    ptr += sizeof(uint32_t);
+    auto rename_len = load_le<uint32_t>(ptr);
+    ptr += sizeof(uint32_t);
+    assert(ptr == binary_str.data() + binary_header_size);
+
+    // Trailing bytes are tolerated as some backends append a '\0'
+    if(binary_str.size() - binary_header_size <
+       static_cast<size_t>(target_len) + rename_len) {
+        throw std::invalid_argument("Truncated metadata paths");
+    }
+#ifdef HAS_SYMLINKS
+    target_path_.assign(ptr, target_len);
+#endif
+    ptr += target_len;
+#if defined(HAS_SYMLINKS) && defined(HAS_RENAME)
+    rename_path_.assign(ptr, rename_len);
+#endif
+}
 
-    // last parsed char is the separator char
-    assert(*ptr == MSP);
-    // yet we have some character to parse
+/**
+ * Parses the legacy '|'-separated text format, which only contains the fields
+ * enabled in gkfs::config::metadata.
+ * @param text_str
+ * @throws std::invalid_argument on malformed input
+ */
+void
+Metadata::parse_text(std::string_view text_str) {
+    // Values may have been stored including their terminating '\0'
+    while(!text_str.empty() && text_str.back() == '\0') {
+        text_str.remove_suffix(1);
+    }
+    auto ptr = text_str.data();
+    const auto last = ptr + text_str.size();
 
-    size_ = std::stol(++ptr, &read);
-    assert(read > 0);
-    ptr += read;
+    ptr = parse_number(ptr, last, mode_);
+    ptr = parse_number(expect_separator(ptr, last), last, size_);
 
     // The order is important. don't change.
     if constexpr(gkfs::config::metadata::use_atime) {
-        assert(*ptr == MSP);
-        atime_ = static_cast<time_t>(std::stol(++ptr, &read));
-        assert(read > 0);
-        ptr += read;
+        ptr = parse_number(expect_separator(ptr, last), last, atime_);
     }
     if constexpr(gkfs::config::metadata::use_mtime) {
-        assert(*ptr == MSP);
-        mtime_ = static_cast<time_t>(std::stol(++ptr, &read));
-        assert(read > 0);
-        ptr += read;
+        ptr = parse_number(expect_separator(ptr, last), last, mtime_);
     }
     if constexpr(gkfs::config::metadata::use_ctime) {
-        assert(*ptr == MSP);
-        ctime_ = static_cast<time_t>(std::stol(++ptr, &read));
-        assert(read > 0);
-        ptr += read;
+        ptr = parse_number(expect_separator(ptr, last), last, ctime_);
     }
     if constexpr(gkfs::config::metadata::use_link_cnt) {
-        assert(*ptr == MSP);
-        link_count_ = static_cast<nlink_t>(std::stoul(++ptr, &read));
-        assert(read > 0);
-        ptr += read;
+        ptr = parse_number(expect_separator(ptr, last), last, link_count_);
     }
-    if constexpr(gkfs::config::metadata::use_blocks) { // last one will not
-                                                       // encounter a
-                                                       // delimiter anymore
-        assert(*ptr == MSP);
-        blocks_ = static_cast<blkcnt_t>(std::stol(++ptr, &read));
-        assert(read > 0);
-        ptr += read;
+    if constexpr(gkfs::config::metadata::use_blocks) {
+        ptr = parse_number(expect_separator(ptr, last), last, blocks_);
     }
 
 #ifdef HAS_SYMLINKS
     // Read target_path
-    assert(*ptr == MSP);
-    target_path_ = ++ptr;
-    // target_path should be there only if this is a link
-    ptr += target_path_.size();
+    ptr = expect_separator(ptr, last);
+    std::string_view paths(ptr, last - ptr);
 #ifdef HAS_RENAME
-    // Read rename target, we had captured '|' so we need to recover it
-    if(!target_path_.empty()) {
-        auto index = target_path_.find_last_of(MSP);
-        auto size = target_path_.size();
-        target_path_ = target_path_.substr(0, index);
-        ptr -= (size - index);
+    // The rename target follows the last separator as the target path may
+    // contain '|' itself
+    auto index = paths.find_last_of(MSP);
+    if(index == std::string_view::npos) {
+        throw std::invalid_argument("Missing rename path in metadata");
     }
-    assert(*ptr == MSP);
-    rename_path_ = ++ptr;
-    ptr += rename_path_.size();
+    target_path_.assign(paths.substr(0, index));
+    rename_path_.assign(paths.substr(index + 1));
+#else
+    target_path_.assign(paths);
 #endif // HAS_RENAME
+    ptr = last;
 #endif // HAS_SYMLINKS
 
-    // we consumed all the binary string
-    assert(*ptr == '\0');
+    // we consumed all the string
+    if(ptr != last) {
+        throw std::invalid_argument("Trailing characters in metadata");
+    }
 }
 
 std::string
 Metadata::serialize() const {
+    size_t target_len = 0;
+    size_t rename_len = 0;
+#ifdef HAS_SYMLINKS
+    target_len = target_path_.size();
+#ifdef HAS_RENAME
+    rename_len = rename_path_.size();
+#endif // HAS_RENAME
+#endif // HAS_SYMLINKS
+
+    std::string s(binary_header_size + target_len + rename_len, '\0');
+    auto ptr = s.data();
+    *ptr++ = static_cast<char>(binary_format_version);
+    // The order is important. don't change.
+    ptr = store_le(ptr, static_cast<uint32_t>(mode_));
+    ptr = store_le(ptr, static_cast<uint64_t>(size_));
+    ptr = store_le(ptr, static_cast<int64_t>(atime_));
+    ptr = store_le(ptr, static_cast<int64_t>(mtime_));
+    ptr = store_le(ptr, static_cast<int64_t>(ctime_));
+    ptr = store_le(ptr, static_cast<uint64_t>(link_count_));
+    ptr = store_le(ptr, static_cast<int64_t>(blocks_));
+    ptr = store_le(ptr, static_cast<uint32_t>(target_len));
+    ptr = store_le(ptr, static_cast<uint32_t>(rename_len));
+#ifdef HAS_SYMLINKS
+    target_path_.copy(ptr, target_len);
+    ptr += target_len;
+#ifdef HAS_RENAME
+    rename_path_.copy(ptr, rename_len);
+    ptr += rename_len;
+#endif // HAS_RENAME
+#endif // HAS_SYMLINKS
+    assert(ptr == s.data() + s.size());
+    return s;
+}
+
+std::string
+Metadata::serialize_text() const {
     std::string s;
     // The order is important. don't change.
     s += fmt::format_int(mode_).c_str(); // add mandatory mode
@@ -28,12 +28,112 @@
 
 #include <common/rpc/distributor.hpp>
 
+#include <cstring>
+
 using namespace std;
 
 namespace gkfs {
 
 namespace rpc {
 
+namespace {
+
+// wyhash constants
+constexpr uint64_t hash_p0 = 0xa0761d6478bd642full;
+constexpr uint64_t hash_p1 = 0xe7037ed1a0b428dbull;
+constexpr uint64_t hash_p2 = 0x8ebc6af09c88c6e3ull;
+constexpr uint64_t hash_p3 = 0x589965cc75374cc3ull;
+
+/**
+ * Multiplies a and b to 128 bits and folds the result to 64 bits
+ */
+inline uint64_t
+hash_mix(uint64_t a, uint64_t b) {
+    auto r = static_cast<unsigned __int128>(a) * b;
+    return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+}
+
+/**
+ * Reads 8 bytes as a little-endian word
+ */
+inline uint64_t
+read_word(const char* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
+}
+
+/**
+ * Jump consistent hash (Lamping and Veach, 2014): maps key to one of
+ * num_buckets buckets so that only 1 / num_buckets of all keys change their
+ * bucket when a bucket is added.
+ */
+inline host_t
+jump_consistent_hash(uint64_t key, unsigned int num_buckets) {
+    int64_t b = -1;
+    int64_t j = 0;
+    while(j < static_cast<int64_t>(num_buckets)) {
+        b = j;
+        key = key * 2862933555777941757ull + 1;
+        j = static_cast<int64_t>(static_cast<double>(b + 1) *
+                                 (static_cast<double>(1ll << 31) /
+                                  static_cast<double>((key >> 33) + 1)));
+    }
+    return static_cast<host_t>(b);
+}
+
+/**
+ * Reads up to 8 bytes as a zero-padded little-endian word
+ */
+inline uint64_t
+read_tail(const char* p, size_t n) {
+    uint64_t v = 0;
+    for(size_t i = 0; i < n; i++) {
+        v |= static_cast<uint64_t>(static_cast<uint8_t>(p[i])) << (8 * i);
+    }
+    return v;
+}
+
+} // namespace
+
+uint64_t
+hash_path(const string& path) {
+    const auto* p = path.data();
+    const auto len = path.size();
+    uint64_t h = hash_p0;
+    size_t i = 0;
+    for(; i + 16 <= len; i += 16) {
+        h = hash_mix(read_word(p + i) ^ hash_p1, read_word(p + i + 8) ^ h);
+    }
+    uint64_t a = 0;
+    uint64_t b = 0;
+    auto rest = len - i;
+    if(rest > 8) {
+        a = read_word(p + i);
+        b = read_tail(p + i + 8, rest - 8);
+    } else {
+        a = read_tail(p + i, rest);
+    }
+    h = hash_mix(a ^ hash_p1, b ^ h);
+    return hash_mix(h ^ hash_p2, len ^ hash_p3);
+}
+
+uint64_t
+hash_chunk(uint64_t path_hash, chunkid_t chnk_id) {
+    return hash_mix(path_hash ^ hash_p2,
+                    static_cast<uint64_t>(chnk_id) ^ hash_p0);
+}
+
+host_t
+Distributor::locate_data_hashed(const string& path, uint64_t path_hash,
+                                const chunkid_t& chnk_id,
+                                const int num_copy) const {
+    return locate_data(path, chnk_id, num_copy);
+}
+
 SimpleHashDistributor::SimpleHashDistributor(host_t localhost,
                                              unsigned int hosts_size)
     : localhost_(localhost), hosts_size_(hosts_size), all_hosts_(hosts_size) {
@@ -60,7 +160,7 @@ SimpleHashDistributor::hosts_size(unsigned int size) {
 host_t
 SimpleHashDistributor::locate_data(const string& path, const chunkid_t& chnk_id,
                                    const int num_copy) const {
-    return (str_hash(path + ::to_string(chnk_id)) + num_copy) % hosts_size_;
+    return locate_data_hashed(path, hash_path(path), chnk_id, num_copy);
 }
 
 host_t
@@ -73,13 +173,21 @@ SimpleHashDistributor::locate_data(const string& path, const chunkid_t& chnk_id,
         ::iota(all_hosts_.begin(), all_hosts_.end(), 0);
     }
 
-    return (str_hash(path + ::to_string(chnk_id)) + num_copy) % hosts_size_;
+    return locate_data_hashed(path, hash_path(path), chnk_id, num_copy);
+}
+
+host_t
+SimpleHashDistributor::locate_data_hashed(const string& path,
+                                          uint64_t path_hash,
+                                          const chunkid_t& chnk_id,
+                                          const int num_copy) const {
+    return (hash_chunk(path_hash, chnk_id) + num_copy) % hosts_size_;
 }
 
 host_t
 SimpleHashDistributor::locate_file_metadata(const string& path,
                                             const int num_copy) const {
-    return (str_hash(path) + num_copy) % hosts_size_;
+    return (hash_path(path) + num_copy) % hosts_size_;
 }
 
 ::vector<host_t>
@@ -87,6 +195,68 @@ SimpleHashDistributor::locate_directory_metadata() const {
     return all_hosts_;
 }
 
+JumpHashDistributor::JumpHashDistributor(host_t localhost,
+                                         unsigned int hosts_size)
+    : localhost_(localhost), hosts_size_(hosts_size), all_hosts_(hosts_size) {
+    ::iota(all_hosts_.begin(), all_hosts_.end(), 0);
+}
+
+JumpHashDistributor::JumpHashDistributor() {}
+
+host_t
+JumpHashDistributor::localhost() const {
+    return localhost_;
+}
+
+unsigned int
+JumpHashDistributor::hosts_size() const {
+    return hosts_size_;
+}
+
+void
+JumpHashDistributor::hosts_size(unsigned int size) {
+    hosts_size_ = size;
+}
+
+host_t
+JumpHashDistributor::locate_data(const string& path, const chunkid_t& chnk_id,
+                                 const int num_copy) const {
+    return locate_data_hashed(path, hash_path(path), chnk_id, num_copy);
+}
+
+host_t
+JumpHashDistributor::locate_data(const string& path, const chunkid_t& chnk_id,
+                                 unsigned int hosts_size, const int num_copy) {
+    if(hosts_size_ != hosts_size) {
+        hosts_size_ = hosts_size;
+        all_hosts_ = std::vector<unsigned int>(hosts_size);
+        ::iota(all_hosts_.begin(), all_hosts_.end(), 0);
+    }
+
+    return locate_data_hashed(path, hash_path(path), chnk_id, num_copy);
+}
+
+host_t
+JumpHashDistributor::locate_data_hashed(const string& path, uint64_t path_hash,
+                                        const chunkid_t& chnk_id,
+                                        const int num_copy) const {
+    return (jump_consistent_hash(hash_chunk(path_hash, chnk_id), hosts_size_) +
+            num_copy) %
+           hosts_size_;
+}
+
+host_t
+JumpHashDistributor::locate_file_metadata(const string& path,
+                                          const int num_copy) const {
+    return (jump_consistent_hash(hash_path(path), hosts_size_) + num_copy) %
+           hosts_size_;
+}
+
+::vector<host_t>
+JumpHashDistributor::locate_directory_metadata() const {
+    return all_hosts_;
+}
+
 LocalOnlyDistributor::LocalOnlyDistributor(host_t localhost)
     : localhost_(localhost) {}
 
@@ -160,7 +330,7 @@ ForwarderDistributor::locate_data(const std::string& path,
 host_t
 ForwarderDistributor::locate_file_metadata(const std::string& path,
                                            const int num_copy) const {
-    return (str_hash(path) + num_copy) % hosts_size_;
+    return (hash_path(path) + num_copy) % hosts_size_;
 }
 
 
@@ -287,17 +457,16 @@ GuidedDistributor::locate_data(const string& path, const chunkid_t& chnk_id,
         if(0 == path.compare(0, min(it.length(), path.length()), it, 0,
                              min(it.length(), path.length()))) {
         }
-        return str_hash(path) % hosts_size_;
+        return hash_path(path) % hosts_size_;
     }
 
-    auto locate = path + ::to_string(chnk_id);
-    return (str_hash(locate) + num_copy) % hosts_size_;
+    return (hash_chunk(hash_path(path), chnk_id) + num_copy) % hosts_size_;
 }
 
 host_t
 GuidedDistributor::locate_file_metadata(const string& path,
                                         const int num_copy) const {
-    return (str_hash(path) + num_copy) % hosts_size_;
+    return (hash_path(path) + num_copy) % hosts_size_;
 }
 
 
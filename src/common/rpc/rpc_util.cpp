@@ -34,7 +34,13 @@ extern "C" {
 #include <netdb.h>
 }
 
+#include <atomic>
+#include <charconv>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
 #include <system_error>
+#include <thread>
 
 
 using namespace std;
@@ -211,5 +217,87 @@ decompress_bitset(const std::string& compressedString) {
     return base64_decode(compressedString);
 }
 
+/**
+ * Encodes a list of strings into a single RPC string. Each string is prefixed
+ * by its decimal length and a ':' so that strings may contain any character
+ * but '\0', e.g., {"/a", "/bc"} becomes "2:/a3:/bc".
+ * @param strings
+ * @return encoded string
+ */
+std::string
+encode_string_batch(const std::vector<std::string>& strings) {
+    std::string encoded;
+    size_t total = 0;
+    for(const auto& s : strings)
+        total += s.size() + 8;
+    encoded.reserve(total);
+    for(const auto& s : strings) {
+        encoded.append(std::to_string(s.size()));
+        encoded.push_back(':');
+        encoded.append(s);
+    }
+    return encoded;
+}
+
+/**
+ * Decodes a string created by encode_string_batch()
+ * @param encoded
+ * @return list of strings
+ * @throws std::invalid_argument if the string is malformed
+ */
+std::vector<std::string>
+decode_string_batch(std::string_view encoded) {
+    std::vector<std::string> strings;
+    const auto* pos = encoded.data();
+    const auto* end = encoded.data() + encoded.size();
+    while(pos != end) {
+        size_t len = 0;
+        auto [ptr, ec] = std::from_chars(pos, end, len);
+        if(ec != std::errc() || ptr == end || *ptr != ':' ||
+           len > static_cast<size_t>(end - ptr - 1)) {
+            throw std::invalid_argument("Malformed string batch");
+        }
+        pos = ptr + 1;
+        strings.emplace_back(pos, len);
+        pos += len;
+    }
+    return strings;
+}
+
+void
+for_each_concurrently(const std::vector<uint64_t>& ids,
+                      unsigned int concurrency,
+                      const std::function<void(uint64_t)>& func) {
+    std::atomic<size_t> next{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto worker = [&]() {
+        size_t i;
+        while((i = next.fetch_add(1)) < ids.size()) {
+            try {
+                func(ids[i]);
+            } catch(...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if(!error) {
+                    error = std::current_exception();
+                }
+                next.store(ids.size());
+            }
+        }
+    };
+    auto threads = std::min<size_t>(concurrency, ids.size());
+    std::vector<std::thread> workers;
+    // the calling thread is one of the workers
+    for(size_t t = 1; t < threads; t++) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for(auto& w : workers) {
+        w.join();
+    }
+    if(error) {
+        std::rethrow_exception(error);
+    }
+}
 
 } // namespace gkfs::rpc
\ No newline at end of file
@@ -76,6 +76,26 @@ Stats::setup_Prometheus(const std::string& gateway_ip,
                 Summary::Quantiles{});
     }
 
+    family_cache = &BuildCounter()
+                            .Name("CACHE")
+                            .Help("Number of cache hits and misses")
+                            .Register(*registry);
+
+    for(auto e : all_CacheOp) {
+        cache_prometheus[e] = &family_cache->Add(
+                {{"operation", CacheOp_s[static_cast<int>(e)]}});
+    }
+
+    family_gauge = &BuildGauge()
+                            .Name("GAUGE")
+                            .Help("Current value, e.g., buffer occupancy")
+                            .Register(*registry);
+
+    for(auto e : all_GaugeOp) {
+        gauge_prometheus[e] = &family_gauge->Add(
+                {{"operation", GaugeOp_s[static_cast<int>(e)]}});
+    }
+
     gateway->RegisterCollectable(registry);
 #endif /// GKFS_ENABLE_PROMETHEUS
 }
@@ -102,6 +122,14 @@ Stats::Stats(bool enable_chunkstats, bool enable_prometheus,
         time_size[e].push_back(pair(std::chrono::steady_clock::now(), 0.0));
     }
 
+    for(auto e : all_CacheOp) {
+        cache_count[e] = 0;
+    }
+
+    for(auto e : all_GaugeOp) {
+        gauge_value[e] = 0;
+    }
+
 #ifdef GKFS_ENABLE_PROMETHEUS
     auto pos_separator = prometheus_gateway.find(':');
     setup_Prometheus(prometheus_gateway.substr(0, pos_separator),
@@ -211,6 +239,52 @@ Stats::add_value_size(enum SizeOp iop, unsigned long long value) {
         add_value_iops(IopsOp::iops_write);
 }
 
+void
+Stats::add_value_cache(enum CacheOp cop, unsigned long long value) {
+    cache_count[cop] += value;
+#ifdef GKFS_ENABLE_PROMETHEUS
+    if(enable_prometheus_) {
+        cache_prometheus[cop]->Increment(static_cast<double>(value));
+    }
+#endif
+}
+
+unsigned long long
+Stats::get_count(enum CacheOp cop) {
+    return cache_count[cop];
+}
+
+void
+Stats::add_value_gauge(enum GaugeOp gop, long long delta) {
+    auto value = gauge_value[gop] += delta;
+#ifdef GKFS_ENABLE_PROMETHEUS
+    if(enable_prometheus_) {
+        gauge_prometheus[gop]->Set(static_cast<double>(value));
+    }
+#else
+    (void) value;
+#endif
+}
+
+long long
+Stats::get_gauge(enum GaugeOp gop) {
+    return gauge_value[gop];
+}
+
+void
+Stats::set_external_source(std::function<external_stats_t()> source) {
+    std::lock_guard<std::mutex> lock(external_mutex);
+    external_source = std::move(source);
+}
+
+Stats::external_stats_t
+Stats::get_external() {
+    std::lock_guard<std::mutex> lock(external_mutex);
+    if(!external_source)
+        return {};
+    return external_source();
+}
+
 /**
  * @brief Get the total mean value of the asked stat
  * This can be provided inmediately without cost
@@ -318,6 +392,41 @@ Stats::dump(std::ofstream& of) {
         }
         of << std::endl;
     }
+    for(auto e : all_CacheOp) {
+        of << "Stats " << CacheOp_s[static_cast<int>(e)] << " total \t\t"
+           << get_count(e) << std::endl;
+    }
+    auto fd_hits = get_count(CacheOp::chunk_fd_hit);
+    auto fd_lookups = fd_hits + get_count(CacheOp::chunk_fd_miss);
+    if(fd_lookups > 0) {
+        of << "Stats CHUNK_FD_CACHE hit rate \t\t" << std::setprecision(4)
+           << 100.0 * static_cast<double>(fd_hits) /
+                      static_cast<double>(fd_lookups)
+           << " %" << std::endl;
+    }
+    auto md_hits = get_count(CacheOp::metadata_hit);
+    auto md_lookups = md_hits + get_count(CacheOp::metadata_miss);
+    if(md_lookups > 0) {
+        of << "Stats METADATA_CACHE hit rate \t\t" << std::setprecision(4)
+           << 100.0 * static_cast<double>(md_hits) /
+                      static_cast<double>(md_lookups)
+           << " %" << std::endl;
+    }
+    for(auto e : all_GaugeOp) {
+        of << "Stats " << GaugeOp_s[static_cast<int>(e)] << " current \t\t"
+           << get_gauge(e) << std::endl;
+    }
+    auto pool_used = get_gauge(GaugeOp::bulk_pool_used);
+    auto pool_capacity = get_gauge(GaugeOp::bulk_pool_capacity);
+    if(pool_capacity > 0) {
+        of << "Stats BULK_POOL occupancy \t\t" << std::setprecision(4)
+           << 100.0 * static_cast<double>(pool_used) /
+                      static_cast<double>(pool_capacity)
+           << " %" << std::endl;
+    }
+    for(const auto& [name, value] : get_external()) {
+        of << "Stats " << name << " current \t\t" << value << std::endl;
+    }
     of << std::endl;
 }
 void
@@ -340,6 +449,10 @@ Stats::output(std::chrono::seconds d, std::string file_output) {
         }
 #ifdef GKFS_ENABLE_PROMETHEUS
         if(enable_prometheus_) {
+            for(const auto& [name, value] : get_external()) {
+                family_gauge->Add({{"operation", name}})
+                        .Set(static_cast<double>(value));
+            }
             gateway->Push();
         }
 #endif
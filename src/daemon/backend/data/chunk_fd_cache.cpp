@@ -0,0 +1,211 @@
+/*
+  Copyright 2018-2024, Barcelona Supercomputing Center (BSC), Spain
+  Copyright 2015-2024, Johannes Gutenberg Universitaet Mainz, Germany
+
+  This software was partially supported by the
+  EC H2020 funded project NEXTGenIO (Project ID: 671951, www.nextgenio.eu).
+
+  This software was partially supported by the
+  ADA-FS project under the SPPEXA project funded by the DFG.
+
+  This file is part of GekkoFS.
+
+  GekkoFS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GekkoFS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GekkoFS.  If not, see <https://www.gnu.org/licenses/>.
+
+  SPDX-License-Identifier: GPL-3.0-or-later
+*/
+/**
+ * @brief Definitions of the chunk file descriptor cache.
+ */
+
+#include <daemon/backend/data/chunk_fd_cache.hpp>
+#include <daemon/backend/data/file_handle.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+extern "C" {
+#include <fcntl.h>
+}
+
+using namespace std;
+
+namespace gkfs::data {
+
+ChunkFdCache::shard&
+ChunkFdCache::shard_for(const string& path) const {
+    return shards_[std::hash<string>{}(path) % shard_count_];
+}
+
+void
+ChunkFdCache::erase_locked(shard& s, lru_list::iterator it) {
+    auto path_it = s.index.find(it->path);
+    if(path_it != s.index.end()) {
+        path_it->second.erase(it->chunk_id);
+        if(path_it->second.empty())
+            s.index.erase(path_it);
+    }
+    s.lru.erase(it);
+}
+
+ChunkFdCache::ChunkFdCache(size_t capacity, size_t shard_count)
+    : shards_(make_unique<shard[]>(shard_count > 0 ? shard_count : 1)),
+      shard_count_(shard_count > 0 ? shard_count : 1),
+      shard_capacity_(std::max<size_t>(1, capacity / shard_count_)) {}
+
+ChunkFdCache::~ChunkFdCache() {
+    clear();
+}
+
+/**
+ * @internal
+ * The chunk file is opened outside of the shard lock. If another tasklet
+ * inserted the same chunk in the meantime, its handle is used and the newly
+ * opened one is closed when it goes out of scope. On insertion, the least
+ * recently used entry of the shard is evicted if the shard is full. The evicted
+ * file descriptor is closed once no in-flight operation holds a reference.
+ * @endinternal
+ */
+ChunkFdCache::handle_t
+ChunkFdCache::get(const string& path, gkfs::rpc::chnk_id_t chunk_id,
+                  const string& chunk_path, int flags, bool& hit) {
+    auto& s = shard_for(path);
+    uint64_t epoch;
+    {
+        lock_guard<mutex> lock(s.mtx);
+        auto path_it = s.index.find(path);
+        if(path_it != s.index.end()) {
+            auto chunk_it = path_it->second.find(chunk_id);
+            if(chunk_it != path_it->second.end()) {
+                // move to front of the LRU list
+                s.lru.splice(s.lru.begin(), s.lru, chunk_it->second);
+                hits_.fetch_add(1, memory_order_relaxed);
+                hit = true;
+                return chunk_it->second->handle;
+            }
+        }
+        epoch = s.epoch;
+    }
+    hit = false;
+    misses_.fetch_add(1, memory_order_relaxed);
+
+    auto fh = make_shared<FileHandle>(::open(chunk_path.c_str(), flags, 0640),
+                                      chunk_path);
+    if(!fh->valid())
+        return fh; // errno is set by open()
+
+    handle_t evicted{}; // closed after the lock is released
+    lock_guard<mutex> lock(s.mtx);
+    // file was invalidated while we were opening it. Don't cache
+    if(s.epoch != epoch)
+        return fh;
+    auto& chunks = s.index[path];
+    auto chunk_it = chunks.find(chunk_id);
+    if(chunk_it != chunks.end()) {
+        // lost the race against another tasklet
+        s.lru.splice(s.lru.begin(), s.lru, chunk_it->second);
+        return chunk_it->second->handle;
+    }
+    s.lru.push_front(entry{path, chunk_id, fh});
+    chunks.emplace(chunk_id, s.lru.begin());
+    if(s.lru.size() > shard_capacity_) {
+        auto last = std::prev(s.lru.end());
+        evicted = std::move(last->handle);
+        erase_locked(s, last);
+    }
+    return fh;
+}
+
+void
+ChunkFdCache::invalidate(const string& path) {
+    auto& s = shard_for(path);
+    vector<handle_t> evicted{};
+    lock_guard<mutex> lock(s.mtx);
+    s.epoch++;
+    auto path_it = s.index.find(path);
+    if(path_it == s.index.end())
+        return;
+    for(auto& [chunk_id, it] : path_it->second) {
+        evicted.emplace_back(std::move(it->handle));
+        s.lru.erase(it);
+    }
+    s.index.erase(path_it);
+}
+
+void
+ChunkFdCache::invalidate_from(const string& path,
+                              gkfs::rpc::chnk_id_t chunk_start) {
+    auto& s = shard_for(path);
+    vector<handle_t> evicted{};
+    lock_guard<mutex> lock(s.mtx);
+    s.epoch++;
+    auto path_it = s.index.find(path);
+    if(path_it == s.index.end())
+        return;
+    auto& chunks = path_it->second;
+    for(auto chunk_it = chunks.begin(); chunk_it != chunks.end();) {
+        if(chunk_it->first >= chunk_start) {
+            evicted.emplace_back(std::move(chunk_it->second->handle));
+            s.lru.erase(chunk_it->second);
+            chunk_it = chunks.erase(chunk_it);
+        } else {
+            ++chunk_it;
+        }
+    }
+    if(chunks.empty())
+        s.index.erase(path_it);
+}
+
+void
+ChunkFdCache::invalidate_chunk(const string& path,
+                               gkfs::rpc::chnk_id_t chunk_id) {
+    auto& s = shard_for(path);
+    handle_t evicted{};
+    lock_guard<mutex> lock(s.mtx);
+    s.epoch++;
+    auto path_it = s.index.find(path);
+    if(path_it == s.index.end())
+        return;
+    auto chunk_it = path_it->second.find(chunk_id);
+    if(chunk_it == path_it->second.end())
+        return;
+    evicted = std::move(chunk_it->second->handle);
+    erase_locked(s, chunk_it->second);
+}
+
+void
+ChunkFdCache::clear() {
+    for(size_t i = 0; i < shard_count_; i++) {
+        auto& s = shards_[i];
+        lock_guard<mutex> lock(s.mtx);
+        s.epoch++;
+        s.index.clear();
+        s.lru.clear();
+    }
+}
+
+uint64_t
+ChunkFdCache::hits() const {
+    return hits_.load(memory_order_relaxed);
+}
+
+uint64_t
+ChunkFdCache::misses() const {
+    return misses_.load(memory_order_relaxed);
+}
+
+} // namespace gkfs::data
@@ -33,7 +33,9 @@
 #include <daemon/backend/data/data_module.hpp>
 #include <daemon/backend/data/chunk_storage.hpp>
 #include <daemon/backend/data/file_handle.hpp>
+#include <daemon/backend/data/chunk_fd_cache.hpp>
 #include <common/path_util.hpp>
+#include <common/statistics/stats.hpp>
 
 #include <cerrno>
 #include <algorithm>
@@ -86,8 +88,27 @@ ChunkStorage::get_chunk_path(const string& file_path,
     return fmt::format("{}/{}", get_chunks_dir(file_path), chunk_id);
 }
 
+ChunkStorage::chunk_dir_shard&
+ChunkStorage::chunk_dir_shard_for(const string& file_path) const {
+    return known_chunk_dirs_[std::hash<string>{}(file_path) %
+                             gkfs::config::data::chunk_dir_cache_shards];
+}
+
+/**
+ * @internal
+ * The known chunk directory set is only an optimization to avoid a mkdir()
+ * syscall for each chunk write. If a shard grows beyond its share of
+ * chunk_dir_cache_size, it is simply cleared and repopulated lazily.
+ * @endinternal
+ */
 void
 ChunkStorage::init_chunk_space(const string& file_path) const {
+    if(known_chunk_dirs_) {
+        auto& shard = chunk_dir_shard_for(file_path);
+        lock_guard<mutex> lock(shard.mtx);
+        if(shard.dirs.count(file_path) != 0)
+            return;
+    }
     auto chunk_dir = absolute(get_chunks_dir(file_path));
     auto err = mkdir(chunk_dir.c_str(), 0750);
     if(err == -1 && errno != EEXIST) {
@@ -96,12 +117,59 @@ ChunkStorage::init_chunk_space(const string& file_path) const {
                 __func__, file_path, errno);
         throw ChunkStorageException(errno, err_str);
     }
+    if(known_chunk_dirs_) {
+        constexpr size_t max_shard_size =
+                gkfs::config::data::chunk_dir_cache_size /
+                gkfs::config::data::chunk_dir_cache_shards;
+        auto& shard = chunk_dir_shard_for(file_path);
+        lock_guard<mutex> lock(shard.mtx);
+        if(shard.dirs.size() >= max_shard_size)
+            shard.dirs.clear();
+        shard.dirs.insert(file_path);
+    }
+}
+
+void
+ChunkStorage::forget_chunk_space(const string& file_path) const {
+    if(!known_chunk_dirs_)
+        return;
+    auto& shard = chunk_dir_shard_for(file_path);
+    lock_guard<mutex> lock(shard.mtx);
+    shard.dirs.erase(file_path);
+}
+
+/**
+ * @internal
+ * Without the chunk file descriptor cache, the file is opened with the given
+ * flags and closed when the last reference to the handle is dropped. With the
+ * cache, chunk files are always opened read-write so that a single cached file
+ * descriptor serves both reads and writes. O_CREAT is only used for writes so
+ * that reads of sparse regions still fail with ENOENT.
+ * @endinternal
+ */
+shared_ptr<FileHandle>
+ChunkStorage::open_chunk(const string& file_path, gkfs::rpc::chnk_id_t chunk_id,
+                         const string& chunk_path, int flags) const {
+    if(!fd_cache_) {
+        return make_shared<FileHandle>(open(chunk_path.c_str(), flags, 0640),
+                                       chunk_path);
+    }
+    bool hit = false;
+    auto fh = fd_cache_->get(file_path, chunk_id, chunk_path,
+                             O_RDWR | (flags & O_CREAT), hit);
+    if(stats_) {
+        using gkfs::utils::Stats;
+        stats_->add_value_cache(hit ? Stats::CacheOp::chunk_fd_hit
+                                    : Stats::CacheOp::chunk_fd_miss);
+    }
+    return fh;
 }
 
 // public functions
 
-ChunkStorage::ChunkStorage(string& path, const size_t chunksize)
-    : root_path_(path), chunksize_(chunksize) {
+ChunkStorage::ChunkStorage(string& path, const size_t chunksize,
+                           shared_ptr<gkfs::utils::Stats> stats)
+    : root_path_(path), chunksize_(chunksize), stats_(std::move(stats)) {
     /* Get logger instance and set it for data module and chunk storage */
     GKFS_DATA_MOD->log(spdlog::get(GKFS_DATA_MOD->LOGGER_NAME));
     assert(GKFS_DATA_MOD->log());
@@ -115,19 +183,43 @@ ChunkStorage::ChunkStorage(string& path, const size_t chunksize)
                 __func__, root_path_);
         throw ChunkStorageException(EPERM, err_str);
     }
+    if(gkfs::config::data::use_chunk_fd_cache && !gkfs::config::limbo_mode) {
+        fd_cache_ = std::make_unique<ChunkFdCache>(
+                gkfs::config::data::chunk_fd_cache_size,
+                gkfs::config::data::chunk_fd_cache_shards);
+        log_->debug("{}() Chunk file descriptor cache enabled with size '{}'",
+                    __func__, gkfs::config::data::chunk_fd_cache_size);
+    }
+    if(gkfs::config::data::use_chunk_dir_cache) {
+        static_assert(gkfs::config::data::chunk_dir_cache_shards > 0,
+                      "Chunk directory cache requires at least one shard");
+        known_chunk_dirs_ = std::make_unique<chunk_dir_shard[]>(
+                gkfs::config::data::chunk_dir_cache_shards);
+    }
     log_->debug("{}() Chunk storage initialized with path: '{}'", __func__,
                 root_path_);
 }
 
+ChunkStorage::~ChunkStorage() = default;
+
 void
 ChunkStorage::destroy_chunk_space(const string& file_path) const {
     auto chunk_dir = absolute(get_chunks_dir(file_path));
     try {
         // Note: remove_all does not throw an error when path doesn't exist.
         auto n = fs::remove_all(chunk_dir);
+        // Evict cached file descriptors only after the files are gone.
+        // Otherwise, a concurrent write could re-insert a descriptor of a
+        // removed chunk file.
+        if(fd_cache_)
+            fd_cache_->invalidate(file_path);
+        forget_chunk_space(file_path);
         log_->debug("{}() Removed '{}' files and directories from '{}'",
                     __func__, n, chunk_dir);
     } catch(const fs::filesystem_error& e) {
+        if(fd_cache_)
+            fd_cache_->invalidate(file_path);
+        forget_chunk_space(file_path);
         auto err_str = fmt::format(
                 "{}() Failed to remove chunk directory. Path: '{}', Error: '{}'",
                 __func__, chunk_dir, e.what());
@@ -152,17 +244,27 @@ ChunkStorage::write_chunk(const string& file_path,
 
     assert((offset + size) <= chunksize_);
     string chunk_path{};
+    shared_ptr<FileHandle> fh{};
     if(gkfs::config::limbo_mode) {
         chunk_path = "/dev/null"s;
+        fh = make_shared<FileHandle>(open(chunk_path.c_str(), O_WRONLY),
+                                     chunk_path);
     } else {
         // may throw ChunkStorageException on failure
         init_chunk_space(file_path);
         chunk_path = absolute(get_chunk_path(file_path, chunk_id));
+        fh = open_chunk(file_path, chunk_id, chunk_path, O_WRONLY | O_CREAT);
+        if(!fh->valid() && errno == ENOENT) {
+            // chunk directory was known but removed in the meantime, e.g., by
+            // a concurrent remove. Create it again and retry once.
+            forget_chunk_space(file_path);
+            init_chunk_space(file_path);
+            fh = open_chunk(file_path, chunk_id, chunk_path,
+                            O_WRONLY | O_CREAT);
+        }
     }
 
-    FileHandle fh(open(chunk_path.c_str(), O_WRONLY | O_CREAT, 0640),
-                  chunk_path);
-    if(!fh.valid()) {
+    if(!fh->valid()) {
         auto err_str = fmt::format(
                 "{}() Failed to open chunk file for write. File: '{}', Error: '{}'",
                 __func__, chunk_path, ::strerror(errno));
@@ -173,7 +275,7 @@ ChunkStorage::write_chunk(const string& file_path,
     ssize_t wrote{};
 
     do {
-        wrote = pwrite(fh.native(), buf + wrote_total, size - wrote_total,
+        wrote = pwrite(fh->native(), buf + wrote_total, size - wrote_total,
                        offset + wrote_total);
 
         if(wrote < 0) {
@@ -189,7 +291,7 @@ ChunkStorage::write_chunk(const string& file_path,
         wrote_total += wrote;
     } while(wrote_total != size);
 
-    // file is closed via the file handle's destructor.
+    // file is closed via the file handle's destructor unless it is cached.
     return wrote_total;
 }
 
@@ -205,14 +307,17 @@ ChunkStorage::read_chunk(const string& file_path, gkfs::rpc::chnk_id_t chunk_id,
                          char* buf, size_t size, off64_t offset) const {
     assert((offset + size) <= chunksize_);
     string chunk_path{};
+    shared_ptr<FileHandle> fh{};
     if(gkfs::config::limbo_mode) {
         chunk_path = "/dev/zero"s;
+        fh = make_shared<FileHandle>(open(chunk_path.c_str(), O_RDONLY),
+                                     chunk_path);
     } else {
         chunk_path = absolute(get_chunk_path(file_path, chunk_id));
+        fh = open_chunk(file_path, chunk_id, chunk_path, O_RDONLY);
     }
 
-    FileHandle fh(open(chunk_path.c_str(), O_RDONLY), chunk_path);
-    if(!fh.valid()) {
+    if(!fh->valid()) {
         auto err_str = fmt::format(
                 "{}() Failed to open chunk file for read. File: '{}', Error: '{}'",
                 __func__, chunk_path, ::strerror(errno));
@@ -222,7 +327,7 @@ ChunkStorage::read_chunk(const string& file_path, gkfs::rpc::chnk_id_t chunk_id,
     ssize_t read = 0;
 
     do {
-        read = pread64(fh.native(), buf + read_total, size - read_total,
+        read = pread64(fh->native(), buf + read_total, size - read_total,
                        offset + read_total);
         if(read == 0) {
             /*
@@ -256,7 +361,7 @@ ChunkStorage::read_chunk(const string& file_path, gkfs::rpc::chnk_id_t chunk_id,
         read_total += read;
     } while(read_total != size);
 
-    // file is closed via the file handle's destructor.
+    // file is closed via the file handle's destructor unless it is cached.
     return read_total;
 }
 
@@ -293,6 +398,8 @@ ChunkStorage::trim_chunk_space(const string& file_path,
             }
         }
     }
+    if(fd_cache_)
+        fd_cache_->invalidate_from(file_path, chunk_start);
     if(err_flag)
         throw ChunkStorageException(
                 EIO,
@@ -307,6 +414,8 @@ ChunkStorage::truncate_chunk_file(const string& file_path,
     auto chunk_path = absolute(get_chunk_path(file_path, chunk_id));
     assert(length > 0 &&
            static_cast<gkfs::rpc::chnk_id_t>(length) <= chunksize_);
+    if(fd_cache_)
+        fd_cache_->invalidate_chunk(file_path, chunk_id);
     auto ret = truncate(chunk_path.c_str(), length);
     if(ret == -1) {
         auto err_str = fmt::format(
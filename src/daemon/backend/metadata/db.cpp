@@ -45,11 +45,13 @@ namespace gkfs::metadata {
 /**
  * Factory to create DB instances
  * @param path where KV store data is stored
- * @param id parallax or rocksdb (default) backend
+ * @param id parallax, inmemory, or rocksdb (default) backend
+ * @param profile_file RocksDB tuning profile, empty for the default
  */
 struct MetadataDBFactory {
     static std::unique_ptr<AbstractMetadataBackend>
-    create(const std::string& path, const std::string_view id) {
+    create(const std::string& path, const std::string_view id,
+           [[maybe_unused]] const std::string& profile_file) {
 
         if(id == gkfs::metadata::parallax_backend) {
 #ifdef GKFS_ENABLE_PARALLAX
@@ -66,8 +68,17 @@ struct MetadataDBFactory {
             fs::create_directories(metadata_path);
             GKFS_METADATA_MOD->log()->trace("Using RocksDB directory '{}'",
                                             metadata_path);
-            return std::make_unique<RocksDBBackend>(metadata_path);
+            return std::make_unique<RocksDBBackend>(metadata_path,
+                                                    profile_file);
 #endif
+        } else if(id == gkfs::metadata::inmemory_backend) {
+            auto metadata_path = fmt::format("{}/{}", path,
+                                             gkfs::metadata::inmemory_backend);
+            fs::create_directories(metadata_path);
+            GKFS_METADATA_MOD->log()->trace(
+                    "Using in-memory metadata, snapshot directory '{}'",
+                    metadata_path);
+            return std::make_unique<InMemoryBackend>(metadata_path);
         }
         GKFS_METADATA_MOD->log()->error("No valid metadata backend selected");
         exit(EXIT_FAILURE);
@@ -81,7 +92,8 @@ struct MetadataDBFactory {
  * see here: https://github.com/facebook/rocksdb/wiki/RocksDB-Tuning-Guide
  * @endinternal
  */
-MetadataDB::MetadataDB(const std::string& path, const std::string_view database)
+MetadataDB::MetadataDB(const std::string& path, const std::string_view database,
+                       const std::string& profile_file)
     : path_(path) {
 
     /* Get logger instance and set it for data module and chunk storage */
@@ -90,7 +102,7 @@ MetadataDB::MetadataDB(const std::string& path, const std::string_view database)
     log_ = spdlog::get(GKFS_METADATA_MOD->LOGGER_NAME);
     assert(log_);
 
-    backend_ = MetadataDBFactory::create(path, database);
+    backend_ = MetadataDBFactory::create(path, database, profile_file);
 }
 
 MetadataDB::~MetadataDB() {
@@ -120,11 +132,31 @@ MetadataDB::put_no_exist(const std::string& key, const std::string& val) {
     backend_->put_no_exist(key, val);
 }
 
+std::vector<std::optional<std::string>>
+MetadataDB::get_batch(const std::vector<std::string>& keys) const {
+    return backend_->get_batch(keys);
+}
+
+void
+MetadataDB::put_batch(
+        const std::vector<std::pair<std::string, std::string>>& kvs) {
+    for([[maybe_unused]] const auto& [key, val] : kvs) {
+        assert(gkfs::path::is_absolute(key));
+        assert(key == "/" || !gkfs::path::has_trailing_slash(key));
+    }
+    backend_->put_batch(kvs);
+}
+
 void
 MetadataDB::remove(const std::string& key) {
     backend_->remove(key);
 }
 
+void
+MetadataDB::remove_batch(const std::vector<std::string>& keys) {
+    backend_->remove_batch(keys);
+}
+
 bool
 MetadataDB::exists(const std::string& key) {
     return backend_->exists(key);
@@ -160,6 +192,21 @@ MetadataDB::get_dirents(const std::string& dir) const {
     return backend_->get_dirents(root_path);
 }
 
+std::vector<std::pair<std::string, bool>>
+MetadataDB::get_dirents_page(const std::string& dir,
+                             const std::string& start_key,
+                             size_t max_entries) const {
+    auto root_path = dir;
+    assert(gkfs::path::is_absolute(root_path));
+    // add trailing slash if missing
+    if(!gkfs::path::has_trailing_slash(root_path) && root_path.size() != 1) {
+        // add trailing slash only if missing and is not the root_folder "/"
+        root_path.push_back('/');
+    }
+
+    return backend_->get_dirents_page(root_path, start_key, max_entries);
+}
+
 std::vector<std::tuple<std::string, bool, size_t, time_t>>
 MetadataDB::get_dirents_extended(const std::string& dir) const {
     auto root_path = dir;
@@ -189,4 +236,9 @@ MetadataDB::db_size() const {
     return backend_->db_size();
 }
 
+std::vector<std::pair<std::string, uint64_t>>
+MetadataDB::db_stats() const {
+    return backend_->db_stats();
+}
+
 } // namespace gkfs::metadata
@@ -0,0 +1,531 @@
+/*
+  Copyright 2018-2024, Barcelona Supercomputing Center (BSC), Spain
+  Copyright 2015-2024, Johannes Gutenberg Universitaet Mainz, Germany
+
+  This software was partially supported by the
+  EC H2020 funded project NEXTGenIO (Project ID: 671951, www.nextgenio.eu).
+
+  This software was partially supported by the
+  ADA-FS project under the SPPEXA project funded by the DFG.
+
+  This file is part of GekkoFS.
+
+  GekkoFS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GekkoFS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GekkoFS.  If not, see <https://www.gnu.org/licenses/>.
+
+  SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#include <daemon/backend/metadata/inmemory_backend.hpp>
+#include <daemon/backend/exceptions.hpp>
+#include <daemon/backend/metadata/metadata_module.hpp>
+
+#include <common/metadata.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <mutex>
+extern "C" {
+#include <sys/stat.h>
+}
+
+namespace fs = std::filesystem;
+
+namespace gkfs::metadata {
+
+namespace {
+
+constexpr auto snapshot_file = "snapshot";
+constexpr char snapshot_magic[] = "GKFSMD01";
+
+/**
+ * Splits a path into its parent directory and its database key
+ * @param path absolute path
+ * @return pair of parent and key in the `<parent>\0<name>` format
+ */
+std::pair<std::string, std::string>
+split_key(const std::string& path) {
+    auto pos = path.rfind('/');
+    if(pos == std::string::npos || path.size() == 1) {
+        // root or not a path
+        return {path, path};
+    }
+    std::string parent = pos == 0 ? "/" : path.substr(0, pos);
+    std::string key;
+    key.reserve(path.size() + 1);
+    key.append(parent);
+    key.push_back('\0');
+    key.append(path, pos + 1, std::string::npos);
+    return {std::move(parent), std::move(key)};
+}
+
+/**
+ * Returns the parent directory and the common key prefix of all direct
+ * children of a directory
+ * @param dir absolute directory path with a trailing slash
+ * @return pair of parent and key prefix
+ */
+std::pair<std::string, std::string>
+children_prefix(const std::string& dir) {
+    auto parent = dir;
+    if(parent.size() > 1 && parent.back() == '/') {
+        parent.pop_back();
+    }
+    auto prefix = parent;
+    prefix.push_back('\0');
+    return {std::move(parent), std::move(prefix)};
+}
+
+void
+write_string(std::ofstream& out, const std::string& str) {
+    uint64_t len = str.size();
+    out.write(reinterpret_cast<const char*>(&len), sizeof(len));
+    out.write(str.data(), static_cast<std::streamsize>(len));
+}
+
+bool
+read_string(std::ifstream& in, std::string& str) {
+    uint64_t len = 0;
+    if(!in.read(reinterpret_cast<char*>(&len), sizeof(len))) {
+        return false;
+    }
+    str.resize(len);
+    return static_cast<bool>(
+            in.read(str.data(), static_cast<std::streamsize>(len)));
+}
+
+} // namespace
+
+/**
+ * Called when the daemon is started: Loads the snapshot if snapshots are
+ * enabled
+ * @param path directory for the snapshot file
+ * @param use_snapshot
+ */
+InMemoryBackend::InMemoryBackend(const std::string& path, bool use_snapshot)
+    : shards_(std::make_unique<shard[]>(gkfs::config::inmemory::shards)) {
+    if(use_snapshot) {
+        snapshot_path_ = (fs::path(path) / snapshot_file).string();
+        load_snapshot();
+    }
+}
+
+/**
+ * Called when the daemon is shut down: Writes the snapshot if snapshots are
+ * enabled
+ */
+InMemoryBackend::~InMemoryBackend() {
+    if(snapshot_path_.empty()) {
+        return;
+    }
+    try {
+        write_snapshot();
+    } catch(const std::exception& e) {
+        GKFS_METADATA_MOD->log()->error("{}() Failed to write snapshot: '{}'",
+                                        __func__, e.what());
+    }
+}
+
+InMemoryBackend::shard&
+InMemoryBackend::shard_for(const std::string& parent) const {
+    return shards_[std::hash<std::string>{}(parent) %
+                   gkfs::config::inmemory::shards];
+}
+
+std::pair<std::string, InMemoryBackend::shard&>
+InMemoryBackend::locate(const std::string& path) const {
+    auto [parent, key] = split_key(path);
+    return {std::move(key), shard_for(parent)};
+}
+
+/**
+ * Loads the entries of a snapshot file. A missing file is an empty file system
+ * @throws DBException on failure
+ */
+void
+InMemoryBackend::load_snapshot() {
+    std::ifstream in(snapshot_path_, std::ios::binary);
+    if(!in) {
+        return;
+    }
+    char magic[sizeof(snapshot_magic) - 1];
+    if(!in.read(magic, sizeof(magic)) ||
+       !std::equal(magic, magic + sizeof(magic), snapshot_magic)) {
+        throw DBException("Invalid metadata snapshot '" + snapshot_path_ +
+                          "'");
+    }
+    uint64_t count = 0;
+    std::string key, val;
+    while(read_string(in, key)) {
+        if(!read_string(in, val)) {
+            throw DBException("Truncated metadata snapshot '" +
+                              snapshot_path_ + "'");
+        }
+        auto sep = key.find('\0');
+        auto& s = shard_for(sep == std::string::npos ? key
+                                                     : key.substr(0, sep));
+        s.entries.insert_or_assign(key, Metadata(val));
+        count++;
+    }
+    GKFS_METADATA_MOD->log()->info(
+            "{}() Loaded '{}' metadata entries from snapshot '{}'", __func__,
+            count, snapshot_path_);
+}
+
+/**
+ * Writes all entries to a new snapshot file, which replaces the previous
+ * snapshot when it is complete. Shards are locked one after another, the
+ * daemon is expected to be idle.
+ * @throws DBException on failure
+ */
+void
+InMemoryBackend::write_snapshot() const {
+    auto tmp_path = snapshot_path_ + ".tmp";
+    std::ofstream out(tmp_path, std::ios::binary | std::ios::trunc);
+    if(!out) {
+        throw DBException("Failed to open metadata snapshot '" + tmp_path +
+                          "'");
+    }
+    out.write(snapshot_magic, sizeof(snapshot_magic) - 1);
+    uint64_t count = 0;
+    for(auto i = 0; i < gkfs::config::inmemory::shards; i++) {
+        std::shared_lock lock(shards_[i].mtx);
+        for(const auto& [key, md] : shards_[i].entries) {
+            write_string(out, key);
+            write_string(out, md.serialize());
+            count++;
+        }
+    }
+    out.close();
+    if(!out) {
+        throw DBException("Failed to write metadata snapshot '" + tmp_path +
+                          "'");
+    }
+    std::error_code ec;
+    fs::rename(tmp_path, snapshot_path_, ec);
+    if(ec) {
+        throw DBException("Failed to replace metadata snapshot '" +
+                          snapshot_path_ + "': " + ec.message());
+    }
+    GKFS_METADATA_MOD->log()->info(
+            "{}() Wrote '{}' metadata entries to snapshot '{}'", __func__,
+            count, snapshot_path_);
+}
+
+/**
+ * Gets a KV store value for a key
+ * @param key
+ * @return value
+ * @throws NotFoundException if entry doesn't exist
+ */
+std::string
+InMemoryBackend::get_impl(const std::string& key) const {
+    auto [db_key, s] = locate(key);
+    std::shared_lock lock(s.mtx);
+    auto it = s.entries.find(db_key);
+    if(it == s.entries.end()) {
+        throw NotFoundException(key);
+    }
+    return it->second.serialize();
+}
+
+/**
+ * Puts an entry into the KV store. Like a create merge in RocksDB, an existing
+ * entry is kept
+ * @param key
+ * @param val
+ */
+void
+InMemoryBackend::put_impl(const std::string& key, const std::string& val) {
+    Metadata md(val);
+    auto [db_key, s] = locate(key);
+    std::unique_lock lock(s.mtx);
+    s.entries.try_emplace(std::move(db_key), std::move(md));
+}
+
+/**
+ * Puts an entry into the KV store if it doesn't exist
+ * @param key
+ * @param val
+ * @throws ExistException if entry already exists
+ */
+void
+InMemoryBackend::put_no_exist_impl(const std::string& key,
+                                   const std::string& val) {
+    Metadata md(val);
+    auto [db_key, s] = locate(key);
+    std::unique_lock lock(s.mtx);
+    if(!s.entries.try_emplace(std::move(db_key), std::move(md)).second) {
+        throw ExistsException(key);
+    }
+}
+
+/**
+ * Gets the KV store values for several keys
+ * @param keys
+ * @return value per key, std::nullopt if the entry doesn't exist
+ */
+std::vector<std::optional<std::string>>
+InMemoryBackend::get_batch_impl(const std::vector<std::string>& keys) const {
+    std::vector<std::optional<std::string>> ret(keys.size());
+    for(size_t i = 0; i < keys.size(); ++i) {
+        auto [db_key, s] = locate(keys[i]);
+        std::shared_lock lock(s.mtx);
+        auto it = s.entries.find(db_key);
+        if(it != s.entries.end()) {
+            ret[i] = it->second.serialize();
+        }
+    }
+    return ret;
+}
+
+/**
+ * Puts several entries into the KV store
+ * @param kvs
+ */
+void
+InMemoryBackend::put_batch_impl(
+        const std::vector<std::pair<std::string, std::string>>& kvs) {
+    for(const auto& [key, val] : kvs) {
+        put_impl(key, val);
+    }
+}
+
+/**
+ * Removes an entry from the KV store. Like a delete in RocksDB, removing a
+ * missing entry is not an error
+ * @param key
+ */
+void
+InMemoryBackend::remove_impl(const std::string& key) {
+    auto [db_key, s] = locate(key);
+    std::unique_lock lock(s.mtx);
+    s.entries.erase(db_key);
+}
+
+/**
+ * Removes several entries from the KV store
+ * @param keys
+ */
+void
+InMemoryBackend::remove_batch_impl(const std::vector<std::string>& keys) {
+    for(const auto& key : keys) {
+        remove_impl(key);
+    }
+}
+
+/**
+ * checks for existence of an entry
+ * @param key
+ * @return true if exists
+ */
+bool
+InMemoryBackend::exists_impl(const std::string& key) {
+    auto [db_key, s] = locate(key);
+    std::shared_lock lock(s.mtx);
+    return s.entries.count(db_key) != 0;
+}
+
+/**
+ * Updates a metadentry atomically and also allows to change keys
+ * @param old_key
+ * @param new_key
+ * @param val
+ */
+void
+InMemoryBackend::update_impl(const std::string& old_key,
+                             const std::string& new_key,
+                             const std::string& val) {
+    Metadata md(val);
+    auto [old_db_key, old_s] = locate(old_key);
+    auto [new_db_key, new_s] = locate(new_key);
+    // lock the shards in address order to avoid deadlocks
+    std::unique_lock first(std::min(&old_s, &new_s)->mtx);
+    std::unique_lock<std::shared_mutex> second;
+    if(&old_s != &new_s) {
+        second = std::unique_lock(std::max(&old_s, &new_s)->mtx);
+    }
+    old_s.entries.erase(old_db_key);
+    new_s.entries.insert_or_assign(std::move(new_db_key), std::move(md));
+}
+
+/**
+ * Updates the size on the metadata
+ * Operation. E.g., called before a write() call
+ *
+ * The size is modified in place under the exclusive shard lock. Hence,
+ * concurrent appends reserve disjoint offsets without a merge operator.
+ *
+ * @param key
+ * @param io_size
+ * @param offset
+ * @param append
+ * @return offset where the write operation should start. This is only used when
+ * append is set
+ * @throws NotFoundException if entry doesn't exist
+ */
+off_t
+InMemoryBackend::increase_size_impl(const std::string& key, size_t io_size,
+                                    off_t offset, bool append) {
+    auto [db_key, s] = locate(key);
+    std::unique_lock lock(s.mtx);
+    auto it = s.entries.find(db_key);
+    if(it == s.entries.end()) {
+        throw NotFoundException(key);
+    }
+    auto& md = it->second;
+    off_t out_offset = -1;
+    if(append) {
+        out_offset = static_cast<off_t>(md.size());
+        md.size(md.size() + io_size);
+    } else {
+        md.size(std::max(md.size(), static_cast<size_t>(offset) + io_size));
+        if constexpr(gkfs::config::metadata::use_mtime) {
+            md.mtime(time(nullptr));
+        }
+    }
+    return out_offset;
+}
+
+/**
+ * Decreases the size on the metadata
+ * Operation E.g., called before a truncate() call
+ * @param key
+ * @param size
+ * @throws NotFoundException if entry doesn't exist
+ */
+void
+InMemoryBackend::decrease_size_impl(const std::string& key, size_t size) {
+    auto [db_key, s] = locate(key);
+    std::unique_lock lock(s.mtx);
+    auto it = s.entries.find(db_key);
+    if(it == s.entries.end()) {
+        throw NotFoundException(key);
+    }
+    it->second.size(size);
+    if constexpr(gkfs::config::metadata::use_mtime) {
+        it->second.mtime(time(nullptr));
+    }
+}
+
+/**
+ * Return all the first-level entries of the directory @dir
+ *
+ * @return vector of pair <std::string name, bool is_dir>,
+ *         where name is the name of the entries and is_dir
+ *         is true in the case the entry is a directory.
+ */
+std::vector<std::pair<std::string, bool>>
+InMemoryBackend::get_dirents_impl(const std::string& dir) const {
+    return get_dirents_page_impl(dir, "", std::numeric_limits<size_t>::max());
+}
+
+/**
+ * Return up to @max_entries first-level entries of the directory @dir whose
+ * names sort after @start_key, in name order
+ *
+ * @return vector of pair <std::string name, bool is_dir>,
+ *         where name is the name of the entries and is_dir
+ *         is true in the case the entry is a directory.
+ */
+std::vector<std::pair<std::string, bool>>
+InMemoryBackend::get_dirents_page_impl(const std::string& dir,
+                                       const std::string& start_key,
+                                       size_t max_entries) const {
+    auto [parent, prefix] = children_prefix(dir);
+    auto& s = shard_for(parent);
+    std::shared_lock lock(s.mtx);
+
+    std::vector<std::pair<std::string, bool>> entries;
+    // resume at the last entry of the previous page
+    for(auto it = s.entries.lower_bound(prefix + start_key);
+        it != s.entries.end() && entries.size() < max_entries; ++it) {
+        const auto& key = it->first;
+        if(key.compare(0, prefix.size(), prefix) != 0) {
+            break;
+        }
+        auto name = key.substr(prefix.size());
+        if(name.empty() || name == start_key) {
+            continue;
+        }
+#ifdef HAS_RENAME
+        // Remove entries with negative blocks (rename)
+        if(it->second.blocks() == -1) {
+            continue;
+        }
+#endif // HAS_RENAME
+        entries.emplace_back(std::move(name), S_ISDIR(it->second.mode()));
+    }
+    return entries;
+}
+
+/**
+ * Return all the first-level entries of the directory @dir
+ *
+ * @return vector of pair <std::string name, bool is_dir - size - ctime>,
+ *         where name is the name of the entries and is_dir
+ *         is true in the case the entry is a directory.
+ */
+std::vector<std::tuple<std::string, bool, size_t, time_t>>
+InMemoryBackend::get_dirents_extended_impl(const std::string& dir) const {
+    auto [parent, prefix] = children_prefix(dir);
+    auto& s = shard_for(parent);
+    std::shared_lock lock(s.mtx);
+
+    std::vector<std::tuple<std::string, bool, size_t, time_t>> entries;
+    for(auto it = s.entries.lower_bound(prefix); it != s.entries.end(); ++it) {
+        const auto& key = it->first;
+        if(key.compare(0, prefix.size(), prefix) != 0) {
+            break;
+        }
+        const auto& md = it->second;
+#ifdef HAS_RENAME
+        // Remove entries with negative blocks (rename)
+        if(md.blocks() == -1) {
+            continue;
+        }
+#endif // HAS_RENAME
+        entries.emplace_back(key.substr(prefix.size()), S_ISDIR(md.mode()),
+                             md.size(), md.ctime());
+    }
+    return entries;
+}
+
+/**
+ * Not supported, there is no iterator object for the sharded maps
+ * @return nullptr
+ */
+void*
+InMemoryBackend::iterate_all_impl() const {
+    return nullptr;
+}
+
+uint64_t
+InMemoryBackend::db_size_impl() const {
+    uint64_t num_keys = 0;
+    for(auto i = 0; i < gkfs::config::inmemory::shards; i++) {
+        std::shared_lock lock(shards_[i].mtx);
+        num_keys += shards_[i].entries.size();
+    }
+    return num_keys;
+}
+
+std::vector<std::pair<std::string, uint64_t>>
+InMemoryBackend::db_stats_impl() const {
+    return {{"INMEMORY_ENTRIES", db_size_impl()}};
+}
+
+} // namespace gkfs::metadata
@@ -61,12 +61,7 @@ MergeOperand::get_params(const rdb::Slice& serialized_op) {
 }
 
 IncreaseSizeOperand::IncreaseSizeOperand(const size_t size)
-    : size_(size), merge_id_(0), append_(false) {}
-
-IncreaseSizeOperand::IncreaseSizeOperand(const size_t size,
-                                         const uint16_t merge_id,
-                                         const bool append)
-    : size_(size), merge_id_(merge_id), append_(append) {}
+    : size_(size), append_(false) {}
 
 IncreaseSizeOperand::IncreaseSizeOperand(const rdb::Slice& serialized_op) {
     size_t read = 0;
@@ -74,14 +69,11 @@ IncreaseSizeOperand::IncreaseSizeOperand(const rdb::Slice& serialized_op) {
     size_ = std::stoul(serialized_op.data(), &read);
     if(read + 1 == serialized_op.size() ||
        serialized_op[read] == serialize_end) {
-        merge_id_ = 0;
         append_ = false;
         return;
     }
+    // legacy append operand, followed by its merge id
     assert(serialized_op[read] == serialize_sep);
-    // Parse merge id
-    merge_id_ = static_cast<uint16_t>(
-            std::stoul(serialized_op.data() + read + 1, nullptr));
     append_ = true;
 }
 
@@ -93,12 +85,7 @@ IncreaseSizeOperand::id() const {
 string
 IncreaseSizeOperand::serialize_params() const {
     // serialize_end avoids rogue characters in the serialized string
-    if(append_)
-        return fmt::format("{}{}{}{}", size_, serialize_sep, merge_id_,
-                           serialize_end);
-    else {
-        return fmt::format("{}{}", size_, serialize_end);
-    }
+    return fmt::format("{}{}", size_, serialize_end);
 }
 
 
@@ -166,18 +153,16 @@ UpdateTimeOperand::serialize_params() const {
  * well as merge_out->new_value is for RocksDB internals The new value is the
  * merged value of multiple value that is written to one key.
  *
- * Append operations receive special treatment here as the corresponding write
- * function that triggered the size update needs the starting offset. In
- * parallel append operations this is crucial. This is done by accessing a mutex
- * protected std::map which may incur performance overheads for append
- * operations.
+ * Size increases merge with max(), so the operands written by concurrent
+ * appends, which already reserved their offsets in
+ * RocksDBBackend::increase_size_impl(), can be merged in any order.
  * @endinternal
  */
 bool
 MetadataMergeOperator::FullMergeV2(const MergeOperationInput& merge_in,
                                    MergeOperationOutput* merge_out) const {
 
-    string prev_md_value;
+    rdb::Slice prev_md_value;
     auto ops_it = merge_in.operand_list.cbegin();
     if(merge_in.existing_value == nullptr) {
         // The key to operate on doesn't exists in DB
@@ -185,13 +170,14 @@ MetadataMergeOperator::FullMergeV2(const MergeOperationInput& merge_in,
             throw ::runtime_error(
                     "Merge operation failed: key do not exists and first operand is not a creation");
         }
-        prev_md_value = MergeOperand::get_params(ops_it[0]).ToString();
+        prev_md_value = MergeOperand::get_params(ops_it[0]);
         ops_it++;
     } else {
-        prev_md_value = merge_in.existing_value->ToString();
+        prev_md_value = *merge_in.existing_value;
     }
 
-    Metadata md{prev_md_value};
+    // parse in place, the Slice is valid for the duration of the merge
+    Metadata md{std::string_view(prev_md_value.data(), prev_md_value.size())};
 
     size_t fsize = md.size();
 
@@ -204,13 +190,8 @@ MetadataMergeOperator::FullMergeV2(const MergeOperationInput& merge_in,
         if(operand_id == OperandID::increase_size) {
             auto op = IncreaseSizeOperand(parameters);
             if(op.append()) {
-                auto curr_offset = fsize;
-                // append mode, just increment file size
+                // legacy append operand, just increment file size
                 fsize += op.size();
-                // save the offset where this append operation should start
-                // it is retrieved later in RocksDBBackend::increase_size_impl()
-                GKFS_METADATA_MOD->append_offset_reserve_put(op.merge_id(),
-                                                             curr_offset);
             } else {
                 fsize = ::max(op.size(), fsize);
             }
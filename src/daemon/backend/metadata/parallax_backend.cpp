@@ -192,7 +192,8 @@ ParallaxBackend::get_impl(const std::string& key) const {
     if(V.val_buffer == NULL) {
         throw_status_excpt("Not Found");
     } else {
-        val = V.val_buffer;
+        // values are stored with a trailing '\0', see str2par()
+        val.assign(V.val_buffer, V.val_size > 0 ? V.val_size - 1 : 0);
         free(V.val_buffer);
     }
     return val;
@@ -245,6 +246,37 @@ ParallaxBackend::put_no_exist_impl(const std::string& key,
         throw ExistsException(key);
 }
 
+/**
+ * Gets the KV store values for several keys. Parallax has no batched read,
+ * the keys are read one after another.
+ * @param keys
+ * @return value per key, std::nullopt if the entry doesn't exist
+ * @throws DBException on failure
+ */
+std::vector<std::optional<std::string>>
+ParallaxBackend::get_batch_impl(const std::vector<std::string>& keys) const {
+    std::vector<std::optional<std::string>> vals(keys.size());
+    for(size_t i = 0; i < keys.size(); ++i) {
+        try {
+            vals[i] = get_impl(keys[i]);
+        } catch(const NotFoundException& e) {
+        }
+    }
+    return vals;
+}
+
+/**
+ * Puts several entries into the KV store one after another
+ * @param kvs
+ * @throws DBException on failure
+ */
+void
+ParallaxBackend::put_batch_impl(
+        const std::vector<std::pair<std::string, std::string>>& kvs) {
+    for(const auto& [key, val] : kvs)
+        put_impl(key, val);
+}
+
 /**
  * Removes an entry from the KV store
  * @param key
@@ -265,6 +297,21 @@ ParallaxBackend::remove_impl(const std::string& key) {
     }
 }
 
+/**
+ * Removes several entries from the KV store one after another
+ * @param keys
+ * @throws DBException on failure
+ */
+void
+ParallaxBackend::remove_batch_impl(const std::vector<std::string>& keys) {
+    for(const auto& key : keys) {
+        try {
+            remove_impl(key);
+        } catch(const NotFoundException& e) {
+        }
+    }
+}
+
 /**
  * checks for existence of an entry
  * @param key
@@ -439,6 +486,73 @@ ParallaxBackend::get_dirents_impl(const std::string& dir) const {
     return entries;
 }
 
+/**
+ * Return up to @max_entries first-level entries of the directory @dir whose
+ * names sort after @start_key, in name order
+ *
+ * @return vector of pair <std::string name, bool is_dir>,
+ *         where name is the name of the entries and is_dir
+ *         is true in the case the entry is a directory.
+ */
+std::vector<std::pair<std::string, bool>>
+ParallaxBackend::get_dirents_page_impl(const std::string& dir,
+                                       const std::string& start_key,
+                                       size_t max_entries) const {
+    auto root_path = dir;
+    // resume at the last entry of the previous page
+    auto start_path = root_path + start_key;
+    struct par_key K;
+
+    str2par(start_path, K);
+    const char* error = NULL;
+    par_scanner S = par_init_scanner(par_db_, &K, PAR_GREATER_OR_EQUAL, &error);
+    if(error) {
+        throw_status_excpt(
+                fmt::format("Failed get_dirents_page_impl: err {}", *error));
+    }
+    std::vector<std::pair<std::string, bool>> entries;
+
+    while(par_is_valid(S) && entries.size() < max_entries) {
+        struct par_key K2 = par_get_key(S);
+        struct par_value value = par_get_value(S);
+
+        std::string k(K2.data, K2.size);
+        std::string v(value.val_buffer, value.val_size);
+        if(k.size() < root_path.size() ||
+           k.substr(0, root_path.size()) != root_path) {
+            break;
+        }
+
+        /***** Get File name *****/
+        auto name = k.substr(root_path.size());
+        if(name.empty() || name == start_key ||
+           name.find_first_of('/') != std::string::npos) {
+            // skip the directory itself, the previous page's last entry and
+            // stuff deeper then one level depth
+            par_get_next(S);
+            continue;
+        }
+
+        Metadata md(v);
+#ifdef HAS_RENAME
+        // Remove entries with negative blocks (rename)
+        if(md.blocks() == -1) {
+            par_get_next(S);
+            continue;
+        }
+#endif // HAS_RENAME
+        auto is_dir = S_ISDIR(md.mode());
+
+        entries.emplace_back(std::move(name), is_dir);
+
+        par_get_next(S);
+    }
+    // If we don't close the scanner we cannot delete keys
+    par_close_scanner(S);
+
+    return entries;
+}
+
 /**
  * Return all the first-level entries of the directory @dir
  *
@@ -534,5 +648,10 @@ ParallaxBackend::iterate_all_impl() const {
     return nullptr;
 }
 
+std::vector<std::pair<std::string, uint64_t>>
+ParallaxBackend::db_stats_impl() const {
+    return {};
+}
+
 
 } // namespace gkfs::metadata
@@ -33,19 +33,154 @@
 
 #include <common/metadata.hpp>
 #include <common/path_util.hpp>
+#include <rocksdb/cache.h>
+#include <rocksdb/filter_policy.h>
+#include <rocksdb/slice_transform.h>
+#include <rocksdb/statistics.h>
+#include <rocksdb/table.h>
+#include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <ctime>
+#include <cstring>
+#include <stdexcept>
 extern "C" {
 #include <sys/stat.h>
 }
 
 namespace gkfs::metadata {
 
+namespace {
+
+/**
+ * Prefix extractor that maps a key in the `<parent>\0<name>` format to
+ * `<parent>\0`. All direct children of a directory share this prefix, which
+ * allows readdir seeks to use prefix bloom filters. The root and internal
+ * entries have no prefix.
+ */
+class ParentPrefixTransform : public rdb::SliceTransform {
+public:
+    const char*
+    Name() const override {
+        return "gkfs.ParentPrefixTransform";
+    }
+
+    rdb::Slice
+    Transform(const rdb::Slice& key) const override {
+        auto sep = static_cast<const char*>(
+                std::memchr(key.data(), '\0', key.size()));
+        return {key.data(), static_cast<size_t>(sep - key.data()) + 1};
+    }
+
+    bool
+    InDomain(const rdb::Slice& key) const override {
+        return std::memchr(key.data(), '\0', key.size()) != nullptr;
+    }
+};
+
+bool
+parse_profile_bool(const std::string& key, const std::string& val) {
+    if(val == "true" || val == "on" || val == "1")
+        return true;
+    if(val == "false" || val == "off" || val == "0")
+        return false;
+    throw std::runtime_error("Invalid boolean for RocksDB profile key '" + key +
+                             "': '" + val + "'");
+}
+
+template <typename T>
+T
+parse_profile_number(const std::string& key, const std::string& val) {
+    try {
+        size_t pos = 0;
+        auto num = std::stoll(val, &pos);
+        if(pos == val.size() && num >= 0)
+            return static_cast<T>(num);
+    } catch(const std::logic_error&) {
+    }
+    throw std::runtime_error("Invalid number for RocksDB profile key '" + key +
+                             "': '" + val + "'");
+}
+
+std::string
+trim(const std::string& str) {
+    auto first = str.find_first_not_of(" \t\r");
+    if(first == std::string::npos)
+        return {};
+    auto last = str.find_last_not_of(" \t\r");
+    return str.substr(first, last - first + 1);
+}
+
+} // namespace
+
+/**
+ * Reads a profile file
+ * @param file path of the profile file
+ * @return profile
+ * @throws std::runtime_error if the file can't be read or is malformed
+ */
+RocksDBProfile
+RocksDBProfile::load(const std::string& file) {
+    std::ifstream in(file);
+    if(!in) {
+        throw std::runtime_error("Failed to open RocksDB profile '" + file +
+                                 "'");
+    }
+    RocksDBProfile profile{};
+    std::string line;
+    while(std::getline(in, line)) {
+        line = trim(line);
+        if(line.empty() || line[0] == '#')
+            continue;
+        auto eq = line.find('=');
+        if(eq == std::string::npos) {
+            throw std::runtime_error("Invalid line in RocksDB profile '" +
+                                     file + "': '" + line + "'");
+        }
+        auto key = trim(line.substr(0, eq));
+        auto val = trim(line.substr(eq + 1));
+        if(key == "prefix_bloom") {
+            profile.prefix_bloom = parse_profile_bool(key, val);
+        } else if(key == "bloom_bits_per_key") {
+            profile.bloom_bits_per_key = parse_profile_number<int>(key, val);
+        } else if(key == "block_cache_size_mb") {
+            profile.block_cache_size_mb =
+                    parse_profile_number<uint64_t>(key, val);
+        } else if(key == "write_buffer_size_mb") {
+            profile.write_buffer_size_mb =
+                    parse_profile_number<uint64_t>(key, val);
+        } else if(key == "max_write_buffer_number") {
+            profile.max_write_buffer_number =
+                    parse_profile_number<int>(key, val);
+        } else if(key == "level0_file_num_compaction_trigger") {
+            profile.level0_file_num_compaction_trigger =
+                    parse_profile_number<int>(key, val);
+        } else if(key == "max_background_jobs") {
+            profile.max_background_jobs = parse_profile_number<int>(key, val);
+        } else if(key == "target_file_size_base_mb") {
+            profile.target_file_size_base_mb =
+                    parse_profile_number<uint64_t>(key, val);
+        } else if(key == "statistics") {
+            profile.statistics = parse_profile_bool(key, val);
+        } else {
+            throw std::runtime_error("Unknown key in RocksDB profile '" +
+                                     file + "': '" + key + "'");
+        }
+    }
+    return profile;
+}
+
 /**
  * Called when the daemon is started: Connects to the KV store
  * @param path where KV store data is stored
+ * @param profile_file tuning profile, empty for the default profile
  */
-RocksDBBackend::RocksDBBackend(const std::string& path) {
+RocksDBBackend::RocksDBBackend(const std::string& path,
+                               const std::string& profile_file)
+    : profile_(profile_file.empty() ? RocksDBProfile{}
+                                    : RocksDBProfile::load(profile_file)),
+      append_shards_(std::make_unique<append_shard[]>(
+              gkfs::config::rocksdb::append_size_shards)) {
 
     // Optimize RocksDB. This is the easiest way to get RocksDB to perform well
     options_.IncreaseParallelism();
@@ -61,6 +196,7 @@ RocksDBBackend::RocksDBBackend(const std::string& path) {
         throw std::runtime_error("Failed to open RocksDB: " + s.ToString());
     }
     this->db_.reset(rdb_ptr);
+    migrate_key_format();
 }
 
 
@@ -68,6 +204,177 @@ RocksDBBackend::~RocksDBBackend() {
     this->db_.reset();
 }
 
+/**
+ * Translates a path to its database key
+ * @param path absolute path
+ * @return key in the direct-children format
+ */
+std::string
+RocksDBBackend::encode_key(const std::string& path) {
+    auto pos = path.rfind('/');
+    if(pos == std::string::npos || path.size() == 1) {
+        // root or not a path
+        return path;
+    }
+    std::string key;
+    key.reserve(path.size() + 1);
+    if(pos == 0) {
+        key.push_back('/');
+    } else {
+        key.append(path, 0, pos);
+    }
+    key.push_back('\0');
+    key.append(path, pos + 1, std::string::npos);
+    return key;
+}
+
+/**
+ * Translates a database key back to its path
+ * @param key database key
+ * @return absolute path or an empty string for internal entries
+ */
+std::string
+RocksDBBackend::decode_key(const rdb::Slice& key) {
+    if(key.empty() || key[0] != '/') {
+        return {};
+    }
+    auto sep = static_cast<const char*>(
+            std::memchr(key.data(), '\0', key.size()));
+    if(sep == nullptr) {
+        // root or a key that has not been converted yet
+        return key.ToString();
+    }
+    size_t parent_len = sep - key.data();
+    std::string path;
+    path.reserve(key.size());
+    if(parent_len > 1) {
+        path.append(key.data(), parent_len);
+    }
+    path.push_back('/');
+    path.append(sep + 1, key.size() - parent_len - 1);
+    return path;
+}
+
+/**
+ * Returns the common key prefix of all direct children of a directory
+ * @param dir absolute directory path with a trailing slash
+ * @return key prefix
+ */
+std::string
+RocksDBBackend::children_prefix(const std::string& dir) {
+    auto prefix = dir;
+    if(prefix.size() > 1 && prefix.back() == '/') {
+        prefix.pop_back();
+    }
+    prefix.push_back('\0');
+    return prefix;
+}
+
+/**
+ * Converts a database that still uses plain path keys to the direct-children
+ * key format. Each batch of entries is converted atomically, so an
+ * interrupted conversion is resumed on the next start.
+ * @throws DBException on failure
+ */
+void
+RocksDBBackend::migrate_key_format() {
+    std::string version;
+    auto s = db_->Get(rdb::ReadOptions(), key_format_key, &version);
+    if(s.ok() && version == key_format_version) {
+        return;
+    }
+    if(!s.ok() && !s.IsNotFound()) {
+        throw_status_excpt(s);
+    }
+
+    uint64_t count = 0;
+    rdb::WriteBatch batch;
+    // The iterator reads from an implicit snapshot and does not see the
+    // converted keys written below
+    rdb::ReadOptions ropts;
+    ropts.total_order_seek = true;
+    std::unique_ptr<rdb::Iterator> it(db_->NewIterator(ropts));
+    for(it->SeekToFirst(); it->Valid(); it->Next()) {
+        auto key = it->key();
+        // skip internal entries, the root, and keys that are converted already
+        if(key.empty() || key[0] != '/' || key.size() == 1 ||
+           std::memchr(key.data(), '\0', key.size()) != nullptr) {
+            continue;
+        }
+        batch.Delete(key);
+        batch.Put(encode_key(key.ToString()), it->value());
+        if(++count % gkfs::config::rocksdb::key_migration_batch_size == 0) {
+            s = db_->Write(write_opts_, &batch);
+            if(!s.ok()) {
+                throw_status_excpt(s);
+            }
+            batch.Clear();
+            GKFS_METADATA_MOD->log()->info(
+                    "{}() Converted '{}' metadata entries to the direct-children key format ...",
+                    __func__, count);
+        }
+    }
+    if(!it->status().ok()) {
+        throw_status_excpt(it->status());
+    }
+    batch.Put(key_format_key, key_format_version);
+    s = db_->Write(write_opts_, &batch);
+    if(!s.ok()) {
+        throw_status_excpt(s);
+    }
+    if(count > 0) {
+        GKFS_METADATA_MOD->log()->info(
+                "{}() Converted '{}' metadata entries to the direct-children key format",
+                __func__, count);
+    }
+}
+
+RocksDBBackend::append_shard&
+RocksDBBackend::append_shard_for(const std::string& key) const {
+    return append_shards_[std::hash<std::string>{}(key) %
+                          gkfs::config::rocksdb::append_size_shards];
+}
+
+/**
+ * @internal
+ * The size is loaded while holding the shard lock, so concurrent first appends
+ * to a file agree on a single size object. Non-append size increases merge
+ * before they look up the size object. Thus, their merge is either visible to
+ * the load or they find the loaded size and raise it.
+ * @endinternal
+ */
+RocksDBBackend::append_size_t
+RocksDBBackend::append_size(const std::string& key) {
+    auto& shard = append_shard_for(key);
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    auto it = shard.sizes.find(key);
+    if(it != shard.sizes.end())
+        return it->second;
+    auto val = get_impl(key);
+    auto size = std::make_shared<std::atomic<size_t>>(Metadata(val).size());
+    constexpr size_t shard_capacity = std::max(
+            1, gkfs::config::rocksdb::append_size_cache_size /
+                       gkfs::config::rocksdb::append_size_shards);
+    if(shard.sizes.size() >= shard_capacity) {
+        // drop sizes without an append in flight
+        for(auto idle = shard.sizes.begin(); idle != shard.sizes.end();) {
+            if(idle->second.use_count() == 1)
+                idle = shard.sizes.erase(idle);
+            else
+                ++idle;
+        }
+    }
+    shard.sizes.emplace(key, size);
+    return size;
+}
+
+void
+RocksDBBackend::forget_append_size(const std::string& key) {
+    auto& shard = append_shard_for(key);
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    shard.sizes.erase(key);
+}
+
 /**
  * Exception wrapper on Status object. Throws NotFoundException if
  * s.IsNotFound(), general DBException otherwise
@@ -96,7 +403,7 @@ std::string
 RocksDBBackend::get_impl(const std::string& key) const {
     std::string val;
 
-    auto s = db_->Get(rdb::ReadOptions(), key, &val);
+    auto s = db_->Get(rdb::ReadOptions(), encode_key(key), &val);
     if(!s.ok()) {
         throw_status_excpt(s);
     }
@@ -114,10 +421,11 @@ void
 RocksDBBackend::put_impl(const std::string& key, const std::string& val) {
 
     auto cop = CreateOperand(val);
-    auto s = db_->Merge(write_opts_, key, cop.serialize());
+    auto s = db_->Merge(write_opts_, encode_key(key), cop.serialize());
     if(!s.ok()) {
         throw_status_excpt(s);
     }
+    forget_append_size(key);
 }
 
 /**
@@ -136,6 +444,54 @@ RocksDBBackend::put_no_exist_impl(const std::string& key,
     put(key, val);
 }
 
+/**
+ * Gets the KV store values for several keys with a single MultiGet
+ * @param keys
+ * @return value per key, std::nullopt if the entry doesn't exist
+ * @throws DBException on failure
+ */
+std::vector<std::optional<std::string>>
+RocksDBBackend::get_batch_impl(const std::vector<std::string>& keys) const {
+    std::vector<std::string> db_keys;
+    db_keys.reserve(keys.size());
+    for(const auto& key : keys)
+        db_keys.emplace_back(encode_key(key));
+    std::vector<rdb::Slice> slices(db_keys.begin(), db_keys.end());
+    std::vector<std::string> vals;
+
+    auto statuses = db_->MultiGet(rdb::ReadOptions(), slices, &vals);
+    std::vector<std::optional<std::string>> ret(keys.size());
+    for(size_t i = 0; i < keys.size(); ++i) {
+        if(statuses[i].ok()) {
+            ret[i] = std::move(vals[i]);
+        } else if(!statuses[i].IsNotFound()) {
+            throw_status_excpt(statuses[i]);
+        }
+    }
+    return ret;
+}
+
+/**
+ * Puts several entries into the KV store with a single WriteBatch
+ * @param kvs
+ * @throws DBException on failure
+ */
+void
+RocksDBBackend::put_batch_impl(
+        const std::vector<std::pair<std::string, std::string>>& kvs) {
+    rdb::WriteBatch batch;
+    for(const auto& [key, val] : kvs) {
+        auto cop = CreateOperand(val);
+        batch.Merge(encode_key(key), cop.serialize());
+    }
+    auto s = db_->Write(write_opts_, &batch);
+    if(!s.ok()) {
+        throw_status_excpt(s);
+    }
+    for(const auto& kv : kvs)
+        forget_append_size(kv.first);
+}
+
 /**
  * Removes an entry from the KV store
  * @param key
@@ -144,10 +500,29 @@ RocksDBBackend::put_no_exist_impl(const std::string& key,
 void
 RocksDBBackend::remove_impl(const std::string& key) {
 
-    auto s = db_->Delete(write_opts_, key);
+    auto s = db_->Delete(write_opts_, encode_key(key));
     if(!s.ok()) {
         throw_status_excpt(s);
     }
+    forget_append_size(key);
+}
+
+/**
+ * Removes several entries from the KV store with a single WriteBatch
+ * @param keys
+ * @throws DBException on failure
+ */
+void
+RocksDBBackend::remove_batch_impl(const std::vector<std::string>& keys) {
+    rdb::WriteBatch batch;
+    for(const auto& key : keys)
+        batch.Delete(encode_key(key));
+    auto s = db_->Write(write_opts_, &batch);
+    if(!s.ok()) {
+        throw_status_excpt(s);
+    }
+    for(const auto& key : keys)
+        forget_append_size(key);
 }
 
 /**
@@ -161,7 +536,7 @@ RocksDBBackend::exists_impl(const std::string& key) {
 
     std::string val;
 
-    auto s = db_->Get(rdb::ReadOptions(), key, &val);
+    auto s = db_->Get(rdb::ReadOptions(), encode_key(key), &val);
     if(!s.ok()) {
         if(s.IsNotFound()) {
             return false;
@@ -186,12 +561,15 @@ RocksDBBackend::update_impl(const std::string& old_key,
 
     // TODO use rdb::Put() method
     rdb::WriteBatch batch;
-    batch.Delete(old_key);
-    batch.Put(new_key, val);
+    batch.Delete(encode_key(old_key));
+    batch.Put(encode_key(new_key), val);
     auto s = db_->Write(write_opts_, &batch);
     if(!s.ok()) {
         throw_status_excpt(s);
     }
+    forget_append_size(old_key);
+    if(new_key != old_key)
+        forget_append_size(new_key);
 }
 
 /**
@@ -200,9 +578,10 @@ RocksDBBackend::update_impl(const std::string& old_key,
  *
  * A special case represents the append operation. Since multiple processes
  * could want to append a file in parallel, the corresponding offsets where the
- * write operation starts, needs to be reserved. This is an expensive operation
- * as we need to force a RocksDB Merge operation to receive the starting offset
- * for this write request.
+ * write operation starts, needs to be reserved. Appends reserve their offset
+ * with an atomic fetch-add on an in-memory file size and persist the resulting
+ * end of file with a regular size increase operand. As these operands merge
+ * with max(), their order does not matter and no read is required.
  *
  * @param key
  * @param io_size
@@ -215,32 +594,25 @@ off_t
 RocksDBBackend::increase_size_impl(const std::string& key, size_t io_size,
                                    off_t offset, bool append) {
     off_t out_offset = -1;
+    auto db_key = encode_key(key);
     if(append) {
-        auto merge_id = gkfs::metadata::gen_unique_id(key);
-        // no offset needed because new size is current file size + io_size
-        auto uop = IncreaseSizeOperand(io_size, merge_id, append);
-        auto s = db_->Merge(write_opts_, key, uop.serialize());
+        // the reference keeps the size from being dropped until it is merged
+        auto size = append_size(key);
+        out_offset = static_cast<off_t>(
+                size->fetch_add(io_size, std::memory_order_relaxed));
+        auto uop = IncreaseSizeOperand(out_offset + io_size);
+        auto s = db_->Merge(write_opts_, db_key, uop.serialize());
         if(!s.ok()) {
+            // the in-memory size is ahead of the database now
+            forget_append_size(key);
             throw_status_excpt(s);
-        } else {
-            // force merge operation to run
-            get_impl(key);
-            try {
-                // the offset was added during FullMergeV2() call
-                out_offset =
-                        GKFS_METADATA_MOD->append_offset_reserve_get_and_erase(
-                                merge_id);
-            } catch(std::out_of_range& e) {
-                GKFS_METADATA_MOD->log()->warn(
-                        "{}() - out_of_range exception: {} when attempting to get offset for key {}",
-                        __func__, e.what(), key);
-            }
         }
     } else {
         // In the standard case we simply add the I/O request size to the
         // offset.
-        auto uop = IncreaseSizeOperand(offset + io_size);
-        auto s = db_->Merge(write_opts_, key, uop.serialize());
+        auto new_size = offset + io_size;
+        auto uop = IncreaseSizeOperand(new_size);
+        auto s = db_->Merge(write_opts_, db_key, uop.serialize());
         if(!s.ok()) {
             throw_status_excpt(s);
         }
@@ -248,11 +620,27 @@ RocksDBBackend::increase_size_impl(const std::string& key, size_t io_size,
             // get current time and update mtime for this file
             time_t now = time(nullptr);
             auto t_op = UpdateTimeOperand(now);
-            s = db_->Merge(write_opts_, key, t_op.serialize());
+            s = db_->Merge(write_opts_, db_key, t_op.serialize());
             if(!s.ok()) {
                 throw_status_excpt(s);
             }
         }
+        // subsequent appends must start behind this write
+        auto& shard = append_shard_for(key);
+        append_size_t size;
+        {
+            std::lock_guard<std::mutex> lock(shard.mtx);
+            auto it = shard.sizes.find(key);
+            if(it != shard.sizes.end())
+                size = it->second;
+        }
+        if(size) {
+            auto curr = size->load(std::memory_order_relaxed);
+            while(curr < new_size &&
+                  !size->compare_exchange_weak(curr, new_size,
+                                               std::memory_order_relaxed)) {
+            }
+        }
     }
     return out_offset;
 }
@@ -267,16 +655,24 @@ RocksDBBackend::increase_size_impl(const std::string& key, size_t io_size,
 void
 RocksDBBackend::decrease_size_impl(const std::string& key, size_t size) {
 
+    auto db_key = encode_key(key);
     auto uop = DecreaseSizeOperand(size);
-    auto s = db_->Merge(write_opts_, key, uop.serialize());
+    auto s = db_->Merge(write_opts_, db_key, uop.serialize());
     if(!s.ok()) {
         throw_status_excpt(s);
     }
+    {
+        auto& shard = append_shard_for(key);
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        auto it = shard.sizes.find(key);
+        if(it != shard.sizes.end())
+            it->second->store(size, std::memory_order_relaxed);
+    }
     if constexpr(gkfs::config::metadata::use_mtime) {
         // get current time and update mtime for this file
         time_t now = time(nullptr);
         auto t_op = UpdateTimeOperand(now);
-        s = db_->Merge(write_opts_, key, t_op.serialize());
+        s = db_->Merge(write_opts_, db_key, t_op.serialize());
         if(!s.ok()) {
             throw_status_excpt(s);
         }
@@ -292,32 +688,76 @@ RocksDBBackend::decrease_size_impl(const std::string& key, size_t size) {
  */
 std::vector<std::pair<std::string, bool>>
 RocksDBBackend::get_dirents_impl(const std::string& dir) const {
-    auto root_path = dir;
+    // only the direct children share this prefix
+    auto prefix = children_prefix(dir);
+    auto upper = prefix;
+    upper.back() = '\1';
+    rdb::Slice upper_bound(upper);
     rocksdb::ReadOptions ropts;
-    auto it = db_->NewIterator(ropts);
+    ropts.iterate_upper_bound = &upper_bound;
+    std::unique_ptr<rdb::Iterator> it(db_->NewIterator(ropts));
 
     std::vector<std::pair<std::string, bool>> entries;
-    for(it->Seek(root_path); it->Valid() && it->key().starts_with(root_path);
+    for(it->Seek(prefix); it->Valid() && it->key().starts_with(prefix);
         it->Next()) {
 
-        if(it->key().size() == root_path.size()) {
-            // we skip this path cause it is exactly the root_path
+        /***** Get File name *****/
+        std::string name(it->key().data() + prefix.size(),
+                         it->key().size() - prefix.size());
+
+        // relative path of directory entries must not be empty
+        assert(!name.empty());
+
+        Metadata md(std::string_view(it->value().data(),
+                                     it->value().size()));
+#ifdef HAS_RENAME
+        // Remove entries with negative blocks (rename)
+        if(md.blocks() == -1) {
             continue;
         }
+#endif // HAS_RENAME
+        auto is_dir = S_ISDIR(md.mode());
+
+        entries.emplace_back(std::move(name), is_dir);
+    }
+    assert(it->status().ok());
+    return entries;
+}
+
+/**
+ * Return up to @max_entries first-level entries of the directory @dir whose
+ * names sort after @start_key, in name order
+ *
+ * @return vector of pair <std::string name, bool is_dir>,
+ *         where name is the name of the entries and is_dir
+ *         is true in the case the entry is a directory.
+ */
+std::vector<std::pair<std::string, bool>>
+RocksDBBackend::get_dirents_page_impl(const std::string& dir,
+                                      const std::string& start_key,
+                                      size_t max_entries) const {
+    auto prefix = children_prefix(dir);
+    auto upper = prefix;
+    upper.back() = '\1';
+    rdb::Slice upper_bound(upper);
+    rocksdb::ReadOptions ropts;
+    ropts.iterate_upper_bound = &upper_bound;
+    std::unique_ptr<rdb::Iterator> it(db_->NewIterator(ropts));
+
+    std::vector<std::pair<std::string, bool>> entries;
+    // resume at the last entry of the previous page
+    for(it->Seek(prefix + start_key);
+        it->Valid() && entries.size() < max_entries; it->Next()) {
 
         /***** Get File name *****/
-        auto name = it->key().ToString();
-        if(name.find_first_of('/', root_path.size()) != std::string::npos) {
-            // skip stuff deeper then one level depth
+        std::string name(it->key().data() + prefix.size(),
+                         it->key().size() - prefix.size());
+        if(name.empty() || name == start_key) {
             continue;
         }
-        // remove prefix
-        name = name.substr(root_path.size());
-
-        // relative path of directory entries must not be empty
-        assert(!name.empty());
 
-        Metadata md(it->value().ToString());
+        Metadata md(std::string_view(it->value().data(),
+                                     it->value().size()));
 #ifdef HAS_RENAME
         // Remove entries with negative blocks (rename)
         if(md.blocks() == -1) {
@@ -341,33 +781,29 @@ RocksDBBackend::get_dirents_impl(const std::string& dir) const {
  */
 std::vector<std::tuple<std::string, bool, size_t, time_t>>
 RocksDBBackend::get_dirents_extended_impl(const std::string& dir) const {
-    auto root_path = dir;
+    // only the direct children share this prefix
+    auto prefix = children_prefix(dir);
+    auto upper = prefix;
+    upper.back() = '\1';
+    rdb::Slice upper_bound(upper);
     rocksdb::ReadOptions ropts;
-    auto it = db_->NewIterator(ropts);
+    ropts.iterate_upper_bound = &upper_bound;
+    std::unique_ptr<rdb::Iterator> it(db_->NewIterator(ropts));
 
     std::vector<std::tuple<std::string, bool, size_t, time_t>> entries;
 
-    for(it->Seek(root_path); it->Valid() && it->key().starts_with(root_path);
+    for(it->Seek(prefix); it->Valid() && it->key().starts_with(prefix);
         it->Next()) {
 
-        if(it->key().size() == root_path.size()) {
-            // we skip this path cause it is exactly the root_path
-            continue;
-        }
-
         /***** Get File name *****/
-        auto name = it->key().ToString();
-        if(name.find_first_of('/', root_path.size()) != std::string::npos) {
-            // skip stuff deeper then one level depth
-            continue;
-        }
-        // remove prefix
-        name = name.substr(root_path.size());
+        std::string name(it->key().data() + prefix.size(),
+                         it->key().size() - prefix.size());
 
         // relative path of directory entries must not be empty
         assert(!name.empty());
 
-        Metadata md(it->value().ToString());
+        Metadata md(std::string_view(it->value().data(),
+                                     it->value().size()));
 #ifdef HAS_RENAME
         // Remove entries with negative blocks (rename)
         if(md.blocks() == -1) {
@@ -399,7 +835,10 @@ RocksDBBackend::iterate_all_impl() const {
     //        val = iter->value().ToString();
     //    }
     // TODO Fix this hacky solution. Returning void* is not a good idea :>
-    return static_cast<void*>(db_->NewIterator(rdb::ReadOptions()));
+    // iterate across all prefixes of the prefix extractor
+    rdb::ReadOptions ropts;
+    ropts.total_order_seek = true;
+    return static_cast<void*>(db_->NewIterator(ropts));
 }
 
 uint64_t
@@ -411,11 +850,93 @@ RocksDBBackend::db_size_impl() const {
 }
 
 /**
- * Used for setting KV store settings
+ * Returns the sizes of the block cache, memtables, and SST files, and, if
+ * statistics are enabled in the profile, RocksDB's tickers
+ * @return pairs of name and value
+ */
+std::vector<std::pair<std::string, uint64_t>>
+RocksDBBackend::db_stats_impl() const {
+    static const std::vector<std::pair<std::string, std::string>> properties =
+            {{"ROCKSDB_ESTIMATE_NUM_KEYS", "rocksdb.estimate-num-keys"},
+             {"ROCKSDB_BLOCK_CACHE_USAGE_BYTES", "rocksdb.block-cache-usage"},
+             {"ROCKSDB_MEMTABLE_BYTES", "rocksdb.cur-size-all-mem-tables"},
+             {"ROCKSDB_LIVE_SST_BYTES", "rocksdb.live-sst-files-size"},
+             {"ROCKSDB_PENDING_COMPACTION_BYTES",
+              "rocksdb.estimate-pending-compaction-bytes"},
+             {"ROCKSDB_RUNNING_COMPACTIONS",
+              "rocksdb.num-running-compactions"}};
+    static const std::vector<std::pair<std::string, rdb::Tickers>> tickers = {
+            {"ROCKSDB_BLOCK_CACHE_HIT", rdb::BLOCK_CACHE_HIT},
+            {"ROCKSDB_BLOCK_CACHE_MISS", rdb::BLOCK_CACHE_MISS},
+            {"ROCKSDB_BLOOM_FILTER_USEFUL", rdb::BLOOM_FILTER_USEFUL},
+            {"ROCKSDB_BLOOM_FILTER_PREFIX_CHECKED",
+             rdb::BLOOM_FILTER_PREFIX_CHECKED},
+            {"ROCKSDB_BLOOM_FILTER_PREFIX_USEFUL",
+             rdb::BLOOM_FILTER_PREFIX_USEFUL},
+            {"ROCKSDB_MEMTABLE_HIT", rdb::MEMTABLE_HIT},
+            {"ROCKSDB_MEMTABLE_MISS", rdb::MEMTABLE_MISS},
+            {"ROCKSDB_KEYS_READ", rdb::NUMBER_KEYS_READ},
+            {"ROCKSDB_KEYS_WRITTEN", rdb::NUMBER_KEYS_WRITTEN},
+            {"ROCKSDB_DB_SEEK", rdb::NUMBER_DB_SEEK},
+            {"ROCKSDB_COMPACT_READ_BYTES", rdb::COMPACT_READ_BYTES},
+            {"ROCKSDB_COMPACT_WRITE_BYTES", rdb::COMPACT_WRITE_BYTES},
+            {"ROCKSDB_STALL_MICROS", rdb::STALL_MICROS}};
+
+    std::vector<std::pair<std::string, uint64_t>> stats;
+    for(const auto& [name, property] : properties) {
+        uint64_t value = 0;
+        if(db_->GetIntProperty(property, &value))
+            stats.emplace_back(name, value);
+    }
+    if(options_.statistics) {
+        for(const auto& [name, ticker] : tickers)
+            stats.emplace_back(name,
+                               options_.statistics->getTickerCount(ticker));
+    }
+    return stats;
+}
+
+/**
+ * Used for setting KV store settings. Applies the tuning profile on top of
+ * the level style compaction defaults
  */
 void
 RocksDBBackend::optimize_database_impl() {
     options_.max_successive_merges = 128;
+
+    rdb::BlockBasedTableOptions table_options;
+    if(profile_.block_cache_size_mb > 0) {
+        table_options.block_cache =
+                rdb::NewLRUCache(profile_.block_cache_size_mb * 1024 * 1024);
+    }
+    if(profile_.bloom_bits_per_key > 0) {
+        table_options.filter_policy.reset(
+                rdb::NewBloomFilterPolicy(profile_.bloom_bits_per_key));
+    }
+    if(profile_.prefix_bloom) {
+        options_.prefix_extractor =
+                std::make_shared<ParentPrefixTransform>();
+        // point lookups keep using the whole key filter
+        table_options.whole_key_filtering = true;
+        options_.memtable_prefix_bloom_size_ratio = 0.1;
+    }
+    options_.table_factory.reset(rdb::NewBlockBasedTableFactory(table_options));
+
+    if(profile_.write_buffer_size_mb > 0)
+        options_.write_buffer_size =
+                profile_.write_buffer_size_mb * 1024 * 1024;
+    if(profile_.max_write_buffer_number > 0)
+        options_.max_write_buffer_number = profile_.max_write_buffer_number;
+    if(profile_.level0_file_num_compaction_trigger > 0)
+        options_.level0_file_num_compaction_trigger =
+                profile_.level0_file_num_compaction_trigger;
+    if(profile_.max_background_jobs > 0)
+        options_.max_background_jobs = profile_.max_background_jobs;
+    if(profile_.target_file_size_base_mb > 0)
+        options_.target_file_size_base =
+                profile_.target_file_size_base_mb * 1024 * 1024;
+    if(profile_.statistics)
+        options_.statistics = rdb::CreateDBStatistics();
 }
 
 
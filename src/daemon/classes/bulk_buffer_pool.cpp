@@ -0,0 +1,266 @@
+/*
+  Copyright 2018-2024, Barcelona Supercomputing Center (BSC), Spain
+  Copyright 2015-2024, Johannes Gutenberg Universitaet Mainz, Germany
+
+  This software was partially supported by the
+  EC H2020 funded project NEXTGenIO (Project ID: 671951, www.nextgenio.eu).
+
+  This software was partially supported by the
+  ADA-FS project under the SPPEXA project funded by the DFG.
+
+  This file is part of GekkoFS.
+
+  GekkoFS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GekkoFS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GekkoFS.  If not, see <https://www.gnu.org/licenses/>.
+
+  SPDX-License-Identifier: GPL-3.0-or-later
+*/
+/**
+ * @brief Definitions of the daemon's bulk buffer pool.
+ */
+
+#include <daemon/classes/bulk_buffer_pool.hpp>
+#include <common/statistics/stats.hpp>
+
+#include <utility>
+
+using namespace std;
+
+namespace gkfs::daemon {
+
+using gkfs::utils::Stats;
+
+BulkBufferPool::Buffer::Buffer(BulkBufferPool* pool, hg_bulk_t handle,
+                               void* data, size_t size_class)
+    : pool_(pool), handle_(handle), data_(data), size_class_(size_class) {}
+
+BulkBufferPool::Buffer::~Buffer() {
+    if(pool_ && handle_ != HG_BULK_NULL)
+        pool_->release(*this);
+}
+
+BulkBufferPool::Buffer::Buffer(Buffer&& other) noexcept
+    : pool_(other.pool_), handle_(other.handle_), data_(other.data_),
+      size_class_(other.size_class_) {
+    other.pool_ = nullptr;
+    other.handle_ = HG_BULK_NULL;
+    other.data_ = nullptr;
+}
+
+BulkBufferPool::Buffer&
+BulkBufferPool::Buffer::operator=(Buffer&& other) noexcept {
+    if(this != &other) {
+        if(pool_ && handle_ != HG_BULK_NULL)
+            pool_->release(*this);
+        pool_ = std::exchange(other.pool_, nullptr);
+        handle_ = std::exchange(other.handle_, HG_BULK_NULL);
+        data_ = std::exchange(other.data_, nullptr);
+        size_class_ = other.size_class_;
+    }
+    return *this;
+}
+
+hg_bulk_t
+BulkBufferPool::Buffer::handle() const {
+    return handle_;
+}
+
+void*
+BulkBufferPool::Buffer::data() const {
+    return data_;
+}
+
+bool
+BulkBufferPool::Buffer::valid() const {
+    return handle_ != HG_BULK_NULL;
+}
+
+bool
+BulkBufferPool::Buffer::pooled() const {
+    return size_class_ != npos;
+}
+
+BulkBufferPool::BulkBufferPool(margo_instance_id mid, size_t chunksize,
+                               size_t size_classes, size_t max_size,
+                               std::shared_ptr<Stats> stats)
+    : mid_(mid), max_size_(max_size), stats_(std::move(stats)) {
+    if(max_size_ == 0)
+        return;
+    classes_.resize(size_classes);
+    for(size_t i = 0; i < size_classes; i++)
+        classes_[i].size = chunksize << i;
+    if(stats_)
+        stats_->add_value_gauge(Stats::GaugeOp::bulk_pool_capacity,
+                                static_cast<long long>(max_size_));
+}
+
+BulkBufferPool::~BulkBufferPool() {
+    lock_guard<mutex> lock(mtx_);
+    if(stats_ && max_size_ > 0) {
+        stats_->add_value_gauge(Stats::GaugeOp::bulk_pool_capacity,
+                                -static_cast<long long>(max_size_));
+        stats_->add_value_gauge(Stats::GaugeOp::bulk_pool_allocated,
+                                -static_cast<long long>(allocated_size_));
+    }
+    for(auto& c : classes_) {
+        for(auto& [handle, data] : c.free)
+            margo_bulk_free(handle);
+        allocated_size_ -= c.size * c.free.size();
+        c.free.clear();
+    }
+}
+
+pair<hg_bulk_t, void*>
+BulkBufferPool::create(size_t size) const {
+    hg_bulk_t handle = HG_BULK_NULL;
+    hg_size_t bulk_size = size;
+    auto ret = margo_bulk_create(mid_, 1, nullptr, &bulk_size,
+                                 HG_BULK_READWRITE, &handle);
+    if(ret != HG_SUCCESS)
+        return {HG_BULK_NULL, nullptr};
+    // access the internally allocated memory buffer
+    void* data = nullptr;
+    uint32_t actual_count = 0;
+    ret = margo_bulk_access(handle, 0, bulk_size, HG_BULK_READWRITE, 1, &data,
+                            &bulk_size, &actual_count);
+    if(ret != HG_SUCCESS || actual_count != 1) {
+        margo_bulk_free(handle);
+        return {HG_BULK_NULL, nullptr};
+    }
+    return {handle, data};
+}
+
+/**
+ * @internal
+ * margo_bulk_create() and margo_bulk_free() are never called while holding the
+ * pool lock. Room for a new pooled buffer is reserved in allocated_size_ before
+ * the buffer is created and given back if the creation fails.
+ * @endinternal
+ */
+BulkBufferPool::Buffer
+BulkBufferPool::acquire(size_t size) {
+    size_t idx = npos;
+    for(size_t i = 0; i < classes_.size(); i++) {
+        if(size <= classes_[i].size) {
+            idx = i;
+            break;
+        }
+    }
+    if(idx != npos) {
+        auto class_size = classes_[idx].size;
+        vector<pair<hg_bulk_t, void*>> evicted{};
+        bool reserved = false;
+        {
+            lock_guard<mutex> lock(mtx_);
+            auto& free = classes_[idx].free;
+            if(!free.empty()) {
+                auto [handle, data] = free.back();
+                free.pop_back();
+                used_size_ += class_size;
+                if(stats_) {
+                    stats_->add_value_cache(Stats::CacheOp::bulk_pool_hit);
+                    stats_->add_value_gauge(
+                            Stats::GaugeOp::bulk_pool_used,
+                            static_cast<long long>(class_size));
+                }
+                return {this, handle, data, idx};
+            }
+            // release idle buffers of other classes if the cap is reached
+            for(auto it = classes_.rbegin();
+                it != classes_.rend() &&
+                allocated_size_ + class_size > max_size_;
+                ++it) {
+                while(!it->free.empty() &&
+                      allocated_size_ + class_size > max_size_) {
+                    evicted.emplace_back(it->free.back());
+                    it->free.pop_back();
+                    allocated_size_ -= it->size;
+                    if(stats_)
+                        stats_->add_value_gauge(
+                                Stats::GaugeOp::bulk_pool_allocated,
+                                -static_cast<long long>(it->size));
+                }
+            }
+            if(allocated_size_ + class_size <= max_size_) {
+                allocated_size_ += class_size;
+                used_size_ += class_size;
+                reserved = true;
+            }
+        }
+        for(auto& [handle, data] : evicted)
+            margo_bulk_free(handle);
+        if(reserved) {
+            auto [handle, data] = create(class_size);
+            if(handle != HG_BULK_NULL) {
+                if(stats_) {
+                    stats_->add_value_cache(Stats::CacheOp::bulk_pool_miss);
+                    stats_->add_value_gauge(
+                            Stats::GaugeOp::bulk_pool_allocated,
+                            static_cast<long long>(class_size));
+                    stats_->add_value_gauge(
+                            Stats::GaugeOp::bulk_pool_used,
+                            static_cast<long long>(class_size));
+                }
+                return {this, handle, data, idx};
+            }
+            lock_guard<mutex> lock(mtx_);
+            allocated_size_ -= class_size;
+            used_size_ -= class_size;
+        }
+    }
+    // fallback: buffer is allocated for this request only
+    if(stats_ && max_size_ > 0)
+        stats_->add_value_cache(Stats::CacheOp::bulk_pool_fallback);
+    auto [handle, data] = create(size);
+    return {this, handle, data, npos};
+}
+
+void
+BulkBufferPool::release(Buffer& buf) {
+    if(buf.size_class_ == npos) {
+        margo_bulk_free(buf.handle_);
+    } else {
+        auto class_size = classes_[buf.size_class_].size;
+        {
+            lock_guard<mutex> lock(mtx_);
+            classes_[buf.size_class_].free.emplace_back(buf.handle_,
+                                                        buf.data_);
+            used_size_ -= class_size;
+        }
+        if(stats_)
+            stats_->add_value_gauge(Stats::GaugeOp::bulk_pool_used,
+                                    -static_cast<long long>(class_size));
+    }
+    buf.pool_ = nullptr;
+    buf.handle_ = HG_BULK_NULL;
+    buf.data_ = nullptr;
+}
+
+size_t
+BulkBufferPool::allocated_size() {
+    lock_guard<mutex> lock(mtx_);
+    return allocated_size_;
+}
+
+size_t
+BulkBufferPool::used_size() {
+    lock_guard<mutex> lock(mtx_);
+    return used_size_;
+}
+
+size_t
+BulkBufferPool::max_size() const {
+    return max_size_;
+}
+
+} // namespace gkfs::daemon
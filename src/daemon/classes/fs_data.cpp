@@ -28,6 +28,7 @@
 
 #include <daemon/classes/fs_data.hpp>
 #include <daemon/backend/metadata/db.hpp>
+#include <daemon/ops/metadata_cache.hpp>
 
 #include <spdlog/spdlog.h>
 
@@ -65,9 +66,21 @@ FsData::mdb(const std::shared_ptr<gkfs::metadata::MetadataDB>& mdb) {
 
 void
 FsData::close_mdb() {
+    metadata_cache_.reset();
     mdb_.reset();
 }
 
+const std::shared_ptr<gkfs::metadata::MetadataCache>&
+FsData::metadata_cache() const {
+    return metadata_cache_;
+}
+
+void
+FsData::metadata_cache(
+        const std::shared_ptr<gkfs::metadata::MetadataCache>& metadata_cache) {
+    metadata_cache_ = metadata_cache;
+}
+
 const std::shared_ptr<gkfs::data::ChunkStorage>&
 FsData::storage() const {
     return storage_;
@@ -177,6 +190,16 @@ FsData::hosts_file(const std::string& lookup_file) {
     hosts_file_ = lookup_file;
 }
 
+const std::string&
+FsData::distributor_type() const {
+    return distributor_type_;
+}
+
+void
+FsData::distributor_type(const std::string& distributor_type) {
+    distributor_type_ = distributor_type;
+}
+
 bool
 FsData::use_auto_sm() const {
     return use_auto_sm_;
@@ -248,6 +271,16 @@ FsData::parallax_size_md(unsigned int size_md) {
             size_md * 1024ull * 1024ull * 1024ull);
 }
 
+const std::string&
+FsData::rocksdb_profile() const {
+    return rocksdb_profile_;
+}
+
+void
+FsData::rocksdb_profile(const std::string& rocksdb_profile) {
+    FsData::rocksdb_profile_ = rocksdb_profile;
+}
+
 const std::shared_ptr<gkfs::utils::Stats>&
 FsData::stats() const {
     return stats_;
@@ -27,6 +27,7 @@
 */
 
 #include <daemon/classes/rpc_data.hpp>
+#include <daemon/classes/bulk_buffer_pool.hpp>
 
 using namespace std;
 
@@ -149,4 +150,25 @@ RPCData::distributor(
     distributor_ = distributor;
 }
 
+const std::shared_ptr<BulkBufferPool>&
+RPCData::bulk_pool() const {
+    return bulk_pool_;
+}
+
+void
+RPCData::bulk_pool(const std::shared_ptr<BulkBufferPool>& bulk_pool) {
+    bulk_pool_ = bulk_pool;
+}
+
+const std::shared_ptr<BulkBufferPool>&
+RPCData::proxy_bulk_pool() const {
+    return proxy_bulk_pool_;
+}
+
+void
+RPCData::proxy_bulk_pool(
+        const std::shared_ptr<BulkBufferPool>& proxy_bulk_pool) {
+    proxy_bulk_pool_ = proxy_bulk_pool;
+}
+
 } // namespace gkfs::daemon
\ No newline at end of file
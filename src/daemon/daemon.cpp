@@ -40,10 +40,12 @@
 #include <common/rpc/rpc_types.hpp>
 #include <common/rpc/rpc_util.hpp>
 #include <common/statistics/stats.hpp>
+#include <daemon/classes/bulk_buffer_pool.hpp>
 
 #include <daemon/env.hpp>
 #include <daemon/handler/rpc_defs.hpp>
 #include <daemon/ops/metadentry.hpp>
+#include <daemon/ops/metadata_cache.hpp>
 #include <daemon/backend/metadata/db.hpp>
 #include <daemon/backend/data/chunk_storage.hpp>
 #include <daemon/util.hpp>
@@ -84,10 +86,12 @@ struct cli_options {
     string rpc_protocol;
     string dbbackend;
     string parallax_size;
+    string dbconfig;
     string stats_file;
     string prometheus_gateway;
     string proxy_protocol;
     string proxy_listen;
+    string distributor;
 };
 
 /**
@@ -149,6 +153,15 @@ register_server_rpcs(margo_instance_id mid) {
                    rpc_err_out_t, rpc_srv_decr_size);
     MARGO_REGISTER(mid, gkfs::rpc::tag::remove_metadata, rpc_rm_node_in_t,
                    rpc_rm_metadata_out_t, rpc_srv_remove_metadata);
+    MARGO_REGISTER(mid, gkfs::rpc::tag::create_batch, rpc_batch_mk_node_in_t,
+                   rpc_batch_out_t, rpc_srv_create_batch);
+    MARGO_REGISTER(mid, gkfs::rpc::tag::stat_batch, rpc_batch_path_in_t,
+                   rpc_batch_out_t, rpc_srv_stat_batch);
+    MARGO_REGISTER(mid, gkfs::rpc::tag::remove_metadata_batch,
+                   rpc_batch_path_in_t, rpc_batch_out_t,
+                   rpc_srv_remove_metadata_batch);
+    MARGO_REGISTER(mid, gkfs::rpc::tag::open_metadentry, rpc_open_in_t,
+                   rpc_open_out_t, rpc_srv_open_metadentry);
     MARGO_REGISTER(mid, gkfs::rpc::tag::remove_data, rpc_rm_node_in_t,
                    rpc_err_out_t, rpc_srv_remove_data);
     MARGO_REGISTER(mid, gkfs::rpc::tag::update_metadentry,
@@ -160,8 +173,9 @@ register_server_rpcs(margo_instance_id mid) {
                    rpc_update_metadentry_size_in_t,
                    rpc_update_metadentry_size_out_t,
                    rpc_srv_update_metadentry_size);
-    MARGO_REGISTER(mid, gkfs::rpc::tag::get_dirents, rpc_get_dirents_in_t,
-                   rpc_get_dirents_out_t, rpc_srv_get_dirents);
+    MARGO_REGISTER(mid, gkfs::rpc::tag::get_dirents,
+                   rpc_get_dirents_paged_in_t, rpc_get_dirents_paged_out_t,
+                   rpc_srv_get_dirents);
     MARGO_REGISTER(mid, gkfs::rpc::tag::get_dirents_extended,
                    rpc_get_dirents_in_t, rpc_get_dirents_out_t,
                    rpc_srv_get_dirents_extended);
@@ -241,6 +255,13 @@ init_rpc_server() {
 
     // Put context and class into RPC_data object
     RPC_DATA->server_rpc_mid(mid);
+    RPC_DATA->bulk_pool(std::make_shared<gkfs::daemon::BulkBufferPool>(
+            mid, gkfs::config::rpc::chunksize,
+            gkfs::config::rpc::bulk_buffer_pool_size_classes,
+            gkfs::config::rpc::use_bulk_buffer_pool
+                    ? gkfs::config::rpc::bulk_buffer_pool_max_size
+                    : 0,
+            GKFS_DATA->stats()));
 
     // register RPCs
     register_server_rpcs(mid);
@@ -383,6 +404,13 @@ init_proxy_rpc_server() {
 
     // Put context and class into RPC_data object
     RPC_DATA->proxy_server_rpc_mid(mid);
+    RPC_DATA->proxy_bulk_pool(std::make_shared<gkfs::daemon::BulkBufferPool>(
+            mid, gkfs::config::rpc::chunksize,
+            gkfs::config::rpc::bulk_buffer_pool_size_classes,
+            gkfs::config::rpc::use_bulk_buffer_pool
+                    ? gkfs::config::rpc::bulk_buffer_pool_max_size
+                    : 0,
+            GKFS_DATA->stats()));
 
     // register RPCs
     register_proxy_server_rpcs(mid);
@@ -409,7 +437,8 @@ init_environment() {
                                   __func__, metadata_path);
     try {
         GKFS_DATA->mdb(std::make_shared<gkfs::metadata::MetadataDB>(
-                metadata_path, GKFS_DATA->dbbackend()));
+                metadata_path, GKFS_DATA->dbbackend(),
+                GKFS_DATA->rocksdb_profile()));
     } catch(const std::exception& e) {
         GKFS_DATA->spdlogger()->error(
                 "{}() Failed to initialize metadata DB: {}", __func__,
@@ -436,6 +465,26 @@ init_environment() {
         GKFS_DATA->stats(std::make_shared<gkfs::utils::Stats>(
                 GKFS_DATA->enable_chunkstats(), GKFS_DATA->enable_prometheus(),
                 GKFS_DATA->stats_file(), GKFS_DATA->prometheus_gateway()));
+    if(GKFS_DATA->stats()) {
+        // report the metadata backend's internal statistics
+        GKFS_DATA->stats()->set_external_source([] {
+            gkfs::utils::Stats::external_stats_t values;
+            for(const auto& [name, value] : GKFS_DATA->mdb()->db_stats())
+                values.emplace_back(name, value);
+            return values;
+        });
+    }
+
+    if constexpr(gkfs::config::metadata::use_metadata_cache) {
+        GKFS_DATA->metadata_cache(
+                std::make_shared<gkfs::metadata::MetadataCache>(
+                        gkfs::config::metadata::metadata_cache_size,
+                        gkfs::config::metadata::metadata_cache_shards,
+                        GKFS_DATA->stats()));
+        GKFS_DATA->spdlogger()->debug(
+                "{}() Metadata cache enabled with size '{}'", __func__,
+                gkfs::config::metadata::metadata_cache_size);
+    }
 
     // Initialize data backend
     auto chunk_storage_path = fmt::format("{}/{}", GKFS_DATA->rootdir(),
@@ -445,7 +494,8 @@ init_environment() {
     fs::create_directories(chunk_storage_path);
     try {
         GKFS_DATA->storage(std::make_shared<gkfs::data::ChunkStorage>(
-                chunk_storage_path, gkfs::config::rpc::chunksize));
+                chunk_storage_path, gkfs::config::rpc::chunksize,
+                GKFS_DATA->stats()));
     } catch(const std::exception& e) {
         GKFS_DATA->spdlogger()->error(
                 "{}() Failed to initialize storage backend: {}", __func__,
@@ -531,7 +581,14 @@ init_environment() {
     GKFS_DATA->spdlogger()->debug("{}() Initializing Distributor ... ",
                                   __func__);
     try {
-        auto distributor = std::make_shared<gkfs::rpc::SimpleHashDistributor>();
+        std::shared_ptr<gkfs::rpc::Distributor> distributor;
+        if(GKFS_DATA->distributor_type() ==
+           gkfs::rpc::jump_hash_distributor) {
+            distributor = std::make_shared<gkfs::rpc::JumpHashDistributor>();
+        } else {
+            distributor =
+                    std::make_shared<gkfs::rpc::SimpleHashDistributor>();
+        }
         RPC_DATA->distributor(distributor);
     } catch(const std::exception& e) {
         GKFS_DATA->spdlogger()->error(
@@ -607,12 +664,20 @@ destroy_enviroment() {
         }
     }
 
+    // registered bulk buffers must be freed before their margo instance
+    RPC_DATA->bulk_pool(nullptr);
+    RPC_DATA->proxy_bulk_pool(nullptr);
+
     if(RPC_DATA->server_rpc_mid() != nullptr) {
         GKFS_DATA->spdlogger()->debug("{}() Finalizing margo RPC server",
                                       __func__);
         margo_finalize(RPC_DATA->server_rpc_mid());
     }
 
+    // the stats output must not query the closed metadata DB
+    if(GKFS_DATA->stats()) {
+        GKFS_DATA->stats()->set_external_source(nullptr);
+    }
     GKFS_DATA->spdlogger()->info("{}() Closing metadata DB", __func__);
     GKFS_DATA->close_mdb();
 
@@ -791,6 +856,20 @@ parse_input(const cli_options& opts, const CLI::App& desc) {
     }
     GKFS_DATA->hosts_file(hosts_file);
 
+    if(desc.count("--distributor")) {
+        if(opts.distributor != gkfs::rpc::simple_hash_distributor &&
+           opts.distributor != gkfs::rpc::jump_hash_distributor) {
+            throw runtime_error(fmt::format(
+                    "distributor '{}' is not valid. Consult `--help`",
+                    opts.distributor));
+        }
+        GKFS_DATA->distributor_type(opts.distributor);
+    } else {
+        GKFS_DATA->distributor_type(gkfs::rpc::simple_hash_distributor);
+    }
+    GKFS_DATA->spdlogger()->info("{}() Data distribution: '{}'", __func__,
+                                 GKFS_DATA->distributor_type());
+
     assert(desc.count("--mountdir"));
     // Store mountdir and ensure parent dir exists as it is required for path
     // resolution on the client
@@ -891,7 +970,8 @@ parse_input(const cli_options& opts, const CLI::App& desc) {
 
     if(desc.count("--dbbackend")) {
         if(opts.dbbackend == gkfs::metadata::rocksdb_backend ||
-           opts.dbbackend == gkfs::metadata::parallax_backend) {
+           opts.dbbackend == gkfs::metadata::parallax_backend ||
+           opts.dbbackend == gkfs::metadata::inmemory_backend) {
 #ifndef GKFS_ENABLE_PARALLAX
             if(opts.dbbackend == gkfs::metadata::parallax_backend) {
                 throw runtime_error(fmt::format(
@@ -921,6 +1001,13 @@ parse_input(const cli_options& opts, const CLI::App& desc) {
     if(desc.count("--parallaxsize")) { // Size in GB
         GKFS_DATA->parallax_size_md(stoi(opts.parallax_size));
     }
+    if(desc.count("--dbconfig")) {
+        if(!fs::is_regular_file(opts.dbconfig)) {
+            throw runtime_error(fmt::format(
+                    "RocksDB profile '{}' does not exist", opts.dbconfig));
+        }
+        GKFS_DATA->rocksdb_profile(fs::canonical(opts.dbconfig).native());
+    }
 
     /*
      * Statistics collection arguments
@@ -1035,14 +1122,26 @@ main(int argc, const char* argv[]) {
     desc.add_flag(
                 "--clean-rootdir-finish,-c",
                 "Cleans Rootdir >after< the deamon finishes");
+    desc.add_option(
+                "--distributor", opts.distributor,
+                "Placement of data and metadata on the daemons. Available: {simplehash, jumphash}\n"
+                "simplehash is default if not set. jumphash uses jump consistent hashing, which moves "
+                "considerably less data when the file system is expanded. Clients adopt the daemons' setting.");
     desc.add_option(
                 "--dbbackend,-d", opts.dbbackend,
-                "Metadata database backend to use. Available: {rocksdb, parallaxdb}\n"
+                "Metadata database backend to use. Available: {rocksdb, parallaxdb, inmemory}\n"
                 "RocksDB is default if not set. Parallax support is experimental.\n"
-                "Note, parallaxdb creates a file called rocksdbx with 8GB created in metadir.");
+                "Note, parallaxdb creates a file called rocksdbx with 8GB created in metadir.\n"
+                "inmemory keeps metadata in DRAM only, it is lost when the daemon stops.");
     desc.add_option("--parallaxsize", opts.parallax_size,
                     "parallaxdb - metadata file size in GB (default 8GB), "
                     "used only with new files");
+    desc.add_option(
+                "--dbconfig", opts.dbconfig,
+                "rocksdb - tuning profile file with one `key = value` setting per line. "
+                "Keys: prefix_bloom, bloom_bits_per_key, block_cache_size_mb, write_buffer_size_mb, "
+                "max_write_buffer_number, level0_file_num_compaction_trigger, max_background_jobs, "
+                "target_file_size_base_mb, statistics");
     desc.add_flag(
                 "--enable-collection",
                 "Enables collection of general statistics. "
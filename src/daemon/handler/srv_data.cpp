@@ -38,6 +38,7 @@
 #include <daemon/handler/rpc_util.hpp>
 #include <daemon/backend/data/chunk_storage.hpp>
 #include <daemon/ops/data.hpp>
+#include <daemon/classes/bulk_buffer_pool.hpp>
 
 #include <common/rpc/rpc_types.hpp>
 #include <common/rpc/rpc_util.hpp>
@@ -62,21 +63,21 @@ namespace {
  * @internal
  * The write operation has multiple steps:
  * 1. Setting up all RPC related information
- * 2. Allocating space for bulk transfer buffers
+ * 2. Borrowing a registered bulk transfer buffer from the daemon's buffer pool
  * 3. By processing the RPC input, the chunk IDs that are hashing to this daemon
  * are computed based on a client-defined interval (start and endchunk id for
  * this write operation). The client does _not_ provide the daemons with a list
  * of chunk IDs because it is dynamic data that cannot be part of an RPC input
  * struct. Therefore, this information would need to be pulled with a bulk
  * transfer as well, adding unnecessary latency to the overall write operation.
- *
- * For each relevant chunk, a PULL bulk transfer is issued. Once finished, a
- * non-blocking Argobots tasklet is launched to write the data chunk to the
- * backend storage. Therefore, bulk transfer and the backend I/O operation are
- * overlapping for efficiency.
- * 4. Wait for all tasklets to complete adding up all the complete written data
+ * 4. For each relevant chunk, a non-blocking PULL bulk transfer is issued,
+ * keeping up to gkfs::config::rpc::write_pull_depth transfers in flight. Once a
+ * chunk's transfer is finished, a non-blocking Argobots tasklet is launched to
+ * write the data chunk to the backend storage. Therefore, bulk transfers and
+ * the backend I/O operations are overlapping for efficiency.
+ * 5. Wait for all tasklets to complete adding up all the complete written data
  * size as reported by each task.
- * 5. Respond to client (when all backend write operations are finished) and
+ * 6. Respond to client (when all backend write operations are finished) and
  * cleanup RPC resources. Any error is reported in the RPC output struct. Note,
  * that backend write operations are not canceled while in-flight when a task
  * encounters an error.
@@ -105,7 +106,7 @@ rpc_srv_write(hg_handle_t handle) {
     if(ret != HG_SUCCESS) {
         GKFS_DATA->spdlogger()->error(
                 "{}() Could not get RPC input data with err {}", __func__, ret);
-        return gkfs::rpc::cleanup_respond(&handle, &in, &out, &bulk_handle);
+        return gkfs::rpc::cleanup_respond(&handle, &in, &out);
     }
     auto hgi = margo_get_info(handle);
     auto mid = margo_hg_handle_get_instance(handle);
@@ -162,29 +163,16 @@ rpc_srv_write(hg_handle_t handle) {
     /*
      * 2. Set up buffers for pull bulk transfers
      */
-    void* bulk_buf;                          // buffer for bulk transfer
     vector<char*> bulk_buf_ptrs(in.chunk_n); // buffer-chunk offsets
-    // create bulk handle and allocated memory for buffer with buf_sizes
-    // information
-    ret = margo_bulk_create(mid, 1, nullptr, &in.total_chunk_size,
-                            HG_BULK_READWRITE, &bulk_handle);
-    if(ret != HG_SUCCESS) {
+    // borrow a registered buffer of at least total_chunk_size from the pool.
+    // It is returned to the pool when the handler returns.
+    auto bulk_buf = RPC_DATA->bulk_pool()->acquire(in.total_chunk_size);
+    if(!bulk_buf.valid()) {
         GKFS_DATA->spdlogger()->error("{}() Failed to create bulk handle",
                                       __func__);
-        return gkfs::rpc::cleanup_respond(&handle, &in, &out,
-                                          static_cast<hg_bulk_t*>(nullptr));
-    }
-    // access the internally allocated memory buffer and put it into buf_ptrs
-    uint32_t actual_count;
-    ret = margo_bulk_access(bulk_handle, 0, in.total_chunk_size,
-                            HG_BULK_READWRITE, 1, &bulk_buf,
-                            &in.total_chunk_size, &actual_count);
-    if(ret != HG_SUCCESS || actual_count != 1) {
-        GKFS_DATA->spdlogger()->error(
-                "{}() Failed to access allocated buffer from bulk handle",
-                __func__);
-        return gkfs::rpc::cleanup_respond(&handle, &in, &out, &bulk_handle);
+        return gkfs::rpc::cleanup_respond(&handle, &in, &out);
     }
+    bulk_handle = bulk_buf.handle();
     auto const host_id = in.host_id;
     [[maybe_unused]] auto const host_size = in.host_size;
 
@@ -195,10 +183,13 @@ rpc_srv_write(hg_handle_t handle) {
     auto chnk_id_curr = static_cast<uint64_t>(0);
     // chnk sizes per chunk for this host
     vector<uint64_t> chnk_sizes(in.chunk_n);
+    // client and local bulk offsets per chunk for this host
+    vector<uint64_t> origin_offsets(in.chunk_n);
+    vector<uint64_t> local_offsets(in.chunk_n);
     // how much size is left to assign chunks for writing
     auto chnk_size_left_host = in.total_chunk_size;
     // temporary traveling pointer
-    auto chnk_ptr = static_cast<char*>(bulk_buf);
+    auto chnk_ptr = static_cast<char*>(bulk_buf.data());
     /*
      * consider the following cases:
      * 1. Very first chunk has offset or not and is serviced by this node
@@ -221,8 +212,7 @@ rpc_srv_write(hg_handle_t handle) {
     gkfs::data::ChunkWriteOperation chunk_op{in.path, in.chunk_n};
 
     /*
-     * 3. Calculate chunk sizes that correspond to this host, transfer data, and
-     * start tasks to write to disk
+     * 3. Calculate chunk sizes and bulk offsets that correspond to this host
      */
     // Start to look for a chunk that hashes to this host with the first chunk
     // in the buffer
@@ -256,18 +246,8 @@ rpc_srv_write(hg_handle_t handle) {
             else
                 offset_transfer_size = static_cast<size_t>(
                         gkfs::config::rpc::chunksize - in.offset);
-            ret = margo_bulk_transfer(mid, HG_BULK_PULL, hgi->addr,
-                                      in.bulk_handle, 0, bulk_handle, 0,
-                                      offset_transfer_size);
-            if(ret != HG_SUCCESS) {
-                GKFS_DATA->spdlogger()->error(
-                        "{}() Failed to pull data from client for chunk {} (startchunk {}; endchunk {}",
-                        __func__, chnk_id_file, in.chunk_start,
-                        in.chunk_end - 1);
-                out.err = EBUSY;
-                return gkfs::rpc::cleanup_respond(&handle, &in, &out,
-                                                  &bulk_handle);
-            }
+            origin_offsets[chnk_id_curr] = 0;
+            local_offsets[chnk_id_curr] = 0;
             bulk_buf_ptrs[chnk_id_curr] = chnk_ptr;
             chnk_sizes[chnk_id_curr] = offset_transfer_size;
             chnk_ptr += offset_transfer_size;
@@ -286,53 +266,92 @@ rpc_srv_write(hg_handle_t handle) {
             // last chunk might have different transfer_size
             if(chnk_id_curr == in.chunk_n - 1)
                 transfer_size = chnk_size_left_host;
+            origin_offsets[chnk_id_curr] = origin_offset;
+            local_offsets[chnk_id_curr] = local_offset;
+            bulk_buf_ptrs[chnk_id_curr] = chnk_ptr;
+            chnk_sizes[chnk_id_curr] = transfer_size;
+            chnk_ptr += transfer_size;
+            chnk_size_left_host -= transfer_size;
+        }
+        // next chunk
+        chnk_id_curr++;
+    }
+    // Sanity check that all chunks where detected in previous loop
+    // TODO don't proceed if that happens.
+    if(chnk_size_left_host != 0)
+        GKFS_DATA->spdlogger()->warn(
+                "{}() Not all chunks were detected!!! Size left {}", __func__,
+                chnk_size_left_host);
+    /*
+     * 4. Pull the chunks from the client and start a tasklet writing a chunk to
+     * disk as soon as its transfer has finished. Up to write_pull_depth
+     * transfers are in flight so that network transfers and disk I/O overlap.
+     * All posted transfers are waited for, even on error, because they target
+     * the bulk buffer.
+     */
+    auto const pull_depth =
+            std::max<uint64_t>(1, gkfs::config::rpc::write_pull_depth);
+    vector<margo_request> pull_reqs(chnk_id_curr, MARGO_REQUEST_NULL);
+    uint64_t pulls_posted = 0;
+    auto pull_err = 0;
+    for(uint64_t idx = 0; idx < chnk_id_curr; idx++) {
+        // keep the pipeline filled
+        while(pull_err == 0 && pulls_posted < chnk_id_curr &&
+              pulls_posted < idx + pull_depth) {
             GKFS_DATA->spdlogger()->trace(
-                    "{}() BULK_TRANSFER_PULL hostid {} file {} chnkid {} total_Csize {} Csize_left {} origin offset {} local offset {} transfersize {}",
-                    __func__, host_id, in.path, chnk_id_file,
-                    in.total_chunk_size, chnk_size_left_host, origin_offset,
-                    local_offset, transfer_size);
+                    "{}() BULK_TRANSFER_PULL hostid {} file {} chnkid {} origin offset {} local offset {} transfersize {}",
+                    __func__, host_id, in.path, chnk_ids_host[pulls_posted],
+                    origin_offsets[pulls_posted], local_offsets[pulls_posted],
+                    chnk_sizes[pulls_posted]);
             // RDMA the data to here
-            ret = margo_bulk_transfer(mid, HG_BULK_PULL, hgi->addr,
-                                      in.bulk_handle, origin_offset,
-                                      bulk_handle, local_offset, transfer_size);
+            ret = margo_bulk_itransfer(
+                    mid, HG_BULK_PULL, hgi->addr, in.bulk_handle,
+                    origin_offsets[pulls_posted], bulk_handle,
+                    local_offsets[pulls_posted], chnk_sizes[pulls_posted],
+                    &pull_reqs[pulls_posted]);
             if(ret != HG_SUCCESS) {
                 GKFS_DATA->spdlogger()->error(
                         "{}() Failed to pull data from client. file {} chunk {} (startchunk {}; endchunk {})",
-                        __func__, in.path, chnk_id_file, in.chunk_start,
-                        (in.chunk_end - 1));
-                out.err = EBUSY;
-                return gkfs::rpc::cleanup_respond(&handle, &in, &out,
-                                                  &bulk_handle);
+                        __func__, in.path, chnk_ids_host[pulls_posted],
+                        in.chunk_start, (in.chunk_end - 1));
+                pull_err = EBUSY;
+                break;
             }
-            bulk_buf_ptrs[chnk_id_curr] = chnk_ptr;
-            chnk_sizes[chnk_id_curr] = transfer_size;
-            chnk_ptr += transfer_size;
-            chnk_size_left_host -= transfer_size;
+            pulls_posted++;
         }
+        // nothing left to wait for after an error
+        if(idx >= pulls_posted)
+            break;
+        ret = margo_wait(pull_reqs[idx]);
+        if(ret != HG_SUCCESS) {
+            GKFS_DATA->spdlogger()->error(
+                    "{}() Failed to pull data from client. file {} chunk {} (startchunk {}; endchunk {})",
+                    __func__, in.path, chnk_ids_host[idx], in.chunk_start,
+                    (in.chunk_end - 1));
+            pull_err = EBUSY;
+        }
+        if(pull_err != 0)
+            continue;
         try {
             // start tasklet for writing chunk
             chunk_op.write_nonblock(
-                    chnk_id_curr, chnk_ids_host[chnk_id_curr],
-                    bulk_buf_ptrs[chnk_id_curr], chnk_sizes[chnk_id_curr],
-                    (chnk_id_file == in.chunk_start) ? in.offset : 0);
+                    idx, chnk_ids_host[idx], bulk_buf_ptrs[idx],
+                    chnk_sizes[idx],
+                    (chnk_ids_host[idx] == in.chunk_start) ? in.offset : 0);
         } catch(const gkfs::data::ChunkWriteOpException& e) {
             // This exception is caused by setup of Argobots variables. If this
             // fails, something is really wrong
             GKFS_DATA->spdlogger()->error("{}() while write_nonblock err '{}'",
                                           __func__, e.what());
-            return gkfs::rpc::cleanup_respond(&handle, &in, &out, &bulk_handle);
+            pull_err = EIO;
         }
-        // next chunk
-        chnk_id_curr++;
     }
-    // Sanity check that all chunks where detected in previous loop
-    // TODO don't proceed if that happens.
-    if(chnk_size_left_host != 0)
-        GKFS_DATA->spdlogger()->warn(
-                "{}() Not all chunks were detected!!! Size left {}", __func__,
-                chnk_size_left_host);
+    if(pull_err != 0) {
+        out.err = pull_err;
+        return gkfs::rpc::cleanup_respond(&handle, &in, &out);
+    }
     /*
-     * 4. Read task results and accumulate in out.io_size
+     * 5. Read task results and accumulate in out.io_size
      */
     auto write_result = chunk_op.wait_for_tasks();
     out.err = write_result.first;
@@ -346,12 +365,11 @@ rpc_srv_write(hg_handle_t handle) {
     }
 
     /*
-     * 5. Respond and cleanup
+     * 6. Respond and cleanup
      */
     GKFS_DATA->spdlogger()->debug("{}() Sending output response {}", __func__,
                                   out.err);
-    auto handler_ret =
-            gkfs::rpc::cleanup_respond(&handle, &in, &out, &bulk_handle);
+    auto handler_ret = gkfs::rpc::cleanup_respond(&handle, &in, &out);
     if(GKFS_DATA->enable_stats()) {
         GKFS_DATA->stats()->add_value_size(
                 gkfs::utils::Stats::SizeOp::write_size, bulk_size);
@@ -365,7 +383,7 @@ rpc_srv_write(hg_handle_t handle) {
  * @internal
  * The read operation has multiple steps:
  * 1. Setting up all RPC related information
- * 2. Allocating space for bulk transfer buffers
+ * 2. Borrowing a registered bulk transfer buffer from the daemon's buffer pool
  * 3. By processing the RPC input, the chunk IDs that are hashing to this daemon
  * are computed based on a client-defined interval (start and endchunk id for
  * this read operation). The client does _not_ provide the daemons with a list
@@ -375,10 +393,11 @@ rpc_srv_write(hg_handle_t handle) {
  *
  * For each relevant chunk, a non-blocking Arbobots tasklet is launched to read
  * the data chunk from the backend storage to the allocated buffers.
- * 4. Wait for all tasklets to finish the read operation while PUSH bulk
- * transferring each chunk back to the client when a tasklet finishes.
- * Therefore, bulk transfer and the backend I/O operation are overlapping for
- * efficiency. The read size is added up for all tasklets.
+ * 4. Each tasklet posts a non-blocking PUSH bulk transfer of its chunk back to
+ * the client as soon as it has read the chunk. The handler waits until all
+ * tasklets have finished and then for their in-flight transfers. Therefore,
+ * bulk transfer and the backend I/O operation are overlapping for efficiency.
+ * The read size is added up for all tasklets.
  * 5. Respond to client (when all bulk transfers are finished) and cleanup RPC
  * resources. Any error is reported in the RPC output struct. Note, that backend
  * read operations are not canceled while in-flight when a task encounters an
@@ -408,7 +427,7 @@ rpc_srv_read(hg_handle_t handle) {
     if(ret != HG_SUCCESS) {
         GKFS_DATA->spdlogger()->error(
                 "{}() Could not get RPC input data with err {}", __func__, ret);
-        return gkfs::rpc::cleanup_respond(&handle, &in, &out, &bulk_handle);
+        return gkfs::rpc::cleanup_respond(&handle, &in, &out);
     }
     auto hgi = margo_get_info(handle);
     auto mid = margo_hg_handle_get_instance(handle);
@@ -464,29 +483,16 @@ rpc_srv_read(hg_handle_t handle) {
     /*
      * 2. Set up buffers for push bulk transfers
      */
-    void* bulk_buf;                          // buffer for bulk transfer
     vector<char*> bulk_buf_ptrs(in.chunk_n); // buffer-chunk offsets
-    // create bulk handle and allocated memory for buffer with buf_sizes
-    // information
-    ret = margo_bulk_create(mid, 1, nullptr, &in.total_chunk_size,
-                            HG_BULK_READWRITE, &bulk_handle);
-    if(ret != HG_SUCCESS) {
+    // borrow a registered buffer of at least total_chunk_size from the pool.
+    // It is returned to the pool when the handler returns.
+    auto bulk_buf = RPC_DATA->bulk_pool()->acquire(in.total_chunk_size);
+    if(!bulk_buf.valid()) {
         GKFS_DATA->spdlogger()->error("{}() Failed to create bulk handle",
                                       __func__);
-        return gkfs::rpc::cleanup_respond(&handle, &in, &out,
-                                          static_cast<hg_bulk_t*>(nullptr));
-    }
-    // access the internally allocated memory buffer and put it into buf_ptrs
-    uint32_t actual_count;
-    ret = margo_bulk_access(bulk_handle, 0, in.total_chunk_size,
-                            HG_BULK_READWRITE, 1, &bulk_buf,
-                            &in.total_chunk_size, &actual_count);
-    if(ret != HG_SUCCESS || actual_count != 1) {
-        GKFS_DATA->spdlogger()->error(
-                "{}() Failed to access allocated buffer from bulk handle",
-                __func__);
-        return gkfs::rpc::cleanup_respond(&handle, &in, &out, &bulk_handle);
+        return gkfs::rpc::cleanup_respond(&handle, &in, &out);
     }
+    bulk_handle = bulk_buf.handle();
 
     auto const host_id = in.host_id;
 
@@ -503,13 +509,23 @@ rpc_srv_read(hg_handle_t handle) {
     // how much size is left to assign chunks for reading
     auto chnk_size_left_host = in.total_chunk_size;
     // temporary traveling pointer
-    auto chnk_ptr = static_cast<char*>(bulk_buf);
+    auto chnk_ptr = static_cast<char*>(bulk_buf.data());
     // temporary variables
     auto transfer_size = (bulk_size <= gkfs::config::rpc::chunksize)
                                  ? bulk_size
                                  : gkfs::config::rpc::chunksize;
+    // Each tasklet pushes its chunk back to the client when it has finished
+    gkfs::data::ChunkReadOperation::bulk_args bulk_args{};
+    bulk_args.mid = mid;
+    bulk_args.origin_addr = hgi->addr;
+    bulk_args.origin_bulk_handle = in.bulk_handle;
+    bulk_args.origin_offsets = &origin_offsets;
+    bulk_args.local_bulk_handle = bulk_handle;
+    bulk_args.local_offsets = &local_offsets;
+    bulk_args.chunk_ids = &chnk_ids_host;
     // object for asynchronous disk IO
-    gkfs::data::ChunkReadOperation chunk_read_op{in.path, in.chunk_n};
+    gkfs::data::ChunkReadOperation chunk_read_op{in.path, in.chunk_n,
+                                                 bulk_args};
     /*
      * 3. Calculate chunk sizes that correspond to this host and start tasks to
      * read from disk
@@ -589,7 +605,7 @@ rpc_srv_read(hg_handle_t handle) {
             // fails, something is really wrong
             GKFS_DATA->spdlogger()->error("{}() while read_nonblock err '{}'",
                                           __func__, e.what());
-            return gkfs::rpc::cleanup_respond(&handle, &in, &out, &bulk_handle);
+            return gkfs::rpc::cleanup_respond(&handle, &in, &out);
         }
         chnk_id_curr++;
     }
@@ -607,16 +623,8 @@ rpc_srv_read(hg_handle_t handle) {
     /*
      * 4. Read task results and accumulate in out.io_size
      */
-    gkfs::data::ChunkReadOperation::bulk_args bulk_args{};
-    bulk_args.mid = mid;
-    bulk_args.origin_addr = hgi->addr;
-    bulk_args.origin_bulk_handle = in.bulk_handle;
-    bulk_args.origin_offsets = &origin_offsets;
-    bulk_args.local_bulk_handle = bulk_handle;
-    bulk_args.local_offsets = &local_offsets;
-    bulk_args.chunk_ids = &chnk_ids_host;
-    // wait for all tasklets and push read data back to client
-    auto read_result = chunk_read_op.wait_for_tasks_and_push_back(bulk_args);
+    // wait for all tasklets and their transfers of read data to the client
+    auto read_result = chunk_read_op.wait_for_tasks_and_push_back();
     out.err = read_result.first;
     out.io_size = read_result.second;
 
@@ -625,8 +633,7 @@ rpc_srv_read(hg_handle_t handle) {
      */
     GKFS_DATA->spdlogger()->debug("{}() Sending output response, err: {}",
                                   __func__, out.err);
-    auto handler_ret =
-            gkfs::rpc::cleanup_respond(&handle, &in, &out, &bulk_handle);
+    auto handler_ret = gkfs::rpc::cleanup_respond(&handle, &in, &out);
     if(GKFS_DATA->enable_stats()) {
         GKFS_DATA->stats()->add_value_size(
                 gkfs::utils::Stats::SizeOp::read_size, bulk_size);
@@ -640,7 +647,7 @@ rpc_srv_read(hg_handle_t handle) {
  * @internal
  * The write operation has multiple steps:
  * 1. Setting up all RPC related information
- * 2. Allocating space for bulk transfer buffers
+ * 2. Borrowing a registered bulk transfer buffer from the daemon's buffer pool
  * 3. By processing the RPC input, the chunk IDs that are hashing to this daemon
  * are computed based on a client-defined interval (start and endchunk id for
  * this write operation). The client does _not_ provide the daemons with a list
@@ -684,7 +691,7 @@ rpc_srv_proxy_write(hg_handle_t handle) {
     if(ret != HG_SUCCESS) {
         GKFS_DATA->spdlogger()->error(
                 "{}() Could not get RPC input data with err {}", __func__, ret);
-        return gkfs::rpc::cleanup_respond(&handle, &in, &out, &bulk_handle);
+        return gkfs::rpc::cleanup_respond(&handle, &in, &out);
     }
     auto hgi = margo_get_info(handle);
     auto mid = margo_hg_handle_get_instance(handle);
@@ -739,29 +746,16 @@ rpc_srv_proxy_write(hg_handle_t handle) {
     /*
      * 2. Set up buffers for pull bulk transfers
      */
-    void* bulk_buf;                          // buffer for bulk transfer
     vector<char*> bulk_buf_ptrs(in.chunk_n); // buffer-chunk offsets
-    // create bulk handle and allocated memory for buffer with buf_sizes
-    // information
-    ret = margo_bulk_create(mid, 1, nullptr, &in.total_chunk_size,
-                            HG_BULK_READWRITE, &bulk_handle);
-    if(ret != HG_SUCCESS) {
+    // borrow a registered buffer of at least total_chunk_size from the pool.
+    // It is returned to the pool when the handler returns.
+    auto bulk_buf = RPC_DATA->proxy_bulk_pool()->acquire(in.total_chunk_size);
+    if(!bulk_buf.valid()) {
         GKFS_DATA->spdlogger()->error("{}() Failed to create bulk handle",
                                       __func__);
-        return gkfs::rpc::cleanup_respond(&handle, &in, &out,
-                                          static_cast<hg_bulk_t*>(nullptr));
-    }
-    // access the internally allocated memory buffer and put it into buf_ptrs
-    uint32_t actual_count;
-    ret = margo_bulk_access(bulk_handle, 0, in.total_chunk_size,
-                            HG_BULK_READWRITE, 1, &bulk_buf,
-                            &in.total_chunk_size, &actual_count);
-    if(ret != HG_SUCCESS || actual_count != 1) {
-        GKFS_DATA->spdlogger()->error(
-                "{}() Failed to access allocated buffer from bulk handle",
-                __func__);
-        return gkfs::rpc::cleanup_respond(&handle, &in, &out, &bulk_handle);
+        return gkfs::rpc::cleanup_respond(&handle, &in, &out);
     }
+    bulk_handle = bulk_buf.handle();
     auto const host_id = in.host_id;
     [[maybe_unused]] auto const host_size = in.host_size;
 
@@ -775,7 +769,7 @@ rpc_srv_proxy_write(hg_handle_t handle) {
     // how much size is left to assign chunks for writing
     auto chnk_size_left_host = in.total_chunk_size;
     // temporary traveling pointer
-    auto chnk_ptr = static_cast<char*>(bulk_buf);
+    auto chnk_ptr = static_cast<char*>(bulk_buf.data());
     /*
      * consider the following cases:
      * 1. Very first chunk has offset or not and is serviced by this node
@@ -843,8 +837,7 @@ rpc_srv_proxy_write(hg_handle_t handle) {
                         __func__, chnk_id_file, in.chunk_start,
                         in.chunk_end - 1);
                 out.err = EBUSY;
-                return gkfs::rpc::cleanup_respond(&handle, &in, &out,
-                                                  &bulk_handle);
+                return gkfs::rpc::cleanup_respond(&handle, &in, &out);
             }
             bulk_buf_ptrs[chnk_id_curr] = chnk_ptr;
             chnk_sizes[chnk_id_curr] = offset_transfer_size;
@@ -879,8 +872,7 @@ rpc_srv_proxy_write(hg_handle_t handle) {
                         __func__, in.path, chnk_id_file, in.chunk_start,
                         (in.chunk_end - 1));
                 out.err = EBUSY;
-                return gkfs::rpc::cleanup_respond(&handle, &in, &out,
-                                                  &bulk_handle);
+                return gkfs::rpc::cleanup_respond(&handle, &in, &out);
             }
             bulk_buf_ptrs[chnk_id_curr] = chnk_ptr;
             chnk_sizes[chnk_id_curr] = transfer_size;
@@ -898,7 +890,7 @@ rpc_srv_proxy_write(hg_handle_t handle) {
             // fails, something is really wrong
             GKFS_DATA->spdlogger()->error("{}() while write_nonblock err '{}'",
                                           __func__, e.what());
-            return gkfs::rpc::cleanup_respond(&handle, &in, &out, &bulk_handle);
+            return gkfs::rpc::cleanup_respond(&handle, &in, &out);
         }
         // next chunk
         chnk_id_curr++;
@@ -928,8 +920,7 @@ rpc_srv_proxy_write(hg_handle_t handle) {
      */
     GKFS_DATA->spdlogger()->debug("{}() Sending output response {}", __func__,
                                   out.err);
-    auto handler_ret =
-            gkfs::rpc::cleanup_respond(&handle, &in, &out, &bulk_handle);
+    auto handler_ret = gkfs::rpc::cleanup_respond(&handle, &in, &out);
     if(GKFS_DATA->enable_stats()) {
         GKFS_DATA->stats()->add_value_size(
                 gkfs::utils::Stats::SizeOp::write_size, bulk_size);
@@ -943,7 +934,7 @@ rpc_srv_proxy_write(hg_handle_t handle) {
  * @internal
  * The read operation has multiple steps:
  * 1. Setting up all RPC related information
- * 2. Allocating space for bulk transfer buffers
+ * 2. Borrowing a registered bulk transfer buffer from the daemon's buffer pool
  * 3. By processing the RPC input, the chunk IDs that are hashing to this daemon
  * are computed based on a client-defined interval (start and endchunk id for
  * this read operation). The client does _not_ provide the daemons with a list
@@ -953,10 +944,11 @@ rpc_srv_proxy_write(hg_handle_t handle) {
  *
  * For each relevant chunk, a non-blocking Arbobots tasklet is launched to read
  * the data chunk from the backend storage to the allocated buffers.
- * 4. Wait for all tasklets to finish the read operation while PUSH bulk
- * transferring each chunk back to the client when a tasklet finishes.
- * Therefore, bulk transfer and the backend I/O operation are overlapping for
- * efficiency. The read size is added up for all tasklets.
+ * 4. Each tasklet posts a non-blocking PUSH bulk transfer of its chunk back to
+ * the client as soon as it has read the chunk. The handler waits until all
+ * tasklets have finished and then for their in-flight transfers. Therefore,
+ * bulk transfer and the backend I/O operation are overlapping for efficiency.
+ * The read size is added up for all tasklets.
  * 5. Respond to client (when all bulk transfers are finished) and cleanup RPC
  * resources. Any error is reported in the RPC output struct. Note, that backend
  * read operations are not canceled while in-flight when a task encounters an
@@ -987,7 +979,7 @@ rpc_srv_proxy_read(hg_handle_t handle) {
     if(ret != HG_SUCCESS) {
         GKFS_DATA->spdlogger()->error(
                 "{}() Could not get RPC input data with err {}", __func__, ret);
-        return gkfs::rpc::cleanup_respond(&handle, &in, &out, &bulk_handle);
+        return gkfs::rpc::cleanup_respond(&handle, &in, &out);
     }
     auto hgi = margo_get_info(handle);
     auto mid = margo_hg_handle_get_instance(handle);
@@ -1042,29 +1034,16 @@ rpc_srv_proxy_read(hg_handle_t handle) {
     /*
      * 2. Set up buffers for push bulk transfers
      */
-    void* bulk_buf;                          // buffer for bulk transfer
     vector<char*> bulk_buf_ptrs(in.chunk_n); // buffer-chunk offsets
-    // create bulk handle and allocated memory for buffer with buf_sizes
-    // information
-    ret = margo_bulk_create(mid, 1, nullptr, &in.total_chunk_size,
-                            HG_BULK_READWRITE, &bulk_handle);
-    if(ret != HG_SUCCESS) {
+    // borrow a registered buffer of at least total_chunk_size from the pool.
+    // It is returned to the pool when the handler returns.
+    auto bulk_buf = RPC_DATA->proxy_bulk_pool()->acquire(in.total_chunk_size);
+    if(!bulk_buf.valid()) {
         GKFS_DATA->spdlogger()->error("{}() Failed to create bulk handle",
                                       __func__);
-        return gkfs::rpc::cleanup_respond(&handle, &in, &out,
-                                          static_cast<hg_bulk_t*>(nullptr));
-    }
-    // access the internally allocated memory buffer and put it into buf_ptrs
-    uint32_t actual_count;
-    ret = margo_bulk_access(bulk_handle, 0, in.total_chunk_size,
-                            HG_BULK_READWRITE, 1, &bulk_buf,
-                            &in.total_chunk_size, &actual_count);
-    if(ret != HG_SUCCESS || actual_count != 1) {
-        GKFS_DATA->spdlogger()->error(
-                "{}() Failed to access allocated buffer from bulk handle",
-                __func__);
-        return gkfs::rpc::cleanup_respond(&handle, &in, &out, &bulk_handle);
+        return gkfs::rpc::cleanup_respond(&handle, &in, &out);
     }
+    bulk_handle = bulk_buf.handle();
 #ifndef GKFS_ENABLE_FORWARDING
     auto const host_id = in.host_id;
     auto const host_size = in.host_size;
@@ -1082,13 +1061,23 @@ rpc_srv_proxy_read(hg_handle_t handle) {
     // how much size is left to assign chunks for reading
     auto chnk_size_left_host = in.total_chunk_size;
     // temporary traveling pointer
-    auto chnk_ptr = static_cast<char*>(bulk_buf);
+    auto chnk_ptr = static_cast<char*>(bulk_buf.data());
     // temporary variables
     auto transfer_size = (bulk_size <= gkfs::config::rpc::chunksize)
                                  ? bulk_size
                                  : gkfs::config::rpc::chunksize;
+    // Each tasklet pushes its chunk back to the client when it has finished
+    gkfs::data::ChunkReadOperation::bulk_args bulk_args{};
+    bulk_args.mid = mid;
+    bulk_args.origin_addr = hgi->addr;
+    bulk_args.origin_bulk_handle = in.bulk_handle;
+    bulk_args.origin_offsets = &origin_offsets;
+    bulk_args.local_bulk_handle = bulk_handle;
+    bulk_args.local_offsets = &local_offsets;
+    bulk_args.chunk_ids = &chnk_ids_host;
     // object for asynchronous disk IO
-    gkfs::data::ChunkReadOperation chunk_read_op{in.path, in.chunk_n};
+    gkfs::data::ChunkReadOperation chunk_read_op{in.path, in.chunk_n,
+                                                 bulk_args};
     /*
      * 3. Calculate chunk sizes that correspond to this host and start tasks to
      * read from disk
@@ -1166,7 +1155,7 @@ rpc_srv_proxy_read(hg_handle_t handle) {
             // fails, something is really wrong
             GKFS_DATA->spdlogger()->error("{}() while read_nonblock err '{}'",
                                           __func__, e.what());
-            return gkfs::rpc::cleanup_respond(&handle, &in, &out, &bulk_handle);
+            return gkfs::rpc::cleanup_respond(&handle, &in, &out);
         }
         chnk_id_curr++;
     }
@@ -1180,16 +1169,8 @@ rpc_srv_proxy_read(hg_handle_t handle) {
     /*
      * 4. Read task results and accumulate in out.io_size
      */
-    gkfs::data::ChunkReadOperation::bulk_args bulk_args{};
-    bulk_args.mid = mid;
-    bulk_args.origin_addr = hgi->addr;
-    bulk_args.origin_bulk_handle = in.bulk_handle;
-    bulk_args.origin_offsets = &origin_offsets;
-    bulk_args.local_bulk_handle = bulk_handle;
-    bulk_args.local_offsets = &local_offsets;
-    bulk_args.chunk_ids = &chnk_ids_host;
-    // wait for all tasklets and push read data back to client
-    auto read_result = chunk_read_op.wait_for_tasks_and_push_back(bulk_args);
+    // wait for all tasklets and their transfers of read data to the client
+    auto read_result = chunk_read_op.wait_for_tasks_and_push_back();
     out.err = read_result.first;
     out.io_size = read_result.second;
 
@@ -1198,8 +1179,7 @@ rpc_srv_proxy_read(hg_handle_t handle) {
      */
     GKFS_DATA->spdlogger()->debug("{}() Sending output response, err: {}",
                                   __func__, out.err);
-    auto handler_ret =
-            gkfs::rpc::cleanup_respond(&handle, &in, &out, &bulk_handle);
+    auto handler_ret = gkfs::rpc::cleanup_respond(&handle, &in, &out);
     if(GKFS_DATA->enable_stats()) {
         GKFS_DATA->stats()->add_value_size(
                 gkfs::utils::Stats::SizeOp::read_size, bulk_size);
@@ -31,8 +31,10 @@
 #include <daemon/handler/rpc_util.hpp>
 #include <daemon/malleability/malleable_manager.hpp>
 #include <daemon/backend/metadata/db.hpp>
+#include <daemon/ops/metadata_cache.hpp>
 
 #include <common/rpc/rpc_types.hpp>
+#include <common/metadata.hpp>
 
 extern "C" {
 #include <unistd.h>
@@ -125,7 +127,10 @@ rpc_srv_migrate_metadata(hg_handle_t handle) {
                                   __func__, in.key, in.value);
     try {
         // create metadentry
-        GKFS_DATA->mdb()->put(in.key, in.value);
+        GKFS_DATA->mdb()->put(in.key,
+                              gkfs::metadata::Metadata(in.value).serialize());
+        if(GKFS_DATA->metadata_cache())
+            GKFS_DATA->metadata_cache()->erase(in.key);
         out.err = 0;
     } catch(const std::exception& e) {
         GKFS_DATA->spdlogger()->error("{}() Failed to create KV entry: '{}'",
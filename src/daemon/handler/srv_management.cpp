@@ -72,6 +72,7 @@ rpc_srv_get_fs_config(hg_handle_t handle) {
     out.blocks_state = static_cast<hg_bool_t>(GKFS_DATA->blocks_state());
     out.uid = getuid();
     out.gid = getgid();
+    out.distributor = GKFS_DATA->distributor_type().c_str();
     GKFS_DATA->spdlogger()->debug(
             "{}() Sending output configs back to library. mountdir '{}' rootdir '{}'",
             __func__, out.mountdir, out.rootdir);
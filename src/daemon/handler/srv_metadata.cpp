@@ -41,12 +41,27 @@
 #include <daemon/ops/metadentry.hpp>
 
 #include <common/rpc/rpc_types.hpp>
+#include <common/rpc/rpc_util.hpp>
 #include <common/statistics/stats.hpp>
 
 using namespace std;
 
 namespace {
 
+/**
+ * @brief Encodes per-path error codes of a batched request for the RPC output.
+ * @param errs error codes
+ * @return encoded string
+ */
+std::string
+encode_batch_errs(const std::vector<int>& errs) {
+    std::vector<std::string> strs;
+    strs.reserve(errs.size());
+    for(auto err : errs)
+        strs.emplace_back(std::to_string(err));
+    return gkfs::rpc::encode_string_batch(strs);
+}
+
 /**
  * @brief Serves a file/directory create request or returns an error to the
  * client if the object already exists.
@@ -130,7 +145,8 @@ rpc_srv_stat(hg_handle_t handle) {
 
     try {
         // get the metadata
-        val = gkfs::metadata::get_str(in.path);
+        // RPC strings are NUL-terminated, send the text format
+        val = gkfs::metadata::get(in.path).serialize_text();
         out.db_val = val.c_str();
         out.err = 0;
         GKFS_DATA->spdlogger()->debug("{}() Sending output mode '{}'", __func__,
@@ -188,7 +204,7 @@ rpc_srv_decr_size(hg_handle_t handle) {
                                   in.path, in.length);
 
     try {
-        GKFS_DATA->mdb()->decrease_size(in.path, in.length);
+        gkfs::metadata::decrease_size(in.path, in.length);
         out.err = 0;
     } catch(const std::exception& e) {
         GKFS_DATA->spdlogger()->error("{}() Failed to decrease size: '{}'",
@@ -296,6 +312,305 @@ rpc_srv_remove_metadata(hg_handle_t handle) {
     return HG_SUCCESS;
 }
 
+/**
+ * @brief Serves a request to create several files or directories with the same
+ * mode.
+ * @internal
+ * All paths are created with a single write to the KV store. Paths that already
+ * exist get an EEXIST error code in the per-path error list of the output. This
+ * is not a hard error. The output's err is only set if the request failed as a
+ * whole.
+ *
+ * All exceptions must be caught here and dealt with accordingly.
+ * @endinteral
+ * @param handle Mercury RPC handle
+ * @return Mercury error code to Mercury
+ */
+hg_return_t
+rpc_srv_create_batch(hg_handle_t handle) {
+    rpc_batch_mk_node_in_t in{};
+    rpc_batch_out_t out{};
+
+    auto ret = margo_get_input(handle, &in);
+    if(ret != HG_SUCCESS)
+        GKFS_DATA->spdlogger()->error(
+                "{}() Failed to retrieve input from handle", __func__);
+    assert(ret == HG_SUCCESS);
+    std::vector<std::string> paths;
+    std::string errs;
+    try {
+        paths = gkfs::rpc::decode_string_batch(in.paths);
+        GKFS_DATA->spdlogger()->debug("{}() Got RPC with '{}' paths", __func__,
+                                      paths.size());
+        errs = encode_batch_errs(gkfs::metadata::create_batch(paths, in.mode));
+        out.err = 0;
+    } catch(const std::exception& e) {
+        GKFS_DATA->spdlogger()->error(
+                "{}() Failed to create metadentries: '{}'", __func__,
+                e.what());
+        out.err = EIO;
+    }
+    out.errs = errs.c_str();
+    out.values = "";
+
+    GKFS_DATA->spdlogger()->debug("{}() Sending output err '{}'", __func__,
+                                  out.err);
+    auto hret = margo_respond(handle, &out);
+    if(hret != HG_SUCCESS) {
+        GKFS_DATA->spdlogger()->error("{}() Failed to respond", __func__);
+    }
+
+    // Destroy handle when finished
+    margo_free_input(handle, &in);
+    margo_destroy(handle);
+    if(GKFS_DATA->enable_stats()) {
+        for(size_t i = 0; i < paths.size(); ++i)
+            GKFS_DATA->stats()->add_value_iops(
+                    gkfs::utils::Stats::IopsOp::iops_create);
+    }
+    return HG_SUCCESS;
+}
+
+/**
+ * @brief Serves a stat request for several objects.
+ * @internal
+ * All entries that are not cached are read from the KV store with a single
+ * request. The output holds an error code and a metadata value string per
+ * path. The value is empty if the object does not exist (ENOENT).
+ *
+ * All exceptions must be caught here and dealt with accordingly.
+ * @endinteral
+ * @param handle Mercury RPC handle
+ * @return Mercury error code to Mercury
+ */
+hg_return_t
+rpc_srv_stat_batch(hg_handle_t handle) {
+    rpc_batch_path_in_t in{};
+    rpc_batch_out_t out{};
+
+    auto ret = margo_get_input(handle, &in);
+    if(ret != HG_SUCCESS)
+        GKFS_DATA->spdlogger()->error(
+                "{}() Failed to retrieve input from handle", __func__);
+    assert(ret == HG_SUCCESS);
+    std::vector<std::string> paths;
+    std::string errs;
+    std::string values;
+    try {
+        paths = gkfs::rpc::decode_string_batch(in.paths);
+        GKFS_DATA->spdlogger()->debug("{}() Got RPC with '{}' paths", __func__,
+                                      paths.size());
+        auto mds = gkfs::metadata::get_batch(paths);
+        std::vector<int> path_errs(paths.size(), 0);
+        std::vector<std::string> vals(paths.size());
+        for(size_t i = 0; i < paths.size(); ++i) {
+            if(!mds[i]) {
+                path_errs[i] = ENOENT;
+                continue;
+            }
+            // RPC strings are NUL-terminated, send the text format
+            vals[i] = mds[i]->serialize_text();
+        }
+        errs = encode_batch_errs(path_errs);
+        values = gkfs::rpc::encode_string_batch(vals);
+        out.err = 0;
+    } catch(const std::exception& e) {
+        GKFS_DATA->spdlogger()->error(
+                "{}() Failed to get metadentries from DB: '{}'", __func__,
+                e.what());
+        out.err = EBUSY;
+    }
+    out.errs = errs.c_str();
+    out.values = values.c_str();
+
+    auto hret = margo_respond(handle, &out);
+    if(hret != HG_SUCCESS) {
+        GKFS_DATA->spdlogger()->error("{}() Failed to respond", __func__);
+    }
+
+    // Destroy handle when finished
+    margo_free_input(handle, &in);
+    margo_destroy(handle);
+
+    if(GKFS_DATA->enable_stats()) {
+        for(size_t i = 0; i < paths.size(); ++i)
+            GKFS_DATA->stats()->add_value_iops(
+                    gkfs::utils::Stats::IopsOp::iops_stats);
+    }
+    return HG_SUCCESS;
+}
+
+/**
+ * @brief Serves a request to remove the metadata of several files.
+ * @internal
+ * Works like rpc_srv_remove_metadata() for each path but removes all entries
+ * with a single write to the KV store. Directories are not removed and get an
+ * EISDIR error code, renamed files an ENOENT error code. The output holds an
+ * error code and the removed metadata value string per path so that the client
+ * can remove the files' data chunks and follow renamed files to their new path
+ * without another request.
+ *
+ * All exceptions must be caught here and dealt with accordingly. Any errors are
+ * placed in the response.
+ * @endinteral
+ * @param handle Mercury RPC handle
+ * @return Mercury error code to Mercury
+ */
+hg_return_t
+rpc_srv_remove_metadata_batch(hg_handle_t handle) {
+    rpc_batch_path_in_t in{};
+    rpc_batch_out_t out{};
+
+    auto ret = margo_get_input(handle, &in);
+    if(ret != HG_SUCCESS)
+        GKFS_DATA->spdlogger()->error(
+                "{}() Failed to retrieve input from handle", __func__);
+    assert(ret == HG_SUCCESS);
+    std::vector<std::string> paths;
+    std::string errs;
+    std::string values;
+    try {
+        paths = gkfs::rpc::decode_string_batch(in.paths);
+        GKFS_DATA->spdlogger()->debug(
+                "{}() Got remove metadata RPC with '{}' paths", __func__,
+                paths.size());
+        auto mds = gkfs::metadata::get_batch(paths);
+        std::vector<int> path_errs(paths.size(), 0);
+        std::vector<std::string> vals(paths.size());
+        std::vector<std::string> rm_paths;
+        for(size_t i = 0; i < paths.size(); ++i) {
+            if(!mds[i]) {
+                path_errs[i] = ENOENT;
+            } else if(S_ISDIR(mds[i]->mode())) {
+                path_errs[i] = EISDIR;
+#if defined(HAS_SYMLINKS) && defined(HAS_RENAME)
+            } else if(mds[i]->blocks() == -1) {
+                // the file was renamed and is only found at its new path
+                path_errs[i] = ENOENT;
+#endif
+            } else {
+                rm_paths.push_back(paths[i]);
+                vals[i] = mds[i]->serialize_text();
+            }
+        }
+        gkfs::metadata::remove_batch(rm_paths);
+        if constexpr(gkfs::config::metadata::implicit_data_removal) {
+            for(size_t i = 0; i < paths.size(); ++i) {
+                if(path_errs[i] != 0 || !S_ISREG(mds[i]->mode()) ||
+                   mds[i]->size() == 0)
+                    continue;
+                try {
+                    GKFS_DATA->storage()->destroy_chunk_space(paths[i]);
+                } catch(const gkfs::data::ChunkStorageException& e) {
+                    GKFS_DATA->spdlogger()->error(
+                            "{}(): path '{}' errcode '{}' message '{}'",
+                            __func__, paths[i], e.code().value(), e.what());
+                    path_errs[i] = e.code().value();
+                }
+            }
+        }
+        errs = encode_batch_errs(path_errs);
+        values = gkfs::rpc::encode_string_batch(vals);
+        out.err = 0;
+    } catch(const gkfs::metadata::DBException& e) {
+        GKFS_DATA->spdlogger()->error("{}(): message '{}'", __func__,
+                                      e.what());
+        out.err = EIO;
+    } catch(const std::exception& e) {
+        GKFS_DATA->spdlogger()->error("{}() message '{}'", __func__, e.what());
+        out.err = EBUSY;
+    }
+    out.errs = errs.c_str();
+    out.values = values.c_str();
+
+    GKFS_DATA->spdlogger()->debug("{}() Sending output '{}'", __func__,
+                                  out.err);
+    auto hret = margo_respond(handle, &out);
+    if(hret != HG_SUCCESS) {
+        GKFS_DATA->spdlogger()->error("{}() Failed to respond", __func__);
+    }
+    // Destroy handle when finished
+    margo_free_input(handle, &in);
+    margo_destroy(handle);
+    if(GKFS_DATA->enable_stats()) {
+        for(size_t i = 0; i < paths.size(); ++i)
+            GKFS_DATA->stats()->add_value_iops(
+                    gkfs::utils::Stats::IopsOp::iops_remove);
+    }
+    return HG_SUCCESS;
+}
+
+/**
+ * @brief Serves an open request that creates, stats, and truncates an object's
+ * metadata in one step.
+ * @internal
+ * The object is created if it doesn't exist and the create flag is set. Its
+ * metadata value string is returned in any case so that the client doesn't
+ * need another stat request. With the excl flag, an existing object results in
+ * an EEXIST error code. With the trunc flag, a regular file's size is set to 0
+ * and its previous size is returned so that the client can remove its data
+ * chunks. The client still checks the parent directory and follows links.
+ *
+ * All exceptions must be caught here and dealt with accordingly. Any errors are
+ * placed in the response.
+ * @endinteral
+ * @param handle Mercury RPC handle
+ * @return Mercury error code to Mercury
+ */
+hg_return_t
+rpc_srv_open_metadentry(hg_handle_t handle) {
+    rpc_open_in_t in{};
+    rpc_open_out_t out{};
+
+    auto ret = margo_get_input(handle, &in);
+    if(ret != HG_SUCCESS)
+        GKFS_DATA->spdlogger()->error(
+                "{}() Failed to retrieve input from handle", __func__);
+    assert(ret == HG_SUCCESS);
+    GKFS_DATA->spdlogger()->debug(
+            "{}() Got RPC with path '{}' create '{}' excl '{}' trunc '{}'",
+            __func__, in.path, in.create, in.excl, in.trunc);
+    std::string val;
+    out.created = false;
+    out.trunc_size = 0;
+    gkfs::metadata::Metadata md(in.mode);
+    try {
+        auto [created, trunc_size] = gkfs::metadata::open_or_create(
+                in.path, md, in.create, in.excl, in.trunc);
+        out.created = created;
+        out.trunc_size = static_cast<hg_int64_t>(trunc_size);
+        // RPC strings are NUL-terminated, send the text format
+        val = md.serialize_text();
+        out.err = 0;
+    } catch(const gkfs::metadata::NotFoundException& e) {
+        out.err = ENOENT;
+    } catch(const gkfs::metadata::ExistsException& e) {
+        out.err = EEXIST;
+    } catch(const std::exception& e) {
+        GKFS_DATA->spdlogger()->error("{}() Failed to open metadentry: '{}'",
+                                      __func__, e.what());
+        out.err = EBUSY;
+    }
+    out.db_val = val.c_str();
+
+    GKFS_DATA->spdlogger()->debug("{}() Sending output err '{}' created '{}'",
+                                  __func__, out.err, out.created);
+    auto hret = margo_respond(handle, &out);
+    if(hret != HG_SUCCESS) {
+        GKFS_DATA->spdlogger()->error("{}() Failed to respond", __func__);
+    }
+
+    // Destroy handle when finished
+    margo_free_input(handle, &in);
+    margo_destroy(handle);
+    if(GKFS_DATA->enable_stats()) {
+        GKFS_DATA->stats()->add_value_iops(
+                out.created ? gkfs::utils::Stats::IopsOp::iops_create
+                            : gkfs::utils::Stats::IopsOp::iops_stats);
+    }
+    return HG_SUCCESS;
+}
+
 /**
  * @brief Serves a request to remove all file data chunks on this daemon.
  * @internal
@@ -515,15 +830,14 @@ rpc_srv_get_metadentry_size(hg_handle_t handle) {
 }
 
 /**
- * @brief Serves a request to return all file system objects in a directory.
+ * @brief Serves a request to return one page of file system objects in a
+ * directory.
  * @internal
- * This handler triggers a KV store scan starting at the given path prefix that
- * represents a directory. All KV store entries are returned via a bulk transfer
- * as it can involve an arbitrary number of entries.
- *
- * Note, the bulk buffer size is decided by the client statically although it
- * doesn't know if it the space is sufficient to accomodate all entries. This is
- * planned to be fixed in the future.
+ * This handler triggers a KV store scan of the direct children of the given
+ * directory, starting after the resume key `start_key` (empty for the first
+ * page). As many entries as fit into the client's bulk buffer are returned via
+ * a bulk transfer, together with the resume key for the next page. An empty
+ * resume key indicates that this daemon has no further entries.
  *
  * All exceptions must be caught here and dealt with accordingly. Any errors are
  * placed in the response.
@@ -533,11 +847,14 @@ rpc_srv_get_metadentry_size(hg_handle_t handle) {
  */
 hg_return_t
 rpc_srv_get_dirents(hg_handle_t handle) {
-    rpc_get_dirents_in_t in{};
-    rpc_get_dirents_out_t out{};
+    rpc_get_dirents_paged_in_t in{};
+    rpc_get_dirents_paged_out_t out{};
     out.err = EIO;
     out.dirents_size = 0;
+    out.next_key = "";
     hg_bulk_t bulk_handle = nullptr;
+    // must outlive the response
+    string next_key{};
 
     // Get input parmeters
     auto ret = margo_get_input(handle, &in);
@@ -553,13 +870,15 @@ rpc_srv_get_dirents(hg_handle_t handle) {
     auto hgi = margo_get_info(handle);
     auto mid = margo_hg_handle_get_instance(handle);
     auto bulk_size = margo_bulk_get_size(in.bulk_handle);
-    GKFS_DATA->spdlogger()->debug("{}() Got RPC: path '{}' bulk_size '{}' ",
-                                  __func__, in.path, bulk_size);
+    GKFS_DATA->spdlogger()->debug(
+            "{}() Got RPC: path '{}' start_key '{}' bulk_size '{}' ", __func__,
+            in.path, in.start_key, bulk_size);
 
-    // Get directory entries from local DB
+    // Get one page of directory entries from local DB
     vector<pair<string, bool>> entries{};
     try {
-        entries = gkfs::metadata::get_dirents(in.path);
+        entries = gkfs::metadata::get_dirents_page(
+                in.path, in.start_key, gkfs::config::rpc::dirents_page_entries);
     } catch(const ::exception& e) {
         GKFS_DATA->spdlogger()->error("{}() Error during get_dirents(): '{}'",
                                       __func__, e.what());
@@ -575,25 +894,31 @@ rpc_srv_get_dirents(hg_handle_t handle) {
         return gkfs::rpc::cleanup_respond(&handle, &in, &out);
     }
 
-    // Calculate total output size
-    // TODO OPTIMIZATION: this can be calculated inside db_get_dirents
-    size_t tot_names_size = 0;
+    // Take as many entries as fit into the client's buffer. Each entry needs
+    // its name, a \0 terminator, and the is_dir bool
+    size_t page_entries = 0;
+    size_t out_size = 0;
     for(auto const& e : entries) {
-        tot_names_size += e.first.size();
+        auto entry_size = e.first.size() + sizeof(char) + sizeof(bool);
+        if(out_size + entry_size > bulk_size) {
+            break;
+        }
+        out_size += entry_size;
+        page_entries++;
     }
-
-    // tot_names_size (# characters in entry) + # entries * (bool size + char
-    // size for \0 character)
-    size_t out_size =
-            tot_names_size + entries.size() * (sizeof(bool) + sizeof(char));
-    if(bulk_size < out_size) {
-        // Source buffer is smaller than total output size
+    if(page_entries == 0) {
+        // Source buffer is smaller than a single entry
         GKFS_DATA->spdlogger()->error(
-                "{}() Entries do not fit source buffer. bulk_size '{}' < out_size '{}' must be satisfied!",
-                __func__, bulk_size, out_size);
+                "{}() Entry does not fit source buffer. bulk_size '{}' < entry size '{}' must be satisfied!",
+                __func__, bulk_size, entries.front().first.size() + 2);
         out.err = ENOBUFS;
         return gkfs::rpc::cleanup_respond(&handle, &in, &out);
     }
+    // Resume after the last returned entry if the page is full
+    if(page_entries < entries.size() ||
+       entries.size() == gkfs::config::rpc::dirents_page_entries) {
+        next_key = entries[page_entries - 1].first;
+    }
 
     void* bulk_buf; // buffer for bulk transfer
     // create bulk handle and allocated memory for buffer with out_size
@@ -619,14 +944,15 @@ rpc_srv_get_dirents(hg_handle_t handle) {
 
     GKFS_DATA->spdlogger()->trace(
             "{}() path '{}' entries '{}' out_size '{}'. Set up local read only bulk handle and allocated buffer with size '{}'",
-            __func__, in.path, entries.size(), out_size, out_size);
+            __func__, in.path, page_entries, out_size, out_size);
 
     // Serialize output data on local buffer
     auto out_buff_ptr = static_cast<char*>(bulk_buf);
     auto bool_ptr = reinterpret_cast<bool*>(out_buff_ptr);
-    auto names_ptr = out_buff_ptr + entries.size();
+    auto names_ptr = out_buff_ptr + page_entries;
 
-    for(auto const& e : entries) {
+    for(size_t i = 0; i < page_entries; i++) {
+        auto const& e = entries[i];
         if(e.first.empty()) {
             GKFS_DATA->spdlogger()->warn(
                     "{}() Entry in readdir() empty. If this shows up, something else is very wrong.",
@@ -643,23 +969,24 @@ rpc_srv_get_dirents(hg_handle_t handle) {
 
     GKFS_DATA->spdlogger()->trace(
             "{}() path '{}' entries '{}' out_size '{}'. Copied data to bulk_buffer. NEXT bulk_transfer",
-            __func__, in.path, entries.size(), out_size);
+            __func__, in.path, page_entries, out_size);
 
     ret = margo_bulk_transfer(mid, HG_BULK_PUSH, hgi->addr, in.bulk_handle, 0,
                               bulk_handle, 0, out_size);
     if(ret != HG_SUCCESS) {
         GKFS_DATA->spdlogger()->error(
                 "{}() Failed to push '{}' dirents on path '{}' to client with bulk size '{}' and out_size '{}'",
-                __func__, entries.size(), in.path, bulk_size, out_size);
+                __func__, page_entries, in.path, bulk_size, out_size);
         out.err = EBUSY;
         return gkfs::rpc::cleanup_respond(&handle, &in, &out, &bulk_handle);
     }
 
-    out.dirents_size = entries.size();
+    out.dirents_size = page_entries;
+    out.next_key = next_key.c_str();
     out.err = 0;
     GKFS_DATA->spdlogger()->debug(
-            "{}() Sending output response err '{}' dirents_size '{}'. DONE",
-            __func__, out.err, out.dirents_size);
+            "{}() Sending output response err '{}' dirents_size '{}' next_key '{}'. DONE",
+            __func__, out.err, out.dirents_size, out.next_key);
     if(GKFS_DATA->enable_stats()) {
         GKFS_DATA->stats()->add_value_iops(
                 gkfs::utils::Stats::IopsOp::iops_dirent);
@@ -878,7 +1205,7 @@ rpc_srv_mk_symlink(hg_handle_t handle) {
 #endif // HAS_RENAME
         GKFS_DATA->spdlogger()->debug(
                 "{}() Updating path '{}' with metadata '{}'", __func__, in.path,
-                md.serialize());
+                md.serialize_text());
         gkfs::metadata::update(in.path, md);
         out.err = 0;
     } catch(const std::exception& e) {
@@ -912,6 +1239,14 @@ DEFINE_MARGO_RPC_HANDLER(rpc_srv_decr_size)
 
 DEFINE_MARGO_RPC_HANDLER(rpc_srv_remove_metadata)
 
+DEFINE_MARGO_RPC_HANDLER(rpc_srv_create_batch)
+
+DEFINE_MARGO_RPC_HANDLER(rpc_srv_stat_batch)
+
+DEFINE_MARGO_RPC_HANDLER(rpc_srv_remove_metadata_batch)
+
+DEFINE_MARGO_RPC_HANDLER(rpc_srv_open_metadentry)
+
 DEFINE_MARGO_RPC_HANDLER(rpc_srv_remove_data)
 
 DEFINE_MARGO_RPC_HANDLER(rpc_srv_update_metadentry)
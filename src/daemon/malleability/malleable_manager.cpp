@@ -29,15 +29,18 @@
 #include <daemon/malleability/malleable_manager.hpp>
 #include <daemon/malleability/rpc/forward_redistribution.hpp>
 #include <daemon/backend/metadata/db.hpp>
+#include <daemon/ops/metadata_cache.hpp>
 #include <daemon/backend/data/chunk_storage.hpp>
 
 #include <common/rpc/rpc_util.hpp>
+#include <common/metadata.hpp>
 
 #include <filesystem>
 #include <algorithm>
 #include <regex>
 #include <random>
 #include <thread>
+#include <mutex>
 
 extern "C" {
 #include <abt.h>
@@ -130,6 +133,16 @@ MalleableManager::connect_to_hosts(
     bool local_host_found = false;
 
     RPC_DATA->hosts_size(hosts.size());
+    for(uint64_t id = 0; id < hosts.size(); id++) {
+        if(hosts[id].first == local_hostname) {
+            GKFS_DATA->spdlogger()->debug("{}() Found local host: {}", __func__,
+                                          local_hostname);
+            RPC_DATA->local_host_id(id);
+            local_host_found = true;
+            break;
+        }
+    }
+
     vector<uint64_t> host_ids(hosts.size());
     // populate vector with [0, ..., host_size - 1]
     ::iota(::begin(host_ids), ::end(host_ids), 0);
@@ -143,51 +156,52 @@ MalleableManager::connect_to_hosts(
     ::mt19937 g(rd());  // seed the random generator
     ::shuffle(host_ids.begin(), host_ids.end(), g); // Shuffle hosts vector
     // lookup addresses and put abstract server addresses into rpc_addresses
-    for(const auto& id : host_ids) {
-        const auto& hostname = hosts.at(id).first;
-        const auto& uri = hosts.at(id).second;
-
-        hg_addr_t svr_addr = HG_ADDR_NULL;
-
-        // try to look up 3 times before erroring out
-        hg_return_t ret;
-        for(uint32_t i = 0; i < 4; i++) {
-            ret = margo_addr_lookup(RPC_DATA->client_rpc_mid(), uri.c_str(),
-                                    &svr_addr);
-            if(ret != HG_SUCCESS) {
-                // still not working after 5 tries.
-                if(i == 3) {
-                    auto err_msg =
-                            fmt::format("{}() Unable to lookup address '{}'",
-                                        __func__, uri);
+    mutex endpoints_mutex;
+    gkfs::rpc::for_each_concurrently(
+            host_ids, gkfs::config::rpc::host_lookup_concurrency,
+            [&](uint64_t id) {
+                const auto& uri = hosts.at(id).second;
+
+                hg_addr_t svr_addr = HG_ADDR_NULL;
+
+                // try to look up 3 times before erroring out
+                hg_return_t ret;
+                for(uint32_t i = 0; i < 4; i++) {
+                    ret = margo_addr_lookup(RPC_DATA->client_rpc_mid(),
+                                            uri.c_str(), &svr_addr);
+                    if(ret != HG_SUCCESS) {
+                        // still not working after 5 tries.
+                        if(i == 3) {
+                            auto err_msg = fmt::format(
+                                    "{}() Unable to lookup address '{}'",
+                                    __func__, uri);
+                            throw runtime_error(err_msg);
+                        }
+                        // Wait a random amount of time and try again
+                        ::mt19937 eng(::random_device{}()); // seed the random
+                                                            // generator
+                        ::uniform_int_distribution<> distr(
+                                50, 50 * (i + 2)); // define the range
+                        ::this_thread::sleep_for(
+                                std::chrono::milliseconds(distr(eng)));
+                    } else {
+                        break;
+                    }
+                }
+                if(svr_addr == HG_ADDR_NULL) {
+                    auto err_msg = fmt::format(
+                            "{}() looked up address is NULL for address '{}'",
+                            __func__, uri);
                     throw runtime_error(err_msg);
                 }
-                // Wait a random amount of time and try again
-                ::mt19937 eng(rd()); // seed the random generator
-                ::uniform_int_distribution<> distr(
-                        50, 50 * (i + 2)); // define the range
-                ::this_thread::sleep_for(std::chrono::milliseconds(distr(eng)));
-            } else {
-                break;
-            }
-        }
-        if(svr_addr == HG_ADDR_NULL) {
-            auto err_msg = fmt::format(
-                    "{}() looked up address is NULL for address '{}'", __func__,
-                    uri);
-            throw runtime_error(err_msg);
-        }
-        RPC_DATA->rpc_endpoints().insert(make_pair(id, svr_addr));
-
-        if(!local_host_found && hostname == local_hostname) {
-            GKFS_DATA->spdlogger()->debug("{}() Found local host: {}", __func__,
-                                          hostname);
-            RPC_DATA->local_host_id(id);
-            local_host_found = true;
-        }
-        GKFS_DATA->spdlogger()->debug("{}() Found daemon: id '{}' uri '{}'",
-                                      __func__, id, uri);
-    }
+                {
+                    lock_guard<mutex> lock(endpoints_mutex);
+                    RPC_DATA->rpc_endpoints().insert(make_pair(id, svr_addr));
+                }
+                GKFS_DATA->spdlogger()->debug(
+                        "{}() Found daemon: id '{}' uri '{}'", __func__, id,
+                        uri);
+            });
     if(!local_host_found) {
         auto err_msg = fmt::format(
                 "{}() Local host '{}' not found in hosts file. This should not happen.",
@@ -205,16 +219,27 @@ MalleableManager::redistribute_metadata() {
             "{}() Starting metadata redistribution for '{}' estimated number of KV pairs...",
             __func__, estimate_db_size);
     int migration_err = 0;
+    if(GKFS_DATA->dbbackend() != gkfs::metadata::rocksdb_backend) {
+        GKFS_DATA->spdlogger()->error(
+                "{}() Metadata redistribution requires the '{}' backend",
+                __func__, gkfs::metadata::rocksdb_backend);
+        return 1;
+    }
     string key, value;
     auto iter =
             static_cast<rocksdb::Iterator*>(GKFS_DATA->mdb()->iterate_all());
     // TODO parallelize
     for(iter->SeekToFirst(); iter->Valid(); iter->Next()) {
-        key = iter->key().ToString();
-        value = iter->value().ToString();
-        if(key == "/") {
+        // database keys are not plain paths
+        key = gkfs::metadata::RocksDBBackend::decode_key(iter->key());
+        if(key.empty() || key == "/") {
             continue;
         }
+        // RPC strings are NUL-terminated, send the text format
+        value = gkfs::metadata::Metadata(std::string_view(
+                                                 iter->value().data(),
+                                                 iter->value().size()))
+                        .serialize_text();
         auto dest_id = RPC_DATA->distributor()->locate_file_metadata(key, 0);
         GKFS_DATA->spdlogger()->trace(
                 "{}() Migration: key {} and value {}. From host {} to host {}",
@@ -231,6 +256,8 @@ MalleableManager::redistribute_metadata() {
             migration_err++;
         }
         GKFS_DATA->mdb()->remove(key);
+        if(GKFS_DATA->metadata_cache())
+            GKFS_DATA->metadata_cache()->erase(key);
         count++;
         if(percent_interval > 0 && count % percent_interval == 0) {
             GKFS_DATA->spdlogger()->info(
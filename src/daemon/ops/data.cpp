@@ -309,11 +309,13 @@ ChunkWriteOperation::wait_for_tasks() {
    const gkfs::rpc::chnk_id_t* chnk_id;
    size_t size;
    off64_t off;
-   ABT_eventual* eventual;
+   size_t idx;
+   ChunkReadOperation* op;
  * This function is driven by the IO pool. so there is a maximum allowed number
  of concurrent IO operations per daemon.
  * This function is called by tasklets, as this function cannot be allowed to
- block.
+ block. Posting the PUSH bulk transfer with margo_bulk_itransfer() does not
+ block. Its completion is waited for by the RPC handler.
  * @endinternal
  */
 void
@@ -321,11 +323,10 @@ ChunkReadOperation::read_file_abt(void* _arg) {
     assert(_arg);
     // unpack args
     auto* arg = static_cast<struct chunk_read_args*>(_arg);
+    auto* op = arg->op;
     const string& path = *(arg->path);
     ssize_t read = 0;
     try {
-        // Under expected circumstances (error or no error) read_chunk will
-        // signal the eventual
         read = GKFS_DATA->storage()->read_chunk(path, arg->chnk_id, arg->buf,
                                                 arg->size, arg->off);
     } catch(const ChunkStorageException& err) {
@@ -337,17 +338,74 @@ ChunkReadOperation::read_file_abt(void* _arg) {
                 arg->chnk_id, path);
         read = -EIO;
     }
-    ABT_eventual_set(arg->eventual, &read, sizeof(read));
+    arg->read = read;
+    // sparse regions do not have chunk files and are therefore skipped. A read
+    // size of 0 is not an error and can happen because reading the end-of-file
+    if(read < 0 && -read != ENOENT) {
+        int expected = 0;
+        op->io_err_.compare_exchange_strong(expected, static_cast<int>(-read));
+    }
+    // As soon as an error is encountered, bulk transfers are no longer
+    // executed as the data would be corrupted
+    if(read > 0 && op->io_err_.load() == 0) {
+        const auto& args = op->bulk_args_;
+        GKFS_DATA->spdlogger()->trace(
+                "ChunkReadOperation::{}() BULK_TRANSFER_PUSH file '{}' chnkid '{}' origin offset '{}' local offset '{}' transfersize '{}'",
+                __func__, path, arg->chnk_id,
+                args.origin_offsets->at(arg->idx),
+                args.local_offsets->at(arg->idx), read);
+        assert(arg->chnk_id == args.chunk_ids->at(arg->idx));
+        auto margo_err = margo_bulk_itransfer(
+                args.mid, HG_BULK_PUSH, args.origin_addr,
+                args.origin_bulk_handle, args.origin_offsets->at(arg->idx),
+                args.local_bulk_handle, args.local_offsets->at(arg->idx),
+                static_cast<size_t>(read), &arg->push_req);
+        if(margo_err != HG_SUCCESS) {
+            GKFS_DATA->spdlogger()->error(
+                    "ChunkReadOperation::{}() Failed to margo_bulk_itransfer with margo err: '{}'",
+                    __func__, margo_err);
+            arg->push_req = MARGO_REQUEST_NULL;
+            int expected = 0;
+            op->io_err_.compare_exchange_strong(expected, EBUSY);
+        }
+    }
+    op->finish_one();
+}
+
+void
+ChunkReadOperation::finish_one() {
+    if(pending_.fetch_sub(1) == 1)
+        ABT_eventual_set(done_eventual_, nullptr, 0);
 }
 
 void
 ChunkReadOperation::clear_task_args() {
+    // in-flight transfers target the bulk buffer and must not outlive it
+    for(auto& task_arg : task_args_) {
+        if(task_arg.push_req != MARGO_REQUEST_NULL) {
+            margo_wait(task_arg.push_req);
+            task_arg.push_req = MARGO_REQUEST_NULL;
+        }
+    }
     task_args_.clear();
 }
 
-ChunkReadOperation::ChunkReadOperation(const string& path, size_t n)
-    : ChunkOperation{path, n} {
+ChunkReadOperation::ChunkReadOperation(const string& path, size_t n,
+                                       const bulk_args& args)
+    : ChunkOperation{path, n}, bulk_args_(args) {
     task_args_.resize(n);
+    for(auto& task_arg : task_args_)
+        task_arg.push_req = MARGO_REQUEST_NULL;
+    // failure is reported by read_nonblock()
+    if(ABT_eventual_create(0, &done_eventual_) != ABT_SUCCESS)
+        done_eventual_ = ABT_EVENTUAL_NULL;
+}
+
+ChunkReadOperation::~ChunkReadOperation() {
+    // tasklets reference the eventual and must be finished before freeing it
+    cancel_all_tasks();
+    if(done_eventual_ != ABT_EVENTUAL_NULL)
+        ABT_eventual_free(&done_eventual_);
 }
 
 /**
@@ -365,13 +423,10 @@ ChunkReadOperation::read_nonblock(size_t idx, const uint64_t chunk_id,
     GKFS_DATA->spdlogger()->trace(
             "ChunkReadOperation::{}() enter: idx '{}' path '{}' size '{}' offset '{}'",
             __func__, idx, path_, size, offset);
-    // sizeof(ssize_t) comes from pread's return type
-    auto abt_err = ABT_eventual_create(
-            sizeof(ssize_t), &task_eventuals_[idx]); // read file return value
-    if(abt_err != ABT_SUCCESS) {
+    if(done_eventual_ == ABT_EVENTUAL_NULL) {
         auto err_str = fmt::format(
-                "ChunkReadOperation::{}() Failed to create ABT eventual with abt_err '{}'",
-                __func__, abt_err);
+                "ChunkReadOperation::{}() Failed to create ABT eventual",
+                __func__);
         throw ChunkReadOpException(err_str);
     }
 
@@ -381,12 +436,16 @@ ChunkReadOperation::read_nonblock(size_t idx, const uint64_t chunk_id,
     task_arg.chnk_id = chunk_id;
     task_arg.size = size;
     task_arg.off = offset;
-    task_arg.eventual = task_eventuals_[idx];
-    task_arg.bulk_transfer_done = false;
-
-    abt_err = ABT_task_create(RPC_DATA->io_pool(), read_file_abt,
-                              &task_args_[idx], &abt_tasks_[idx]);
+    task_arg.idx = idx;
+    task_arg.op = this;
+    task_arg.read = 0;
+    task_arg.push_req = MARGO_REQUEST_NULL;
+
+    pending_++;
+    auto abt_err = ABT_task_create(RPC_DATA->io_pool(), read_file_abt,
+                                   &task_args_[idx], &abt_tasks_[idx]);
     if(abt_err != ABT_SUCCESS) {
+        pending_--;
         auto err_str = fmt::format(
                 "ChunkReadOperation::{}() Failed to create ABT task with abt_err '{}'",
                 __func__, abt_err);
@@ -395,154 +454,43 @@ ChunkReadOperation::read_nonblock(size_t idx, const uint64_t chunk_id,
 }
 
 pair<int, size_t>
-ChunkReadOperation::wait_for_tasks_and_push_back(const bulk_args& args) {
+ChunkReadOperation::wait_for_tasks_and_push_back() {
     GKFS_DATA->spdlogger()->trace("ChunkReadOperation::{}() enter: path '{}'",
                                   __func__, path_);
-    assert(args.chunk_ids->size() == task_args_.size());
+    assert(bulk_args_.chunk_ids->size() == task_args_.size());
     size_t total_read = 0;
-    int io_err = 0;
 
+    // drop the launcher reference and wait for the last tasklet to finish
+    finish_one();
+    auto abt_err = ABT_eventual_wait(done_eventual_, nullptr);
+    if(abt_err != ABT_SUCCESS) {
+        GKFS_DATA->spdlogger()->error(
+                "ChunkReadOperation::{}() Error when waiting on ABT eventual",
+                __func__);
+        int expected = 0;
+        io_err_.compare_exchange_strong(expected, EIO);
+    }
     /*
-     * gather all Eventual's information. do not throw here to properly cleanup
-     * all eventuals As soon as an error is encountered, bulk_transfers will no
-     * longer be executed as the data would be corrupted The loop continues
-     * until all eventuals have been cleaned and freed.
+     * All transfers have been posted by now. Wait for all of them, regardless
+     * of errors, because they target the bulk buffer.
      */
-    // TODO refactor both if/else. They have redundant code.
-    if(gkfs::config::io::spin_lock_read) {
-        uint64_t bulk_transfer_cnt = 0;
-        do {
-            for(uint64_t idx = 0; idx < task_args_.size(); idx++) {
-                if(task_args_[idx].bulk_transfer_done)
-                    continue;
-                ssize_t* task_size = nullptr;
-                int is_ready = 0;
-                auto abt_err = ABT_eventual_test(
-                        task_eventuals_[idx], (void**) &task_size, &is_ready);
-                if(abt_err != ABT_SUCCESS) {
-                    GKFS_DATA->spdlogger()->error(
-                            "ChunkReadOperation::{}() Error when testing on ABT eventual",
-                            __func__);
-                    io_err = EIO;
-                    bulk_transfer_cnt = task_args_.size();
-                    ABT_eventual_free(&task_eventuals_[idx]);
-                    continue;
-                }
-                // not ready yet, try next
-                if(is_ready == ABT_FALSE)
-                    continue;
-                // error occured. stop processing but clean up
-                if(io_err != 0) {
-                    task_args_[idx].bulk_transfer_done = true;
-                    bulk_transfer_cnt++;
-                    ABT_eventual_free(&task_eventuals_[idx]);
-                    continue;
-                }
-                assert(task_size != nullptr);
-                if(*task_size < 0) {
-                    // sparse regions do not have chunk files and are therefore
-                    // skipped
-                    if(-(*task_size) == ENOENT) {
-                        task_args_[idx].bulk_transfer_done = true;
-                        bulk_transfer_cnt++;
-                        ABT_eventual_free(&task_eventuals_[idx]);
-                        continue;
-                    }
-                    io_err = -(*task_size); // make error code > 0
-                } else if(*task_size == 0) {
-                    // read size of 0 is not an error and can happen because
-                    // reading the end-of-file
-                    task_args_[idx].bulk_transfer_done = true;
-                    bulk_transfer_cnt++;
-                    ABT_eventual_free(&task_eventuals_[idx]);
-                    continue;
-                } else {
-                    // successful case, push read data back to client
-                    GKFS_DATA->spdlogger()->trace(
-                            "ChunkReadOperation::{}() BULK_TRANSFER_PUSH file '{}' chnkid '{}' origin offset '{}' local offset '{}' transfersize '{}'",
-                            __func__, path_, args.chunk_ids->at(idx),
-                            args.origin_offsets->at(idx),
-                            args.local_offsets->at(idx), *task_size);
-                    assert(task_args_[idx].chnk_id == args.chunk_ids->at(idx));
-                    auto margo_err = margo_bulk_transfer(
-                            args.mid, HG_BULK_PUSH, args.origin_addr,
-                            args.origin_bulk_handle,
-                            args.origin_offsets->at(idx),
-                            args.local_bulk_handle, args.local_offsets->at(idx),
-                            *task_size);
-                    if(margo_err != HG_SUCCESS) {
-                        GKFS_DATA->spdlogger()->error(
-                                "ChunkReadOperation::{}() Failed to margo_bulk_transfer with margo err: '{}'",
-                                __func__, margo_err);
-                        io_err = EBUSY;
-                        continue;
-                    }
-                    total_read += *task_size;
-                }
-                task_args_[idx].bulk_transfer_done = true;
-                bulk_transfer_cnt++;
-                ABT_eventual_free(&task_eventuals_[idx]);
-            }
-        } while(bulk_transfer_cnt != task_args_.size());
-    } else {
-        for(uint64_t idx = 0; idx < task_args_.size(); idx++) {
-            ssize_t* task_size = nullptr;
-            auto abt_err = ABT_eventual_wait(task_eventuals_[idx],
-                                             (void**) &task_size);
-            if(abt_err != ABT_SUCCESS) {
-                GKFS_DATA->spdlogger()->error(
-                        "ChunkReadOperation::{}() Error when waiting on ABT eventual",
-                        __func__);
-                io_err = EIO;
-                ABT_eventual_free(&task_eventuals_[idx]);
-                continue;
-            }
-            // error occured. stop processing but clean up
-            if(io_err != 0) {
-                ABT_eventual_free(&task_eventuals_[idx]);
-                continue;
-            }
-            assert(task_size != nullptr);
-            if(*task_size < 0) {
-                // sparse regions do not have chunk files and are therefore
-                // skipped
-                if(-(*task_size) == ENOENT) {
-                    ABT_eventual_free(&task_eventuals_[idx]);
-                    continue;
-                }
-                io_err = -(*task_size); // make error code > 0
-            } else if(*task_size == 0) {
-                // read size of 0 is not an error and can happen because reading
-                // the end-of-file
-                ABT_eventual_free(&task_eventuals_[idx]);
-                continue;
-            } else {
-                // successful case, push read data back to client
-                GKFS_DATA->spdlogger()->trace(
-                        "ChunkReadOperation::{}() BULK_TRANSFER_PUSH file '{}' chnkid '{}' origin offset '{}' local offset '{}' transfersize '{}'",
-                        __func__, path_, args.chunk_ids->at(idx),
-                        args.origin_offsets->at(idx),
-                        args.local_offsets->at(idx), *task_size);
-                assert(task_args_[idx].chnk_id == args.chunk_ids->at(idx));
-                auto margo_err = margo_bulk_transfer(
-                        args.mid, HG_BULK_PUSH, args.origin_addr,
-                        args.origin_bulk_handle, args.origin_offsets->at(idx),
-                        args.local_bulk_handle, args.local_offsets->at(idx),
-                        *task_size);
-                if(margo_err != HG_SUCCESS) {
-                    GKFS_DATA->spdlogger()->error(
-                            "ChunkReadOperation::{}() Failed to margo_bulk_transfer with margo err: '{}'",
-                            __func__, margo_err);
-                    io_err = EBUSY;
-                    continue;
-                }
-                total_read += *task_size;
-            }
-            ABT_eventual_free(&task_eventuals_[idx]);
+    for(auto& task_arg : task_args_) {
+        if(task_arg.push_req == MARGO_REQUEST_NULL)
+            continue;
+        auto margo_err = margo_wait(task_arg.push_req);
+        task_arg.push_req = MARGO_REQUEST_NULL;
+        if(margo_err != HG_SUCCESS) {
+            GKFS_DATA->spdlogger()->error(
+                    "ChunkReadOperation::{}() Failed to margo_bulk_transfer with margo err: '{}'",
+                    __func__, margo_err);
+            int expected = 0;
+            io_err_.compare_exchange_strong(expected, EBUSY);
+            continue;
         }
+        total_read += static_cast<size_t>(task_arg.read);
     }
 
-
+    auto io_err = io_err_.load();
     // in case of error set read size to zero as data would be corrupted
     if(io_err != 0)
         total_read = 0;
@@ -0,0 +1,213 @@
+/*
+  Copyright 2018-2024, Barcelona Supercomputing Center (BSC), Spain
+  Copyright 2015-2024, Johannes Gutenberg Universitaet Mainz, Germany
+
+  This software was partially supported by the
+  EC H2020 funded project NEXTGenIO (Project ID: 671951, www.nextgenio.eu).
+
+  This software was partially supported by the
+  ADA-FS project under the SPPEXA project funded by the DFG.
+
+  This file is part of GekkoFS.
+
+  GekkoFS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GekkoFS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GekkoFS.  If not, see <https://www.gnu.org/licenses/>.
+
+  SPDX-License-Identifier: GPL-3.0-or-later
+*/
+/**
+ * @brief Definitions of the daemon's metadata cache.
+ */
+
+#include <daemon/ops/metadata_cache.hpp>
+#include <common/statistics/stats.hpp>
+#include <config.hpp>
+
+#include <algorithm>
+#include <ctime>
+#include <iterator>
+
+using namespace std;
+
+namespace gkfs::metadata {
+
+MetadataCache::shard&
+MetadataCache::shard_for(const string& path) const {
+    return shards_[std::hash<string>{}(path) % shard_count_];
+}
+
+void
+MetadataCache::insert_locked(shard& s, const string& path,
+                             const Metadata& md) {
+    auto it = s.index.find(path);
+    if(it != s.index.end()) {
+        it->second->second = md;
+        s.lru.splice(s.lru.begin(), s.lru, it->second);
+        return;
+    }
+    s.lru.emplace_front(path, md);
+    s.index.emplace(s.lru.front().first, s.lru.begin());
+    if(s.lru.size() > shard_capacity_) {
+        erase_locked(s, std::prev(s.lru.end())->first);
+    }
+}
+
+void
+MetadataCache::erase_locked(shard& s, const string& path) {
+    auto it = s.index.find(path);
+    if(it == s.index.end())
+        return;
+    auto lru_it = it->second;
+    // the index key refers to the list entry, so erase it first
+    s.index.erase(it);
+    s.lru.erase(lru_it);
+}
+
+MetadataCache::MetadataCache(size_t capacity, size_t shard_count,
+                             shared_ptr<gkfs::utils::Stats> stats)
+    : shards_(make_unique<shard[]>(shard_count > 0 ? shard_count : 1)),
+      shard_count_(shard_count > 0 ? shard_count : 1),
+      shard_capacity_(std::max<size_t>(1, capacity / shard_count_)),
+      stats_(std::move(stats)) {}
+
+bool
+MetadataCache::get(const string& path, Metadata& md, uint64_t& epoch) {
+    using gkfs::utils::Stats;
+    auto& s = shard_for(path);
+    bool hit = false;
+    {
+        lock_guard<mutex> lock(s.mtx);
+        epoch = s.epoch;
+        auto it = s.index.find(path);
+        if(it != s.index.end()) {
+            // move to front of the LRU list
+            s.lru.splice(s.lru.begin(), s.lru, it->second);
+            md = it->second->second;
+            hit = true;
+        }
+    }
+    if(hit)
+        hits_.fetch_add(1, memory_order_relaxed);
+    else
+        misses_.fetch_add(1, memory_order_relaxed);
+    if(stats_)
+        stats_->add_value_cache(hit ? Stats::CacheOp::metadata_hit
+                                    : Stats::CacheOp::metadata_miss);
+    return hit;
+}
+
+uint64_t
+MetadataCache::epoch(const string& path) {
+    auto& s = shard_for(path);
+    lock_guard<mutex> lock(s.mtx);
+    return s.epoch;
+}
+
+void
+MetadataCache::fill(const string& path, const Metadata& md, uint64_t epoch) {
+    auto& s = shard_for(path);
+    lock_guard<mutex> lock(s.mtx);
+    // modified while we were reading from the backend. Don't cache
+    if(s.epoch != epoch)
+        return;
+    insert_locked(s, path, md);
+}
+
+void
+MetadataCache::put(const string& path, const Metadata& md, uint64_t epoch) {
+    auto& s = shard_for(path);
+    lock_guard<mutex> lock(s.mtx);
+    if(s.epoch != epoch) {
+        erase_locked(s, path);
+    } else {
+        insert_locked(s, path, md);
+    }
+    s.epoch++;
+}
+
+void
+MetadataCache::update(const string& path, uint64_t epoch,
+                      const function<void(Metadata&)>& modify) {
+    auto& s = shard_for(path);
+    lock_guard<mutex> lock(s.mtx);
+    if(s.epoch != epoch) {
+        erase_locked(s, path);
+    } else {
+        auto it = s.index.find(path);
+        if(it != s.index.end())
+            modify(it->second->second);
+    }
+    s.epoch++;
+}
+
+void
+MetadataCache::increase_size(const string& path, uint64_t epoch,
+                             size_t io_size, off_t offset, bool append,
+                             off_t start) {
+    if(append && start < 0) {
+        erase(path);
+        return;
+    }
+    // mirror the backend's merge operands
+    update(path, epoch, [&](Metadata& md) {
+        if(append) {
+            md.size(static_cast<size_t>(start) + io_size);
+        } else {
+            md.size(std::max(md.size(), static_cast<size_t>(offset) + io_size));
+            if constexpr(gkfs::config::metadata::use_mtime) {
+                md.mtime(std::time(nullptr));
+            }
+        }
+    });
+}
+
+void
+MetadataCache::decrease_size(const string& path, uint64_t epoch, size_t size) {
+    update(path, epoch, [&](Metadata& md) {
+        md.size(size);
+        if constexpr(gkfs::config::metadata::use_mtime) {
+            md.mtime(std::time(nullptr));
+        }
+    });
+}
+
+void
+MetadataCache::erase(const string& path) {
+    auto& s = shard_for(path);
+    lock_guard<mutex> lock(s.mtx);
+    erase_locked(s, path);
+    s.epoch++;
+}
+
+void
+MetadataCache::clear() {
+    for(size_t i = 0; i < shard_count_; i++) {
+        auto& s = shards_[i];
+        lock_guard<mutex> lock(s.mtx);
+        s.epoch++;
+        s.index.clear();
+        s.lru.clear();
+    }
+}
+
+uint64_t
+MetadataCache::hits() const {
+    return hits_.load(memory_order_relaxed);
+}
+
+uint64_t
+MetadataCache::misses() const {
+    return misses_.load(memory_order_relaxed);
+}
+
+} // namespace gkfs::metadata
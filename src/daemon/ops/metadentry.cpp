@@ -30,14 +30,111 @@
 #include <daemon/backend/metadata/db.hpp>
 #include <daemon/backend/data/chunk_storage.hpp>
 #include <daemon/backend/metadata/metadata_module.hpp>
+#include <daemon/ops/metadata_cache.hpp>
+
+#include <array>
+#include <mutex>
+#include <set>
+#include <unordered_set>
 
 using namespace std;
 
 namespace gkfs::metadata {
 
+namespace {
+
+/**
+ * @internal
+ * Returns the shard epoch of the metadata cache that must be taken before a
+ * backend modification, 0 if the cache is disabled.
+ * @endinternal
+ */
+uint64_t
+cache_epoch(const std::string& path) {
+    const auto& cache = GKFS_DATA->metadata_cache();
+    return cache ? cache->epoch(path) : 0;
+}
+
+/**
+ * @internal
+ * Sets the timestamps of a new metadentry based on what metadata is needed
+ * @endinternal
+ */
+void
+init_times(Metadata& md) {
+    if(GKFS_DATA->atime_state() || GKFS_DATA->mtime_state() ||
+       GKFS_DATA->ctime_state()) {
+        std::time_t time;
+        std::time(&time);
+        if(GKFS_DATA->atime_state())
+            md.atime(time);
+        if(GKFS_DATA->mtime_state())
+            md.mtime(time);
+        if(GKFS_DATA->ctime_state())
+            md.ctime(time);
+    }
+}
+
+/*
+ * Creates of the same path must not interleave their existence check and
+ * their put. Paths map to a fixed set of locks, which a batch create takes in
+ * ascending order.
+ */
+constexpr size_t create_lock_n = 64;
+std::array<std::mutex, create_lock_n> create_locks;
+
+size_t
+create_lock_idx(const std::string& path) {
+    return std::hash<std::string>{}(path) % create_lock_n;
+}
+
+} // namespace
+
 Metadata
 get(const std::string& path) {
-    return Metadata(get_str(path));
+    const auto& cache = GKFS_DATA->metadata_cache();
+    if(!cache)
+        return Metadata(get_str(path));
+    Metadata md{};
+    uint64_t epoch;
+    if(cache->get(path, md, epoch))
+        return md;
+    md = Metadata(get_str(path));
+    cache->fill(path, md, epoch);
+    return md;
+}
+
+std::vector<std::optional<Metadata>>
+get_batch(const std::vector<std::string>& paths) {
+    std::vector<std::optional<Metadata>> mds(paths.size());
+    const auto& cache = GKFS_DATA->metadata_cache();
+    // collect cache misses and read them with one backend request
+    std::vector<size_t> miss_idx;
+    std::vector<std::string> miss_paths;
+    std::vector<uint64_t> miss_epochs;
+    for(size_t i = 0; i < paths.size(); ++i) {
+        Metadata md{};
+        uint64_t epoch = 0;
+        if(cache && cache->get(paths[i], md, epoch)) {
+            mds[i] = std::move(md);
+            continue;
+        }
+        miss_idx.push_back(i);
+        miss_paths.push_back(paths[i]);
+        miss_epochs.push_back(epoch);
+    }
+    if(miss_paths.empty())
+        return mds;
+    auto vals = GKFS_DATA->mdb()->get_batch(miss_paths);
+    for(size_t i = 0; i < miss_idx.size(); ++i) {
+        if(!vals[i])
+            continue;
+        Metadata md(*vals[i]);
+        if(cache)
+            cache->fill(miss_paths[i], md, miss_epochs[i]);
+        mds[miss_idx[i]] = std::move(md);
+    }
+    return mds;
 }
 
 std::string
@@ -55,6 +152,12 @@ get_dirents(const std::string& dir) {
     return GKFS_DATA->mdb()->get_dirents(dir);
 }
 
+std::vector<std::pair<std::string, bool>>
+get_dirents_page(const std::string& dir, const std::string& start_key,
+                 size_t max_entries) {
+    return GKFS_DATA->mdb()->get_dirents_page(dir, start_key, max_entries);
+}
+
 std::vector<std::tuple<std::string, bool, size_t, time_t>>
 get_dirents_extended(const std::string& dir) {
     return GKFS_DATA->mdb()->get_dirents_extended(dir);
@@ -64,28 +167,103 @@ void
 create(const std::string& path, Metadata& md) {
 
     // update metadata object based on what metadata is needed
-    if(GKFS_DATA->atime_state() || GKFS_DATA->mtime_state() ||
-       GKFS_DATA->ctime_state()) {
-        std::time_t time;
-        std::time(&time);
-        auto time_s = fmt::format_int(time).str();
-        if(GKFS_DATA->atime_state())
-            md.atime(time);
-        if(GKFS_DATA->mtime_state())
-            md.mtime(time);
-        if(GKFS_DATA->ctime_state())
-            md.ctime(time);
-    }
+    init_times(md);
+    auto epoch = cache_epoch(path);
     if constexpr(gkfs::config::metadata::create_exist_check) {
+        std::lock_guard<std::mutex> lock(create_locks[create_lock_idx(path)]);
         GKFS_DATA->mdb()->put_no_exist(path, md.serialize());
     } else {
         GKFS_DATA->mdb()->put(path, md.serialize());
     }
+    if(GKFS_DATA->metadata_cache())
+        GKFS_DATA->metadata_cache()->put(path, md, epoch);
+}
+
+std::vector<int>
+create_batch(const std::vector<std::string>& paths, mode_t mode) {
+    std::vector<int> errs(paths.size(), 0);
+    Metadata md(mode);
+    init_times(md);
+    const auto val = md.serialize();
+
+    std::vector<std::optional<std::string>> existing(paths.size());
+    // held until the batch is written so that no create slips in between
+    std::vector<std::unique_lock<std::mutex>> locks;
+    if constexpr(gkfs::config::metadata::create_exist_check) {
+        std::set<size_t> lock_idxs;
+        for(const auto& path : paths)
+            lock_idxs.insert(create_lock_idx(path));
+        for(auto idx : lock_idxs)
+            locks.emplace_back(create_locks[idx]);
+        existing = GKFS_DATA->mdb()->get_batch(paths);
+    }
+    std::unordered_set<std::string_view> seen;
+    std::vector<std::pair<std::string, std::string>> kvs;
+    std::vector<uint64_t> epochs;
+    kvs.reserve(paths.size());
+    epochs.reserve(paths.size());
+    for(size_t i = 0; i < paths.size(); ++i) {
+        // a path listed twice is created by its first occurrence
+        if(existing[i] || !seen.insert(paths[i]).second) {
+            errs[i] = EEXIST;
+            continue;
+        }
+        epochs.push_back(cache_epoch(paths[i]));
+        kvs.emplace_back(paths[i], val);
+    }
+    if(kvs.empty())
+        return errs;
+    GKFS_DATA->mdb()->put_batch(kvs);
+    if(GKFS_DATA->metadata_cache()) {
+        for(size_t i = 0; i < kvs.size(); ++i)
+            GKFS_DATA->metadata_cache()->put(kvs[i].first, md, epochs[i]);
+    }
+    return errs;
+}
+
+std::pair<bool, size_t>
+open_or_create(const std::string& path, Metadata& md, bool create, bool excl,
+               bool trunc) {
+    try {
+        md = get(path);
+    } catch(const NotFoundException& e) {
+        if(!create)
+            throw;
+        try {
+            gkfs::metadata::create(path, md);
+            return {true, 0};
+        } catch(const ExistsException& e) {
+            // created concurrently by another client
+            if(excl)
+                throw;
+            md = get(path);
+        }
+    }
+    if(excl)
+        throw ExistsException(path);
+    if(!trunc || !S_ISREG(md.mode()) || md.size() == 0)
+        return {false, 0};
+#ifdef HAS_SYMLINKS
+    // the client resolves links and renamed files before truncating them
+    if(!md.target_path().empty())
+        return {false, 0};
+#ifdef HAS_RENAME
+    if(md.blocks() == -1)
+        return {false, 0};
+#endif // HAS_RENAME
+#endif // HAS_SYMLINKS
+    const auto old_size = md.size();
+    decrease_size(path, 0);
+    md.size(0);
+    return {false, old_size};
 }
 
 void
 update(const string& path, Metadata& md) {
+    auto epoch = cache_epoch(path);
     GKFS_DATA->mdb()->update(path, path, md.serialize());
+    if(GKFS_DATA->metadata_cache())
+        GKFS_DATA->metadata_cache()->put(path, md, epoch);
 }
 
 /**
@@ -100,7 +278,20 @@ update(const string& path, Metadata& md) {
  */
 off_t
 update_size(const string& path, size_t io_size, off64_t offset, bool append) {
-    return GKFS_DATA->mdb()->increase_size(path, io_size, offset, append);
+    auto epoch = cache_epoch(path);
+    auto ret = GKFS_DATA->mdb()->increase_size(path, io_size, offset, append);
+    if(GKFS_DATA->metadata_cache())
+        GKFS_DATA->metadata_cache()->increase_size(path, epoch, io_size, offset,
+                                                   append, ret);
+    return ret;
+}
+
+void
+decrease_size(const string& path, size_t size) {
+    auto epoch = cache_epoch(path);
+    GKFS_DATA->mdb()->decrease_size(path, size);
+    if(GKFS_DATA->metadata_cache())
+        GKFS_DATA->metadata_cache()->decrease_size(path, epoch, size);
 }
 
 void
@@ -114,6 +305,17 @@ remove(const string& path) {
         GKFS_DATA->mdb()->remove(path); // remove metadata from KV store
     } catch(const NotFoundException& e) {
     }
+    if(GKFS_DATA->metadata_cache())
+        GKFS_DATA->metadata_cache()->erase(path);
+}
+
+void
+remove_batch(const std::vector<std::string>& paths) {
+    GKFS_DATA->mdb()->remove_batch(paths);
+    if(GKFS_DATA->metadata_cache()) {
+        for(const auto& path : paths)
+            GKFS_DATA->metadata_cache()->erase(path);
+    }
 }
 
 } // namespace gkfs::metadata
\ No newline at end of file
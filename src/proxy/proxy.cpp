@@ -35,6 +35,7 @@ struct cli_options {
     string hosts_file;
     string proxy_protocol;
     string pid_path;
+    string distributor;
 };
 
 void
@@ -189,7 +190,8 @@ init_rpc_client(const string& protocol) {
 }
 
 void
-init_environment(const string& hostfile_path, const string& rpc_protocol) {
+init_environment(const string& hostfile_path, const string& rpc_protocol,
+                 const string& distributor_type) {
     // Check if host file exists before doing anything
     if(!gkfs::util::check_for_hosts_file(hostfile_path))
         throw runtime_error(fmt::format(
@@ -255,16 +257,24 @@ init_environment(const string& hostfile_path, const string& rpc_protocol) {
         throw runtime_error(err_msg);
     }
 
-    // Setup SimpleDistributor
+    // Setup distributor
     PROXY_DATA->log()->info(
-            "{}() Setting up simple hash distributor with local_host_id '{}' #hosts '{}'...",
-            __func__, PROXY_DATA->local_host_id(),
+            "{}() Setting up '{}' distributor with local_host_id '{}' #hosts '{}'...",
+            __func__, distributor_type, PROXY_DATA->local_host_id(),
             PROXY_DATA->rpc_endpoints().size());
     // TODO this needs to be globally configured because client must have same
-    // distribution
-    auto simple_hash_dist = std::make_shared<gkfs::rpc::SimpleHashDistributor>(
-            PROXY_DATA->local_host_id(), PROXY_DATA->rpc_endpoints().size());
-    PROXY_DATA->distributor(simple_hash_dist);
+    // distribution. Must match the daemons' `--distributor` for now.
+    std::shared_ptr<gkfs::rpc::Distributor> distributor;
+    if(distributor_type == gkfs::rpc::jump_hash_distributor) {
+        distributor = std::make_shared<gkfs::rpc::JumpHashDistributor>(
+                PROXY_DATA->local_host_id(),
+                PROXY_DATA->rpc_endpoints().size());
+    } else {
+        distributor = std::make_shared<gkfs::rpc::SimpleHashDistributor>(
+                PROXY_DATA->local_host_id(),
+                PROXY_DATA->rpc_endpoints().size());
+    }
+    PROXY_DATA->distributor(distributor);
 
     PROXY_DATA->log()->info("Startup successful. Proxy is ready.");
 }
@@ -340,6 +350,8 @@ main(int argc, const char* argv[]) {
                     "Used protocol between proxy and daemon communication. Choose between: ofi+sockets, ofi+psm2, ofi+verbs. Default: ofi+sockets");
     desc.add_option("--pid-path,-P", opts.pid_path,
                     "Path to PID file where daemon registers itself for clients. Default: /tmp/gkfs_proxy.pid");
+    desc.add_option("--distributor", opts.distributor,
+                    "Placement of data on the daemons. Must match the daemons' `--distributor`. Choose between: simplehash, jumphash. Default: simplehash");
     // clang-format on
     try {
         desc.parse(argc, argv);
@@ -361,10 +373,22 @@ main(int argc, const char* argv[]) {
     if(desc.count("--pid-path")) {
         PROXY_DATA->pid_file_path(opts.pid_path);
     }
+    string distributor = gkfs::rpc::simple_hash_distributor;
+    if(desc.count("--distributor")) {
+        distributor = opts.distributor;
+        if(distributor != gkfs::rpc::simple_hash_distributor &&
+           distributor != gkfs::rpc::jump_hash_distributor) {
+            cerr << fmt::format(
+                            "Distributor '{}' is not valid. Consult `--help`",
+                            distributor)
+                 << endl;
+            return EXIT_FAILURE;
+        }
+    }
 
     PROXY_DATA->log()->info("{}() Initializing environment", __func__);
     try {
-        init_environment(hosts_file, proxy_protocol);
+        init_environment(hosts_file, proxy_protocol, distributor);
     } catch(const std::exception& e) {
         auto emsg =
                 fmt::format("Failed to initialize environment: {}", e.what());
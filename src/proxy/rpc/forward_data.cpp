@@ -57,8 +57,11 @@ forward_write(const std::string& path, void* buf, const int64_t offset,
     uint64_t chnk_start_target = 0;
     uint64_t chnk_end_target = 0;
 
+    // the path is hashed once for all chunks
+    auto path_hash = gkfs::rpc::hash_path(path);
     for(uint64_t chnk_id = chnk_start; chnk_id <= chnk_end; chnk_id++) {
-        auto target = PROXY_DATA->distributor()->locate_data(path, chnk_id, 0);
+        auto target = PROXY_DATA->distributor()->locate_data_hashed(
+                path, path_hash, chnk_id, 0);
 
         if(target_chnks.count(target) == 0) {
             target_chnks.insert(
@@ -217,8 +220,11 @@ forward_read(const std::string& path, void* buf, const int64_t offset,
     uint64_t chnk_start_target = 0;
     uint64_t chnk_end_target = 0;
 
+    // the path is hashed once for all chunks
+    auto path_hash = gkfs::rpc::hash_path(path);
     for(uint64_t chnk_id = chnk_start; chnk_id <= chnk_end; chnk_id++) {
-        auto target = PROXY_DATA->distributor()->locate_data(path, chnk_id, 0);
+        auto target = PROXY_DATA->distributor()->locate_data_hashed(
+                path, path_hash, chnk_id, 0);
 
         if(target_chnks.count(target) == 0) {
             target_chnks.insert(
@@ -367,9 +373,11 @@ forward_truncate(const std::string& path, size_t current_size,
                                                gkfs::config::rpc::chunksize);
 
     std::unordered_set<unsigned int> hosts;
+    auto path_hash = gkfs::rpc::hash_path(path);
     for(unsigned int chunk_id = chunk_start; chunk_id <= chunk_end;
         ++chunk_id) {
-        hosts.insert(PROXY_DATA->distributor()->locate_data(path, chunk_id, 0));
+        hosts.insert(PROXY_DATA->distributor()->locate_data_hashed(
+                path, path_hash, chunk_id, 0));
     }
     // some helper variables for async RPC
     vector<hg_handle_t> rpc_handles(hosts.size());
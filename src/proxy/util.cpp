@@ -24,6 +24,7 @@
 #include <random>
 #include <fstream>
 #include <thread>
+#include <mutex>
 
 extern "C" {
 #include <unistd.h>
@@ -178,6 +179,16 @@ connect_to_hosts(const vector<pair<string, string>>& hosts) {
     bool local_host_found = false;
 
     PROXY_DATA->hosts_size(hosts.size());
+    for(uint64_t id = 0; id < hosts.size(); id++) {
+        if(hosts[id].first == local_hostname) {
+            PROXY_DATA->log()->debug("{}() Found local host: {}", __func__,
+                                     local_hostname);
+            PROXY_DATA->local_host_id(id);
+            local_host_found = true;
+            break;
+        }
+    }
+
     vector<uint64_t> host_ids(hosts.size());
     // populate vector with [0, ..., host_size - 1]
     ::iota(::begin(host_ids), ::end(host_ids), 0);
@@ -191,51 +202,51 @@ connect_to_hosts(const vector<pair<string, string>>& hosts) {
     ::mt19937 g(rd());  // seed the random generator
     ::shuffle(host_ids.begin(), host_ids.end(), g); // Shuffle hosts vector
     // lookup addresses and put abstract server addresses into rpc_addresses
-    for(const auto& id : host_ids) {
-        const auto& hostname = hosts.at(id).first;
-        const auto& uri = hosts.at(id).second;
-
-        hg_addr_t svr_addr = HG_ADDR_NULL;
-
-        // try to look up 3 times before erroring out
-        hg_return_t ret;
-        for(uint32_t i = 0; i < 4; i++) {
-            ret = margo_addr_lookup(PROXY_DATA->client_rpc_mid(), uri.c_str(),
-                                    &svr_addr);
-            if(ret != HG_SUCCESS) {
-                // still not working after 5 tries.
-                if(i == 4) {
-                    auto err_msg =
-                            fmt::format("{}() Unable to lookup address '{}'",
-                                        __func__, uri);
+    mutex endpoints_mutex;
+    gkfs::rpc::for_each_concurrently(
+            host_ids, gkfs::config::rpc::host_lookup_concurrency,
+            [&](uint64_t id) {
+                const auto& uri = hosts.at(id).second;
+
+                hg_addr_t svr_addr = HG_ADDR_NULL;
+
+                // try to look up 3 times before erroring out
+                hg_return_t ret;
+                for(uint32_t i = 0; i < 4; i++) {
+                    ret = margo_addr_lookup(PROXY_DATA->client_rpc_mid(),
+                                            uri.c_str(), &svr_addr);
+                    if(ret != HG_SUCCESS) {
+                        // still not working after 5 tries.
+                        if(i == 4) {
+                            auto err_msg = fmt::format(
+                                    "{}() Unable to lookup address '{}'",
+                                    __func__, uri);
+                            throw runtime_error(err_msg);
+                        }
+                        // Wait a random amount of time and try again
+                        ::mt19937 eng(::random_device{}()); // seed the random
+                                                            // generator
+                        ::uniform_int_distribution<> distr(
+                                50, 50 * (i + 2)); // define the range
+                        ::this_thread::sleep_for(
+                                std::chrono::milliseconds(distr(eng)));
+                    } else {
+                        break;
+                    }
+                }
+                if(svr_addr == HG_ADDR_NULL) {
+                    auto err_msg = fmt::format(
+                            "{}() looked up address is NULL for address '{}'",
+                            __func__, uri);
                     throw runtime_error(err_msg);
                 }
-                // Wait a random amount of time and try again
-                ::mt19937 eng(rd()); // seed the random generator
-                ::uniform_int_distribution<> distr(
-                        50, 50 * (i + 2)); // define the range
-                ::this_thread::sleep_for(std::chrono::milliseconds(distr(eng)));
-            } else {
-                break;
-            }
-        }
-        if(svr_addr == HG_ADDR_NULL) {
-            auto err_msg = fmt::format(
-                    "{}() looked up address is NULL for address '{}'", __func__,
-                    uri);
-            throw runtime_error(err_msg);
-        }
-        PROXY_DATA->rpc_endpoints().insert(make_pair(id, svr_addr));
-
-        if(!local_host_found && hostname == local_hostname) {
-            PROXY_DATA->log()->debug("{}() Found local host: {}", __func__,
-                                     hostname);
-            PROXY_DATA->local_host_id(id);
-            local_host_found = true;
-        }
-        PROXY_DATA->log()->debug("{}() Found daemon: id '{}' uri '{}'",
-                                 __func__, id, uri);
-    }
+                {
+                    lock_guard<mutex> lock(endpoints_mutex);
+                    PROXY_DATA->rpc_endpoints().insert(make_pair(id, svr_addr));
+                }
+                PROXY_DATA->log()->debug("{}() Found daemon: id '{}' uri '{}'",
+                                         __func__, id, uri);
+            });
 
     if(!local_host_found) {
         PROXY_DATA->log()->warn(
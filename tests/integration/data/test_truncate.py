@@ -158,3 +158,29 @@ def test_fail_truncate(gkfs_daemon, gkfs_client):
     assert ret.statbuf.st_size == buf_length+1
 
 
+
+
+def test_open_truncate(gkfs_daemon, gkfs_client):
+    """Testing open with O_TRUNC and O_CREAT on an existing file:
+    1. create a file over multiple chunks
+    2. open it with O_CREAT | O_TRUNC and check that it is empty
+    3. open it with O_CREAT | O_EXCL and check that it fails
+    """
+    truncfile = gkfs_daemon.mountdir / "open_trunc_file"
+
+    ret = gkfs_client.open(truncfile, os.O_CREAT | os.O_WRONLY, stat.S_IRWXU | stat.S_IRWXG | stat.S_IRWXO)
+    assert ret.retval != -1
+
+    buf_length = 2097152
+    ret = gkfs_client.write_random(truncfile, buf_length)
+    assert ret.retval == buf_length
+
+    ret = gkfs_client.open(truncfile, os.O_CREAT | os.O_TRUNC | os.O_WRONLY, stat.S_IRWXU | stat.S_IRWXG | stat.S_IRWXO)
+    assert ret.retval != -1
+
+    ret = gkfs_client.stat(truncfile)
+    assert ret.statbuf.st_size == 0
+
+    ret = gkfs_client.open(truncfile, os.O_CREAT | os.O_EXCL | os.O_WRONLY, stat.S_IRWXU | stat.S_IRWXG | stat.S_IRWXO)
+    assert ret.retval == -1
+    assert ret.errno == errno.EEXIST
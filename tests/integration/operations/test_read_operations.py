@@ -162,4 +162,38 @@ def test_preadv(gkfs_daemon, gkfs_client):
 
     assert ret.buf_0 == buf_0
     assert ret.buf_1 == buf_1
-    assert ret.retval == len(buf_0) + len(buf_1) # Return the number of read bytes
\ No newline at end of file
+    assert ret.retval == len(buf_0) + len(buf_1) # Return the number of read bytes
+
+
+def test_preadv_chunk_boundary(gkfs_daemon, gkfs_client):
+
+    file = gkfs_daemon.mountdir / "file"
+
+    # create a file in gekkofs
+    ret = gkfs_client.open(file,
+                           os.O_CREAT | os.O_WRONLY,
+                           stat.S_IRWXU | stat.S_IRWXG | stat.S_IRWXO)
+
+    assert ret.retval == 10000
+
+    # the segments are sent as one write that spans two chunks (512 KiB)
+    offset = 524288 - 3
+    buf_0 = b'4242'
+    buf_1 = b'2424'
+    ret = gkfs_client.pwritev(file, buf_0, buf_1, 2, offset)
+
+    assert ret.retval == len(buf_0) + len(buf_1) # Return the number of written bytes
+
+    # open the file to read
+    ret = gkfs_client.open(file,
+                           os.O_RDONLY,
+                           stat.S_IRWXU | stat.S_IRWXG | stat.S_IRWXO)
+
+    assert ret.retval == 10000
+
+    # read the file with differently sized segments
+    ret = gkfs_client.preadv(file, 3, 5, offset)
+
+    assert ret.buf_0 == b'424'
+    assert ret.buf_1 == b'22424'
+    assert ret.retval == len(buf_0) + len(buf_1) # Return the number of read bytes
@@ -0,0 +1,172 @@
+/*
+  Copyright 2018-2024, Barcelona Supercomputing Center (BSC), Spain
+  Copyright 2015-2024, Johannes Gutenberg Universitaet Mainz, Germany
+
+  This software was partially supported by the
+  EC H2020 funded project NEXTGenIO (Project ID: 671951, www.nextgenio.eu).
+
+  This software was partially supported by the
+  ADA-FS project under the SPPEXA project funded by the DFG.
+
+  This file is part of GekkoFS.
+
+  GekkoFS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GekkoFS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GekkoFS.  If not, see <https://www.gnu.org/licenses/>.
+
+  SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+
+#include <catch2/catch.hpp>
+#include <daemon/classes/bulk_buffer_pool.hpp>
+#include <common/common_defs.hpp>
+
+#include <utility>
+
+using gkfs::daemon::BulkBufferPool;
+
+namespace {
+
+constexpr size_t chunksize = 4096;
+
+/**
+ * Bulk handles need a margo instance. The shared memory transport does not
+ * need a network.
+ */
+margo_instance_id
+init_margo() {
+    struct margo_init_info args = {nullptr};
+    return margo_init_ext(gkfs::rpc::protocol::na_sm, MARGO_SERVER_MODE,
+                          &args);
+}
+
+} // namespace
+
+SCENARIO(" bulk buffers are reused after they are returned ",
+         "[bulk_buffer_pool]") {
+
+    auto mid = init_margo();
+    REQUIRE(mid != MARGO_INSTANCE_NULL);
+
+    GIVEN(" a pool with three size classes ") {
+        // classes of 4, 8 and 16 KiB
+        BulkBufferPool pool(mid, chunksize, 3, 4 * chunksize);
+
+        WHEN(" a buffer is borrowed ") {
+            void* data;
+            {
+                auto buf = pool.acquire(100);
+                REQUIRE(buf.valid());
+                REQUIRE(buf.pooled());
+                data = buf.data();
+
+                THEN(" its size class is lent out ") {
+                    REQUIRE(pool.allocated_size() == chunksize);
+                    REQUIRE(pool.used_size() == chunksize);
+                }
+            }
+
+            THEN(" it is returned when it goes out of scope ") {
+                REQUIRE(pool.used_size() == 0);
+                REQUIRE(pool.allocated_size() == chunksize);
+            }
+
+            THEN(" the next request of its size class gets the same buffer ") {
+                auto buf = pool.acquire(chunksize);
+                REQUIRE(buf.data() == data);
+                REQUIRE(pool.allocated_size() == chunksize);
+            }
+
+            THEN(" a request of another size class gets a new buffer ") {
+                auto buf = pool.acquire(chunksize + 1);
+                REQUIRE(buf.pooled());
+                REQUIRE(pool.allocated_size() == 3 * chunksize);
+            }
+        }
+
+        WHEN(" a borrowed buffer is moved ") {
+            auto buf = pool.acquire(100);
+            auto moved = std::move(buf);
+
+            THEN(" it is returned only once ") {
+                REQUIRE(!buf.valid());
+                REQUIRE(moved.valid());
+                moved = BulkBufferPool::Buffer{};
+                REQUIRE(pool.used_size() == 0);
+                REQUIRE(pool.allocated_size() == chunksize);
+            }
+        }
+    }
+
+    margo_finalize(mid);
+}
+
+SCENARIO(" the bulk buffer pool stays within its memory cap ",
+         "[bulk_buffer_pool]") {
+
+    auto mid = init_margo();
+    REQUIRE(mid != MARGO_INSTANCE_NULL);
+
+    GIVEN(" a pool with idle buffers of the two smaller size classes ") {
+        BulkBufferPool pool(mid, chunksize, 3, 4 * chunksize);
+        {
+            auto small = pool.acquire(chunksize);
+            auto medium = pool.acquire(2 * chunksize);
+        }
+        REQUIRE(pool.allocated_size() == 3 * chunksize);
+        REQUIRE(pool.used_size() == 0);
+
+        WHEN(" a buffer of the largest size class is borrowed ") {
+            auto large = pool.acquire(4 * chunksize);
+
+            THEN(" the idle buffers are released to make room ") {
+                REQUIRE(large.pooled());
+                REQUIRE(pool.allocated_size() == 4 * chunksize);
+                REQUIRE(pool.used_size() == 4 * chunksize);
+            }
+
+            THEN(" further requests fall back to per-request buffers ") {
+                {
+                    auto fallback = pool.acquire(100);
+                    REQUIRE(fallback.valid());
+                    REQUIRE(!fallback.pooled());
+                }
+                REQUIRE(pool.allocated_size() == 4 * chunksize);
+                REQUIRE(pool.used_size() == 4 * chunksize);
+            }
+        }
+
+        WHEN(" a request exceeds the largest size class ") {
+            auto buf = pool.acquire(4 * chunksize + 1);
+
+            THEN(" it gets a per-request buffer ") {
+                REQUIRE(buf.valid());
+                REQUIRE(!buf.pooled());
+                REQUIRE(pool.allocated_size() == 3 * chunksize);
+            }
+        }
+    }
+
+    GIVEN(" a pool without memory ") {
+        BulkBufferPool pool(mid, chunksize, 3, 0);
+
+        THEN(" all requests get per-request buffers ") {
+            auto buf = pool.acquire(100);
+            REQUIRE(buf.valid());
+            REQUIRE(!buf.pooled());
+            REQUIRE(pool.allocated_size() == 0);
+        }
+    }
+
+    margo_finalize(mid);
+}
@@ -0,0 +1,325 @@
+/*
+  Copyright 2018-2024, Barcelona Supercomputing Center (BSC), Spain
+  Copyright 2015-2024, Johannes Gutenberg Universitaet Mainz, Germany
+
+  This software was partially supported by the
+  EC H2020 funded project NEXTGenIO (Project ID: 671951, www.nextgenio.eu).
+
+  This software was partially supported by the
+  ADA-FS project under the SPPEXA project funded by the DFG.
+
+  This file is part of GekkoFS.
+
+  GekkoFS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GekkoFS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GekkoFS.  If not, see <https://www.gnu.org/licenses/>.
+
+  SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+
+#include <catch2/catch.hpp>
+#include <client/cache.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+using gkfs::cache::file::ChunkCache;
+
+namespace {
+
+constexpr size_t chunk_size = 16;
+
+/**
+ * A file on the daemons. Like the daemons, a read copies the stored bytes of
+ * each chunk to their position in the buffer and returns the summed size.
+ * Chunks that were never written are not stored.
+ */
+struct FakeFile {
+    std::map<uint64_t, std::string> chunks;
+    size_t fetches{0};
+    off64_t last_offset{-1};
+    size_t last_count{0};
+
+    std::pair<int, long>
+    fetch(char* buf, off64_t offset, size_t count) {
+        fetches++;
+        last_offset = offset;
+        last_count = count;
+        long read = 0;
+        for(auto& [chunk_id, data] : chunks) {
+            auto chunk_offset = static_cast<off64_t>(chunk_id * chunk_size);
+            auto start = std::max(offset, chunk_offset);
+            auto end = std::min(offset + static_cast<off64_t>(count),
+                                chunk_offset +
+                                        static_cast<off64_t>(data.size()));
+            if(start < end) {
+                memcpy(buf + (start - offset),
+                       data.data() + (start - chunk_offset), end - start);
+                read += end - start;
+            }
+        }
+        return {0, read};
+    }
+
+    ChunkCache::fetch_fn
+    fetch_fn() {
+        return [this](char* buf, off64_t offset, size_t count) {
+            return fetch(buf, offset, count);
+        };
+    }
+};
+
+/**
+ * Reads through the cache and returns the read bytes
+ */
+std::string
+read(ChunkCache& cache, FakeFile& file, off64_t offset, size_t count) {
+    std::string buf(count, '?');
+    auto ret = cache.read("/file", buf.data(), offset, count, file.fetch_fn());
+    REQUIRE(ret.first == 0);
+    REQUIRE(ret.second >= 0);
+    buf.resize(ret.second);
+    return buf;
+}
+
+} // namespace
+
+SCENARIO(" sequential reads are served from cached chunks ", "[chunk_cache]") {
+
+    GIVEN(" a cache of eight chunks and a file of four chunks ") {
+        ChunkCache cache(chunk_size, 8 * chunk_size, 4);
+        FakeFile file;
+        for(uint64_t i = 0; i < 4; i++) {
+            file.chunks[i] = std::string(chunk_size, 'a' + i);
+        }
+
+        WHEN(" the file is read sequentially ") {
+            REQUIRE(read(cache, file, 0, 8) == std::string(8, 'a'));
+
+            THEN(" the first miss fetches a chunk of read-ahead ") {
+                REQUIRE(file.fetches == 1);
+                REQUIRE(file.last_offset == 0);
+                REQUIRE(file.last_count == 2 * chunk_size);
+                REQUIRE(cache.size() == 2 * chunk_size);
+                REQUIRE(cache.misses() == 1);
+            }
+            THEN(" following reads within the window hit ") {
+                REQUIRE(read(cache, file, 8, 16) ==
+                        std::string(8, 'a') + std::string(8, 'b'));
+                REQUIRE(read(cache, file, 24, 8) == std::string(8, 'b'));
+                REQUIRE(file.fetches == 1);
+                REQUIRE(cache.hits() == 2);
+            }
+            THEN(" the next miss doubles the read-ahead window ") {
+                read(cache, file, 8, 24);
+                REQUIRE(read(cache, file, 32, 8) == std::string(8, 'c'));
+                REQUIRE(file.fetches == 2);
+                REQUIRE(file.last_offset == 2 * chunk_size);
+                REQUIRE(file.last_count == 3 * chunk_size);
+            }
+        }
+
+        WHEN(" the file is read at random offsets ") {
+            REQUIRE(read(cache, file, 40, 4) == std::string(4, 'c'));
+
+            THEN(" the read bypasses the cache ") {
+                REQUIRE(file.last_offset == 40);
+                REQUIRE(file.last_count == 4);
+                REQUIRE(cache.size() == 0);
+            }
+            THEN(" no read-ahead state is kept for the file ") {
+                REQUIRE(read(cache, file, 44, 4) == std::string(4, 'c'));
+                REQUIRE(file.last_offset == 44);
+                REQUIRE(file.last_count == 4);
+            }
+        }
+    }
+}
+
+SCENARIO(" incomplete fetches are bounded by the returned size ",
+         "[chunk_cache]") {
+
+    GIVEN(" a cache of eight chunks ") {
+        ChunkCache cache(chunk_size, 8 * chunk_size, 4);
+        FakeFile file;
+
+        WHEN(" the file ends within the fetched chunks ") {
+            file.chunks[0] = std::string(chunk_size, 'a');
+            file.chunks[1] = "bbbb";
+            REQUIRE(read(cache, file, 0, 16) == std::string(16, 'a'));
+
+            THEN(" the chunk containing EOF is cached ") {
+                REQUIRE(cache.size() == chunk_size + 4);
+                REQUIRE(read(cache, file, 16, 16) == "bbbb");
+                REQUIRE(read(cache, file, 20, 8).empty());
+                REQUIRE(file.fetches == 1);
+            }
+        }
+
+        WHEN(" a sparse chunk precedes written data ") {
+            file.chunks[1] = std::string(chunk_size, 'b');
+            auto first = read(cache, file, 0, 16);
+
+            THEN(" the sparse chunk reads as zeros without another fetch ") {
+                REQUIRE(first == std::string(16, '\0'));
+                REQUIRE(file.fetches == 1);
+                REQUIRE(cache.size() == chunk_size);
+            }
+            THEN(" the written chunk is read and cached at its offset ") {
+                REQUIRE(read(cache, file, 16, 16) == std::string(16, 'b'));
+                REQUIRE(cache.size() == 2 * chunk_size);
+                REQUIRE(read(cache, file, 16, 8) == std::string(8, 'b'));
+            }
+        }
+
+        WHEN(" a sparse chunk follows written data ") {
+            file.chunks[0] = std::string(chunk_size, 'a');
+            file.chunks[2] = std::string(chunk_size, 'c');
+            read(cache, file, 0, 8);
+            auto second = read(cache, file, 8, 24);
+
+            THEN(" the data before and after the sparse chunk is found ") {
+                REQUIRE(second ==
+                        std::string(8, 'a') + std::string(16, '\0'));
+                REQUIRE(read(cache, file, 32, 16) == std::string(16, 'c'));
+            }
+        }
+
+        WHEN(" all fetched chunks are empty ") {
+            file.chunks[0] = std::string(chunk_size, 'a');
+            read(cache, file, 0, 16);
+            auto fetches = file.fetches;
+
+            THEN(" the read returns EOF without another fetch ") {
+                REQUIRE(read(cache, file, 16, 16).empty());
+                REQUIRE(file.fetches == fetches + 1);
+            }
+        }
+    }
+}
+
+SCENARIO(" invalidated chunks are dropped ", "[chunk_cache]") {
+
+    GIVEN(" a cache holding chunks of a file ") {
+        ChunkCache cache(chunk_size, 8 * chunk_size, 4);
+        FakeFile file;
+        for(uint64_t i = 0; i < 4; i++) {
+            file.chunks[i] = std::string(chunk_size, 'a' + i);
+        }
+        read(cache, file, 0, 8);
+        REQUIRE(cache.size() == 2 * chunk_size);
+
+        WHEN(" a written range is invalidated ") {
+            cache.invalidate("/file", 20, 4);
+            file.chunks[1] = std::string(chunk_size, 'x');
+
+            THEN(" only the overlapping chunk is dropped ") {
+                REQUIRE(cache.size() == chunk_size);
+                REQUIRE(read(cache, file, 8, 8) == std::string(8, 'a'));
+                REQUIRE(read(cache, file, 16, 8) == std::string(8, 'x'));
+            }
+        }
+
+        WHEN(" the whole file is invalidated ") {
+            cache.invalidate("/file");
+
+            THEN(" its chunks and the read-ahead state are dropped ") {
+                REQUIRE(cache.size() == 0);
+                read(cache, file, 8, 8);
+                REQUIRE(file.last_offset == 8);
+                REQUIRE(file.last_count == 8);
+            }
+        }
+
+        WHEN(" the file is modified while a fetch is in flight ") {
+            read(cache, file, 8, 24);
+            auto racing_fetch = [&](char* buf, off64_t offset, size_t count) {
+                auto ret = file.fetch(buf, offset, count);
+                cache.invalidate("/file", offset, count);
+                return ret;
+            };
+            std::string buf(16, '?');
+            auto ret = cache.read("/file", buf.data(), 32, 16, racing_fetch);
+            REQUIRE(ret.second == 16);
+
+            THEN(" the fetched chunks are not cached ") {
+                REQUIRE(cache.size() == 2 * chunk_size);
+            }
+        }
+
+        WHEN(" the file is removed while a fetch is in flight ") {
+            read(cache, file, 8, 24);
+            auto racing_fetch = [&](char* buf, off64_t offset, size_t count) {
+                auto ret = file.fetch(buf, offset, count);
+                cache.invalidate("/file");
+                return ret;
+            };
+            std::string buf(16, '?');
+            cache.read("/file", buf.data(), 32, 16, racing_fetch);
+
+            THEN(" the fetched chunks are not cached in the new entry ") {
+                REQUIRE(cache.size() == 0);
+            }
+        }
+    }
+}
+
+SCENARIO(" the chunk cache stays within its size ", "[chunk_cache]") {
+
+    GIVEN(" a cache of two chunks ") {
+        ChunkCache cache(chunk_size, 2 * chunk_size, 4);
+        FakeFile file;
+        for(uint64_t i = 0; i < 8; i++) {
+            file.chunks[i] = std::string(chunk_size, 'a' + i);
+        }
+
+        WHEN(" more chunks are fetched than fit ") {
+            read(cache, file, 0, 8);
+            read(cache, file, 8, 24);
+            REQUIRE(read(cache, file, 32, 8) == std::string(8, 'c'));
+
+            THEN(" the least recently used chunks are evicted ") {
+                REQUIRE(cache.size() == 2 * chunk_size);
+                auto fetches = file.fetches;
+                REQUIRE(read(cache, file, 40, 8) == std::string(8, 'c'));
+                REQUIRE(file.fetches == fetches);
+                REQUIRE(read(cache, file, 0, 8) == std::string(8, 'a'));
+                REQUIRE(file.fetches == fetches + 1);
+            }
+        }
+
+        WHEN(" a read covers more chunks than fit ") {
+            read(cache, file, 0, 3 * chunk_size);
+
+            THEN(" it bypasses the cache ") {
+                REQUIRE(file.last_count == 3 * chunk_size);
+                REQUIRE(cache.size() == 0);
+            }
+        }
+
+        WHEN(" the cache is cleared ") {
+            read(cache, file, 0, 8);
+            cache.clear();
+
+            THEN(" no chunks are left ") {
+                REQUIRE(cache.size() == 0);
+                read(cache, file, 8, 8);
+                REQUIRE(file.last_offset == 8);
+                REQUIRE(file.last_count == 8);
+            }
+        }
+    }
+}
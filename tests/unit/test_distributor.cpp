@@ -0,0 +1,254 @@
+/*
+  Copyright 2018-2024, Barcelona Supercomputing Center (BSC), Spain
+  Copyright 2015-2024, Johannes Gutenberg Universitaet Mainz, Germany
+
+  This software was partially supported by the
+  EC H2020 funded project NEXTGenIO (Project ID: 671951, www.nextgenio.eu).
+
+  This software was partially supported by the
+  ADA-FS project under the SPPEXA project funded by the DFG.
+
+  This file is part of GekkoFS.
+
+  GekkoFS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GekkoFS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GekkoFS.  If not, see <https://www.gnu.org/licenses/>.
+
+  SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include <common/rpc/distributor.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace gkfs::rpc;
+
+namespace {
+
+/**
+ * Previous placement of SimpleHashDistributor, kept as a baseline for the
+ * benchmarks below.
+ */
+host_t
+legacy_locate_data(const std::string& path, chunkid_t chnk_id,
+                   unsigned int hosts_size) {
+    return std::hash<std::string>{}(path + std::to_string(chnk_id)) %
+           hosts_size;
+}
+
+/**
+ * Counts the chunks placed on each host for `files` files of `chunks` chunks
+ */
+template <typename Locate>
+std::vector<size_t>
+count_chunks(unsigned int hosts_size, unsigned int files, unsigned int chunks,
+             Locate&& locate) {
+    std::vector<size_t> per_host(hosts_size);
+    for(unsigned int f = 0; f < files; f++) {
+        auto path = fmt::format("/output/rank.{}.dat", f);
+        for(chunkid_t c = 0; c < chunks; c++) {
+            per_host.at(locate(path, c))++;
+        }
+    }
+    return per_host;
+}
+
+} // namespace
+
+SCENARIO(" the placement hash is stable ", "[distributor][hash]") {
+
+    GIVEN(" fixed paths ") {
+
+        THEN(" hash_path() returns the documented values ") {
+            // These values must never change. Otherwise, clients and daemons
+            // of different versions place files differently.
+            REQUIRE(hash_path("") == 0x2afa3043c0fbb4d2ull);
+            REQUIRE(hash_path("/") == 0xc6ccfc30bf5e4698ull);
+            REQUIRE(hash_path("/file") == 0x11220e77ed88cc0bull);
+            REQUIRE(hash_path("/a/rather/long/path/to/some/file.dat") ==
+                    0x8bb14d616f0eeafcull);
+        }
+
+        THEN(" hash_chunk() returns the documented values ") {
+            REQUIRE(hash_chunk(hash_path("/file"), 0) == 0x6a8cfdec0315af8aull);
+            REQUIRE(hash_chunk(hash_path("/file"), 1) == 0x0aed51158c159aa1ull);
+        }
+    }
+}
+
+SCENARIO(" SimpleHashDistributor places chunks by the placement hash ",
+         "[distributor][simple_hash]") {
+
+    GIVEN(" a distributor with 10 hosts ") {
+
+        SimpleHashDistributor d(0, 10);
+        const std::string path = "/some/file";
+
+        THEN(" locate_data() and locate_data_hashed() agree ") {
+            const chunkid_t c = GENERATE(range(0u, 100u));
+            const int copy = GENERATE(0, 1, 2);
+            REQUIRE(d.locate_data(path, c, copy) ==
+                    d.locate_data_hashed(path, hash_path(path), c, copy));
+        }
+
+        THEN(" replicas are placed on consecutive hosts ") {
+            const chunkid_t c = GENERATE(range(0u, 100u));
+            REQUIRE(d.locate_data(path, c, 1) ==
+                    (d.locate_data(path, c, 0) + 1) % 10);
+        }
+    }
+
+    GIVEN(" many files with many chunks ") {
+
+        const unsigned int hosts_size = GENERATE(3u, 7u, 16u, 64u);
+        SimpleHashDistributor d(0, hosts_size);
+        auto per_host = count_chunks(
+                hosts_size, 1000, 64,
+                [&](const std::string& path, chunkid_t c) {
+                    return d.locate_data(path, c, 0);
+                });
+
+        THEN(" every host holds a similar number of chunks ") {
+            const auto expected = 1000.0 * 64 / hosts_size;
+            auto [min, max] = std::minmax_element(per_host.begin(),
+                                                  per_host.end());
+            REQUIRE(*min > expected * 0.85);
+            REQUIRE(*max < expected * 1.15);
+        }
+    }
+}
+
+SCENARIO(" JumpHashDistributor moves few chunks when hosts are added ",
+         "[distributor][jump_hash]") {
+
+    GIVEN(" a file system that grows from N to N + k hosts ") {
+
+        const unsigned int hosts_size = GENERATE(4u, 10u, 31u);
+        const unsigned int added = GENERATE(1u, 4u);
+        JumpHashDistributor before(0, hosts_size);
+        JumpHashDistributor after(0, hosts_size + added);
+
+        size_t total = 0;
+        size_t moved = 0;
+        size_t moved_to_old_host = 0;
+        for(unsigned int f = 0; f < 200; f++) {
+            auto path = fmt::format("/output/rank.{}.dat", f);
+            for(chunkid_t c = 0; c < 64; c++) {
+                auto old_host = before.locate_data(path, c, 0);
+                auto new_host = after.locate_data(path, c, 0);
+                total++;
+                if(old_host != new_host) {
+                    moved++;
+                    if(new_host < hosts_size)
+                        moved_to_old_host++;
+                }
+            }
+        }
+
+        THEN(" about k / (N + k) of all chunks move ") {
+            const auto expected = static_cast<double>(total) * added /
+                                  (hosts_size + added);
+            REQUIRE(moved > expected * 0.85);
+            REQUIRE(moved < expected * 1.15);
+        }
+
+        THEN(" chunks only move to the new hosts ") {
+            REQUIRE(moved_to_old_host == 0);
+        }
+    }
+
+    GIVEN(" a distributor with 10 hosts ") {
+
+        JumpHashDistributor d(0, 10);
+        const std::string path = "/some/file";
+
+        THEN(" locate_data() and locate_data_hashed() agree ") {
+            const chunkid_t c = GENERATE(range(0u, 100u));
+            const int copy = GENERATE(0, 1, 2);
+            REQUIRE(d.locate_data(path, c, copy) ==
+                    d.locate_data_hashed(path, hash_path(path), c, copy));
+        }
+
+        THEN(" replicas are placed on consecutive hosts ") {
+            const chunkid_t c = GENERATE(range(0u, 100u));
+            REQUIRE(d.locate_data(path, c, 1) ==
+                    (d.locate_data(path, c, 0) + 1) % 10);
+        }
+    }
+
+    GIVEN(" many files with many chunks ") {
+
+        const unsigned int hosts_size = GENERATE(3u, 7u, 16u, 64u);
+        JumpHashDistributor d(0, hosts_size);
+        auto per_host = count_chunks(
+                hosts_size, 1000, 64,
+                [&](const std::string& path, chunkid_t c) {
+                    return d.locate_data(path, c, 0);
+                });
+
+        THEN(" every host holds a similar number of chunks ") {
+            const auto expected = 1000.0 * 64 / hosts_size;
+            auto [min, max] = std::minmax_element(per_host.begin(),
+                                                  per_host.end());
+            REQUIRE(*min > expected * 0.85);
+            REQUIRE(*max < expected * 1.15);
+        }
+    }
+}
+
+TEST_CASE(" Placement cost ", "[.benchmark][distributor]") {
+
+    const unsigned int hosts_size = 16;
+    SimpleHashDistributor d(0, hosts_size);
+    const std::string path = "/gkfs/output/checkpoint.00042/rank.000123.dat";
+    const chunkid_t chunks = 1024; // one 512 MiB I/O with 512 KiB chunks
+
+    BENCHMARK("std::hash of path and chunk id") {
+        host_t sum = 0;
+        for(chunkid_t c = 0; c < chunks; c++) {
+            sum += legacy_locate_data(path, c, hosts_size);
+        }
+        return sum;
+    };
+
+    BENCHMARK("placement hash per chunk") {
+        host_t sum = 0;
+        for(chunkid_t c = 0; c < chunks; c++) {
+            sum += d.locate_data(path, c, 0);
+        }
+        return sum;
+    };
+
+    JumpHashDistributor jump(0, hosts_size);
+    BENCHMARK("jump consistent hash with path hashed once") {
+        host_t sum = 0;
+        auto path_hash = hash_path(path);
+        for(chunkid_t c = 0; c < chunks; c++) {
+            sum += jump.locate_data_hashed(path, path_hash, c, 0);
+        }
+        return sum;
+    };
+
+    BENCHMARK("placement hash with path hashed once") {
+        host_t sum = 0;
+        auto path_hash = hash_path(path);
+        for(chunkid_t c = 0; c < chunks; c++) {
+            sum += d.locate_data_hashed(path, path_hash, c, 0);
+        }
+        return sum;
+    };
+}
@@ -56,6 +56,6 @@ TEST_CASE( "Guided distributor Testing", "[Distributor]" ) {
                   d.locate_data("/t.c04",5,10,0) +
                   d.locate_data("/t.c05",5,10,0) +
                   d.locate_data("/t.c06",5,10,0) +
-                  d.locate_data("/t.c07",5,10,0) ) == 42);
+                  d.locate_data("/t.c07",5,10,0) ) == 45);
     }
 }
@@ -0,0 +1,233 @@
+/*
+  Copyright 2018-2024, Barcelona Supercomputing Center (BSC), Spain
+  Copyright 2015-2024, Johannes Gutenberg Universitaet Mainz, Germany
+
+  This software was partially supported by the
+  EC H2020 funded project NEXTGenIO (Project ID: 671951, www.nextgenio.eu).
+
+  This software was partially supported by the
+  ADA-FS project under the SPPEXA project funded by the DFG.
+
+  This file is part of GekkoFS.
+
+  GekkoFS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GekkoFS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GekkoFS.  If not, see <https://www.gnu.org/licenses/>.
+
+  SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#include <catch2/catch.hpp>
+#include <spdlog/spdlog.h>
+#include "helpers/helpers.hpp"
+
+#include <daemon/backend/metadata/inmemory_backend.hpp>
+#include <daemon/backend/metadata/metadata_module.hpp>
+#include <common/metadata.hpp>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include <sys/stat.h>
+}
+
+using namespace gkfs::metadata;
+
+namespace {
+
+/**
+ * The metadata module logs into a logger that the daemon sets up otherwise
+ */
+void
+setup_metadata_logger() {
+    if(!GKFS_METADATA_MOD->log()) {
+        GKFS_METADATA_MOD->log(spdlog::default_logger());
+    }
+}
+
+std::vector<std::string>
+names(const std::vector<std::pair<std::string, bool>>& dirents) {
+    std::vector<std::string> ret;
+    for(const auto& dirent : dirents) {
+        ret.push_back(dirent.first);
+    }
+    std::sort(ret.begin(), ret.end());
+    return ret;
+}
+
+} // namespace
+
+SCENARIO(" InMemoryBackend lists only the direct children of a directory ",
+         "[inmemory][dirents]") {
+
+    setup_metadata_logger();
+    helpers::temporary_directory tmpdir;
+
+    GIVEN(" a new database ") {
+
+        InMemoryBackend db(tmpdir.dirname().string(), false);
+        db.put("/", Metadata(S_IFDIR | 0755).serialize());
+        db.put("/a", Metadata(S_IFDIR | 0755).serialize());
+        db.put("/a/b", Metadata(S_IFDIR | 0755).serialize());
+        db.put("/a/b/c", Metadata(S_IFREG | 0644).serialize());
+        db.put("/a/d", Metadata(S_IFREG | 0644).serialize());
+        db.put("/ab", Metadata(S_IFREG | 0644).serialize());
+
+        THEN(" entries can be found by their path ") {
+            REQUIRE(db.exists("/a/b/c"));
+            REQUIRE(!db.exists("/a/c"));
+            REQUIRE(Metadata(db.get("/a/d")).mode() == (S_IFREG | 0644));
+            REQUIRE_THROWS_AS(db.get("/a/c"), NotFoundException);
+            REQUIRE_THROWS_AS(
+                    db.put_no_exist("/a/d",
+                                    Metadata(S_IFREG | 0644).serialize()),
+                    ExistsException);
+            REQUIRE(db.db_size() == 6);
+        }
+
+        THEN(" readdir returns the direct children only ") {
+            REQUIRE(names(db.get_dirents("/")) ==
+                    std::vector<std::string>{"a", "ab"});
+            REQUIRE(names(db.get_dirents("/a/")) ==
+                    std::vector<std::string>{"b", "d"});
+            REQUIRE(names(db.get_dirents("/a/b/")) ==
+                    std::vector<std::string>{"c"});
+            REQUIRE(db.get_dirents("/a/b/c/").empty());
+            auto extended = db.get_dirents_extended("/a/");
+            REQUIRE(extended.size() == 2);
+        }
+
+        THEN(" readdir can be paged with resume keys ") {
+            db.put("/a/e", Metadata(S_IFREG | 0644).serialize());
+            db.put("/a/f", Metadata(S_IFREG | 0644).serialize());
+            auto page = db.get_dirents_page("/a/", "", 2);
+            REQUIRE(names(page) == std::vector<std::string>{"b", "d"});
+            page = db.get_dirents_page("/a/", page.back().first, 2);
+            REQUIRE(names(page) == std::vector<std::string>{"e", "f"});
+            page = db.get_dirents_page("/a/", page.back().first, 2);
+            REQUIRE(page.empty());
+            REQUIRE(db.get_dirents_page("/", "a", 10).size() == 1);
+        }
+
+        WHEN(" an entry is renamed and removed ") {
+            db.update("/a/d", "/a/b/e", Metadata(S_IFREG | 0644).serialize());
+            db.remove("/ab");
+
+            THEN(" readdir reflects the changes ") {
+                REQUIRE(names(db.get_dirents("/")) ==
+                        std::vector<std::string>{"a"});
+                REQUIRE(names(db.get_dirents("/a/")) ==
+                        std::vector<std::string>{"b"});
+                REQUIRE(names(db.get_dirents("/a/b/")) ==
+                        std::vector<std::string>{"c", "e"});
+            }
+        }
+    }
+}
+
+SCENARIO(" InMemoryBackend updates file sizes in place ", "[inmemory][size]") {
+
+    setup_metadata_logger();
+    helpers::temporary_directory tmpdir;
+    const size_t threads = 8;
+    const size_t appends = 1000;
+    const size_t io_size = 100;
+
+    GIVEN(" a file with content ") {
+
+        InMemoryBackend db(tmpdir.dirname().string(), false);
+        db.put("/log", Metadata(S_IFREG | 0644).serialize());
+        db.increase_size("/log", 42, 0, false);
+
+        THEN(" size increases keep the maximum ") {
+            db.increase_size("/log", 10, 0, false);
+            REQUIRE(Metadata(db.get("/log")).size() == 42);
+            db.decrease_size("/log", 5);
+            REQUIRE(Metadata(db.get("/log")).size() == 5);
+            REQUIRE_THROWS_AS(db.increase_size("/none", 1, 0, false),
+                              NotFoundException);
+        }
+
+        WHEN(" several threads append to it ") {
+            std::vector<std::vector<off_t>> offsets(threads);
+            std::vector<std::thread> appenders;
+            for(size_t t = 0; t < threads; t++) {
+                appenders.emplace_back([&, t] {
+                    for(size_t i = 0; i < appends; i++) {
+                        offsets[t].push_back(
+                                db.increase_size("/log", io_size, 0, true));
+                    }
+                });
+            }
+            for(auto& appender : appenders) {
+                appender.join();
+            }
+
+            THEN(" each append starts at its own offset behind the content ") {
+                std::vector<off_t> all;
+                for(const auto& o : offsets) {
+                    all.insert(all.end(), o.begin(), o.end());
+                }
+                std::sort(all.begin(), all.end());
+                for(size_t i = 0; i < all.size(); i++) {
+                    REQUIRE(all[i] == static_cast<off_t>(42 + i * io_size));
+                }
+                REQUIRE(Metadata(db.get("/log")).size() ==
+                        42 + threads * appends * io_size);
+            }
+        }
+    }
+}
+
+SCENARIO(" InMemoryBackend restores a snapshot ", "[inmemory][snapshot]") {
+
+    setup_metadata_logger();
+    helpers::temporary_directory tmpdir;
+    const auto path = tmpdir.dirname().string();
+
+    GIVEN(" a database with snapshots ") {
+        {
+            InMemoryBackend db(path, true);
+            db.put("/", Metadata(S_IFDIR | 0755).serialize());
+            db.put("/d", Metadata(S_IFDIR | 0755).serialize());
+            db.put_batch({{"/d/a", Metadata(S_IFREG | 0644).serialize()},
+                          {"/d/b", Metadata(S_IFREG | 0600).serialize()}});
+            db.increase_size("/d/a", 4096, 0, false);
+        }
+
+        WHEN(" the backend is started again ") {
+            InMemoryBackend db(path, true);
+
+            THEN(" all entries are restored ") {
+                REQUIRE(db.db_size() == 4);
+                REQUIRE(Metadata(db.get("/d/a")).size() == 4096);
+                auto vals = db.get_batch({"/d/b", "/d/x"});
+                REQUIRE(vals[0]);
+                REQUIRE(Metadata(*vals[0]).mode() == (S_IFREG | 0600));
+                REQUIRE(!vals[1]);
+                REQUIRE(names(db.get_dirents("/d/")) ==
+                        std::vector<std::string>{"a", "b"});
+            }
+        }
+
+        WHEN(" the backend is started without snapshots ") {
+            InMemoryBackend db(path, false);
+
+            THEN(" the database is empty ") {
+                REQUIRE(db.db_size() == 0);
+            }
+        }
+    }
+}
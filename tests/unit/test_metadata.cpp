@@ -0,0 +1,170 @@
+/*
+  Copyright 2018-2024, Barcelona Supercomputing Center (BSC), Spain
+  Copyright 2015-2024, Johannes Gutenberg Universitaet Mainz, Germany
+
+  This software was partially supported by the
+  EC H2020 funded project NEXTGenIO (Project ID: 671951, www.nextgenio.eu).
+
+  This software was partially supported by the
+  ADA-FS project under the SPPEXA project funded by the DFG.
+
+  This file is part of GekkoFS.
+
+  GekkoFS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GekkoFS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GekkoFS.  If not, see <https://www.gnu.org/licenses/>.
+
+  SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#include <catch2/catch.hpp>
+#include <common/metadata.hpp>
+
+#include <stdexcept>
+#include <string>
+
+extern "C" {
+#include <sys/stat.h>
+}
+
+using namespace gkfs::metadata;
+
+namespace {
+
+Metadata
+sample_metadata() {
+    Metadata md(S_IFREG | 0644);
+    md.size(123456789012);
+    md.atime(1700000001);
+    md.mtime(1700000002);
+    md.ctime(1700000003);
+    md.link_count(2);
+    md.blocks(241127);
+    return md;
+}
+
+void
+require_equal_fields(const Metadata& a, const Metadata& b) {
+    REQUIRE(a.mode() == b.mode());
+    REQUIRE(a.size() == b.size());
+    REQUIRE(a.blocks() == b.blocks());
+    if constexpr(gkfs::config::metadata::use_atime) {
+        REQUIRE(a.atime() == b.atime());
+    }
+    if constexpr(gkfs::config::metadata::use_mtime) {
+        REQUIRE(a.mtime() == b.mtime());
+    }
+    if constexpr(gkfs::config::metadata::use_ctime) {
+        REQUIRE(a.ctime() == b.ctime());
+    }
+    if constexpr(gkfs::config::metadata::use_link_cnt) {
+        REQUIRE(a.link_count() == b.link_count());
+    }
+#ifdef HAS_SYMLINKS
+    REQUIRE(a.target_path() == b.target_path());
+#ifdef HAS_RENAME
+    REQUIRE(a.rename_path() == b.rename_path());
+#endif
+#endif
+}
+
+} // namespace
+
+SCENARIO(" metadata serialization round-trips ", "[metadata]") {
+
+    GIVEN(" a regular file's metadata ") {
+        auto md = sample_metadata();
+
+        WHEN(" it is serialized to the binary format ") {
+            auto value = md.serialize();
+
+            THEN(" the header is fixed-size and little-endian ") {
+                // version(1) mode(4) 6 * 8 bytes, 2 path lengths(4)
+                REQUIRE(value.size() == 61);
+                REQUIRE(value[0] == 1);
+                REQUIRE(static_cast<unsigned char>(value[1]) == 0xA4);
+                REQUIRE(static_cast<unsigned char>(value[2]) == 0x81);
+                REQUIRE(value[3] == 0);
+                REQUIRE(value[4] == 0);
+            }
+            THEN(" parsing it restores all fields ") {
+                require_equal_fields(Metadata(value), md);
+            }
+        }
+
+        WHEN(" it is serialized to the legacy text format ") {
+            auto value = md.serialize_text();
+
+            THEN(" parsing it restores all configured fields ") {
+                require_equal_fields(Metadata(value), md);
+            }
+            THEN(" a trailing '\\0' stored by some backends is ignored ") {
+                value.push_back('\0');
+                require_equal_fields(Metadata(value), md);
+            }
+        }
+    }
+
+#ifdef HAS_SYMLINKS
+    GIVEN(" a symlink whose target contains the text separator ") {
+        Metadata md(LINK_MODE, "/data/a|b");
+#ifdef HAS_RENAME
+        md.rename_path("/data/renamed");
+#endif
+
+        THEN(" both formats restore the paths ") {
+            require_equal_fields(Metadata(md.serialize()), md);
+            require_equal_fields(Metadata(md.serialize_text()), md);
+        }
+    }
+#endif
+
+    GIVEN(" malformed values ") {
+        auto value = sample_metadata().serialize();
+
+        THEN(" truncated binary values are rejected ") {
+            REQUIRE_THROWS_AS(Metadata(value.substr(0, 20)),
+                              std::invalid_argument);
+        }
+        THEN(" text values without a mode are rejected ") {
+            REQUIRE_THROWS_AS(Metadata(std::string("|42")),
+                              std::invalid_argument);
+        }
+    }
+}
+
+TEST_CASE(" Metadata parse and serialize throughput ", "[.benchmark][metadata]") {
+
+    auto md = sample_metadata();
+#ifdef HAS_SYMLINKS
+    md.target_path("/gkfs/output/checkpoint.00042/rank.000123.dat");
+    md.mode(LINK_MODE);
+#endif
+    const auto text = md.serialize_text();
+    const auto binary = md.serialize();
+
+    BENCHMARK("text serialize") {
+        return md.serialize_text();
+    };
+
+    BENCHMARK("binary serialize") {
+        return md.serialize();
+    };
+
+    BENCHMARK("text parse") {
+        return Metadata(text).size();
+    };
+
+    BENCHMARK("binary parse") {
+        return Metadata(binary).size();
+    };
+}
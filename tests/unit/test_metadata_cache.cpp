@@ -0,0 +1,227 @@
+/*
+  Copyright 2018-2024, Barcelona Supercomputing Center (BSC), Spain
+  Copyright 2015-2024, Johannes Gutenberg Universitaet Mainz, Germany
+
+  This software was partially supported by the
+  EC H2020 funded project NEXTGenIO (Project ID: 671951, www.nextgenio.eu).
+
+  This software was partially supported by the
+  ADA-FS project under the SPPEXA project funded by the DFG.
+
+  This file is part of GekkoFS.
+
+  GekkoFS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GekkoFS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GekkoFS.  If not, see <https://www.gnu.org/licenses/>.
+
+  SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+
+#include <catch2/catch.hpp>
+
+#include <daemon/ops/metadata_cache.hpp>
+#include <common/metadata.hpp>
+
+#include <string>
+
+extern "C" {
+#include <sys/stat.h>
+}
+
+using namespace gkfs::metadata;
+
+namespace {
+
+Metadata
+file_md(size_t size) {
+    Metadata md(S_IFREG | 0644);
+    md.size(size);
+    return md;
+}
+
+/**
+ * Returns the cached size of a path, -1 on a cache miss
+ */
+long
+cached_size(MetadataCache& cache, const std::string& path) {
+    Metadata md{};
+    uint64_t epoch;
+    if(!cache.get(path, md, epoch)) {
+        return -1;
+    }
+    return static_cast<long>(md.size());
+}
+
+} // namespace
+
+SCENARIO(" the metadata cache drops fills and puts that raced a modification ",
+         "[metadata_cache]") {
+
+    GIVEN(" an empty cache ") {
+        MetadataCache cache(16, 1);
+
+        WHEN(" an entry is filled after a miss ") {
+            Metadata md{};
+            uint64_t epoch;
+            REQUIRE_FALSE(cache.get("/a", md, epoch));
+            cache.fill("/a", file_md(1), epoch);
+
+            THEN(" it is cached ") {
+                REQUIRE(cached_size(cache, "/a") == 1);
+                REQUIRE(cache.hits() == 1);
+                REQUIRE(cache.misses() == 1);
+            }
+        }
+
+        WHEN(" a modification finishes while a miss reads the backend ") {
+            Metadata md{};
+            uint64_t epoch;
+            REQUIRE_FALSE(cache.get("/a", md, epoch));
+            cache.put("/a", file_md(2), cache.epoch("/a"));
+            cache.fill("/a", file_md(1), epoch);
+
+            THEN(" the outdated fill is dropped ") {
+                REQUIRE(cached_size(cache, "/a") == 2);
+            }
+        }
+
+        WHEN(" two modifications of a shard overlap ") {
+            auto epoch = cache.epoch("/a");
+            cache.put("/b", file_md(3), cache.epoch("/b"));
+            cache.put("/a", file_md(1), epoch);
+
+            THEN(" the entry of the later put is evicted ") {
+                REQUIRE(cached_size(cache, "/a") == -1);
+                REQUIRE(cached_size(cache, "/b") == 3);
+            }
+        }
+
+        WHEN(" an update overlaps another modification ") {
+            cache.put("/a", file_md(1), cache.epoch("/a"));
+            auto epoch = cache.epoch("/a");
+            cache.put("/b", file_md(3), cache.epoch("/b"));
+            cache.update("/a", epoch, [](Metadata& md) { md.size(5); });
+
+            THEN(" the entry is evicted ") {
+                REQUIRE(cached_size(cache, "/a") == -1);
+            }
+        }
+
+        WHEN(" an uncached entry is updated ") {
+            cache.update("/a", cache.epoch("/a"),
+                         [](Metadata& md) { md.size(5); });
+
+            THEN(" it is not loaded ") {
+                REQUIRE(cached_size(cache, "/a") == -1);
+            }
+        }
+    }
+}
+
+SCENARIO(" the metadata cache mirrors the backend's size updates ",
+         "[metadata_cache]") {
+
+    GIVEN(" a cached file of 100 bytes ") {
+        MetadataCache cache(16, 4);
+        cache.put("/f", file_md(100), cache.epoch("/f"));
+
+        auto increase = [&](size_t io_size, off_t offset, bool append,
+                            off_t start) {
+            cache.increase_size("/f", cache.epoch("/f"), io_size, offset,
+                                append, start);
+        };
+
+        WHEN(" writes within and beyond the file size are merged ") {
+            increase(10, 20, false, -1);
+            REQUIRE(cached_size(cache, "/f") == 100);
+            increase(50, 80, false, -1);
+
+            THEN(" the size is the end of the last byte written ") {
+                REQUIRE(cached_size(cache, "/f") == 130);
+            }
+        }
+
+        WHEN(" appends are merged ") {
+            increase(10, 0, true, 100);
+            increase(5, 0, true, 110);
+
+            THEN(" the size ends after the reserved offset of the last one ") {
+                REQUIRE(cached_size(cache, "/f") == 115);
+            }
+        }
+
+        WHEN(" the file is truncated ") {
+            cache.decrease_size("/f", cache.epoch("/f"), 40);
+
+            THEN(" the size is the truncated size ") {
+                REQUIRE(cached_size(cache, "/f") == 40);
+            }
+        }
+
+        WHEN(" the offset reserved for an append got lost ") {
+            increase(10, 0, true, -1);
+
+            THEN(" the entry is evicted ") {
+                REQUIRE(cached_size(cache, "/f") == -1);
+            }
+        }
+    }
+}
+
+SCENARIO(" the metadata cache evicts entries ", "[metadata_cache]") {
+
+    GIVEN(" a cache with a single shard of three entries ") {
+        MetadataCache cache(3, 1);
+        for(size_t i = 0; i < 3; i++) {
+            auto path = "/" + std::to_string(i);
+            cache.put(path, file_md(i), cache.epoch(path));
+        }
+
+        WHEN(" an entry is removed ") {
+            auto epoch = cache.epoch("/1");
+            cache.erase("/1");
+
+            THEN(" it is no longer cached ") {
+                REQUIRE(cached_size(cache, "/1") == -1);
+                REQUIRE(cached_size(cache, "/0") == 0);
+            }
+            THEN(" a fill that raced the remove is dropped ") {
+                cache.fill("/1", file_md(1), epoch);
+                REQUIRE(cached_size(cache, "/1") == -1);
+            }
+        }
+
+        WHEN(" the capacity is exceeded ") {
+            // touch /0 so that /1 is the least recently used entry
+            REQUIRE(cached_size(cache, "/0") == 0);
+            cache.put("/3", file_md(3), cache.epoch("/3"));
+
+            THEN(" the least recently used entry is evicted ") {
+                REQUIRE(cached_size(cache, "/1") == -1);
+                REQUIRE(cached_size(cache, "/0") == 0);
+                REQUIRE(cached_size(cache, "/2") == 2);
+                REQUIRE(cached_size(cache, "/3") == 3);
+            }
+        }
+
+        WHEN(" the cache is cleared ") {
+            cache.clear();
+
+            THEN(" no entries are left ") {
+                for(size_t i = 0; i < 3; i++) {
+                    REQUIRE(cached_size(cache, "/" + std::to_string(i)) == -1);
+                }
+            }
+        }
+    }
+}
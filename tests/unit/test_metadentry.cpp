@@ -0,0 +1,177 @@
+/*
+  Copyright 2018-2024, Barcelona Supercomputing Center (BSC), Spain
+  Copyright 2015-2024, Johannes Gutenberg Universitaet Mainz, Germany
+
+  This software was partially supported by the
+  EC H2020 funded project NEXTGenIO (Project ID: 671951, www.nextgenio.eu).
+
+  This software was partially supported by the
+  ADA-FS project under the SPPEXA project funded by the DFG.
+
+  This file is part of GekkoFS.
+
+  GekkoFS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GekkoFS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GekkoFS.  If not, see <https://www.gnu.org/licenses/>.
+
+  SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+
+#include <catch2/catch.hpp>
+#include <spdlog/spdlog.h>
+#include "helpers/helpers.hpp"
+
+#include <daemon/daemon.hpp>
+#include <daemon/classes/fs_data.hpp>
+#include <daemon/ops/metadentry.hpp>
+#include <daemon/backend/metadata/db.hpp>
+#include <daemon/backend/metadata/metadata_module.hpp>
+#include <common/metadata.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include <sys/stat.h>
+}
+
+using namespace gkfs::metadata;
+
+namespace {
+
+/**
+ * Sets up the daemon state that the metadentry operations use, i.e., an
+ * in-memory metadata database without a metadata cache
+ */
+void
+setup_daemon_data(const std::string& path) {
+    // MetadataDB takes the logger that the daemon registers otherwise
+    if(!spdlog::get(GKFS_METADATA_MOD->LOGGER_NAME)) {
+        spdlog::register_logger(spdlog::default_logger()->clone(
+                GKFS_METADATA_MOD->LOGGER_NAME));
+    }
+    GKFS_DATA->spdlogger(spdlog::default_logger());
+    GKFS_DATA->atime_state(false);
+    GKFS_DATA->mtime_state(false);
+    GKFS_DATA->ctime_state(false);
+    GKFS_DATA->metadata_cache(nullptr);
+    GKFS_DATA->mdb(std::make_shared<MetadataDB>(path, inmemory_backend));
+}
+
+} // namespace
+
+SCENARIO(" metadentries are created, read, and removed in batches ",
+         "[metadentry][batch]") {
+
+    helpers::temporary_directory tmpdir;
+    setup_daemon_data(tmpdir.dirname().string());
+    GKFS_DATA->mdb()->put("/", Metadata(S_IFDIR | 0755).serialize());
+
+    GIVEN(" a batch that lists a path twice ") {
+        auto errs = create_batch({"/a", "/b", "/a"}, S_IFREG | 0644);
+
+        THEN(" the path is created once ") {
+            REQUIRE(errs == std::vector<int>{0, 0, EEXIST});
+            REQUIRE(GKFS_DATA->mdb()->exists("/a"));
+            REQUIRE(GKFS_DATA->mdb()->exists("/b"));
+        }
+
+        WHEN(" a second batch overlaps the first one ") {
+            errs = create_batch({"/b", "/c"}, S_IFREG | 0600);
+
+            THEN(" existing paths are not overwritten ") {
+                REQUIRE(errs == std::vector<int>{EEXIST, 0});
+                auto mds = get_batch({"/b", "/c", "/x"});
+                REQUIRE(mds.size() == 3);
+                REQUIRE(mds[0]);
+                REQUIRE(mds[0]->mode() == (S_IFREG | 0644));
+                REQUIRE(mds[1]);
+                REQUIRE(mds[1]->mode() == (S_IFREG | 0600));
+                REQUIRE(!mds[2]);
+            }
+        }
+
+        WHEN(" paths are removed in one batch ") {
+            remove_batch({"/a", "/x"});
+
+            THEN(" only the remaining paths are found ") {
+                auto mds = get_batch({"/a", "/b"});
+                REQUIRE(!mds[0]);
+                REQUIRE(mds[1]);
+            }
+
+            THEN(" a removed path can be created again ") {
+                REQUIRE(create_batch({"/a"}, S_IFREG | 0644) ==
+                        std::vector<int>{0});
+            }
+        }
+    }
+
+    GIVEN(" batches and single creates of the same paths at the same time ") {
+        constexpr size_t n = 1024;
+        constexpr size_t batch_size = 16;
+        constexpr size_t threads = 4;
+        std::vector<std::string> paths;
+        for(size_t i = 0; i < n; ++i) {
+            paths.push_back("/f" + std::to_string(i));
+        }
+        std::vector<std::atomic<int>> created(n);
+
+        // every thread starts at a different part of the paths
+        auto create_batches = [&](size_t t) {
+            for(size_t b = 0; b < n / batch_size; ++b) {
+                auto first = ((b + t * n / batch_size / threads) * batch_size) %
+                             n;
+                std::vector<std::string> batch(
+                        paths.begin() + first,
+                        paths.begin() + first + batch_size);
+                auto errs = create_batch(batch, S_IFREG | 0644);
+                for(size_t i = 0; i < batch_size; ++i) {
+                    if(errs[i] == 0)
+                        created[first + i]++;
+                }
+            }
+        };
+        auto create_single = [&](size_t t) {
+            for(size_t k = 0; k < n; ++k) {
+                auto i = (n - 1 - k + t * n / threads) % n;
+                Metadata md(S_IFREG | 0600);
+                try {
+                    create(paths[i], md);
+                    created[i]++;
+                } catch(const ExistsException& e) {
+                }
+            }
+        };
+        std::vector<std::thread> workers;
+        for(size_t t = 0; t < threads; ++t) {
+            workers.emplace_back(create_batches, t);
+            workers.emplace_back(create_single, t);
+        }
+        for(auto& worker : workers) {
+            worker.join();
+        }
+
+        THEN(" every path is created exactly once ") {
+            for(size_t i = 0; i < n; ++i) {
+                REQUIRE(created[i] == 1);
+            }
+        }
+    }
+
+    GKFS_DATA->close_mdb();
+}
@@ -0,0 +1,344 @@
+/*
+  Copyright 2018-2024, Barcelona Supercomputing Center (BSC), Spain
+  Copyright 2015-2024, Johannes Gutenberg Universitaet Mainz, Germany
+
+  This software was partially supported by the
+  EC H2020 funded project NEXTGenIO (Project ID: 671951, www.nextgenio.eu).
+
+  This software was partially supported by the
+  ADA-FS project under the SPPEXA project funded by the DFG.
+
+  This file is part of GekkoFS.
+
+  GekkoFS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GekkoFS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GekkoFS.  If not, see <https://www.gnu.org/licenses/>.
+
+  SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include <client/open_file_map.hpp>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include <fcntl.h>
+}
+
+using namespace gkfs::filemap;
+
+namespace {
+
+std::shared_ptr<OpenFile>
+make_file(const std::string& path) {
+    return std::make_shared<OpenFile>(path, O_RDWR);
+}
+
+/**
+ * Runs `lookups` get() calls on the given fds in each of `threads` threads.
+ * Every fourth lookup is for a kernel fd that is not in the map.
+ * @return number of lookups that found a file
+ */
+size_t
+concurrent_lookups(OpenFileMap& map, const std::vector<int>& fds,
+                   unsigned int threads, size_t lookups) {
+    std::vector<size_t> found(threads, 0);
+    std::vector<std::thread> workers;
+    for(unsigned int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            size_t hits = 0;
+            for(size_t i = 0; i < lookups; i++) {
+                auto fd = (i % 4 == 0) ? 3 : fds[(i + t) % fds.size()];
+                if(map.get(fd) != nullptr) {
+                    hits++;
+                }
+            }
+            found[t] = hits;
+        });
+    }
+    size_t sum = 0;
+    for(unsigned int t = 0; t < threads; t++) {
+        workers[t].join();
+        sum += found[t];
+    }
+    return sum;
+}
+
+} // namespace
+
+SCENARIO(" OpenFileMap hands out and resolves file descriptors ",
+         "[filemap]") {
+
+    GIVEN(" a map with four slots ") {
+        OpenFileMap map(100, 4);
+
+        WHEN(" files are added ") {
+            auto fd1 = map.add(make_file("/a"));
+            auto fd2 = map.add(make_file("/b"));
+
+            THEN(" they get distinct fds from the slot range ") {
+                REQUIRE(fd1 != fd2);
+                REQUIRE(fd1 >= 100);
+                REQUIRE(fd1 < 104);
+                REQUIRE(fd2 >= 100);
+                REQUIRE(fd2 < 104);
+                REQUIRE(map.exist(fd1));
+                REQUIRE(map.get(fd1)->path() == "/a");
+                REQUIRE(map.get(fd2)->path() == "/b");
+                REQUIRE(map.get_all().size() == 2);
+            }
+            THEN(" unknown fds are not found ") {
+                REQUIRE_FALSE(map.exist(3));
+                REQUIRE(map.get(3) == nullptr);
+                REQUIRE(map.get(-1) == nullptr);
+                REQUIRE(map.get(104) == nullptr);
+            }
+            THEN(" a removed fd is gone ") {
+                REQUIRE(map.remove(fd1));
+                REQUIRE_FALSE(map.exist(fd1));
+                REQUIRE(map.get(fd1) == nullptr);
+                REQUIRE_FALSE(map.remove(fd1));
+                REQUIRE(map.get(fd2)->path() == "/b");
+            }
+        }
+
+        WHEN(" more files are added than there are slots ") {
+            std::vector<int> fds;
+            for(int i = 0; i < 6; i++) {
+                fds.push_back(map.add(make_file(fmt::format("/f{}", i))));
+            }
+
+            THEN(" the remaining fds come from beyond the slot range ") {
+                REQUIRE(fds[4] >= 104);
+                REQUIRE(fds[5] >= 104);
+                REQUIRE(fds[4] != fds[5]);
+                for(int i = 0; i < 6; i++) {
+                    REQUIRE(map.get(fds[i])->path() == fmt::format("/f{}", i));
+                }
+                REQUIRE(map.get_all().size() == 6);
+                REQUIRE(map.remove(fds[5]));
+                REQUIRE(map.get(fds[5]) == nullptr);
+            }
+        }
+
+        WHEN(" an fd is duplicated ") {
+            auto fd = map.add(make_file("/a"));
+            auto dupfd = map.dup(fd);
+            auto dup2fd = map.dup2(fd, 1);
+
+            THEN(" all fds share the open file ") {
+                REQUIRE(dupfd != fd);
+                REQUIRE(dup2fd == 1);
+                REQUIRE(map.get(dupfd) == map.get(fd));
+                REQUIRE(map.get(1) == map.get(fd));
+                REQUIRE(map.get_all().size() == 3);
+            }
+            THEN(" dup2() replaces the open file of an existing fd ") {
+                auto other = map.add(make_file("/b"));
+                REQUIRE(map.dup2(other, dupfd) == dupfd);
+                REQUIRE(map.get(dupfd)->path() == "/b");
+                REQUIRE(map.dup2(other, 1) == 1);
+                REQUIRE(map.get(1)->path() == "/b");
+            }
+            THEN(" duplicating an unknown fd fails ") {
+                REQUIRE(map.dup(3) == -1);
+                REQUIRE(errno == EBADF);
+                REQUIRE(map.dup2(3, 4) == -1);
+            }
+        }
+    }
+
+    GIVEN(" a map with slots beyond the first 64 ") {
+        OpenFileMap map(100, 200);
+        std::vector<int> fds;
+        for(int i = 0; i < 150; i++) {
+            fds.push_back(map.add(make_file(fmt::format("/f{}", i))));
+        }
+
+        WHEN(" every other file is closed ") {
+            for(int i = 0; i < 150; i += 2) {
+                REQUIRE(map.remove(fds[i]));
+            }
+
+            THEN(" get_all() returns the open files only ") {
+                auto files = map.get_all();
+                REQUIRE(files.size() == 75);
+                for(const auto& file : files) {
+                    auto i = std::stoi(file->path().substr(2));
+                    REQUIRE(i % 2 == 1);
+                }
+            }
+            THEN(" dup2() into a closed slot is returned by get_all() ") {
+                REQUIRE(map.dup2(fds[1], 299) == 299);
+                REQUIRE(map.get_all().size() == 76);
+            }
+        }
+    }
+
+    GIVEN(" threads that concurrently open and close files ") {
+        OpenFileMap map(100, 64);
+        const unsigned int threads = 8;
+        std::vector<std::thread> workers;
+        std::vector<char> consistent(threads, 1);
+        for(unsigned int t = 0; t < threads; t++) {
+            workers.emplace_back([&, t] {
+                auto path = fmt::format("/thread{}", t);
+                for(int i = 0; i < 10000; i++) {
+                    auto fd = map.add(make_file(path));
+                    auto file = map.get(fd);
+                    if(file == nullptr || file->path() != path ||
+                       !map.remove(fd)) {
+                        consistent[t] = 0;
+                    }
+                }
+            });
+        }
+        for(auto& worker : workers) {
+            worker.join();
+        }
+
+        THEN(" no fd is handed out twice and all are released ") {
+            for(unsigned int t = 0; t < threads; t++) {
+                REQUIRE(consistent[t]);
+            }
+            REQUIRE(map.get_all().empty());
+        }
+    }
+}
+
+SCENARIO(" WriteBackBuffer coalesces adjacent writes within a chunk ",
+         "[filemap]") {
+
+    constexpr size_t chunk_size = 4096;
+    constexpr size_t capacity = 1024;
+    const std::string data(capacity, 'x');
+
+    GIVEN(" an empty buffer ") {
+        WriteBackBuffer buf;
+        REQUIRE(buf.empty());
+        REQUIRE_FALSE(buf.full(capacity, chunk_size));
+
+        WHEN(" adjacent writes are appended ") {
+            REQUIRE(buf.append("abc", 3, 100, capacity, chunk_size));
+            REQUIRE(buf.append("de", 2, 103, capacity, chunk_size));
+
+            THEN(" they form a single contiguous extent ") {
+                REQUIRE_FALSE(buf.empty());
+                REQUIRE(buf.offset() == 100);
+                REQUIRE(buf.end() == 105);
+                REQUIRE(buf.size() == 5);
+                REQUIRE(std::string(buf.data(), buf.size()) == "abcde");
+                REQUIRE_FALSE(buf.full(capacity, chunk_size));
+            }
+            THEN(" writes that are not adjacent are rejected ") {
+                REQUIRE_FALSE(buf.append("f", 1, 106, capacity, chunk_size));
+                REQUIRE_FALSE(buf.append("f", 1, 99, capacity, chunk_size));
+                REQUIRE_FALSE(buf.append("f", 1, 100, capacity, chunk_size));
+                REQUIRE(buf.size() == 5);
+            }
+            THEN(" a cleared buffer starts a new extent anywhere ") {
+                buf.clear();
+                REQUIRE(buf.empty());
+                REQUIRE(buf.append("f", 1, 2000, capacity, chunk_size));
+                REQUIRE(buf.offset() == 2000);
+                REQUIRE(buf.size() == 1);
+            }
+        }
+
+        WHEN(" data is buffered ") {
+            auto dirty = WriteBackBuffer::dirty_count();
+            REQUIRE(buf.append("abc", 3, 100, capacity, chunk_size));
+            REQUIRE(buf.append("de", 2, 103, capacity, chunk_size));
+
+            THEN(" the buffer counts as dirty until it is cleared ") {
+                REQUIRE(WriteBackBuffer::dirty_count() == dirty + 1);
+                buf.clear();
+                REQUIRE(WriteBackBuffer::dirty_count() == dirty);
+                buf.clear();
+                REQUIRE(WriteBackBuffer::dirty_count() == dirty);
+            }
+        }
+
+        WHEN(" writes reach the capacity ") {
+            REQUIRE(buf.append(data.data(), capacity - 1, 0, capacity,
+                               chunk_size));
+            REQUIRE_FALSE(buf.full(capacity, chunk_size));
+            REQUIRE_FALSE(buf.append("ab", 2, capacity - 1, capacity,
+                                     chunk_size));
+            REQUIRE(buf.append("a", 1, capacity - 1, capacity, chunk_size));
+
+            THEN(" the buffer is full ") {
+                REQUIRE(buf.size() == capacity);
+                REQUIRE(buf.full(capacity, chunk_size));
+                REQUIRE_FALSE(
+                        buf.append("b", 1, capacity, capacity, chunk_size));
+            }
+        }
+
+        WHEN(" writes reach the end of a chunk ") {
+            REQUIRE(buf.append(data.data(), 10, chunk_size - 10, capacity,
+                               chunk_size));
+
+            THEN(" the buffer is full and does not cross the boundary ") {
+                REQUIRE(buf.end() == static_cast<int64_t>(chunk_size));
+                REQUIRE(buf.full(capacity, chunk_size));
+                REQUIRE_FALSE(buf.append("a", 1, chunk_size, capacity,
+                                         chunk_size));
+            }
+        }
+
+        WHEN(" a write crosses a chunk boundary ") {
+            THEN(" it is not buffered ") {
+                REQUIRE_FALSE(buf.append(data.data(), 20, chunk_size - 10,
+                                         capacity, chunk_size));
+                REQUIRE(buf.empty());
+            }
+        }
+
+        WHEN(" a write is empty or has a negative offset ") {
+            THEN(" it is not buffered ") {
+                REQUIRE_FALSE(buf.append("a", 0, 0, capacity, chunk_size));
+                REQUIRE_FALSE(buf.append("a", 1, -1, capacity, chunk_size));
+                REQUIRE(buf.empty());
+            }
+        }
+    }
+}
+
+TEST_CASE(" Concurrent fd lookups ", "[.benchmark][filemap]") {
+
+    const size_t open_files = 256;
+    const size_t lookups = 100000;
+
+    OpenFileMap map;
+    std::vector<int> fds;
+    for(size_t i = 0; i < open_files; i++) {
+        fds.push_back(map.add(make_file(fmt::format("/file{}", i))));
+    }
+
+    auto max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for(unsigned int threads = 1; threads <= max_threads; threads *= 2) {
+        BENCHMARK(fmt::format("{} threads", threads)) {
+            return concurrent_lookups(map, fds, threads, lookups);
+        };
+    }
+
+    BENCHMARK("get_all() of 256 open files") {
+        return map.get_all().size();
+    };
+}
@@ -138,3 +138,92 @@ SCENARIO(" resolve fn should handle external paths ",
         }
     }
 }
+
+SCENARIO(" is_certainly_external fn should only reject external paths ",
+         "[test_path][fast path]") {
+
+    GIVEN(" a mount path ") {
+
+        CTX->mountdir("/home/foo/tmp/gkfs_mount");
+        CTX->cwd("/home/foo");
+
+        WHEN(" checking plain paths ") {
+            THEN(" paths outside of the mount path are external ") {
+                REQUIRE(gkfs::path::is_certainly_external(
+                        "/lustre/input/data.bin"));
+                REQUIRE(gkfs::path::is_certainly_external("/home/foo/tmp"));
+                REQUIRE(gkfs::path::is_certainly_external("/home/foo/tmp/"));
+                REQUIRE(gkfs::path::is_certainly_external("input/data.bin"));
+                REQUIRE(gkfs::path::is_certainly_external("tmp/gkfs"));
+            }
+            THEN(" paths inside of the mount path are not ") {
+                REQUIRE_FALSE(gkfs::path::is_certainly_external(
+                        "/home/foo/tmp/gkfs_mount"));
+                REQUIRE_FALSE(gkfs::path::is_certainly_external(
+                        "/home/foo/tmp/gkfs_mount/bar"));
+                REQUIRE_FALSE(
+                        gkfs::path::is_certainly_external("tmp/gkfs_mount"));
+                REQUIRE_FALSE(gkfs::path::is_certainly_external(
+                        "tmp/gkfs_mount/bar/"));
+            }
+        }
+
+        WHEN(" checking paths that change when resolved ") {
+            THEN(" they are left to resolve ") {
+                REQUIRE_FALSE(gkfs::path::is_certainly_external(""));
+                REQUIRE_FALSE(gkfs::path::is_certainly_external(
+                        "/lustre/../home/foo/tmp/gkfs_mount"));
+                REQUIRE_FALSE(gkfs::path::is_certainly_external(
+                        "//home/foo/tmp/gkfs_mount"));
+                REQUIRE_FALSE(gkfs::path::is_certainly_external(
+                        "/home/foo/./tmp/gkfs_mount"));
+                REQUIRE_FALSE(gkfs::path::is_certainly_external("./tmp"));
+                REQUIRE_FALSE(gkfs::path::is_certainly_external("../bar"));
+            }
+        }
+
+        WHEN(" the cwd is inside of the mount path ") {
+            CTX->cwd("/home/foo/tmp/gkfs_mount/bar");
+
+            THEN(" relative paths are not external ") {
+                REQUIRE_FALSE(gkfs::path::is_certainly_external("baz"));
+                REQUIRE(gkfs::path::is_certainly_external("/home/foo"));
+            }
+        }
+
+        WHEN(" the cwd is the root directory ") {
+            CTX->cwd("/");
+
+            THEN(" relative paths are compared with the mount path ") {
+                REQUIRE(gkfs::path::is_certainly_external("home/bar"));
+                REQUIRE_FALSE(gkfs::path::is_certainly_external(
+                        "home/foo/tmp/gkfs_mount/bar"));
+            }
+        }
+    }
+}
+
+TEST_CASE(" Per-syscall cost of classifying external paths ",
+          "[.benchmark][test_path]") {
+
+    CTX->mountdir("/home/foo/tmp/gkfs_mount");
+    CTX->cwd("/home/foo");
+    const char* absolute = "/lustre/scratch/project/input/part-00042.bin";
+    const char* relative = "input/part-00042.bin";
+
+    BENCHMARK("resolve absolute path") {
+        return gkfs::path::resolve_new(absolute).first;
+    };
+
+    BENCHMARK("fast path check of absolute path") {
+        return gkfs::path::is_certainly_external(absolute);
+    };
+
+    BENCHMARK("resolve relative path") {
+        return gkfs::path::resolve_new(relative).first;
+    };
+
+    BENCHMARK("fast path check of relative path") {
+        return gkfs::path::is_certainly_external(relative);
+    };
+}
@@ -0,0 +1,222 @@
+/*
+  Copyright 2018-2024, Barcelona Supercomputing Center (BSC), Spain
+  Copyright 2015-2024, Johannes Gutenberg Universitaet Mainz, Germany
+
+  This software was partially supported by the
+  EC H2020 funded project NEXTGenIO (Project ID: 671951, www.nextgenio.eu).
+
+  This software was partially supported by the
+  ADA-FS project under the SPPEXA project funded by the DFG.
+
+  This file is part of GekkoFS.
+
+  GekkoFS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GekkoFS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GekkoFS.  If not, see <https://www.gnu.org/licenses/>.
+
+  SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+
+#include <catch2/catch.hpp>
+#include <client/cache.hpp>
+
+#include <cstdint>
+#include <memory>
+
+using gkfs::cache::buffer::RegistrationCache;
+
+namespace {
+
+constexpr size_t max_region = 4096;
+
+void*
+address(uintptr_t addr) {
+    return reinterpret_cast<void*>(addr);
+}
+
+/**
+ * Looks up a buffer and counts how often it had to be exposed
+ */
+struct Exposer {
+    RegistrationCache& cache;
+    size_t exposed{0};
+
+    std::shared_ptr<hermes::exposed_memory>
+    get(uintptr_t addr, size_t size,
+        hermes::access_mode mode = hermes::access_mode::read_only) {
+        return cache.get(address(addr), size, mode, [this]() {
+            exposed++;
+            return hermes::exposed_memory{};
+        });
+    }
+};
+
+} // namespace
+
+SCENARIO(" exposed buffers are reused ", "[registration_cache]") {
+
+    GIVEN(" a cache of two buffers ") {
+        RegistrationCache cache(2, max_region);
+        Exposer exposer{cache};
+        auto memory = exposer.get(0x1000, 100);
+
+        WHEN(" the same buffer is used again ") {
+            auto again = exposer.get(0x1000, 100);
+
+            THEN(" its exposed memory is taken from the cache ") {
+                REQUIRE(again == memory);
+                REQUIRE(exposer.exposed == 1);
+                REQUIRE(cache.hits() == 1);
+                REQUIRE(cache.misses() == 1);
+            }
+        }
+
+        WHEN(" the buffer is used with a different size or access mode ") {
+            exposer.get(0x1000, 200);
+            exposer.get(0x1000, 100, hermes::access_mode::write_only);
+
+            THEN(" it is exposed again ") {
+                REQUIRE(exposer.exposed == 3);
+            }
+        }
+
+        WHEN(" a buffer exceeds the maximum region size ") {
+            exposer.get(0x10000, max_region + 1);
+            exposer.get(0x10000, max_region + 1);
+
+            THEN(" it is not cached ") {
+                REQUIRE(exposer.exposed == 3);
+                REQUIRE(cache.size() == 1);
+            }
+        }
+
+        WHEN(" more buffers are used than fit ") {
+            exposer.get(0x2000, 100);
+            // make 0x2000 the least recently used buffer
+            exposer.get(0x1000, 100);
+            exposer.get(0x3000, 100);
+
+            THEN(" the least recently used buffer is evicted ") {
+                REQUIRE(cache.size() == 2);
+                REQUIRE(exposer.exposed == 3);
+                exposer.get(0x1000, 100);
+                exposer.get(0x3000, 100);
+                REQUIRE(exposer.exposed == 3);
+                exposer.get(0x2000, 100);
+                REQUIRE(exposer.exposed == 4);
+            }
+            THEN(" evicted memory stays valid while it is held ") {
+                exposer.get(0x4000, 100);
+                REQUIRE(memory.use_count() == 1);
+            }
+        }
+    }
+}
+
+SCENARIO(" unmapped buffers are dropped from the registration cache ",
+         "[registration_cache]") {
+
+    GIVEN(" a cache holding three buffers ") {
+        RegistrationCache cache(16, max_region);
+        Exposer exposer{cache};
+        exposer.get(0x10000, 0x100);
+        exposer.get(0x20000, 0x100);
+        exposer.get(0x30000, max_region);
+
+        WHEN(" a range is unmapped that overlaps a buffer ") {
+            cache.invalidate(0x10080, 0x10);
+
+            THEN(" only that buffer is dropped ") {
+                REQUIRE(cache.size() == 2);
+                exposer.get(0x10000, 0x100);
+                REQUIRE(exposer.exposed == 4);
+            }
+        }
+
+        WHEN(" ranges are unmapped that only touch a buffer ") {
+            cache.invalidate(0x1ff00, 0x100);
+            cache.invalidate(0x20100, 0x100);
+
+            THEN(" the buffer is kept ") {
+                REQUIRE(cache.size() == 3);
+            }
+        }
+
+        WHEN(" a range is unmapped at the end of a large buffer ") {
+            cache.invalidate(0x30000 + max_region - 1, 1);
+
+            THEN(" the buffer that starts far below is dropped ") {
+                REQUIRE(cache.size() == 2);
+            }
+        }
+
+        WHEN(" a range is unmapped that spans several buffers ") {
+            cache.invalidate(0x10000, 0x20000);
+
+            THEN(" all of them are dropped ") {
+                REQUIRE(cache.size() == 1);
+            }
+        }
+
+        WHEN(" the cache is cleared ") {
+            cache.clear();
+
+            THEN(" no buffers are left ") {
+                REQUIRE(cache.size() == 0);
+                cache.invalidate(0x10000, 0x100);
+                REQUIRE(cache.size() == 0);
+            }
+        }
+    }
+}
+
+SCENARIO(" buffers unmapped while being exposed are not cached ",
+         "[registration_cache]") {
+
+    GIVEN(" an empty cache ") {
+        RegistrationCache cache(16, max_region);
+
+        WHEN(" any range is unmapped while a buffer is exposed ") {
+            auto memory =
+                    cache.get(address(0x1000), 100,
+                              hermes::access_mode::read_only, [&cache]() {
+                                  cache.invalidate(0x80000, 0x1000);
+                                  return hermes::exposed_memory{};
+                              });
+
+            THEN(" the exposed memory is returned but not cached ") {
+                REQUIRE(memory != nullptr);
+                REQUIRE(cache.size() == 0);
+            }
+            THEN(" a later use of the buffer is cached ") {
+                Exposer exposer{cache};
+                exposer.get(0x1000, 100);
+                exposer.get(0x1000, 100);
+                REQUIRE(exposer.exposed == 1);
+                REQUIRE(cache.size() == 1);
+            }
+        }
+
+        WHEN(" the cache is cleared while a buffer is exposed ") {
+            cache.get(address(0x1000), 100, hermes::access_mode::read_only,
+                      [&cache]() {
+                          cache.clear();
+                          return hermes::exposed_memory{};
+                      });
+
+            THEN(" the buffer is not cached ") {
+                REQUIRE(cache.size() == 0);
+            }
+        }
+    }
+}
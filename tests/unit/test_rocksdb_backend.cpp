@@ -0,0 +1,505 @@
+/*
+  Copyright 2018-2024, Barcelona Supercomputing Center (BSC), Spain
+  Copyright 2015-2024, Johannes Gutenberg Universitaet Mainz, Germany
+
+  This software was partially supported by the
+  EC H2020 funded project NEXTGenIO (Project ID: 671951, www.nextgenio.eu).
+
+  This software was partially supported by the
+  ADA-FS project under the SPPEXA project funded by the DFG.
+
+  This file is part of GekkoFS.
+
+  GekkoFS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GekkoFS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GekkoFS.  If not, see <https://www.gnu.org/licenses/>.
+
+  SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+#include "helpers/helpers.hpp"
+
+#include <daemon/backend/metadata/db.hpp>
+#include <daemon/backend/metadata/metadata_module.hpp>
+#include <common/metadata.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include <sys/stat.h>
+}
+
+using namespace gkfs::metadata;
+
+namespace {
+
+/**
+ * The metadata module logs into a logger that the daemon sets up otherwise
+ */
+void
+setup_metadata_logger() {
+    if(!GKFS_METADATA_MOD->log()) {
+        GKFS_METADATA_MOD->log(spdlog::default_logger());
+    }
+}
+
+/**
+ * Writes `paths` with plain path keys and text values, as done before the
+ * direct-children key format and the binary metadata format were introduced
+ */
+void
+write_legacy_db(const std::string& db_path,
+                const std::vector<std::pair<std::string, mode_t>>& paths) {
+    rdb::Options options;
+    options.create_if_missing = true;
+    rdb::DB* db = nullptr;
+    REQUIRE(rdb::DB::Open(options, db_path, &db).ok());
+    std::unique_ptr<rdb::DB> db_guard(db);
+    for(const auto& [path, mode] : paths) {
+        REQUIRE(db->Put(rdb::WriteOptions(), path,
+                        Metadata(mode).serialize_text())
+                        .ok());
+    }
+}
+
+/**
+ * Appends to a file from several threads at once
+ * @return the reserved offsets of all appends in ascending order
+ */
+std::vector<off_t>
+append_concurrently(RocksDBBackend& db, const std::string& path,
+                    size_t threads, size_t appends, size_t io_size) {
+    std::vector<std::vector<off_t>> offsets(threads);
+    std::vector<std::thread> appenders;
+    for(size_t t = 0; t < threads; t++) {
+        appenders.emplace_back([&, t] {
+            for(size_t i = 0; i < appends; i++) {
+                offsets[t].push_back(db.increase_size(path, io_size, 0, true));
+            }
+        });
+    }
+    for(auto& appender : appenders) {
+        appender.join();
+    }
+    std::vector<off_t> all;
+    for(const auto& o : offsets) {
+        all.insert(all.end(), o.begin(), o.end());
+    }
+    std::sort(all.begin(), all.end());
+    return all;
+}
+
+std::vector<std::string>
+names(const std::vector<std::pair<std::string, bool>>& dirents) {
+    std::vector<std::string> ret;
+    for(const auto& dirent : dirents) {
+        ret.push_back(dirent.first);
+    }
+    std::sort(ret.begin(), ret.end());
+    return ret;
+}
+
+} // namespace
+
+SCENARIO(" metadata keys sort the direct children of a directory together ",
+         "[rocksdb][key_format]") {
+
+    GIVEN(" a set of paths ") {
+
+        const std::vector<std::string> paths{
+                "/", "/a", "/a/b", "/a/b/c", "/a/d", "/a b", "/ab", "/x"};
+
+        THEN(" decode_key() reverses encode_key() ") {
+            for(const auto& path : paths) {
+                REQUIRE(RocksDBBackend::decode_key(
+                                RocksDBBackend::encode_key(path)) == path);
+            }
+        }
+
+        THEN(" internal entries have no path ") {
+            REQUIRE(RocksDBBackend::decode_key(RocksDBBackend::key_format_key)
+                            .empty());
+        }
+
+        THEN(" the direct children are a contiguous key range ") {
+            std::vector<std::string> keys;
+            for(const auto& path : paths) {
+                keys.push_back(RocksDBBackend::encode_key(path));
+            }
+            std::sort(keys.begin(), keys.end());
+
+            auto prefix = RocksDBBackend::children_prefix("/a/");
+            auto first = std::find_if(keys.begin(), keys.end(),
+                                      [&](const std::string& k) {
+                                          return k.rfind(prefix, 0) == 0;
+                                      });
+            auto last = std::find_if(first, keys.end(),
+                                     [&](const std::string& k) {
+                                         return k.rfind(prefix, 0) != 0;
+                                     });
+            std::vector<std::string> children;
+            for(auto it = first; it != last; ++it) {
+                children.push_back(RocksDBBackend::decode_key(*it));
+            }
+            REQUIRE(children == std::vector<std::string>{"/a/b", "/a/d"});
+            REQUIRE(std::none_of(last, keys.end(), [&](const std::string& k) {
+                return k.rfind(prefix, 0) == 0;
+            }));
+        }
+    }
+}
+
+SCENARIO(" RocksDBBackend lists only the direct children of a directory ",
+         "[rocksdb][dirents]") {
+
+    setup_metadata_logger();
+    helpers::temporary_directory tmpdir;
+    const auto db_path = (tmpdir.dirname() / "rocksdb").string();
+
+    GIVEN(" a new database ") {
+
+        RocksDBBackend db(db_path);
+        db.put("/", Metadata(S_IFDIR | 0755).serialize());
+        db.put("/a", Metadata(S_IFDIR | 0755).serialize());
+        db.put("/a/b", Metadata(S_IFDIR | 0755).serialize());
+        db.put("/a/b/c", Metadata(S_IFREG | 0644).serialize());
+        db.put("/a/d", Metadata(S_IFREG | 0644).serialize());
+        db.put("/ab", Metadata(S_IFREG | 0644).serialize());
+
+        THEN(" entries can be found by their path ") {
+            REQUIRE(db.exists("/a/b/c"));
+            REQUIRE(!db.exists("/a/c"));
+            REQUIRE(Metadata(db.get("/a/d")).mode() == (S_IFREG | 0644));
+        }
+
+        THEN(" readdir returns the direct children only ") {
+            REQUIRE(names(db.get_dirents("/")) ==
+                    std::vector<std::string>{"a", "ab"});
+            REQUIRE(names(db.get_dirents("/a/")) ==
+                    std::vector<std::string>{"b", "d"});
+            REQUIRE(names(db.get_dirents("/a/b/")) ==
+                    std::vector<std::string>{"c"});
+            REQUIRE(db.get_dirents("/a/b/c/").empty());
+        }
+
+        THEN(" readdir can be paged with resume keys ") {
+            db.put("/a/e", Metadata(S_IFREG | 0644).serialize());
+            db.put("/a/f", Metadata(S_IFREG | 0644).serialize());
+            auto page = db.get_dirents_page("/a/", "", 2);
+            REQUIRE(names(page) == std::vector<std::string>{"b", "d"});
+            page = db.get_dirents_page("/a/", page.back().first, 2);
+            REQUIRE(names(page) == std::vector<std::string>{"e", "f"});
+            page = db.get_dirents_page("/a/", page.back().first, 2);
+            REQUIRE(page.empty());
+            REQUIRE(db.get_dirents_page("/", "a", 10).size() == 1);
+        }
+
+        WHEN(" an entry is renamed and removed ") {
+            db.update("/a/d", "/a/b/e", Metadata(S_IFREG | 0644).serialize());
+            db.remove("/ab");
+
+            THEN(" readdir reflects the changes ") {
+                REQUIRE(names(db.get_dirents("/")) ==
+                        std::vector<std::string>{"a"});
+                REQUIRE(names(db.get_dirents("/a/")) ==
+                        std::vector<std::string>{"b"});
+                REQUIRE(names(db.get_dirents("/a/b/")) ==
+                        std::vector<std::string>{"c", "e"});
+            }
+        }
+    }
+
+    GIVEN(" a database with plain path keys ") {
+
+        write_legacy_db(db_path, {{"/", S_IFDIR | 0755},
+                                  {"/a", S_IFDIR | 0755},
+                                  {"/a/b", S_IFREG | 0644},
+                                  {"/a/c", S_IFDIR | 0755},
+                                  {"/a/c/d", S_IFREG | 0644}});
+
+        WHEN(" the backend opens it ") {
+
+            RocksDBBackend db(db_path);
+
+            THEN(" all entries are converted ") {
+                REQUIRE(db.exists("/a/c/d"));
+                REQUIRE(Metadata(db.get("/a/b")).mode() == (S_IFREG | 0644));
+                REQUIRE(names(db.get_dirents("/a/")) ==
+                        std::vector<std::string>{"b", "c"});
+                REQUIRE(names(db.get_dirents("/a/c/")) ==
+                        std::vector<std::string>{"d"});
+            }
+        }
+    }
+}
+
+SCENARIO(" concurrent appends reserve disjoint offsets ", "[rocksdb][append]") {
+
+    setup_metadata_logger();
+    helpers::temporary_directory tmpdir;
+    const auto db_path = (tmpdir.dirname() / "rocksdb").string();
+    const size_t threads = 8;
+    const size_t appends = 1000;
+    const size_t io_size = 100;
+
+    GIVEN(" a file with content ") {
+        RocksDBBackend db(db_path);
+        db.put("/log", Metadata(S_IFREG | 0644).serialize());
+        db.increase_size("/log", 42, 0, false);
+
+        WHEN(" several threads append to it ") {
+            auto offsets =
+                    append_concurrently(db, "/log", threads, appends, io_size);
+
+            THEN(" each append starts at its own offset behind the content ") {
+                for(size_t i = 0; i < offsets.size(); i++) {
+                    REQUIRE(offsets[i] == static_cast<off_t>(42 + i * io_size));
+                }
+                REQUIRE(Metadata(db.get("/log")).size() ==
+                        42 + threads * appends * io_size);
+            }
+
+            THEN(" a truncate resets the size for later appends ") {
+                db.decrease_size("/log", 10);
+                REQUIRE(db.increase_size("/log", io_size, 0, true) == 10);
+                REQUIRE(Metadata(db.get("/log")).size() == 10 + io_size);
+            }
+        }
+    }
+
+    GIVEN(" a file that several threads appended to before a restart ") {
+        std::vector<off_t> offsets;
+        {
+            RocksDBBackend db(db_path);
+            db.put("/log", Metadata(S_IFREG | 0644).serialize());
+            db.increase_size("/log", 42, 0, false);
+            offsets = append_concurrently(db, "/log", threads, appends,
+                                          io_size);
+        }
+        const auto size = 42 + threads * appends * io_size;
+
+        WHEN(" the backend is reopened ") {
+            RocksDBBackend db(db_path);
+
+            THEN(" the appends did not overlap and their size is kept ") {
+                for(size_t i = 0; i < offsets.size(); i++) {
+                    REQUIRE(offsets[i] == static_cast<off_t>(42 + i * io_size));
+                }
+                REQUIRE(Metadata(db.get("/log")).size() == size);
+            }
+            THEN(" later appends start behind the kept size ") {
+                REQUIRE(db.increase_size("/log", io_size, 0, true) ==
+                        static_cast<off_t>(size));
+                REQUIRE(Metadata(db.get("/log")).size() == size + io_size);
+            }
+        }
+    }
+}
+
+SCENARIO(" metadata entries can be written, read, and removed in batches ",
+         "[rocksdb][batch]") {
+
+    setup_metadata_logger();
+    helpers::temporary_directory tmpdir;
+    const auto db_path = (tmpdir.dirname() / "rocksdb").string();
+
+    GIVEN(" a database with a directory ") {
+
+        RocksDBBackend db(db_path);
+        db.put("/", Metadata(S_IFDIR | 0755).serialize());
+        db.put("/d", Metadata(S_IFDIR | 0755).serialize());
+
+        WHEN(" files are put in one batch ") {
+            db.put_batch({{"/d/a", Metadata(S_IFREG | 0644).serialize()},
+                          {"/d/b", Metadata(S_IFREG | 0600).serialize()}});
+
+            THEN(" they can be read in one batch ") {
+                auto vals = db.get_batch({"/d/b", "/d/x", "/d/a"});
+                REQUIRE(vals.size() == 3);
+                REQUIRE(vals[0]);
+                REQUIRE(Metadata(*vals[0]).mode() == (S_IFREG | 0600));
+                REQUIRE(!vals[1]);
+                REQUIRE(vals[2]);
+                REQUIRE(Metadata(*vals[2]).mode() == (S_IFREG | 0644));
+                REQUIRE(names(db.get_dirents("/d/")) ==
+                        std::vector<std::string>{"a", "b"});
+            }
+
+            THEN(" they can be removed in one batch ") {
+                db.remove_batch({"/d/a", "/d/x"});
+                REQUIRE(!db.exists("/d/a"));
+                REQUIRE(db.exists("/d/b"));
+                REQUIRE(names(db.get_dirents("/d/")) ==
+                        std::vector<std::string>{"b"});
+            }
+
+            THEN(" appends see the size of a re-created file ") {
+                db.increase_size("/d/a", 100, 0, true);
+                db.remove_batch({"/d/a"});
+                db.put_batch({{"/d/a", Metadata(S_IFREG | 0644).serialize()}});
+                REQUIRE(db.increase_size("/d/a", 10, 0, true) == 0);
+            }
+        }
+    }
+}
+
+SCENARIO(" a tuning profile overwrites the default RocksDB settings ",
+         "[rocksdb][profile]") {
+
+    setup_metadata_logger();
+    helpers::temporary_directory tmpdir;
+    const auto profile_path = tmpdir.dirname() / "rocksdb.conf";
+
+    GIVEN(" a profile file ") {
+        helpers::temporary_file profile(profile_path,
+                                        "# metadata tuning\n"
+                                        "prefix_bloom = false\n"
+                                        "block_cache_size_mb=16\n"
+                                        "\n"
+                                        "  statistics = on  \n");
+
+        THEN(" the given settings are loaded ") {
+            auto p = RocksDBProfile::load(profile_path.string());
+            REQUIRE(!p.prefix_bloom);
+            REQUIRE(p.block_cache_size_mb == 16);
+            REQUIRE(p.statistics);
+            REQUIRE(p.bloom_bits_per_key ==
+                    gkfs::config::rocksdb::bloom_bits_per_key);
+        }
+
+        THEN(" the backend reports RocksDB's statistics ") {
+            RocksDBBackend db((tmpdir.dirname() / "rocksdb").string(),
+                              profile_path.string());
+            db.put("/", Metadata(S_IFDIR | 0755).serialize());
+            REQUIRE(db.exists("/"));
+            auto stats = db.db_stats();
+            REQUIRE(std::any_of(stats.begin(), stats.end(), [](auto& s) {
+                return s.first == "ROCKSDB_MEMTABLE_HIT" && s.second > 0;
+            }));
+        }
+    }
+
+    GIVEN(" a profile with an unknown key ") {
+        helpers::temporary_file profile(profile_path, "bloom_bits = 10\n");
+
+        THEN(" loading fails ") {
+            REQUIRE_THROWS(RocksDBProfile::load(profile_path.string()));
+        }
+    }
+}
+
+TEST_CASE(" Concurrent appends to a shared file ",
+          "[.benchmark][rocksdb][append]") {
+
+    setup_metadata_logger();
+    spdlog::set_level(spdlog::level::warn);
+    helpers::temporary_directory tmpdir;
+    const auto db_path = (tmpdir.dirname() / "rocksdb").string();
+    RocksDBBackend db(db_path);
+    db.put("/shared.log", Metadata(S_IFREG | 0644).serialize());
+
+    const size_t appends = 10'000;
+    for(size_t threads : {1, 4, 16, 64}) {
+        BENCHMARK(fmt::format("{} appenders", threads)) {
+            return append_concurrently(db, "/shared.log", threads,
+                                       appends / threads, 128);
+        };
+    }
+}
+
+TEST_CASE(" Listing a top-level directory of a large tree ",
+          "[.benchmark][rocksdb][dirents]") {
+
+    // 10M entries by default, override with GKFS_BENCHMARK_ENTRIES
+    size_t total = 10'000'000;
+    if(auto env = std::getenv("GKFS_BENCHMARK_ENTRIES"); env != nullptr) {
+        total = std::stoul(env);
+    }
+    const size_t top_dirs = 100;
+    const size_t sub_dirs = 100;
+    const size_t files =
+            std::max<size_t>(1, total / (top_dirs * sub_dirs)) - 1;
+
+    setup_metadata_logger();
+    spdlog::set_level(spdlog::level::warn);
+    helpers::temporary_directory tmpdir;
+    const auto db_path = (tmpdir.dirname() / "rocksdb").string();
+
+    // /bench/dir.<i>/sub.<j>/file.<k>
+    {
+        rdb::Options options;
+        options.create_if_missing = true;
+        rdb::DB* raw_db = nullptr;
+        REQUIRE(rdb::DB::Open(options, db_path, &raw_db).ok());
+        std::unique_ptr<rdb::DB> db(raw_db);
+        rdb::WriteBatch batch;
+        auto dir_md = Metadata(S_IFDIR | 0755).serialize();
+        auto file_md = Metadata(S_IFREG | 0644).serialize();
+        batch.Put("/", dir_md);
+        batch.Put("/bench", dir_md);
+        for(size_t i = 0; i < top_dirs; i++) {
+            auto dir = fmt::format("/bench/dir.{}", i);
+            batch.Put(dir, dir_md);
+            for(size_t j = 0; j < sub_dirs; j++) {
+                auto sub = fmt::format("{}/sub.{}", dir, j);
+                batch.Put(sub, dir_md);
+                for(size_t k = 0; k < files; k++) {
+                    batch.Put(fmt::format("{}/file.{}", sub, k), file_md);
+                }
+                if(batch.Count() >= 100'000) {
+                    REQUIRE(db->Write(rdb::WriteOptions(), &batch).ok());
+                    batch.Clear();
+                }
+            }
+        }
+        REQUIRE(db->Write(rdb::WriteOptions(), &batch).ok());
+
+        // the previous readdir scanned the directory's whole subtree
+        const std::string root_path = "/bench/";
+        BENCHMARK("readdir of /bench with plain path keys") {
+            std::unique_ptr<rdb::Iterator> it(
+                    db->NewIterator(rdb::ReadOptions()));
+            size_t entries = 0;
+            for(it->Seek(root_path);
+                it->Valid() && it->key().starts_with(root_path); it->Next()) {
+                auto name = it->key().ToString();
+                if(name.find_first_of('/', root_path.size()) !=
+                   std::string::npos) {
+                    continue;
+                }
+                Metadata md(std::string_view(it->value().data(),
+                                             it->value().size()));
+                entries++;
+            }
+            return entries;
+        };
+    }
+
+    // converts all entries to the direct-children key format
+    RocksDBBackend db(db_path);
+    REQUIRE(db.get_dirents("/bench/").size() == top_dirs);
+
+    BENCHMARK("readdir of /bench") {
+        return db.get_dirents("/bench/");
+    };
+
+    BENCHMARK("readdir of /bench/dir.0") {
+        return db.get_dirents("/bench/dir.0/");
+    };
+}
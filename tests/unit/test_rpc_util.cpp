@@ -0,0 +1,126 @@
+/*
+  Copyright 2018-2024, Barcelona Supercomputing Center (BSC), Spain
+  Copyright 2015-2024, Johannes Gutenberg Universitaet Mainz, Germany
+
+  This software was partially supported by the
+  EC H2020 funded project NEXTGenIO (Project ID: 671951, www.nextgenio.eu).
+
+  This software was partially supported by the
+  ADA-FS project under the SPPEXA project funded by the DFG.
+
+  This file is part of GekkoFS.
+
+  GekkoFS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GekkoFS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GekkoFS.  If not, see <https://www.gnu.org/licenses/>.
+
+  SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+
+#include <catch2/catch.hpp>
+#include <common/rpc/rpc_util.hpp>
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+SCENARIO(" for_each_concurrently calls a function for every id ",
+         "[rpc_util]") {
+
+    GIVEN(" many ids ") {
+        std::vector<uint64_t> ids(1000);
+        std::iota(ids.begin(), ids.end(), 0);
+        std::vector<std::atomic<int>> calls(ids.size());
+
+        WHEN(" they are processed by several threads ") {
+            gkfs::rpc::for_each_concurrently(
+                    ids, 8, [&](uint64_t id) { calls[id]++; });
+
+            THEN(" every id is processed exactly once ") {
+                for(const auto& c : calls) {
+                    REQUIRE(c == 1);
+                }
+            }
+        }
+
+        WHEN(" more threads than ids are requested ") {
+            std::vector<uint64_t> few(ids.begin(), ids.begin() + 3);
+            gkfs::rpc::for_each_concurrently(
+                    few, 64, [&](uint64_t id) { calls[id]++; });
+
+            THEN(" every id is processed exactly once ") {
+                REQUIRE(calls[0] == 1);
+                REQUIRE(calls[1] == 1);
+                REQUIRE(calls[2] == 1);
+                REQUIRE(calls[3] == 0);
+            }
+        }
+
+        WHEN(" a call fails ") {
+            THEN(" the exception is passed to the caller ") {
+                REQUIRE_THROWS_AS(gkfs::rpc::for_each_concurrently(
+                                          ids, 4,
+                                          [&](uint64_t id) {
+                                              if(id == 42) {
+                                                  throw std::runtime_error(
+                                                          "lookup failed");
+                                              }
+                                          }),
+                                  std::runtime_error);
+            }
+        }
+    }
+}
+
+SCENARIO(" string batches survive encoding ", "[rpc_util]") {
+
+    GIVEN(" an empty batch ") {
+        std::vector<std::string> strings;
+
+        WHEN(" it is encoded ") {
+            auto encoded = gkfs::rpc::encode_string_batch(strings);
+
+            THEN(" it decodes to an empty batch ") {
+                REQUIRE(encoded.empty());
+                REQUIRE(gkfs::rpc::decode_string_batch(encoded).empty());
+            }
+        }
+    }
+
+    GIVEN(" strings that are empty or contain the separator ") {
+        std::vector<std::string> strings{"", "/a:b", "", "12:/x", ":", "/c"};
+
+        WHEN(" they are encoded ") {
+            auto encoded = gkfs::rpc::encode_string_batch(strings);
+
+            THEN(" they decode to the same strings in the same order ") {
+                REQUIRE(gkfs::rpc::decode_string_batch(encoded) == strings);
+            }
+        }
+    }
+
+    GIVEN(" malformed batches ") {
+        THEN(" decoding them fails ") {
+            REQUIRE_THROWS_AS(gkfs::rpc::decode_string_batch("3:/a"),
+                              std::invalid_argument);
+            REQUIRE_THROWS_AS(gkfs::rpc::decode_string_batch("2/a"),
+                              std::invalid_argument);
+            REQUIRE_THROWS_AS(gkfs::rpc::decode_string_batch("2"),
+                              std::invalid_argument);
+            REQUIRE_THROWS_AS(gkfs::rpc::decode_string_batch(":/a"),
+                              std::invalid_argument);
+        }
+    }
+}
@@ -0,0 +1,184 @@
+/*
+  Copyright 2018-2024, Barcelona Supercomputing Center (BSC), Spain
+  Copyright 2015-2024, Johannes Gutenberg Universitaet Mainz, Germany
+
+  This software was partially supported by the
+  EC H2020 funded project NEXTGenIO (Project ID: 671951, www.nextgenio.eu).
+
+  This software was partially supported by the
+  ADA-FS project under the SPPEXA project funded by the DFG.
+
+  This file is part of GekkoFS.
+
+  GekkoFS is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  GekkoFS is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with GekkoFS.  If not, see <https://www.gnu.org/licenses/>.
+
+  SPDX-License-Identifier: GPL-3.0-or-later
+*/
+
+
+#include <catch2/catch.hpp>
+#include <client/cache.hpp>
+#include <common/metadata.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+extern "C" {
+#include <sys/stat.h>
+}
+
+using gkfs::cache::file::StatCache;
+using gkfs::metadata::Metadata;
+using namespace std::chrono_literals;
+
+namespace {
+
+Metadata
+file_md(size_t size) {
+    Metadata md(S_IFREG | 0644);
+    md.size(size);
+    return md;
+}
+
+} // namespace
+
+SCENARIO(" the stat cache serves metadata until it expires ", "[stat_cache]") {
+
+    GIVEN(" a cache with a ttl far longer than the test ") {
+        StatCache cache(1h, 16);
+        cache.insert("/a", file_md(1), cache.epoch());
+
+        WHEN(" the metadata is looked up ") {
+            auto md = cache.get("/a");
+
+            THEN(" it is a hit ") {
+                REQUIRE(md.has_value());
+                REQUIRE(md->size() == 1);
+                REQUIRE(cache.hits() == 1);
+                REQUIRE_FALSE(cache.get("/b").has_value());
+                REQUIRE(cache.misses() == 1);
+            }
+        }
+
+        WHEN(" the metadata is fetched again ") {
+            cache.insert("/a", file_md(2), cache.epoch());
+
+            THEN(" the entry is replaced ") {
+                auto md = cache.get("/a");
+                REQUIRE(md.has_value());
+                REQUIRE(md->size() == 2);
+                REQUIRE(cache.size() == 1);
+            }
+        }
+    }
+
+    GIVEN(" a cache with a ttl far shorter than the test ") {
+        StatCache cache(1ms, 16);
+        cache.insert("/a", file_md(1), cache.epoch());
+
+        WHEN(" the ttl has passed ") {
+            std::this_thread::sleep_for(50ms);
+
+            THEN(" the entry is dropped ") {
+                REQUIRE_FALSE(cache.get("/a").has_value());
+                REQUIRE(cache.misses() == 1);
+                REQUIRE(cache.size() == 0);
+            }
+        }
+    }
+}
+
+SCENARIO(" the stat cache drops invalidated metadata ", "[stat_cache]") {
+
+    GIVEN(" a cache holding two entries ") {
+        StatCache cache(1h, 16);
+        cache.insert("/a", file_md(1), cache.epoch());
+        cache.insert("/b", file_md(2), cache.epoch());
+
+        WHEN(" a path is invalidated ") {
+            cache.invalidate("/a");
+
+            THEN(" only its entry is dropped ") {
+                REQUIRE_FALSE(cache.get("/a").has_value());
+                REQUIRE(cache.get("/b").has_value());
+            }
+        }
+
+        WHEN(" any path is invalidated while a stat is in flight ") {
+            auto epoch = cache.epoch();
+            cache.invalidate("/b");
+            cache.insert("/c", file_md(3), epoch);
+
+            THEN(" the fetched metadata is not cached ") {
+                REQUIRE_FALSE(cache.get("/c").has_value());
+                REQUIRE(cache.size() == 1);
+            }
+            THEN(" a stat sent afterwards is cached ") {
+                cache.insert("/c", file_md(3), cache.epoch());
+                REQUIRE(cache.get("/c").has_value());
+            }
+        }
+
+        WHEN(" the cache is cleared while a stat is in flight ") {
+            auto epoch = cache.epoch();
+            cache.clear();
+            cache.insert("/a", file_md(1), epoch);
+
+            THEN(" no entries are left ") {
+                REQUIRE(cache.size() == 0);
+            }
+        }
+    }
+}
+
+SCENARIO(" the stat cache stays within its size ", "[stat_cache]") {
+
+    GIVEN(" a cache of two entries ") {
+        StatCache cache(1h, 2);
+        cache.insert("/a", file_md(1), cache.epoch());
+        cache.insert("/b", file_md(2), cache.epoch());
+
+        WHEN(" a third entry is inserted ") {
+            cache.insert("/c", file_md(3), cache.epoch());
+
+            THEN(" the oldest entry is evicted ") {
+                REQUIRE(cache.size() == 2);
+                REQUIRE_FALSE(cache.get("/a").has_value());
+                REQUIRE(cache.get("/b").has_value());
+                REQUIRE(cache.get("/c").has_value());
+            }
+        }
+
+        WHEN(" a cached entry is updated ") {
+            cache.insert("/a", file_md(4), cache.epoch());
+
+            THEN(" nothing is evicted ") {
+                REQUIRE(cache.size() == 2);
+                REQUIRE(cache.get("/a")->size() == 4);
+                REQUIRE(cache.get("/b").has_value());
+            }
+        }
+    }
+
+    GIVEN(" a cache without entries ") {
+        StatCache cache(1h, 0);
+        cache.insert("/a", file_md(1), cache.epoch());
+
+        THEN(" nothing is cached ") {
+            REQUIRE(cache.size() == 0);
+            REQUIRE_FALSE(cache.get("/a").has_value());
+        }
+    }
+}